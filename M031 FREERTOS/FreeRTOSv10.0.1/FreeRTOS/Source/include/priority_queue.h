@@ -0,0 +1,279 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A priority queue is a queue whose items each carry a small integer
+ * priority, from 0 to one less than the number of levels the queue was
+ * created with.  Receiving returns the oldest item of the highest priority
+ * held, so an urgent command overtakes bulk requests already queued without
+ * the need for a second queue and a queue set.  Items of equal priority are
+ * received in the order they were sent.
+ *
+ * The items share one pool of uxLength slots, and each priority level keeps a
+ * linked list of the slots holding its items.  Sending is O(1), and receiving
+ * is O(1) plus a scan down the levels for the highest one in use, so a queue
+ * should only be created with as many levels as it needs.  Each level records
+ * the most items it has held at once, to help size the queue.
+ *
+ * Tasks block to send and receive in the same way as with a queue, and the
+ * FromISR versions can be used from interrupts.  Items are copied in and out
+ * with interrupts masked, so priority queues suit small messages.
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include priority_queue.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * priority_queue.h
+ *
+ * Type by which priority queues are referenced.  For example, a call to
+ * xPriorityQueueCreate() returns a PriorityQueueHandle_t variable that can
+ * then be used as a parameter to other priority queue functions.
+ *
+ * \defgroup PriorityQueueHandle_t PriorityQueueHandle_t
+ * \ingroup PriorityQueues
+ */
+typedef void * PriorityQueueHandle_t;
+
+/*
+ * The number of bytes of storage a priority queue needs for uxLength items of
+ * uxItemSize bytes and uxLevels priorities.  Each level takes four
+ * UBaseType_t values and each slot one, followed by the items themselves.
+ */
+#define priorityqueueSTORAGE_SIZE( uxLength, uxItemSize, uxLevels ) ( ( ( ( ( size_t ) ( uxLevels ) * ( size_t ) 4 ) + ( size_t ) ( uxLength ) ) * sizeof( UBaseType_t ) ) + ( ( size_t ) ( uxLength ) * ( size_t ) ( uxItemSize ) ) )
+
+/**
+ * priority_queue.h
+ *
+<pre>
+PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels );
+PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels, uint8_t *pucStorageBuffer, StaticPriorityQueue_t *pxStaticPriorityQueue );
+</pre>
+ *
+ * Create a priority queue that holds up to uxLength items of uxItemSize bytes
+ * each, with priorities from 0 to ( uxLevels - 1 ).  The memory is either
+ * allocated from the FreeRTOS heap or provided by the pucStorageBuffer array,
+ * which must hold at least priorityqueueSTORAGE_SIZE( uxLength, uxItemSize,
+ * uxLevels ) bytes and be aligned to a UBaseType_t, and the
+ * StaticPriorityQueue_t variable pointed to by pxStaticPriorityQueue.
+ *
+ * The uxLength slots are shared by all the levels, so a burst of one priority
+ * can fill the queue.
+ *
+ * @return The handle of the queue, or NULL if it could not be allocated.
+ *
+ * \defgroup xPriorityQueueCreate xPriorityQueueCreate
+ * \ingroup PriorityQueues
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels, uint8_t *pucStorageBuffer, StaticPriorityQueue_t *pxStaticPriorityQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * priority_queue.h
+ *
+<pre>
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue );
+</pre>
+ *
+ * Delete a priority queue.  No task may be blocked on it.
+ *
+ * \defgroup vPriorityQueueDelete vPriorityQueueDelete
+ * \ingroup PriorityQueues
+ */
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, TickType_t xTicksToWait );
+</pre>
+ *
+ * Copy an item into the queue behind any others of the same priority,
+ * blocking for up to xTicksToWait ticks if the queue is full.
+ *
+ * Example use:
+<pre>
+typedef struct
+{
+    uint8_t ucCommand;
+    uint8_t ucArgument;
+} Command_t;
+
+#define PRIORITY_BULK      0
+#define PRIORITY_URGENT    1
+
+PriorityQueueHandle_t xCommandQueue;
+
+void vCreateCommandQueue( void )
+{
+    xCommandQueue = xPriorityQueueCreate( 16, sizeof( Command_t ), 2 );
+}
+
+void vStop( void )
+{
+Command_t xCommand = { CMD_STOP, 0 };
+
+    // Received before any telemetry requests already queued.
+    ( void ) xPriorityQueueSend( xCommandQueue, &xCommand, PRIORITY_URGENT, portMAX_DELAY );
+}
+
+void vCommandTask( void *pvParameters )
+{
+Command_t xCommand;
+
+    for( ;; )
+    {
+        if( xPriorityQueueReceive( xCommandQueue, &xCommand, NULL, portMAX_DELAY ) == pdPASS )
+        {
+            vHandleCommand( &xCommand );
+        }
+    }
+}
+</pre>
+ *
+ * @return pdPASS if the item was sent, or errQUEUE_FULL if xTicksToWait
+ * expired first.
+ *
+ * \defgroup xPriorityQueueSend xPriorityQueueSend
+ * \ingroup PriorityQueues
+ */
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xPriorityQueueSend() that can be called from an interrupt.  It
+ * does not block.
+ *
+ * xPriorityQueueSendFromISR() sets *pxHigherPriorityTaskWoken to pdTRUE if
+ * sending unblocked a task with a priority above that of the interrupted task,
+ * in which case a context switch should be requested before the interrupt
+ * exits.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xPriorityQueueSendFromISR xPriorityQueueSendFromISR
+ * \ingroup PriorityQueues
+ */
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, TickType_t xTicksToWait );
+</pre>
+ *
+ * Receive the oldest item of the highest priority held into pvBuffer,
+ * blocking for up to xTicksToWait ticks if the queue is empty.  If puxPriority
+ * is not NULL the priority the item was sent with is stored there.
+ *
+ * @return pdPASS if an item was received, or errQUEUE_EMPTY if xTicksToWait
+ * expired first.
+ *
+ * \defgroup xPriorityQueueReceive xPriorityQueueReceive
+ * \ingroup PriorityQueues
+ */
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xPriorityQueueReceive() that can be called from an interrupt.
+ * It does not block, and sets *pxHigherPriorityTaskWoken in the same way as
+ * xPriorityQueueSendFromISR().
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xPriorityQueueReceiveFromISR xPriorityQueueReceiveFromISR
+ * \ingroup PriorityQueues
+ */
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue );
+</pre>
+ *
+ * @return The number of items held, of all priorities.
+ *
+ * \defgroup uxPriorityQueueMessagesWaiting uxPriorityQueueMessagesWaiting
+ * \ingroup PriorityQueues
+ */
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+<pre>
+UBaseType_t uxPriorityQueueGetHighWaterMark( PriorityQueueHandle_t xQueue, UBaseType_t uxPriority );
+void vPriorityQueueResetHighWaterMarks( PriorityQueueHandle_t xQueue );
+</pre>
+ *
+ * uxPriorityQueueGetHighWaterMark() returns the most items of priority
+ * uxPriority the queue has held at once since it was created, or since
+ * vPriorityQueueResetHighWaterMarks() was last called.  Resetting sets the
+ * mark of each level to the number of items it holds now.
+ *
+ * \defgroup uxPriorityQueueGetHighWaterMark uxPriorityQueueGetHighWaterMark
+ * \ingroup PriorityQueues
+ */
+UBaseType_t uxPriorityQueueGetHighWaterMark( PriorityQueueHandle_t xQueue, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+void vPriorityQueueResetHighWaterMarks( PriorityQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* PRIORITY_QUEUE_H */
+
@@ -60,6 +60,18 @@ extern "C" {
  */
 typedef void * TaskHandle_t;
 
+/**
+ * task. h
+ *
+ * Type by which task pools are referenced.  For example, a call to
+ * xTaskPoolCreate() returns a TaskPoolHandle_t variable that can then be used
+ * as a parameter to xTaskCreateFromPool().
+ *
+ * \defgroup TaskPoolHandle_t TaskPoolHandle_t
+ * \ingroup Tasks
+ */
+typedef void * TaskPoolHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -87,6 +99,13 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/* Actions taken when a task uses up the budget set by vTaskSetBudget(). */
+typedef enum
+{
+	eBudgetDemote = 0,	/* Run the task at configBUDGET_DEMOTED_PRIORITY until its budget is replenished. */
+	eBudgetSuspend		/* Hold the task in the Suspended state until its budget is replenished. */
+} eBudgetAction;
+
 /*
  * Used internally only.
  */
@@ -123,6 +142,20 @@ typedef struct xTASK_PARAMETERS
 	#endif
 } TaskParameters_t;
 
+/* Used with vTaskGetBlockingStats() to return the time a task has spent in the
+Blocked state.  Times are in counts of the run time stats clock if
+configGENERATE_RUN_TIME_STATS is 1, otherwise in ticks. */
+typedef struct xTASK_BLOCKING_STATS
+{
+	uint32_t ulBlockedTime[ eBlockReasonCount ];	/* The time spent blocked for each eBlockReason, not counting the current block.  The eBlockNone entry is always 0. */
+	uint32_t ulLongestBlock;			/* The longest the task has been blocked for at once. */
+	eBlockReason eLongestBlockReason;	/* Why the task was blocked for ulLongestBlock. */
+	const void *pvLongestBlockObject;	/* The object the task was blocked on for ulLongestBlock, or NULL. */
+	eBlockReason eCurrentReason;		/* Why the task is blocked, or eBlockNone if it is not. */
+	const void *pvCurrentObject;		/* The object the task is blocked on, or last blocked on, or NULL. */
+	uint32_t ulCurrentBlockTime;		/* The time the task has been blocked for so far, or 0 if it is not blocked. */
+} TaskBlockingStats_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
 in the system. */
 typedef struct xTASK_STATUS
@@ -136,8 +169,50 @@ typedef struct xTASK_STATUS
 	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	uint16_t usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	#if( configUSE_BLOCKING_STATS == 1 )
+		TaskBlockingStats_t xBlockingStats;	/* The time the task has spent blocked, as returned by vTaskGetBlockingStats(). */
+	#endif
 } TaskStatus_t;
 
+/* Used with vTaskSnapshotStart() and eTaskSnapshotNext() to copy the state of
+each task in the system a task at a time.  The members are private to the
+kernel. */
+typedef struct xTASK_SNAPSHOT
+{
+	const ListItem_t *pxNextTask;	/* The task eTaskSnapshotNext() copies next. */
+	UBaseType_t uxGeneration;		/* Changes each time a task is created or deleted. */
+} TaskSnapshot_t;
+
+/* Returned by eTaskSnapshotNext(). */
+typedef enum
+{
+	eSnapshotTask = 0,	/* The state of the next task was copied. */
+	eSnapshotComplete,	/* The state of every task has been copied. */
+	eSnapshotChanged	/* A task was created or deleted since the snapshot started, so it must be started again. */
+} eSnapshotResult;
+
+/* The length in bytes of the records written by xTaskSnapshotEncode(). */
+#define tskSNAPSHOT_RECORD_LENGTH	( ( size_t ) 12 )
+
+/* Used with uxTaskGetStackReport() to return the stack use of a task. */
+typedef struct xTASK_STACK_REPORT
+{
+	TaskHandle_t xHandle;						/* The handle of the task. */
+	const char *pcTaskName;						/* A pointer to the task's name. */
+	configSTACK_DEPTH_TYPE uxStackDepth;		/* The words the task's stack was created with. */
+	configSTACK_DEPTH_TYPE uxMinimumEverFree;	/* The least free stack space, in words, the idle task has found. */
+	configSTACK_DEPTH_TYPE uxRecommendedDepth;	/* The words the task has used plus configSTACK_WATERMARK_MARGIN. */
+} TaskStackReport_t;
+
+/* Used with vTaskGetBudgetStats() to return the budget accounting of a task. */
+typedef struct xTASK_BUDGET_STATS
+{
+	uint32_t ulBudget;			/* The timer counts the task can run for each period, or 0 if it has no budget. */
+	uint32_t ulUsed;			/* The timer counts the task has run for in the current period. */
+	uint32_t ulExhaustions;		/* The number of periods in which the task used up its budget. */
+	BaseType_t xThrottled;		/* pdTRUE if the task is demoted or suspended until its budget is replenished. */
+} TaskBudgetStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -153,6 +228,17 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * task. h
+ *
+ * The index of the task notification value used by the notification API
+ * functions and macros that do not take an index, such as xTaskNotify() and
+ * ulTaskNotifyTake().
+ *
+ * \ingroup TaskNotifications
+ */
+#define tskDEFAULT_INDEX_TO_NOTIFY	( 0 )
+
 /**
  * task. h
  *
@@ -607,6 +693,125 @@ TaskHandle_t xHandle;
 	BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ *<pre>
+ TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxTasks, const configSTACK_DEPTH_TYPE usStackDepth );</pre>
+ *
+ * configUSE_TASK_POOLS must be defined as 1 for this function to be available.
+ *
+ * Create a pool of uxTasks task control blocks, each with a stack of
+ * usStackDepth words, from which xTaskCreateFromPool() creates tasks.  The
+ * memory for the pool is allocated from the FreeRTOS heap once, here, and is
+ * never freed, so tasks that are created and deleted often neither wait for
+ * the heap nor fragment it.  A task created from a pool is returned to it as
+ * soon as it is deleted, or, if it deletes itself, as soon as the scheduler
+ * has switched away from it, rather than waiting for the idle task to free
+ * its memory.
+ *
+ * Create a pool for each stack size needed.
+ *
+ * @param uxTasks The number of tasks the pool can hold at once.
+ *
+ * @param usStackDepth The size of the stack of each task in the pool,
+ * specified as the number of variables the stack can hold - not the number of
+ * bytes.
+ *
+ * @return The handle of the pool, or NULL if there was not enough heap for
+ * it.
+ *
+ * Example usage:
+   <pre>
+ TaskPoolHandle_t xConnectionPool;
+
+ void vStartServer( void )
+ {
+     // Room for up to four connections at once.
+     xConnectionPool = xTaskPoolCreate( 4, 200 );
+ }
+
+ void vAcceptConnection( void *pvConnection )
+ {
+     if( xTaskCreateFromPool( xConnectionPool, vConnectionTask, "Conn", pvConnection, 2, NULL ) != pdPASS )
+     {
+         // All four connections are open.
+         vRefuseConnection( pvConnection );
+     }
+ }
+
+ void vConnectionTask( void *pvConnection )
+ {
+     vServeConnection( pvConnection );
+
+     // Return to the pool.
+     vTaskDelete( NULL );
+ }
+   </pre>
+ * \defgroup xTaskPoolCreate xTaskPoolCreate
+ * \ingroup Tasks
+ */
+TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxTasks, const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ *<pre>
+ BaseType_t xTaskCreateFromPool(	TaskPoolHandle_t xPool,
+								TaskFunction_t pvTaskCode,
+								const char * const pcName,
+								void *pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t *pvCreatedTask
+							);</pre>
+ *
+ * configUSE_TASK_POOLS must be defined as 1 for this function to be available.
+ *
+ * Create a new task using a task control block and stack taken from a pool
+ * created by xTaskPoolCreate(), and add it to the list of tasks that are ready
+ * to run.  No memory is allocated.  The parameters other than xPool are as
+ * for xTaskCreate(), the stack depth being that of the pool.
+ *
+ * @return pdPASS if the task was created, or
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if every task in the pool is in use.
+ *
+ * \defgroup xTaskCreateFromPool xTaskCreateFromPool
+ * \ingroup Tasks
+ */
+BaseType_t xTaskCreateFromPool(	TaskPoolHandle_t xPool,
+								TaskFunction_t pxTaskCode,
+								const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ *<pre>
+ UBaseType_t uxTaskPoolGetFree( TaskPoolHandle_t xPool );</pre>
+ *
+ * configUSE_TASK_POOLS must be defined as 1 for this function to be available.
+ *
+ * Obtain the number of tasks that can still be created from a pool.
+ *
+ * \defgroup uxTaskPoolGetFree uxTaskPoolGetFree
+ * \ingroup Tasks
+ */
+UBaseType_t uxTaskPoolGetFree( TaskPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ *<pre>
+ UBaseType_t uxTaskPoolGetMinimumEverFree( TaskPoolHandle_t xPool );</pre>
+ *
+ * configUSE_TASK_POOLS must be defined as 1 for this function to be available.
+ *
+ * Obtain the lowest number of free tasks the pool has had since it was
+ * created, for sizing the pool.
+ *
+ * \defgroup uxTaskPoolGetMinimumEverFree uxTaskPoolGetMinimumEverFree
+ * \ingroup Tasks
+ */
+UBaseType_t uxTaskPoolGetMinimumEverFree( TaskPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  *<pre>
@@ -781,7 +986,14 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  * @param xTimeIncrement The cycle time period.  The task will be unblocked at
  * time *pxPreviousWakeTime + xTimeIncrement.  Calling vTaskDelayUntil with the
  * same xTimeIncrement parameter value will cause the task to execute with
- * a fixed interface period.
+ * a fixed interface period.  If configUSE_EDF_SCHEDULING is 1 and the task was
+ * given a period by vTaskSetDeadline(), an xTimeIncrement of 0 uses that
+ * period.
+ *
+ * If configUSE_EDF_SCHEDULING is 1 and the calling task has a deadline, the
+ * call also marks the end of the task's current job, counting a missed
+ * deadline if the job completed late, and releases the next job at the wake
+ * time, with a deadline xRelativeDeadline ticks later.
  *
  * Example usage:
    <pre>
@@ -807,6 +1019,196 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Give a periodic task a relative deadline and a period.  The ready tasks of
+ * priority configEDF_PRIORITY are scheduled earliest deadline first: the one
+ * whose current job has the earliest absolute deadline runs, and is preempted
+ * when a job with an earlier deadline is released.  Tasks with the same
+ * deadline share the processor as tasks of the same priority do.  Tasks of
+ * other priorities are scheduled by fixed priority as usual, so a task given a
+ * deadline should be created at, or moved to, priority configEDF_PRIORITY.
+ * Tasks of that priority without a deadline only run when none with a
+ * deadline is ready, and share the processor with each other.
+ *
+ * The task's current job is taken to be released when vTaskSetDeadline() is
+ * called.  Each call to vTaskDelayUntil() completes a job and releases the
+ * next one at the wake time, with an absolute deadline xRelativeDeadline
+ * ticks after its release.  The job and missed deadline counts are reset.
+ *
+ * @param xTask The task to set the deadline of.  Passing NULL sets the
+ * deadline of the calling task.
+ *
+ * @param xRelativeDeadline The ticks from the release of each job to its
+ * deadline, normally no more than xPeriod.  0 removes the task's deadline.
+ *
+ * @param xPeriod The ticks between the releases of jobs, used when
+ * vTaskDelayUntil() is passed an increment of 0.
+ *
+ * Example usage:
+   <pre>
+ void vControlTask( void * pvParameters )
+ {
+ TickType_t xLastWakeTime;
+
+	 // Run every 10 ticks, each run to complete within 8 ticks.
+	 vTaskSetDeadline( NULL, 8, 10 );
+	 xLastWakeTime = xTaskGetTickCount();
+
+	 for( ;; )
+	 {
+		 vRunControlLoop();
+
+		 // Complete this job and wait for the release of the next.
+		 vTaskDelayUntil( &xLastWakeTime, 0 );
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskGetDeadlineStats( TaskHandle_t xTask, uint32_t *pulJobsCompleted, uint32_t *pulDeadlinesMissed );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Obtain the number of jobs a task with a deadline has completed, and the
+ * number of those that completed after their deadline, since
+ * vTaskSetDeadline() was last called for it.  A job that has not yet
+ * completed is not counted, however late it is.  Either pointer can be NULL.
+ *
+ * \defgroup vTaskGetDeadlineStats vTaskGetDeadlineStats
+ * \ingroup TaskCtrl
+ */
+void vTaskGetDeadlineStats( TaskHandle_t xTask, uint32_t *pulJobsCompleted, uint32_t *pulDeadlinesMissed ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction );</pre>
+ *
+ * configUSE_TASK_BUDGETS must be defined as 1 for this function to be
+ * available.
+ *
+ * Limit the processor time a task can use in each period, so a task that
+ * runs away cannot take the time reserved for the tasks below it.  The time a
+ * task runs for is read from the free running hardware timer
+ * configBUDGET_TIMER_VALUE() each time it is switched in or out, and at each
+ * tick while it runs, so the budget is in counts of that timer.  The timer
+ * must be running before the scheduler is started.
+ *
+ * The budget is checked at each tick.  Once the task has run for ulBudget
+ * counts in the current period it is demoted to configBUDGET_DEMOTED_PRIORITY,
+ * or suspended, as eAction selects, until the period ends.  The budget is then
+ * replenished and the task restored.  The task can overrun its budget by up to
+ * a tick before it is stopped.  A task that holds a mutex is not stopped until
+ * it has given it back, as the tasks waiting for the mutex would be held up
+ * too.  If configUSE_BUDGET_EXHAUSTED_HOOK is 1 the application must provide
+ * void vApplicationBudgetExhaustedHook( TaskHandle_t xTask ), which is called
+ * from the tick interrupt each time a task's budget is used up.
+ *
+ * Each period starts when the previous one ends, the first when
+ * vTaskSetBudget() is called.  A demoted task that inherits a priority from a
+ * task waiting for its mutex is demoted again when it gives the mutex back.
+ * A priority set by vTaskPrioritySet() while a task is demoted is used once
+ * it is restored, or at once if configUSE_MUTEXES is 0.  eBudgetSuspend
+ * requires INCLUDE_vTaskSuspend to be 1.
+ *
+ * @param xTask The task to set the budget of.  Passing NULL sets the budget
+ * of the calling task.  The idle task cannot be given a budget.
+ *
+ * @param ulBudget The timer counts the task can run for in each period.  0
+ * removes the task's budget, restoring it if it is demoted or suspended.
+ *
+ * @param xPeriod The ticks in each period.
+ *
+ * @param eAction eBudgetDemote or eBudgetSuspend.
+ *
+ * Example usage:
+   <pre>
+ // The sensor task can use 2ms of every 10 ticks, timed by a 1MHz timer.
+ vTaskSetBudget( xSensorTask, 2000, 10, eBudgetSuspend );
+   </pre>
+ * \defgroup vTaskSetBudget vTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskGetBudgetStats( TaskHandle_t xTask, TaskBudgetStats_t *pxStats );</pre>
+ *
+ * configUSE_TASK_BUDGETS must be defined as 1 for this function to be
+ * available.
+ *
+ * Obtain a task's budget, the time it has run for in the current period, the
+ * number of periods in which it used up its budget since vTaskSetBudget() was
+ * last called for it, and whether it is being held until its budget is
+ * replenished.
+ *
+ * \defgroup vTaskGetBudgetStats vTaskGetBudgetStats
+ * \ingroup TaskCtrl
+ */
+void vTaskGetBudgetStats( TaskHandle_t xTask, TaskBudgetStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetTimeSliceQuantum( TaskHandle_t xTask, UBaseType_t uxQuantum );</pre>
+ *
+ * configUSE_TIME_SLICE_QUANTUM must be defined as 1 for this function to be
+ * available.
+ *
+ * Set the number of ticks a task runs for before time slicing switches to the
+ * next ready task of the same priority.  Tasks are created with a quantum of
+ * configDEFAULT_TIME_SLICE_QUANTUM ticks.  A long quantum suits tasks that
+ * compute for long periods, as they are switched less often, and a quantum of
+ * 1 suits tasks that must respond quickly.  A task preempted by a higher
+ * priority task part way through its quantum runs for the rest of it when the
+ * higher priority task blocks, before the next task of its own priority.  A
+ * task that blocks or yields gives up the rest of its quantum, and starts a
+ * full one when it next runs.  Only used when configUSE_PREEMPTION and
+ * configUSE_TIME_SLICING are both 1.
+ *
+ * @param xTask The task to set the quantum of.  Passing NULL sets the quantum
+ * of the calling task.
+ *
+ * @param uxQuantum The quantum in ticks, at least 1.  If more than uxQuantum
+ * ticks are left of the task's current time slice it is shortened to
+ * uxQuantum ticks.
+ *
+ * Example usage:
+   <pre>
+ // Switch the logging task out only after it has run for 20 ticks.
+ vTaskSetTimeSliceQuantum( xLogTask, 20 );
+   </pre>
+ * \defgroup vTaskSetTimeSliceQuantum vTaskSetTimeSliceQuantum
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeSliceQuantum( TaskHandle_t xTask, UBaseType_t uxQuantum ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskGetTimeSliceQuantum( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_TIME_SLICE_QUANTUM must be defined as 1 for this function to be
+ * available.
+ *
+ * Obtain the time slice quantum of a task, in ticks.  Passing NULL obtains the
+ * quantum of the calling task.
+ *
+ * \defgroup uxTaskGetTimeSliceQuantum uxTaskGetTimeSliceQuantum
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetTimeSliceQuantum( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>BaseType_t xTaskAbortDelay( TaskHandle_t xTask );</pre>
@@ -1421,6 +1823,94 @@ TaskHandle_t xTaskGetHandle( const char *pcNameToQuery ) PRIVILEGED_FUNCTION; /*
  */
 UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetStackReport( TaskStackReport_t * const pxReportArray, const UBaseType_t uxArraySize );</PRE>
+ *
+ * configUSE_STACK_WATERMARK must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * With configUSE_STACK_WATERMARK set to 1 the idle task scans the stack of one
+ * task each time it runs, working through every task in turn, and keeps the
+ * least free stack space it has found for each.  Scanning runs with interrupts
+ * enabled, so unlike uxTaskGetStackHighWaterMark() and uxTaskGetSystemState()
+ * it does not hold up other tasks.  If configUSE_STACK_MARGIN_HOOK is also 1
+ * the application must provide void vApplicationStackMarginHook( TaskHandle_t
+ * xTask, char *pcTaskName, configSTACK_DEPTH_TYPE uxFreeWords ), which is
+ * called from the idle task, with the scheduler suspended, the first time a
+ * task's free stack space is found to be below configSTACK_WATERMARK_MARGIN.
+ * The hook must not block.
+ *
+ * uxTaskGetStackReport() fills a TaskStackReport_t structure for each task in
+ * the system with the size of its stack, the least free space found, and a
+ * recommended size of the stack used plus configSTACK_WATERMARK_MARGIN.  A task
+ * whose stack the idle task has not scanned yet has all of it free.  The
+ * recommendations are only as good as the time the application has been run
+ * for, so it should be run through all of its paths first.
+ *
+ * @param pxReportArray An array of TaskStackReport_t structures.
+ *
+ * @param uxArraySize The size of pxReportArray.  At most this many tasks are
+ * reported.
+ *
+ * @return The number of TaskStackReport_t structures filled.
+ *
+ * Example usage:
+   <pre>
+ TaskStackReport_t xReport[ 8 ];
+ UBaseType_t x, uxTasks;
+
+     uxTasks = uxTaskGetStackReport( xReport, 8 );
+     for( x = 0; x < uxTasks; x++ )
+     {
+         printf( "%s %u of %u words used, recommend %u\r\n", xReport[ x ].pcTaskName,
+                 xReport[ x ].uxStackDepth - xReport[ x ].uxMinimumEverFree,
+                 xReport[ x ].uxStackDepth, xReport[ x ].uxRecommendedDepth );
+     }
+   </pre>
+ * \defgroup uxTaskGetStackReport uxTaskGetStackReport
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetStackReport( TaskStackReport_t * const pxReportArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>void vTaskGetBlockingStats( TaskHandle_t xTask, TaskBlockingStats_t *pxStats );</PRE>
+ *
+ * configUSE_BLOCKING_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * With configUSE_BLOCKING_STATS set to 1 the kernel notes why each task enters
+ * the Blocked state, and on which object, and when the task leaves the Blocked
+ * state adds the time it was blocked for to the total for that reason.  A task
+ * leaves the Blocked state when it is made ready, so the time a task woken
+ * while the scheduler is suspended waits for the scheduler to be resumed is
+ * counted as blocked, and when it is suspended.  Times are in counts of the
+ * run time stats clock if configGENERATE_RUN_TIME_STATS is 1, so they can be
+ * compared with the run time of the task, otherwise they are in ticks.
+ *
+ * The statistics are also returned in the xBlockingStats member of the
+ * TaskStatus_t structures filled by vTaskGetInfo(), uxTaskGetSystemState() and
+ * eTaskSnapshotNext().
+ *
+ * @param xTask The handle of the task to query, or NULL for the calling task.
+ *
+ * @param pxStats The structure the statistics are written to.
+ *
+ * Example usage:
+   <pre>
+ TaskBlockingStats_t xStats;
+
+     vTaskGetBlockingStats( xTask, &xStats );
+     printf( "%u on queues, %u on mutexes, longest %u on %p\r\n",
+             xStats.ulBlockedTime[ eBlockQueue ], xStats.ulBlockedTime[ eBlockMutex ],
+             xStats.ulLongestBlock, xStats.pvLongestBlockObject );
+   </pre>
+ * \defgroup vTaskGetBlockingStats vTaskGetBlockingStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetBlockingStats( TaskHandle_t xTask, TaskBlockingStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include task.h before
 FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
 so the following two prototypes will cause a compilation error.  This can be
@@ -1629,6 +2119,116 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const
  */
 void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * <PRE>void vTaskSnapshotStart( TaskSnapshot_t *pxSnapshot );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 for this function to be
+ * available.
+ *
+ * Start copying the state of every task in the system, a task at a time, with
+ * eTaskSnapshotNext().  Unlike uxTaskGetSystemState(), which holds the
+ * scheduler suspended while it copies every task, eTaskSnapshotNext() only
+ * enters a critical section long enough to copy one task, so a monitoring
+ * task can take snapshots often without delaying the tasks it monitors.
+ *
+ * @param pxSnapshot The snapshot to start.
+ *
+ * Example usage:
+   <pre>
+ void vMonitorTask( void *pvParameters )
+ {
+ TaskSnapshot_t xSnapshot;
+ TaskStatus_t xStatus;
+ uint8_t ucRecord[ tskSNAPSHOT_RECORD_LENGTH ];
+ eSnapshotResult eResult;
+
+     for( ;; )
+     {
+         vTaskDelay( pdMS_TO_TICKS( 100 ) );
+
+         vTaskSnapshotStart( &xSnapshot );
+         while( ( eResult = eTaskSnapshotNext( &xSnapshot, &xStatus, pdTRUE ) ) == eSnapshotTask )
+         {
+             ( void ) xTaskSnapshotEncode( &xSnapshot, &xStatus, ucRecord );
+             vSendToHost( ucRecord, sizeof( ucRecord ) );
+         }
+
+         if( eResult == eSnapshotChanged )
+         {
+             // A task was created or deleted part way through, so the
+             // records sent do not describe one moment.
+             vSendRestartToHost();
+         }
+     }
+ }
+   </pre>
+ * \defgroup vTaskSnapshotStart vTaskSnapshotStart
+ * \ingroup TaskUtils
+ */
+void vTaskSnapshotStart( TaskSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>eSnapshotResult eTaskSnapshotNext( TaskSnapshot_t *pxSnapshot, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 for this function to be
+ * available.
+ *
+ * Copy the state of the next task of a snapshot started by
+ * vTaskSnapshotStart().  The tasks are copied in the order they were created.
+ * Each task is copied in its own critical section, so the states of different
+ * tasks are from slightly different moments, but the tasks created or deleted
+ * while the snapshot is taken are detected.
+ *
+ * @param pxSnapshot The snapshot to continue.
+ *
+ * @param pxTaskStatus The TaskStatus_t structure the state of the task is
+ * copied to, as by vTaskGetInfo().
+ *
+ * @param xGetFreeStackSpace As for vTaskGetInfo().  The stack is examined
+ * outside of the critical section.
+ *
+ * @return eSnapshotTask if the state of a task was copied, eSnapshotComplete
+ * if the states of all the tasks have been copied, or eSnapshotChanged if a
+ * task was created or deleted since the snapshot was started, in which case
+ * no state was copied and the snapshot must be started again.
+ *
+ * \defgroup eTaskSnapshotNext eTaskSnapshotNext
+ * \ingroup TaskUtils
+ */
+eSnapshotResult eTaskSnapshotNext( TaskSnapshot_t *pxSnapshot, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>size_t xTaskSnapshotEncode( const TaskSnapshot_t *pxSnapshot, const TaskStatus_t *pxTaskStatus, uint8_t *pucRecord );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOT must be defined as 1 for this function to be
+ * available.
+ *
+ * Write the state of a task copied by eTaskSnapshotNext() to a record of
+ * tskSNAPSHOT_RECORD_LENGTH bytes, for sending to a host.  Multi-byte values
+ * are little endian and values too large for their field are truncated:
+ *
+ * bytes 0-1   The task number, TaskStatus_t.xTaskNumber.
+ * byte 2      The state, an eTaskState value.
+ * byte 3      The current priority.
+ * byte 4      The base priority.
+ * byte 5      The generation of the snapshot, which is the same for every
+ *             record of one snapshot.
+ * bytes 6-7   The stack high water mark, in words.
+ * bytes 8-11  The run time counter.
+ *
+ * The task name is not included.  A host can obtain it once for each new task
+ * number.
+ *
+ * @return tskSNAPSHOT_RECORD_LENGTH.
+ *
+ * \defgroup xTaskSnapshotEncode xTaskSnapshotEncode
+ * \ingroup TaskUtils
+ */
+size_t xTaskSnapshotEncode( const TaskSnapshot_t *pxSnapshot, const TaskStatus_t *pxTaskStatus, uint8_t *pucRecord ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>void vTaskGetRunTimeStats( char *pcWriteBuffer );</PRE>
@@ -1686,6 +2286,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1693,6 +2294,15 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES notification
+ * values, each with its own pending state, so a task can wait for notifications
+ * from several sources independently.  The functions and macros with Indexed
+ * in their name act on the notification value at the index given by their
+ * uxIndexToNotify or uxIndexToWaitOn parameter.  The versions without Indexed
+ * in their name act on index 0 (tskDEFAULT_INDEX_TO_NOTIFY), so existing code
+ * that uses a single notification value is unchanged.  A notification sent to
+ * one index can only be received by waiting on the same index.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1721,6 +2331,10 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification value to update, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  xTaskNotify() does
+ * not have this parameter and uses index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1762,13 +2376,16 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1777,7 +2394,8 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
  * A version of xTaskNotify() that can be used from an interrupt service routine
- * (ISR).
+ * (ISR).  xTaskNotifyIndexedFromISR() updates the notification value at
+ * uxIndexToNotify, as xTaskNotifyIndexed() does.
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -1853,13 +2471,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1890,6 +2511,10 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification value to wait on, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  xTaskNotifyWait()
+ * does not have this parameter and waits on index 0.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -1930,11 +2555,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1976,11 +2604,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * <PRE>void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -2031,11 +2661,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
  * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2079,6 +2712,10 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification value to wait on, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  ulTaskNotifyTake()
+ * does not have this parameter and waits on index 0.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2100,23 +2737,29 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
  * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  xTaskNotifyStateClear() clears the
+ * state of index 0, and xTaskNotifyStateClearIndexed() that of uxIndexToClear.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2173,6 +2816,25 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * One pass of the retry loop of a kernel object that blocks with interrupts
+ * masked rather than by locking itself as queues do.  On the first pass
+ * (*pxEntryTimeSet is pdFALSE) the timeout starts, otherwise the remaining
+ * block time in *pxTicksToWait is updated.  If the block time has not expired
+ * the calling task is placed on pxEventList, with eReason and pvObject
+ * recorded when configUSE_BLOCKING_STATS is 1, and a yield is requested that
+ * is performed once interrupts are unmasked.
+ *
+ * @return pdTRUE if the task was placed on the event list, pdFALSE if the
+ * block time expired.
+ */
+BaseType_t xTaskBlockOnEventList( List_t * const pxEventList, TickType_t * const pxTicksToWait, TimeOut_t * const pxTimeOut, BaseType_t * const pxEntryTimeSet, const eBlockReason eReason, const void * const pvObject ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -2213,6 +2875,61 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * THE LEAN MUTEX IMPLEMENTATION.
+ *
+ * Versions of vTaskPlaceOnEventList() and xTaskRemoveFromEventList() for
+ * priority ordered event lists that are shared by several objects.  A task is
+ * tagged with the object it waits for as it is placed in the list, and only
+ * the highest priority task tagged with that object is removed.
+ * vTaskPlaceOnTaggedEventList() must be called with the scheduler suspended,
+ * xTaskRemoveFromTaggedEventList() from a critical section.
+ *
+ * xTaskRemoveFromTaggedEventList() returns the handle of the task removed from
+ * the list, or NULL if no task was waiting for pvTag, and sets
+ * *pxHigherPriorityTaskWoken to pdTRUE if that task has a higher priority than
+ * the calling task.  uxTaskGetTaggedEventListPriority() returns the priority of
+ * the highest priority task waiting for pvTag, or tskIDLE_PRIORITY if there is
+ * none.
+ */
+void vTaskPlaceOnTaggedEventList( List_t * const pxEventList, const void * const pvTag, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+TaskHandle_t xTaskRemoveFromTaggedEventList( const List_t * const pxEventList, const void * const pvTag, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetTaggedEventListPriority( const List_t * const pxEventList, const void * const pvTag ) PRIVILEGED_FUNCTION;
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * THE PRIORITY CEILING MUTEX IMPLEMENTATION.
+ *
+ * uxTaskRaiseCeilingPriority() raises the ceiling of the calling task to
+ * uxCeiling, if that is higher than its current ceiling, and returns the
+ * previous ceiling.  The task runs at no less than its ceiling until the
+ * previous ceiling is passed back to xTaskRestoreCeilingPriority(), which
+ * returns pdTRUE if the priority of the calling task dropped and a yield is
+ * needed.  Ceilings must be restored in the reverse of the order in which they
+ * were raised.
+ */
+UBaseType_t uxTaskRaiseCeilingPriority( UBaseType_t uxCeiling ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRestoreCeilingPriority( UBaseType_t uxPreviousCeiling ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS USED BY THE
+ * KERNEL OBJECTS WHEN configUSE_BLOCKING_STATS IS 1.
+ *
+ * Gives the reason, and the object, the calling task is about to block for.
+ * It is called just before the task is placed on an event list, or waits for
+ * a notification, and is used in place of the reason the kernel would
+ * otherwise record.  taskSET_BLOCK_REASON() calls it only when
+ * configUSE_BLOCKING_STATS is 1.
+ */
+void vTaskSetBlockReason( eBlockReason eReason, const void *pvObject ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_BLOCKING_STATS == 1 )
+	#define taskSET_BLOCK_REASON( eReason, pvObject ) vTaskSetBlockReason( ( eReason ), ( pvObject ) )
+#else
+	#define taskSET_BLOCK_REASON( eReason, pvObject )
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -86,6 +86,36 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/*
+ * Callback statistics for one timer, as returned by vTimerGetStats().
+ * Execution times are in the units of configTIMER_STATS_GET_TIME(), lateness
+ * is in ticks.  Only available when configUSE_TIMER_STATS is 1.
+ */
+typedef struct xTIMER_STATS
+{
+	uint32_t ulCallbackCount;		/* Number of times the callback has executed. */
+	uint32_t ulMinExecutionTime;
+	uint32_t ulMaxExecutionTime;
+	uint32_t ulTotalExecutionTime;
+	uint32_t ulMaxLateness;			/* Longest time between the expiry time and the callback executing. */
+	uint32_t ulTotalLateness;
+	uint32_t ulOverrunCount;		/* Executions that exceeded the budget set by vTimerSetCallbackBudget(). */
+} TimerStats_t;
+
+/*
+ * Statistics for the timer service task as a whole, as returned by
+ * vTimerGetServiceStats().  Only available when configUSE_TIMER_STATS is 1.
+ */
+typedef struct xTIMER_SERVICE_STATS
+{
+	UBaseType_t uxQueueLength;			/* configTIMER_QUEUE_LENGTH. */
+	UBaseType_t uxQueueHighWaterMark;	/* Most commands ever waiting in the timer queue. */
+	uint32_t ulDroppedCommands;			/* Commands that could not be sent because the timer queue was full. */
+	uint32_t ulCallbackCount;			/* Timer callbacks executed by the timer service task. */
+	uint32_t ulMaxLateness;				/* Longest lateness of any timer, in ticks. */
+	uint32_t ulOverrunCount;			/* Callbacks of any timer that exceeded their budget. */
+} TimerServiceStats_t;
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -1256,6 +1286,66 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats, BaseType_t xReset );
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Copies the callback statistics of a timer into *pxStats.  Each time the
+ * timer service task executes the timer's callback it records how long the
+ * callback took and how long after the timer's expiry time it started.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * @param xReset If xReset is pdTRUE the timer's statistics are cleared once
+ * they have been copied, so the next call returns figures for the interval in
+ * between.
+ */
+void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats, BaseType_t xReset ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerGetServiceStats( TimerServiceStats_t *pxStats, BaseType_t xReset );
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Copies statistics for the timer service task into *pxStats.  A queue high
+ * water mark that reaches uxQueueLength, or a non-zero ulDroppedCommands,
+ * means configTIMER_QUEUE_LENGTH is too short or the timer service task
+ * priority too low for the rate at which commands are sent.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * @param xReset If xReset is pdTRUE the statistics are cleared once they have
+ * been copied.
+ */
+void vTimerGetServiceStats( TimerServiceStats_t *pxStats, BaseType_t xReset ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerSetCallbackBudget( TimerHandle_t xTimer, uint32_t ulBudget );
+ *
+ * configUSE_TIMER_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Sets the longest time the callback of a timer is expected to execute for,
+ * in the units of configTIMER_STATS_GET_TIME().  Each execution that takes
+ * longer increments the timer's ulOverrunCount and, if
+ * configUSE_TIMER_OVERRUN_HOOK is set to 1, calls the application defined
+ * hook function:
+ *
+ * void vApplicationTimerOverrunHook( TimerHandle_t xTimer, uint32_t ulExecutionTime );
+ *
+ * The hook is called from the timer service task, so must not block.
+ *
+ * @param xTimer The handle of the timer.
+ *
+ * @param ulBudget The budget, or 0 to not check the timer's callback.
+ */
+void vTimerSetCallbackBudget( TimerHandle_t xTimer, uint32_t ulBudget ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
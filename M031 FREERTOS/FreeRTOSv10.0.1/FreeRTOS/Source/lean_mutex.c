@@ -0,0 +1,386 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lean_mutex.h"
+
+#if( configUSE_LEAN_MUTEXES != 1 )
+	#error configUSE_LEAN_MUTEXES must be set to 1 to build lean_mutex.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( configUSE_PREEMPTION == 0 )
+	/* If the cooperative scheduler is being used then a yield should not be
+	performed just because a higher priority task has been woken. */
+	#define leanYIELD_IF_USING_PREEMPTION()
+#else
+	#define leanYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* The event list the tasks waiting for a mutex block in, selected by the
+mutex's address. */
+#define leanWAIT_LIST( pxMutex ) ( &( xWaitLists[ ( ( portPOINTER_SIZE_TYPE ) ( pxMutex ) / ( portPOINTER_SIZE_TYPE ) sizeof( LeanMutex_t ) ) % ( portPOINTER_SIZE_TYPE ) configLEAN_MUTEX_WAIT_LISTS ] ) )
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+which static variables must be declared volatile. */
+
+/* Event lists shared by all lean mutexes.  Initialised the first time a task
+blocks, as mutexes declared with leanMUTEX_INITIALISER are never passed to an
+initialisation function. */
+PRIVILEGED_DATA static List_t xWaitLists[ configLEAN_MUTEX_WAIT_LISTS ];
+PRIVILEGED_DATA static BaseType_t xWaitListsInitialised = pdFALSE;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise xWaitLists if this is the first time a task has blocked on a lean
+ * mutex.  Called with the scheduler suspended.
+ */
+static void prvCheckWaitListsInitialised( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void vLeanMutexInit( LeanMutex_t *pxMutex )
+{
+	configASSERT( pxMutex );
+
+	pxMutex->xOwner = NULL;
+	pxMutex->uxWaiters = ( UBaseType_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLeanMutexTake( LeanMutex_t *pxMutex, TickType_t xTicksToWait )
+{
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xReturn = pdFAIL, xBlocked, xInheritanceOccurred = pdFALSE;
+TaskHandle_t xCurrentTask;
+TimeOut_t xTimeOut;
+List_t *pxWaitList;
+
+	configASSERT( pxMutex );
+
+	/* The fast path.  Only tasks change the owner, so masking interrupts for
+	the test and set is enough to stop another task getting in between. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxMutex->xOwner == NULL )
+		{
+			pxMutex->xOwner = ( TaskHandle_t ) pvTaskIncrementMutexHeldCount();
+			xReturn = pdPASS;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+
+		xCurrentTask = xTaskGetCurrentTaskHandle();
+		pxWaitList = leanWAIT_LIST( pxMutex );
+
+		/* Lean mutexes are not recursive. */
+		configASSERT( pxMutex->xOwner != xCurrentTask );
+
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			xBlocked = pdFALSE;
+
+			/* Interrupts do not use lean mutexes, so with the scheduler
+			suspended nothing else can change the mutex.  The tick interrupt
+			can still time out a blocked task, but that is only acted on once
+			the scheduler is resumed. */
+			vTaskSuspendAll();
+			{
+				prvCheckWaitListsInitialised();
+
+				if( pxMutex->xOwner == NULL )
+				{
+					/* Given since the last attempt. */
+					pxMutex->xOwner = ( TaskHandle_t ) pvTaskIncrementMutexHeldCount();
+					xReturn = pdPASS;
+				}
+				else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+				{
+					taskENTER_CRITICAL();
+					{
+						if( xTaskPriorityInherit( pxMutex->xOwner ) != pdFALSE )
+						{
+							xInheritanceOccurred = pdTRUE;
+						}
+					}
+					taskEXIT_CRITICAL();
+
+					( pxMutex->uxWaiters )++;
+					taskSET_BLOCK_REASON( eBlockMutex, pxMutex );
+					vTaskPlaceOnTaggedEventList( pxWaitList, pxMutex, xTicksToWait );
+					xBlocked = pdTRUE;
+				}
+				else
+				{
+					/* Timed out.  If the holder inherited this task's priority
+					it drops back to that of the highest priority task still
+					waiting. */
+					if( xInheritanceOccurred != pdFALSE )
+					{
+						taskENTER_CRITICAL();
+						{
+							vTaskPriorityDisinheritAfterTimeout( pxMutex->xOwner, uxTaskGetTaggedEventListPriority( pxWaitList, pxMutex ) );
+						}
+						taskEXIT_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+
+			if( ( xTaskResumeAll() == pdFALSE ) && ( xBlocked != pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xBlocked == pdFALSE )
+			{
+				break;
+			}
+
+			/* Unblocked, either because xLeanMutexGive() handed the mutex to
+			this task, or because the block time expired or was aborted. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				if( pxMutex->xOwner == xCurrentTask )
+				{
+					( void ) pvTaskIncrementMutexHeldCount();
+					xReturn = pdPASS;
+				}
+				else
+				{
+					/* The giving task only removes the waiters it hands the
+					mutex to. */
+					( pxMutex->uxWaiters )--;
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			if( xReturn != pdFAIL )
+			{
+				break;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLeanMutexGive( LeanMutex_t *pxMutex )
+{
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	configASSERT( pxMutex );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxMutex->xOwner == xCurrentTask )
+		{
+			/* Give up any priority inherited while holding the mutex. */
+			xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+
+			if( pxMutex->uxWaiters == ( UBaseType_t ) 0U )
+			{
+				pxMutex->xOwner = NULL;
+			}
+			else
+			{
+				/* Hand the mutex to the highest priority waiting task.  If
+				every waiter has timed out but not yet run, the mutex is left
+				free instead. */
+				pxMutex->xOwner = xTaskRemoveFromTaggedEventList( leanWAIT_LIST( pxMutex ), pxMutex, &xYieldRequired );
+
+				if( pxMutex->xOwner != NULL )
+				{
+					( pxMutex->uxWaiters )--;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xYieldRequired != pdFALSE )
+	{
+		leanYIELD_IF_USING_PREEMPTION();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CEILING_MUTEXES == 1 )
+
+	void vCeilingMutexInit( CeilingMutex_t *pxMutex, UBaseType_t uxCeiling )
+	{
+		configASSERT( pxMutex );
+		configASSERT( uxCeiling < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		vLeanMutexInit( &( pxMutex->xMutex ) );
+		pxMutex->uxCeiling = uxCeiling;
+		pxMutex->uxPreviousCeiling = tskIDLE_PRIORITY;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CEILING_MUTEXES == 1 )
+
+	BaseType_t xCeilingMutexTake( CeilingMutex_t *pxMutex, TickType_t xTicksToWait )
+	{
+	UBaseType_t uxPreviousCeiling;
+	BaseType_t xReturn;
+
+		configASSERT( pxMutex );
+
+		/* Raise the priority before taking the mutex, so the task cannot be
+		preempted by another user of the mutex between the two. */
+		uxPreviousCeiling = uxTaskRaiseCeilingPriority( pxMutex->uxCeiling );
+
+		xReturn = xLeanMutexTake( &( pxMutex->xMutex ), xTicksToWait );
+
+		if( xReturn != pdFAIL )
+		{
+			/* Only the holder uses this, so it needs no protection. */
+			pxMutex->uxPreviousCeiling = uxPreviousCeiling;
+		}
+		else
+		{
+			if( xTaskRestoreCeilingPriority( uxPreviousCeiling ) != pdFALSE )
+			{
+				leanYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CEILING_MUTEXES == 1 )
+
+	BaseType_t xCeilingMutexGive( CeilingMutex_t *pxMutex )
+	{
+	UBaseType_t uxPreviousCeiling;
+	BaseType_t xReturn;
+
+		configASSERT( pxMutex );
+
+		/* Read before the give, as a task the mutex is handed to may run
+		and overwrite it before this task restores its ceiling. */
+		uxPreviousCeiling = pxMutex->uxPreviousCeiling;
+
+		xReturn = xLeanMutexGive( &( pxMutex->xMutex ) );
+
+		if( xReturn != pdFAIL )
+		{
+			if( xTaskRestoreCeilingPriority( uxPreviousCeiling ) != pdFALSE )
+			{
+				leanYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static void prvCheckWaitListsInitialised( void )
+{
+UBaseType_t uxList;
+
+	if( xWaitListsInitialised == pdFALSE )
+	{
+		for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) configLEAN_MUTEX_WAIT_LISTS; uxList++ )
+		{
+			vListInitialise( &( xWaitLists[ uxList ] ) );
+		}
+
+		xWaitListsInitialised = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
@@ -114,6 +114,9 @@ void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_STATS == 1 )
+	size_t xRequestedSize = xWantedSize;
+#endif
 
 	vTaskSuspendAll();
 	{
@@ -138,6 +141,14 @@ void *pvReturn = NULL;
 			structure in addition to the requested amount of bytes. */
 			if( xWantedSize > 0 )
 			{
+				#if( configUSE_HEAP_STATS == 1 )
+				{
+					/* Make room for the tag heap_stats.c places in front of
+					the application's memory. */
+					xWantedSize += xHeapStatsTagSize;
+				}
+				#endif
+
 				xWantedSize += xHeapStructSize;
 
 				/* Ensure that blocks are always aligned to the required number
@@ -182,6 +193,12 @@ void *pvReturn = NULL;
 					of the list of free blocks. */
 					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+					#if( configUSE_HEAP_STATS == 1 )
+					{
+						vPortHeapStatsFreeBlockRemoved( pxBlock->xBlockSize );
+					}
+					#endif
+
 					/* If the block is larger than required it can be split into
 					two. */
 					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
@@ -221,6 +238,12 @@ void *pvReturn = NULL;
 					by the application and has no "next" block. */
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
 					pxBlock->pxNextFreeBlock = NULL;
+
+					#if( configUSE_HEAP_STATS == 1 )
+					{
+						pvReturn = pvPortHeapStatsBlockAllocated( pvReturn, xRequestedSize, configHEAP_STATS_GET_CALLER() );
+					}
+					#endif
 				}
 				else
 				{
@@ -267,6 +290,14 @@ BlockLink_t *pxLink;
 
 	if( pv != NULL )
 	{
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			/* Step back over the tag to the address the allocator handed
+			out. */
+			puc = ( uint8_t * ) pvPortHeapStatsBlockFreed( pv );
+		}
+		#endif
+
 		/* The memory being freed will have an BlockLink_t structure immediately
 		before it. */
 		puc -= xHeapStructSize;
@@ -365,6 +396,12 @@ size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
 	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
 	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
 
+	#if( configUSE_HEAP_STATS == 1 )
+	{
+		vPortHeapStatsFreeBlockAdded( pxFirstFreeBlock->xBlockSize );
+	}
+	#endif
+
 	/* Only one block exists - and it covers the entire usable heap space. */
 	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
 	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
@@ -391,6 +428,13 @@ uint8_t *puc;
 	puc = ( uint8_t * ) pxIterator;
 	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
 	{
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			/* The block in front is absorbed into the one being inserted. */
+			vPortHeapStatsFreeBlockRemoved( pxIterator->xBlockSize );
+		}
+		#endif
+
 		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
 		pxBlockToInsert = pxIterator;
 	}
@@ -406,6 +450,12 @@ uint8_t *puc;
 	{
 		if( pxIterator->pxNextFreeBlock != pxEnd )
 		{
+			#if( configUSE_HEAP_STATS == 1 )
+			{
+				vPortHeapStatsFreeBlockRemoved( pxIterator->pxNextFreeBlock->xBlockSize );
+			}
+			#endif
+
 			/* Form one big block from the two blocks. */
 			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
 			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
@@ -432,5 +482,11 @@ uint8_t *puc;
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
+
+	#if( configUSE_HEAP_STATS == 1 )
+	{
+		vPortHeapStatsFreeBlockAdded( pxBlockToInsert->xBlockSize );
+	}
+	#endif
 }
 
@@ -37,8 +37,13 @@ task.h is included from an application file. */
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 #include "stream_buffer.h"
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+	#include "croutine.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -152,6 +157,10 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xStats;					/* The statistics returned by vStreamBufferGetStats(). */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -340,6 +349,12 @@ StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9
 
 	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( xStreamBuffer );
+	}
+	#endif
+
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -374,6 +389,10 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 	UBaseType_t uxStreamBufferNumber;
 #endif
 
+#if( configUSE_OBJECT_STATS == 1 )
+	ObjectStats_t xStats;
+#endif
+
 	configASSERT( pxStreamBuffer );
 
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -384,6 +403,14 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 	}
 	#endif
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		/* The statistics describe the stream buffer rather than the data in
+		it, so are also restored after the reset. */
+		xStats = pxStreamBuffer->xStats;
+	}
+	#endif
+
 	/* Can only reset a message buffer if there are no tasks blocked on it. */
 	if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 	{
@@ -411,6 +438,12 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 			}
 			#endif
 
+			#if( configUSE_OBJECT_STATS == 1 )
+			{
+				pxStreamBuffer->xStats = xStats;
+			}
+			#endif
+
 			traceSTREAM_BUFFER_RESET( xStreamBuffer );
 		}
 	}
@@ -494,6 +527,10 @@ size_t xReturn, xSpace = 0;
 size_t xRequiredSpace = xDataLengthBytes;
 TimeOut_t xTimeOut;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xTicksBlocked = 0;
+#endif
+
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
@@ -514,6 +551,13 @@ TimeOut_t xTimeOut;
 	{
 		vTaskSetTimeOutState( &xTimeOut );
 
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			/* xTimeOut.xTimeOnEntering moves on each time round the loop. */
+			xTicksBlocked = xTaskGetTickCount();
+		}
+		#endif
+
 		do
 		{
 			/* Wait until the required number of bytes are free in the message
@@ -540,10 +584,17 @@ TimeOut_t xTimeOut;
 			taskEXIT_CRITICAL();
 
 			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			taskSET_BLOCK_REASON( eBlockStreamBuffer, pxStreamBuffer );
 			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
 			pxStreamBuffer->xTaskWaitingToSend = NULL;
 
 		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			xTicksBlocked = xTaskGetTickCount() - xTicksBlocked;
+		}
+		#endif
 	}
 	else
 	{
@@ -569,6 +620,12 @@ TimeOut_t xTimeOut;
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
 			sbSEND_COMPLETED( pxStreamBuffer );
+
+			#if( configUSE_CO_ROUTINE_HOST == 1 )
+			{
+				vCoRoutineHostObjectChanged();
+			}
+			#endif
 		}
 		else
 		{
@@ -581,6 +638,12 @@ TimeOut_t xTimeOut;
 		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
 	}
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxStreamBuffer->xStats ), queueSTATS_SEND, ( xReturn > ( size_t ) 0 ) ? pdTRUE : pdFALSE, xTicksBlocked, ( UBaseType_t ) prvBytesInBuffer( pxStreamBuffer ) );
+	}
+	#endif
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -619,6 +682,12 @@ size_t xRequiredSpace = xDataLengthBytes;
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
 			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+			#if( configUSE_CO_ROUTINE_HOST == 1 )
+			{
+				vCoRoutineHostObjectChangedFromISR( pxHigherPriorityTaskWoken );
+			}
+			#endif
 		}
 		else
 		{
@@ -630,6 +699,12 @@ size_t xRequiredSpace = xDataLengthBytes;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxStreamBuffer->xStats ), queueSTATS_SEND, ( xReturn > ( size_t ) 0 ) ? pdTRUE : pdFALSE, ( TickType_t ) 0, ( UBaseType_t ) prvBytesInBuffer( pxStreamBuffer ) );
+	}
+	#endif
+
 	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
 
 	return xReturn;
@@ -696,6 +771,10 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
 StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
 size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xTicksBlocked = 0;
+#endif
+
 	configASSERT( pvRxData );
 	configASSERT( pxStreamBuffer );
 
@@ -746,9 +825,23 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		{
 			/* Wait for data to be available. */
 			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+
+			#if( configUSE_OBJECT_STATS == 1 )
+			{
+				xTicksBlocked = xTaskGetTickCount();
+			}
+			#endif
+
+			taskSET_BLOCK_REASON( eBlockStreamBuffer, pxStreamBuffer );
 			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
 			pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
+			#if( configUSE_OBJECT_STATS == 1 )
+			{
+				xTicksBlocked = xTaskGetTickCount() - xTicksBlocked;
+			}
+			#endif
+
 			/* Recheck the data available after blocking. */
 			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 		}
@@ -776,6 +869,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		{
 			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
 			sbRECEIVE_COMPLETED( pxStreamBuffer );
+
+			#if( configUSE_CO_ROUTINE_HOST == 1 )
+			{
+				vCoRoutineHostObjectChanged();
+			}
+			#endif
 		}
 		else
 		{
@@ -788,6 +887,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxStreamBuffer->xStats ), queueSTATS_RECEIVE, ( xReceivedLength > ( size_t ) 0 ) ? pdTRUE : pdFALSE, xTicksBlocked, ( UBaseType_t ) 0 );
+	}
+	#endif
+
 	return xReceivedLength;
 }
 /*-----------------------------------------------------------*/
@@ -832,6 +937,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		if( xReceivedLength != ( size_t ) 0 )
 		{
 			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+			#if( configUSE_CO_ROUTINE_HOST == 1 )
+			{
+				vCoRoutineHostObjectChangedFromISR( pxHigherPriorityTaskWoken );
+			}
+			#endif
 		}
 		else
 		{
@@ -843,6 +954,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxStreamBuffer->xStats ), queueSTATS_RECEIVE, ( xReceivedLength > ( size_t ) 0 ) ? pdTRUE : pdFALSE, ( TickType_t ) 0, ( UBaseType_t ) 0 );
+	}
+	#endif
+
 	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
 
 	return xReceivedLength;
@@ -1168,6 +1285,45 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	}
 }
 
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+		configASSERT( xStreamBuffer );
+
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			vQueueAddObjectToRegistry( xStreamBuffer, pcName, &( ( ( StreamBuffer_t * ) xStreamBuffer )->xStats ) );
+		}
+		#else
+		{
+			vQueueAddObjectToRegistry( xStreamBuffer, pcName, NULL );
+		}
+		#endif
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_STATS == 1 )
+
+	void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, ObjectStats_t *pxStats )
+	{
+	const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxStreamBuffer->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_OBJECT_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
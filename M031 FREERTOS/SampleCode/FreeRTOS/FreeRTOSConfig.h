@@ -69,9 +69,50 @@
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
 
-/* Co-routine definitions. */
+/* Notification values per task.  Index 0 is used by xTaskNotify(),
+ulTaskNotifyTake() and the other functions without an index, and the hrtimer.c
+service task uses it, so drivers should use the Indexed functions with index 1
+upwards. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2
+
+/* Optional features and benchmarks.  The Keil project already holds every
+source they need: the kernel files, the drivers in the User group and the
+benchmarks in the Benchmarks group build to nothing, or are dropped by the
+linker, until the configUSE_ options below select them.  The exceptions are
+lean_mutex.c, which has to be included in the build when configUSE_LEAN_MUTEXES
+is 1, and heap_5.c, which has to replace heap_2.c in the build when
+configUSE_HEAP_REGIONS is 1.  Each benchmark prints its figures through the
+UART and needs its configUSE_..._BENCH option set as well as the option of the
+feature it measures. */
+
+/* heap_5 definitions.  With configUSE_HEAP_REGIONS set, heap_regions.c makes
+the heap of all SRAM the linker leaves unused and configTOTAL_HEAP_SIZE is
+ignored.  configHEAP_SRAM_SIZE must match the IRAM1 size of the Keil target. */
+#define configUSE_HEAP_REGIONS			0
+#define configUSE_HEAP_REGION_STATS		1
+#define configHEAP_SRAM_SIZE			( 0x4000 )
+
+/* Active object dispatch latency.  The benchmark time stamps posted events
+with TIMER0; the 24-bit count is shifted up so it wraps as a 32-bit value. */
+#define configUSE_AO_BENCH				0
+#if ( configUSE_AO_BENCH == 1 )
+	#define configAO_MEASURE_LATENCY	1
+	#define configAO_GET_TIMESTAMP()	( TIMER0->CNT << 8 )
+#endif
+
+/* Microsecond timers on TIMER1, and their period jitter against a software
+timer. */
+#define configUSE_HRTIMER				0
+#define configHRTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configUSE_HRTIMER_BENCH			0
+
+/* Co-routine definitions.  With configUSE_CO_ROUTINE_HOST set as well, the
+co-routines are run by a host task; the benchmark compares the heap and stack
+used by state machines written as co-routines and as tasks. */
 #define configUSE_CO_ROUTINES 			0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+#define configUSE_CO_ROUTINE_HOST		0
+#define configUSE_CROUTINE_BENCH		0
 
 /* Software timer definitions. */
 #define configUSE_TIMERS				1
@@ -79,6 +120,134 @@
 #define configTIMER_QUEUE_LENGTH		5
 #define configTIMER_TASK_STACK_DEPTH	( 80 )
 
+/* Set configUSE_TIMER_HEAP to 1 to keep active timers in a heap rather than
+a sorted list, and configUSE_TIMER_DIRECT_COMMANDS to 1 to let tasks update
+the active timers without going through the timer queue.  The benchmark
+measures the cost of timer commands. */
+#define configUSE_TIMER_HEAP			0
+#define configTIMER_HEAP_LENGTH			16
+#define configUSE_TIMER_DIRECT_COMMANDS	0
+#define configUSE_TIMER_BENCH			0
+#if ( configUSE_TIMER_BENCH == 1 ) && ( configUSE_TIMER_HEAP == 1 )
+	#undef configTIMER_HEAP_LENGTH
+	#define configTIMER_HEAP_LENGTH		500
+#endif
+
+/* Set configUSE_EVENT_GROUP_INDEX to 1 to index the tasks blocked on an event
+group by the bits they wait for, so setting bits only examines the tasks those
+bits can unblock.  The benchmark measures the cost of setting bits. */
+#define configUSE_EVENT_GROUP_INDEX		0
+#define configUSE_EVENT_GROUP_BENCH		0
+
+/* Lean mutexes, compared with mutex type semaphores by the benchmark. */
+#define configUSE_LEAN_MUTEXES			0
+#define configUSE_LEAN_MUTEX_BENCH		0
+
+/* Read throughput of a readers-writer lock against that of a mutex. */
+#define configUSE_RWLOCK_BENCH			0
+
+/* Set configUSE_CEILING_MUTEXES to 1 as well as configUSE_LEAN_MUTEXES to
+build the priority ceiling mutexes of lean_mutex.c, and
+configUSE_CEILING_MUTEX_CHECK to 1 to run the self check in
+ceiling_mutex_check.c. */
+#define configUSE_CEILING_MUTEXES		0
+#define configUSE_CEILING_MUTEX_CHECK	0
+
+/* Fanning readings out through a broadcast channel against fanning them out
+through one queue per consumer. */
+#define configUSE_BROADCAST_BENCH		0
+
+/* How long an urgent command waits behind bulk requests in a queue and in a
+priority queue. */
+#define configUSE_PRIORITY_QUEUE_BENCH	0
+
+/* Set configUSE_EDF_SCHEDULING to 1 to schedule the tasks of priority
+configEDF_PRIORITY that have been given a deadline with vTaskSetDeadline()
+earliest deadline first.  The benchmark compares the deadlines missed under
+fixed priority and EDF scheduling. */
+#define configUSE_EDF_SCHEDULING		0
+#define configEDF_PRIORITY				1
+#define configUSE_EDF_BENCH				0
+
+/* Set configUSE_TASK_BUDGETS to 1 to let vTaskSetBudget() limit the processor
+time a task can use in each period.  TIMER2 then free-runs at the HIRC
+frequency to measure it, started by the application before the scheduler, so
+budgets are in CPU cycles.  The benchmark shows the display and comms tasks
+keep running while a runaway sensor task is held to its budget. */
+#define configUSE_TASK_BUDGETS			0
+#define configUSE_BUDGET_BENCH			0
+#if ( configUSE_TASK_BUDGETS == 1 )
+	#define configBUDGET_TIMER_VALUE()	( TIMER2->CNT )
+	#define configBUDGET_TIMER_MASK		0xFFFFFFUL
+	#define configUSE_BUDGET_EXHAUSTED_HOOK	configUSE_BUDGET_BENCH
+#endif
+
+/* Set configUSE_TIME_SLICE_QUANTUM to 1 to let vTaskSetTimeSliceQuantum() set
+the ticks each task runs for before time slicing switches to the next task of
+its priority.  The benchmark counts the switches between batch tasks. */
+#define configUSE_TIME_SLICE_QUANTUM	0
+#define configDEFAULT_TIME_SLICE_QUANTUM	1
+#define configUSE_QUANTUM_BENCH			0
+
+/* Release jitter of a cyclic executive, dispatched from TIMER3, against that
+of a vTaskDelayUntil() loop. */
+#define configUSE_CYCLIC_BENCH			0
+#define configUSE_CYCLIC_OVERRUN_HOOK	configUSE_CYCLIC_BENCH
+
+/* Set configUSE_TASK_POOLS to 1 to let xTaskCreateFromPool() create tasks from
+pools of task control blocks and stacks allocated once by xTaskPoolCreate().
+The benchmark times creating and deleting connection tasks with and without a
+pool. */
+#define configUSE_TASK_POOLS			0
+#define configUSE_TASK_POOL_BENCH		0
+
+/* Set configUSE_TASK_SNAPSHOT to 1 to let vTaskSnapshotStart() and
+eTaskSnapshotNext() read the state of the tasks one at a time.  The benchmark
+compares the delay monitoring causes a control task with
+uxTaskGetSystemState(). */
+#define configUSE_TASK_SNAPSHOT			0
+#define configUSE_SNAPSHOT_BENCH		0
+
+/* Set configUSE_STACK_WATERMARK to 1 to have the idle task keep the least free
+stack space of every task for uxTaskGetStackReport(), which recommends stack
+sizes.  The benchmark reports the stacks of tasks given the sizes main.c
+uses. */
+#define configUSE_STACK_WATERMARK		0
+#define configSTACK_WATERMARK_MARGIN	16
+#define configUSE_STACK_BENCH			0
+#define configUSE_STACK_MARGIN_HOOK		configUSE_STACK_BENCH
+
+/* Set configUSE_OBJECT_STATS to 1 to count the sends, receives, failures and
+waiting time of every queue, semaphore, mutex, stream buffer and event group.
+The benchmark prints the statistics of the objects in the registry. */
+#define configUSE_OBJECT_STATS			0
+#define configUSE_OBJECT_STATS_BENCH	0
+
+/* Set configUSE_BLOCKING_STATS to 1 to keep the time each task spends blocked
+for each reason.  The benchmark finds what a task that misses its deadlines
+waits on. */
+#define configUSE_BLOCKING_STATS		0
+#define configUSE_BLOCKING_BENCH		0
+
+/* Set configUSE_PROFILER to 1 to sample the interrupted PC on TIMER3
+configPROFILER_SAMPLE_HZ times a second; the benchmark profiles a few busy
+tasks.  Samples are counted in configPROFILER_BUCKETS buckets, a power of two,
+with the PC and LR rounded down to 1 << configPROFILER_PC_SHIFT bytes. */
+#define configUSE_PROFILER				0
+#define configPROFILER_SAMPLE_HZ		997
+#define configPROFILER_BUCKETS			64
+#define configPROFILER_PC_SHIFT			2
+#define configUSE_PROFILER_BENCH		0
+
+/* Set configUSE_I2C_ENGINE to 1 to run I2C0 transactions from its interrupt
+at configI2C_ENGINE_BUS_HZ; the benchmark compares it with the polled
+StdDriver helpers.  A task waits for its transactions on notification index
+configI2C_ENGINE_NOTIFY_INDEX. */
+#define configUSE_I2C_ENGINE			0
+#define configI2C_ENGINE_BUS_HZ			400000
+#define configI2C_ENGINE_NOTIFY_INDEX	1
+#define configUSE_I2C_ENGINE_BENCH		0
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet		1
@@ -88,6 +257,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * @file     ao_bench.c
+ * @version  V1.00
+ * @brief    Dispatch latency benchmark for the active object framework.
+ *
+ * To use it, set configUSE_AO_BENCH to 1 in FreeRTOSConfig.h.  TIMER0 then
+ * free-runs at the HIRC frequency and time stamps every posted event, so
+ * latencies are reported in HIRC cycles.
+ *
+ * A time event posts to the Ping active object every 10 ticks.  Ping posts a
+ * pool event to Pong, which shares Ping's runner task, and sends a time stamp
+ * through a FreeRTOS queue to a conventional task of the same priority.  Pong
+ * is dispatched without a context switch once Ping returns, while the task
+ * needs one, so the two latencies compare active object dispatch with the
+ * task-per-state-machine design.  Once a second the Report active object, on
+ * a lower priority runner, prints and resets the figures.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "active_object.h"
+#include "bench_common.h"
+
+#if (configUSE_AO_BENCH == 1)
+
+#define BENCH_FAST_PRIORITY     3
+#define BENCH_SLOW_PRIORITY     1
+#define BENCH_PERIOD_TICKS      10
+#define BENCH_REPORT_TICKS      1000
+
+/* Signals.  STATUS_SIG is published so must be below configAO_MAX_PUB_SIGNAL. */
+enum
+{
+    STATUS_SIG = 1,
+    TICK_SIG,
+    DATA_SIG,
+    REPORT_SIG
+};
+
+/* Active object priorities. */
+#define PING_PRIORITY           3
+#define PONG_PRIORITY           2
+#define REPORT_PRIORITY         1
+
+typedef struct
+{
+    AOEvent_t xSuper;
+    uint32_t u32Sequence;
+} DataEvent_t;
+
+typedef struct
+{
+    uint32_t u32Count;
+    uint32_t u32MaxLatency;
+    uint32_t u32TotalLatency;
+} BaselineStats_t;
+
+static AORunner_t s_xFastRunner, s_xSlowRunner;
+static AOActive_t s_xPingAO, s_xPongAO, s_xReportAO;
+static AOTimeEvent_t s_xTickEvent, s_xReportEvent;
+static const AOEvent_t s_xStatusEvent = aoSTATIC_EVENT(STATUS_SIG);
+
+/* Room for eight data events. */
+static uint32_t s_au32PoolStorage[8 * ((sizeof(DataEvent_t) + sizeof(uint32_t) - 1) / sizeof(uint32_t))];
+
+static QueueHandle_t s_xBaselineQueue;
+static BaselineStats_t s_xBaselineStats;
+static uint32_t s_u32StatusCount;
+
+/* Time stamps are shifted by configAO_GET_TIMESTAMP() so the 24-bit counter
+   wraps as a 32-bit value. */
+#define BENCH_CYCLES(x)         ((x) >> 8)
+
+static void PingDispatch(AOActive_t *pxAO, const AOEvent_t *pxEvent)
+{
+    static uint32_t u32Sequence;
+    DataEvent_t *pxData;
+    uint32_t u32Stamp;
+
+    (void)pxAO;
+
+    if(pxEvent->xSignal == TICK_SIG)
+    {
+        pxData = (DataEvent_t *)pxAOEventNew(sizeof(DataEvent_t), DATA_SIG);
+
+        if(pxData != NULL)
+        {
+            pxData->u32Sequence = u32Sequence++;
+            (void)xAOPost(&s_xPongAO, &pxData->xSuper);
+        }
+
+        u32Stamp = configAO_GET_TIMESTAMP();
+        (void)xQueueSend(s_xBaselineQueue, &u32Stamp, 0);
+
+        (void)uxAOPublish(&s_xStatusEvent);
+    }
+}
+
+static void PongDispatch(AOActive_t *pxAO, const AOEvent_t *pxEvent)
+{
+    /* Nothing to do - the framework has already recorded the latency. */
+    (void)pxAO;
+    (void)pxEvent;
+}
+
+static void PrintStats(const char *pcName, uint32_t u32Count, uint32_t u32Max, uint32_t u32Total)
+{
+    if(u32Count != 0)
+    {
+        printf("%-8s n=%4u mean=%5u max=%5u cycles\n", pcName, (unsigned int)u32Count,
+               (unsigned int)BENCH_CYCLES(u32Total / u32Count), (unsigned int)BENCH_CYCLES(u32Max));
+    }
+}
+
+static void ReportDispatch(AOActive_t *pxAO, const AOEvent_t *pxEvent)
+{
+    AOStats_t xStats;
+    BaselineStats_t xBaseline;
+
+    (void)pxAO;
+
+    if(pxEvent->xSignal == STATUS_SIG)
+    {
+        s_u32StatusCount++;
+    }
+    else if(pxEvent->xSignal == REPORT_SIG)
+    {
+        vAOGetStats(&s_xPingAO, &xStats, pdTRUE);
+        PrintStats("ping", xStats.ulDispatchCount, xStats.ulMaxLatency, xStats.ulTotalLatency);
+        vAOGetStats(&s_xPongAO, &xStats, pdTRUE);
+        PrintStats("pong", xStats.ulDispatchCount, xStats.ulMaxLatency, xStats.ulTotalLatency);
+        vAOGetStats(&s_xReportAO, &xStats, pdTRUE);
+        PrintStats("report", xStats.ulDispatchCount, xStats.ulMaxLatency, xStats.ulTotalLatency);
+
+        vTaskSuspendAll();
+        xBaseline = s_xBaselineStats;
+        s_xBaselineStats.u32Count = 0;
+        s_xBaselineStats.u32MaxLatency = 0;
+        s_xBaselineStats.u32TotalLatency = 0;
+        (void)xTaskResumeAll();
+        PrintStats("task", xBaseline.u32Count, xBaseline.u32MaxLatency, xBaseline.u32TotalLatency);
+
+        printf("status %u, pool min free %u\n", (unsigned int)s_u32StatusCount,
+               (unsigned int)uxAOPoolGetMinimumEverFree(0));
+    }
+}
+
+/* The conventional design: one task blocked on a queue. */
+static void BaselineTask(void *pvParameters)
+{
+    uint32_t u32Stamp, u32Latency;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        if(xQueueReceive(s_xBaselineQueue, &u32Stamp, portMAX_DELAY) == pdPASS)
+        {
+            u32Latency = configAO_GET_TIMESTAMP() - u32Stamp;
+
+            vTaskSuspendAll();
+            s_xBaselineStats.u32Count++;
+            s_xBaselineStats.u32TotalLatency += u32Latency;
+            if(u32Latency > s_xBaselineStats.u32MaxLatency)
+                s_xBaselineStats.u32MaxLatency = u32Latency;
+            (void)xTaskResumeAll();
+        }
+    }
+}
+
+void vAOBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    (void)xAOPoolInit(s_au32PoolStorage, sizeof(s_au32PoolStorage), sizeof(DataEvent_t));
+
+    (void)xAORunnerCreate(&s_xFastRunner, "AOf", 100, BENCH_FAST_PRIORITY);
+    (void)xAORunnerCreate(&s_xSlowRunner, "AOs", 160, BENCH_SLOW_PRIORITY);
+
+    (void)xAOStart(&s_xPingAO, &s_xFastRunner, PING_PRIORITY, 4, PingDispatch);
+    (void)xAOStart(&s_xPongAO, &s_xFastRunner, PONG_PRIORITY, 4, PongDispatch);
+    (void)xAOStart(&s_xReportAO, &s_xSlowRunner, REPORT_PRIORITY, 4, ReportDispatch);
+    (void)xAOSubscribe(&s_xReportAO, STATUS_SIG);
+
+    s_xBaselineQueue = xQueueCreate(4, sizeof(uint32_t));
+    (void)xTaskCreate(BaselineTask, "Base", 80, NULL, BENCH_FAST_PRIORITY, NULL);
+
+    (void)xAOTimeEventCreate(&s_xTickEvent, &s_xPingAO, TICK_SIG, pdTRUE);
+    (void)xAOTimeEventCreate(&s_xReportEvent, &s_xReportAO, REPORT_SIG, pdTRUE);
+
+    /* Timer commands are queued until the scheduler starts. */
+    (void)xAOTimeEventArm(&s_xTickEvent, BENCH_PERIOD_TICKS);
+    (void)xAOTimeEventArm(&s_xReportEvent, BENCH_REPORT_TICKS);
+}
+
+#endif /* configUSE_AO_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
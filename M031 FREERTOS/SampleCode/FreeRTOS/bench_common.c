@@ -0,0 +1,77 @@
+/******************************************************************************
+ * @file     bench_common.c
+ * @version  V1.00
+ * @brief    Cycle timer and statistics shared by the benchmarks.
+ *
+ * Built with the benchmarks in the Benchmarks group of the Keil project.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "bench_common.h"
+
+void BenchTimerInit(TIMER_T *timer)
+{
+    uint32_t u32Module, u32ClkSrc;
+
+    if(timer == TIMER0)
+    {
+        u32Module = TMR0_MODULE;
+        u32ClkSrc = CLK_CLKSEL1_TMR0SEL_HIRC;
+    }
+    else if(timer == TIMER1)
+    {
+        u32Module = TMR1_MODULE;
+        u32ClkSrc = CLK_CLKSEL1_TMR1SEL_HIRC;
+    }
+    else if(timer == TIMER2)
+    {
+        u32Module = TMR2_MODULE;
+        u32ClkSrc = CLK_CLKSEL1_TMR2SEL_HIRC;
+    }
+    else
+    {
+        u32Module = TMR3_MODULE;
+        u32ClkSrc = CLK_CLKSEL1_TMR3SEL_HIRC;
+    }
+
+    SYS_UnlockReg();
+    CLK_EnableModuleClock(u32Module);
+    CLK_SetModuleClock(u32Module, u32ClkSrc, 0);
+    SYS_LockReg();
+
+    /* Free running at the module clock, no prescaler, no interrupt. */
+    timer->CTL = TIMER_CONTINUOUS_MODE;
+    timer->CMP = BENCH_TIMER_MASK;
+    TIMER_Start(timer);
+}
+
+void BenchStatsReset(BenchStats_t *pxStats)
+{
+    pxStats->u32Count = 0;
+    pxStats->u32Min = 0xFFFFFFFF;
+    pxStats->u32Max = 0;
+    pxStats->u32Total = 0;
+}
+
+void BenchStatsRecord(BenchStats_t *pxStats, uint32_t u32Cycles)
+{
+    pxStats->u32Count++;
+    if(u32Cycles < pxStats->u32Min)
+        pxStats->u32Min = u32Cycles;
+    if(u32Cycles > pxStats->u32Max)
+        pxStats->u32Max = u32Cycles;
+    pxStats->u32Total += u32Cycles;
+}
+
+void BenchStatsPrint(const char *pcWhat, const BenchStats_t *pxStats)
+{
+    if(pxStats->u32Count == 0)
+        printf("%-8s no samples\n", pcWhat);
+    else
+        printf("%-8s min=%5u mean=%5u max=%5u cycles\n", pcWhat, (unsigned int)pxStats->u32Min,
+               (unsigned int)(pxStats->u32Total / pxStats->u32Count), (unsigned int)pxStats->u32Max);
+}
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * @file     bench_common.h
+ * @version  V1.00
+ * @brief    Cycle timer and statistics shared by the benchmarks.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* The 24-bit timer counts at the HIRC frequency, which is also HCLK, so the
+   figures are in CPU cycles. */
+#define BENCH_TIMER_MASK        0xFFFFFFUL
+
+/* TIMER0 count, and the cycles since an earlier count of up to one wrap. */
+#define BENCH_NOW()             (TIMER0->CNT)
+#define BENCH_SINCE(u32Start)   ((TIMER0->CNT - (u32Start)) & BENCH_TIMER_MASK)
+
+typedef struct
+{
+    uint32_t u32Count;
+    uint32_t u32Min;
+    uint32_t u32Max;
+    uint32_t u32Total;
+} BenchStats_t;
+
+/* Start a timer free-running at the HIRC frequency with no interrupt.  The
+   benchmarks time with TIMER0; the budget benchmark also starts the timer
+   the kernel measures budgets with. */
+void BenchTimerInit(TIMER_T *timer);
+
+void BenchStatsReset(BenchStats_t *pxStats);
+void BenchStatsRecord(BenchStats_t *pxStats, uint32_t u32Cycles);
+
+/* Print "<pcWhat> min= mean= max= cycles" and a new line.  The caller prints
+   any prefix first. */
+void BenchStatsPrint(const char *pcWhat, const BenchStats_t *pxStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCH_COMMON_H__ */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
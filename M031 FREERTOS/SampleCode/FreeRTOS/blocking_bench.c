@@ -0,0 +1,200 @@
+/******************************************************************************
+ * @file     blocking_bench.c
+ * @version  V1.00
+ * @brief    Finding what a control task that misses its deadlines waits on.
+ *
+ * To use it, set configUSE_BLOCKING_STATS and configUSE_BLOCKING_BENCH to 1
+ * in FreeRTOSConfig.h.  Run time stats are not used, so the times are in
+ * ticks.
+ *
+ * A sensor task notifies a control task every BENCH_PERIOD_TICKS ticks and
+ * sends it a reading BENCH_READING_TICKS ticks later.  The control task waits
+ * for the notification, then for the reading, then takes a mutex that a low
+ * priority logger task holds for BENCH_HOLD_TICKS ticks at a time, and counts
+ * the periods it does not finish within BENCH_DEADLINE_TICKS ticks of the
+ * notification.  Every BENCH_REPORT_TICKS ticks uxTaskGetSystemState() is
+ * called and the time each task has spent blocked for each reason is printed,
+ * with the object it waited on longest.  After BENCH_REPORTS reports the reason
+ * the control task waited for most is printed.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#if (configUSE_BLOCKING_STATS == 1) && (configUSE_BLOCKING_BENCH == 1)
+
+#define BENCH_PERIOD_TICKS      10
+#define BENCH_READING_TICKS     2
+#define BENCH_HOLD_TICKS        4
+#define BENCH_LOG_GAP_TICKS     7
+#define BENCH_DEADLINE_TICKS    5
+#define BENCH_WAIT_TICKS        20
+#define BENCH_REPORT_TICKS      1000
+#define BENCH_REPORTS           5
+#define BENCH_MAX_TASKS         8
+#define BENCH_LOW_PRIORITY      1
+#define BENCH_SENSOR_PRIORITY   2
+#define BENCH_CONTROL_PRIORITY  3
+#define BENCH_TASK_PRIORITY     4
+
+static const char * const s_apcReasons[eBlockReasonCount] =
+{
+    "none", "delay", "queue", "sem", "mutex", "event", "stream", "notify", "other"
+};
+
+static QueueHandle_t s_xReadings;
+static SemaphoreHandle_t s_xBusLock;
+static TaskHandle_t s_xControlTask;
+static TaskStatus_t s_axStatus[BENCH_MAX_TASKS];
+static volatile uint32_t s_u32Periods;
+static volatile uint32_t s_u32Misses;
+
+static const char *ObjectName(const void *pvObject)
+{
+    if(pvObject == NULL)
+        return "-";
+    if(pvObject == (const void *)s_xReadings)
+        return "Readings";
+    if(pvObject == (const void *)s_xBusLock)
+        return "BusLock";
+    return "?";
+}
+
+static void SensorTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    uint32_t u32Reading = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, BENCH_PERIOD_TICKS);
+        xTaskNotifyGive(s_xControlTask);
+
+        /* The reading takes a while to convert. */
+        vTaskDelay(BENCH_READING_TICKS);
+        u32Reading++;
+        (void)xQueueSend(s_xReadings, &u32Reading, 0);
+    }
+}
+
+static void LoggerTask(void *pvParameters)
+{
+    TickType_t xStart;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        if(xSemaphoreTake(s_xBusLock, portMAX_DELAY) == pdPASS)
+        {
+            /* A slow write to the bus. */
+            xStart = xTaskGetTickCount();
+            while((xTaskGetTickCount() - xStart) < BENCH_HOLD_TICKS)
+            {
+            }
+            (void)xSemaphoreGive(s_xBusLock);
+        }
+        vTaskDelay(BENCH_LOG_GAP_TICKS);
+    }
+}
+
+static void ControlTask(void *pvParameters)
+{
+    TickType_t xReleased;
+    uint32_t u32Reading;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        if(ulTaskNotifyTake(pdTRUE, BENCH_WAIT_TICKS) == 0)
+            continue;
+        xReleased = xTaskGetTickCount();
+
+        (void)xQueueReceive(s_xReadings, &u32Reading, BENCH_WAIT_TICKS);
+
+        /* Write the output to the bus the logger also uses. */
+        if(xSemaphoreTake(s_xBusLock, BENCH_WAIT_TICKS) == pdPASS)
+            (void)xSemaphoreGive(s_xBusLock);
+
+        if((xTaskGetTickCount() - xReleased) > BENCH_DEADLINE_TICKS)
+            s_u32Misses++;
+        s_u32Periods++;
+    }
+}
+
+static void BlockingBenchTask(void *pvParameters)
+{
+    UBaseType_t uxTasks = 0, ux;
+    uint32_t i, j, u32Most = 0;
+    const TaskBlockingStats_t *pxStats;
+    eBlockReason eMost = eBlockNone;
+
+    (void)pvParameters;
+
+    printf("period %u ticks, deadline %u ticks\n", (unsigned int)BENCH_PERIOD_TICKS,
+           (unsigned int)BENCH_DEADLINE_TICKS);
+
+    for(i = 0; i < BENCH_REPORTS; i++)
+    {
+        vTaskDelay(BENCH_REPORT_TICKS);
+
+        uxTasks = uxTaskGetSystemState(s_axStatus, BENCH_MAX_TASKS, NULL);
+
+        printf("report %u, control missed %u of %u\n", (unsigned int)i, (unsigned int)s_u32Misses,
+               (unsigned int)s_u32Periods);
+        for(ux = 0; ux < uxTasks; ux++)
+        {
+            pxStats = &s_axStatus[ux].xBlockingStats;
+            printf("  %-7s delay=%5u queue=%5u mutex=%5u notify=%5u longest=%u %s on %s\n",
+                   s_axStatus[ux].pcTaskName, (unsigned int)pxStats->ulBlockedTime[eBlockDelay],
+                   (unsigned int)pxStats->ulBlockedTime[eBlockQueue],
+                   (unsigned int)pxStats->ulBlockedTime[eBlockMutex],
+                   (unsigned int)pxStats->ulBlockedTime[eBlockNotification], (unsigned int)pxStats->ulLongestBlock,
+                   s_apcReasons[pxStats->eLongestBlockReason], ObjectName(pxStats->pvLongestBlockObject));
+        }
+    }
+
+    /* What the control task spent the most time waiting for. */
+    for(ux = 0; ux < uxTasks; ux++)
+    {
+        if(s_axStatus[ux].xHandle != s_xControlTask)
+            continue;
+
+        pxStats = &s_axStatus[ux].xBlockingStats;
+        for(j = (uint32_t)eBlockDelay; j < (uint32_t)eBlockReasonCount; j++)
+        {
+            if(pxStats->ulBlockedTime[j] > u32Most)
+            {
+                u32Most = pxStats->ulBlockedTime[j];
+                eMost = (eBlockReason)j;
+            }
+        }
+    }
+    printf("control waited most for: %s, %u ticks\n", s_apcReasons[eMost], (unsigned int)u32Most);
+
+    vTaskDelete(NULL);
+}
+
+void vBlockingBenchStart(void)
+{
+    s_xReadings = xQueueCreate(1, sizeof(uint32_t));
+    s_xBusLock = xSemaphoreCreateMutex();
+
+    (void)xTaskCreate(BlockingBenchTask, "BlBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(ControlTask, "Control", configMINIMAL_STACK_SIZE + 20, NULL, BENCH_CONTROL_PRIORITY, &s_xControlTask);
+    (void)xTaskCreate(SensorTask, "Sensor", configMINIMAL_STACK_SIZE + 10, NULL, BENCH_SENSOR_PRIORITY, NULL);
+    (void)xTaskCreate(LoggerTask, "Logger", configMINIMAL_STACK_SIZE, NULL, BENCH_LOW_PRIORITY, NULL);
+}
+
+#endif /* configUSE_BLOCKING_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,251 @@
+/******************************************************************************
+ * @file     broadcast_bench.c
+ * @version  V1.00
+ * @brief    Cost of a broadcast channel against one queue per consumer.
+ *
+ * To use it, set configUSE_BROADCAST_BENCH to 1 in FreeRTOSConfig.h.  TIMER0
+ * free-runs at the HIRC frequency, which is also HCLK, so times are reported
+ * in CPU cycles.
+ *
+ * A sensor task publishes a reading every tick to three consumers: logging and
+ * control, which must see every reading, and display, which only wants the
+ * latest and reads every BENCH_DISPLAY_TICKS ticks.  The readings are fanned
+ * out first through one queue per consumer, the display queue holding a single
+ * reading that is overwritten, and then through one broadcast channel with a
+ * subscriber per consumer.  For each the heap taken by the objects, the time
+ * each publish takes including unblocking the consumers, and the readings
+ * received and skipped by each consumer are printed.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "broadcast.h"
+#include "bench_common.h"
+
+#if (configUSE_BROADCAST_BENCH == 1)
+
+#define BENCH_CONSUMERS         3
+#define BENCH_DISPLAY           2       /* Index of the latest value consumer. */
+#define BENCH_LENGTH            8
+#define BENCH_READINGS          500
+#define BENCH_DISPLAY_TICKS     10
+#define BENCH_CONSUMER_PRIORITY 1
+#define BENCH_TASK_PRIORITY     2
+
+enum
+{
+    BENCH_MODE_QUEUES,
+    BENCH_MODE_BROADCAST
+};
+
+typedef struct
+{
+    uint32_t u32Sequence;
+    int16_t ai16Sample[6];
+} Reading_t;
+
+typedef struct
+{
+    uint32_t u32Received;
+    uint32_t u32Skipped;
+} ConsumerStats_t;
+
+static const char * const s_apcConsumerNames[BENCH_CONSUMERS] = { "logging", "control", "display" };
+
+static volatile uint32_t s_u32Mode;
+static QueueHandle_t s_axQueues[BENCH_CONSUMERS];
+static BroadcastHandle_t s_xChannel;
+static BroadcastSubscriber_t s_axSubscribers[BENCH_CONSUMERS];
+static TaskHandle_t s_axConsumerTasks[BENCH_CONSUMERS];
+static ConsumerStats_t s_axStats[BENCH_CONSUMERS];
+
+static void ConsumerTask(void *pvParameters)
+{
+    uint32_t u32Consumer = (uint32_t)pvParameters;
+    uint32_t u32Expected = 0;
+    Reading_t xReading;
+    BaseType_t xReceived;
+
+    for(;;)
+    {
+        if(u32Consumer == BENCH_DISPLAY)
+            vTaskDelay(BENCH_DISPLAY_TICKS);
+
+        if(s_u32Mode == BENCH_MODE_QUEUES)
+            xReceived = xQueueReceive(s_axQueues[u32Consumer], &xReading, portMAX_DELAY);
+        else
+            xReceived = xBroadcastReceive(&s_axSubscribers[u32Consumer], &xReading, portMAX_DELAY);
+
+        if(xReceived == pdPASS)
+        {
+            s_axStats[u32Consumer].u32Received++;
+            s_axStats[u32Consumer].u32Skipped += xReading.u32Sequence - u32Expected;
+            u32Expected = xReading.u32Sequence + 1;
+        }
+    }
+}
+
+static BaseType_t Publish(const Reading_t *pxReading)
+{
+    BaseType_t xReturn = pdPASS;
+    uint32_t i;
+
+    if(s_u32Mode == BENCH_MODE_QUEUES)
+    {
+        for(i = 0; i < BENCH_CONSUMERS; i++)
+        {
+            if(i == BENCH_DISPLAY)
+                (void)xQueueOverwrite(s_axQueues[i], pxReading);
+            else if(xQueueSend(s_axQueues[i], pxReading, portMAX_DELAY) != pdPASS)
+                xReturn = pdFAIL;
+        }
+    }
+    else
+    {
+        xReturn = xBroadcastPublish(s_xChannel, pxReading, portMAX_DELAY);
+    }
+
+    return xReturn;
+}
+
+static BaseType_t CreateObjects(void)
+{
+    BaseType_t xReturn = pdPASS;
+    uint32_t i;
+
+    if(s_u32Mode == BENCH_MODE_QUEUES)
+    {
+        for(i = 0; i < BENCH_CONSUMERS; i++)
+        {
+            s_axQueues[i] = xQueueCreate((i == BENCH_DISPLAY) ? 1 : BENCH_LENGTH, sizeof(Reading_t));
+            if(s_axQueues[i] == NULL)
+                xReturn = pdFAIL;
+        }
+    }
+    else
+    {
+        s_xChannel = xBroadcastCreate(BENCH_LENGTH, sizeof(Reading_t));
+        if(s_xChannel == NULL)
+            xReturn = pdFAIL;
+        else
+        {
+            for(i = 0; i < BENCH_CONSUMERS; i++)
+                vBroadcastSubscribe(s_xChannel, &s_axSubscribers[i],
+                                    (i == BENCH_DISPLAY) ? eBroadcastLatest : eBroadcastLossless);
+        }
+    }
+
+    return xReturn;
+}
+
+static void DeleteObjects(void)
+{
+    uint32_t i;
+
+    if(s_u32Mode == BENCH_MODE_QUEUES)
+    {
+        for(i = 0; i < BENCH_CONSUMERS; i++)
+        {
+            if(s_axQueues[i] != NULL)
+                vQueueDelete(s_axQueues[i]);
+            s_axQueues[i] = NULL;
+        }
+    }
+    else if(s_xChannel != NULL)
+    {
+        for(i = 0; i < BENCH_CONSUMERS; i++)
+            vBroadcastUnsubscribe(&s_axSubscribers[i]);
+        vBroadcastDelete(s_xChannel);
+        s_xChannel = NULL;
+    }
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    Reading_t xReading = { 0 };
+    BenchStats_t xPublish;
+    uint32_t i, u32Start;
+    size_t xHeapBefore;
+
+    s_u32Mode = u32Mode;
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    if(CreateObjects() != pdPASS)
+    {
+        printf("%-9s skipped, out of heap\n", pcName);
+        DeleteObjects();
+        return;
+    }
+    printf("%-9s heap=%4u bytes\n", pcName, (unsigned int)(xHeapBefore - xPortGetFreeHeapSize()));
+
+    for(i = 0; i < BENCH_CONSUMERS; i++)
+    {
+        s_axStats[i].u32Received = 0;
+        s_axStats[i].u32Skipped = 0;
+        (void)xTaskCreate(ConsumerTask, "BCc", 80, (void *)i, BENCH_CONSUMER_PRIORITY, &s_axConsumerTasks[i]);
+    }
+
+    /* Let every consumer block. */
+    vTaskDelay(2);
+
+    BenchStatsReset(&xPublish);
+    for(i = 0; i < BENCH_READINGS; i++)
+    {
+        xReading.u32Sequence = i;
+        xReading.ai16Sample[0] = (int16_t)i;
+
+        /* The consumers run below this task, so none runs during the publish
+           and the time includes unblocking every waiting consumer. */
+        u32Start = BENCH_NOW();
+        (void)Publish(&xReading);
+        BenchStatsRecord(&xPublish, BENCH_SINCE(u32Start));
+
+        vTaskDelay(1);
+    }
+
+    /* Let the display consumer take the last reading. */
+    vTaskDelay(BENCH_DISPLAY_TICKS * 2);
+
+    printf("%-9s ", pcName);
+    BenchStatsPrint("publish", &xPublish);
+    for(i = 0; i < BENCH_CONSUMERS; i++)
+    {
+        vTaskDelete(s_axConsumerTasks[i]);
+        printf("%-9s %-7s received=%4u skipped=%4u\n", pcName, s_apcConsumerNames[i],
+               (unsigned int)s_axStats[i].u32Received, (unsigned int)s_axStats[i].u32Skipped);
+    }
+
+    DeleteObjects();
+
+    /* Let the idle task free the consumers. */
+    vTaskDelay(2);
+}
+
+static void BroadcastBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    printf("reading %u bytes, %u readings of %u consumers\n", (unsigned int)sizeof(Reading_t),
+           (unsigned int)BENCH_READINGS, (unsigned int)BENCH_CONSUMERS);
+
+    BenchRun(BENCH_MODE_QUEUES, "queues");
+    BenchRun(BENCH_MODE_BROADCAST, "broadcast");
+
+    vTaskDelete(NULL);
+}
+
+void vBroadcastBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    (void)xTaskCreate(BroadcastBenchTask, "BCBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_BROADCAST_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * @file     budget_bench.c
+ * @version  V1.00
+ * @brief    A runaway sensor task held to its budget.
+ *
+ * To use it, set configUSE_TASK_BUDGETS and configUSE_BUDGET_BENCH to 1 in
+ * FreeRTOSConfig.h.  TIMER2, which the kernel reads to measure the budgets,
+ * free-runs at the HIRC frequency, which is also HCLK, so budgets are in CPU
+ * cycles.
+ *
+ * A sensor task runs above a display task, which draws a frame every
+ * BENCH_DISPLAY_TICKS ticks, and a comms task, which sends a packet every
+ * tick.  The sensor task has gone wrong and never blocks.  For BENCH_RUN_TICKS
+ * ticks each, the sensor task runs first without a budget, then with a budget
+ * of BENCH_BUDGET_TICKS ticks in every BENCH_PERIOD_TICKS ticks, demoted to
+ * configBUDGET_DEMOTED_PRIORITY and then suspended once it is used up.  The
+ * frames and packets completed, the latest frame in ticks, the times the
+ * sensor task used up its budget and the loops it ran are printed for each.
+ * Without a budget the display and comms tasks do not run at all.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#if (configUSE_TASK_BUDGETS == 1) && (configUSE_BUDGET_BENCH == 1)
+
+#define BENCH_RUN_TICKS         1000
+#define BENCH_PERIOD_TICKS      10
+#define BENCH_BUDGET_TICKS      2
+#define BENCH_DISPLAY_TICKS     5
+#define BENCH_DISPLAY_LOOPS     2000    /* Busy loops to draw each frame. */
+#define BENCH_COUNTS_PER_TICK   (__HIRC / configTICK_RATE_HZ)
+#define BENCH_COMMS_PRIORITY    1
+#define BENCH_DISPLAY_PRIORITY  2
+#define BENCH_SENSOR_PRIORITY   3
+#define BENCH_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+
+enum
+{
+    BENCH_MODE_NO_BUDGET,
+    BENCH_MODE_DEMOTE,
+    BENCH_MODE_SUSPEND
+};
+
+static volatile uint32_t s_u32SensorLoops;
+static volatile uint32_t s_u32Frames, s_u32MaxFrameLateness;
+static volatile uint32_t s_u32Packets;
+static volatile uint32_t s_u32HookCalls;
+
+/* Called from the tick interrupt each time a budget is used up. */
+void vApplicationBudgetExhaustedHook(TaskHandle_t xTask)
+{
+    (void)xTask;
+
+    s_u32HookCalls++;
+}
+
+static void SensorTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    /* Never blocks. */
+    for(;;)
+    {
+        s_u32SensorLoops++;
+    }
+}
+
+static void DisplayTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    uint32_t u32Lateness;
+    volatile uint32_t i;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, BENCH_DISPLAY_TICKS);
+
+        u32Lateness = xTaskGetTickCount() - xLastWake;
+        if(u32Lateness > s_u32MaxFrameLateness)
+            s_u32MaxFrameLateness = u32Lateness;
+
+        for(i = 0; i < BENCH_DISPLAY_LOOPS; i++)
+        {
+        }
+        s_u32Frames++;
+    }
+}
+
+static void CommsTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(1);
+        s_u32Packets++;
+    }
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    TaskHandle_t xSensor, xDisplay, xComms;
+    TaskBudgetStats_t xStats;
+
+    s_u32SensorLoops = 0;
+    s_u32Frames = 0;
+    s_u32MaxFrameLateness = 0;
+    s_u32Packets = 0;
+    s_u32HookCalls = 0;
+
+    (void)xTaskCreate(CommsTask, "Comms", 80, NULL, BENCH_COMMS_PRIORITY, &xComms);
+    (void)xTaskCreate(DisplayTask, "Disp", 80, NULL, BENCH_DISPLAY_PRIORITY, &xDisplay);
+    (void)xTaskCreate(SensorTask, "Sensor", 80, NULL, BENCH_SENSOR_PRIORITY, &xSensor);
+
+    /* None of them runs until this task blocks. */
+    if(u32Mode != BENCH_MODE_NO_BUDGET)
+        vTaskSetBudget(xSensor, BENCH_BUDGET_TICKS * BENCH_COUNTS_PER_TICK, BENCH_PERIOD_TICKS,
+                       (u32Mode == BENCH_MODE_DEMOTE) ? eBudgetDemote : eBudgetSuspend);
+
+    vTaskDelay(BENCH_RUN_TICKS);
+
+    vTaskGetBudgetStats(xSensor, &xStats);
+    vTaskDelete(xSensor);
+    vTaskDelete(xDisplay);
+    vTaskDelete(xComms);
+
+    printf("%-9s frames=%4u latest=%4u ticks packets=%4u exhausted=%3u hook=%3u sensor loops=%u\n", pcName,
+           (unsigned int)s_u32Frames, (unsigned int)s_u32MaxFrameLateness, (unsigned int)s_u32Packets,
+           (unsigned int)xStats.ulExhaustions, (unsigned int)s_u32HookCalls, (unsigned int)s_u32SensorLoops);
+}
+
+static void BudgetBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    printf("%u ticks per run, sensor budget %u of every %u ticks\n", (unsigned int)BENCH_RUN_TICKS,
+           (unsigned int)BENCH_BUDGET_TICKS, (unsigned int)BENCH_PERIOD_TICKS);
+
+    BenchRun(BENCH_MODE_NO_BUDGET, "no budget");
+    BenchRun(BENCH_MODE_DEMOTE, "demote");
+    BenchRun(BENCH_MODE_SUSPEND, "suspend");
+
+    vTaskDelete(NULL);
+}
+
+void vBudgetBenchStart(void)
+{
+    /* The kernel reads TIMER2 when the scheduler starts. */
+    BenchTimerInit(TIMER2);
+
+    (void)xTaskCreate(BudgetBenchTask, "BgBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_BUDGET_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * @file     ceiling_mutex_check.c
+ * @version  V1.00
+ * @brief    Self check of priority ceiling mutexes.
+ *
+ * To use it, include lean_mutex.c in the build and set
+ * configUSE_LEAN_MUTEXES, configUSE_CEILING_MUTEXES and
+ * configUSE_CEILING_MUTEX_CHECK to 1 in FreeRTOSConfig.h.
+ *
+ * The check task runs at CHECK_TASK_PRIORITY and uses two ceiling mutexes
+ * with different ceilings.  It checks the priority it runs at while taking and
+ * giving them nested, while its priority is changed with vTaskPrioritySet()
+ * as it holds one, and that a higher priority task that uses a mutex cannot
+ * preempt the holder until the mutex is given.  Each step prints PASS or FAIL,
+ * followed by the number of failures.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lean_mutex.h"
+
+#if (configUSE_CEILING_MUTEXES == 1) && (configUSE_CEILING_MUTEX_CHECK == 1)
+
+#define CHECK_TASK_PRIORITY     1
+#define CHECK_USER_PRIORITY     2
+#define CHECK_LOW_CEILING       2
+#define CHECK_HIGH_CEILING      3
+#define CHECK_HOLD_TICKS        5
+
+static CeilingMutex_t s_xLowMutex = ceilingMUTEX_INITIALISER(CHECK_LOW_CEILING);
+static CeilingMutex_t s_xHighMutex = ceilingMUTEX_INITIALISER(CHECK_HIGH_CEILING);
+
+static TaskHandle_t s_xUserTask;
+static volatile uint32_t s_u32UserRuns;
+static uint32_t s_u32Failures;
+
+static void CheckPriority(const char *pcStep, UBaseType_t uxExpected)
+{
+    UBaseType_t uxPriority = uxTaskPriorityGet(NULL);
+
+    if(uxPriority == uxExpected)
+    {
+        printf("PASS %-28s priority %u\n", pcStep, (unsigned int)uxPriority);
+    }
+    else
+    {
+        printf("FAIL %-28s priority %u, expected %u\n", pcStep, (unsigned int)uxPriority, (unsigned int)uxExpected);
+        s_u32Failures++;
+    }
+}
+
+static void CheckTrue(const char *pcStep, BaseType_t xCondition)
+{
+    if(xCondition != pdFALSE)
+    {
+        printf("PASS %s\n", pcStep);
+    }
+    else
+    {
+        printf("FAIL %s\n", pcStep);
+        s_u32Failures++;
+    }
+}
+
+/* Takes the high ceiling mutex each time it is notified. */
+static void UserTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        s_u32UserRuns++;
+        (void)xCeilingMutexTake(&s_xHighMutex, portMAX_DELAY);
+        (void)xCeilingMutexGive(&s_xHighMutex);
+    }
+}
+
+static void CheckNesting(void)
+{
+    (void)xCeilingMutexTake(&s_xLowMutex, portMAX_DELAY);
+    CheckPriority("take low", CHECK_LOW_CEILING);
+
+    (void)xCeilingMutexTake(&s_xHighMutex, portMAX_DELAY);
+    CheckPriority("take high inside low", CHECK_HIGH_CEILING);
+
+    (void)xCeilingMutexGive(&s_xHighMutex);
+    CheckPriority("give high", CHECK_LOW_CEILING);
+
+    (void)xCeilingMutexGive(&s_xLowMutex);
+    CheckPriority("give low", CHECK_TASK_PRIORITY);
+
+    /* A lower ceiling inside a higher one does not lower the priority. */
+    (void)xCeilingMutexTake(&s_xHighMutex, portMAX_DELAY);
+    (void)xCeilingMutexTake(&s_xLowMutex, portMAX_DELAY);
+    CheckPriority("take low inside high", CHECK_HIGH_CEILING);
+
+    (void)xCeilingMutexGive(&s_xLowMutex);
+    CheckPriority("give low", CHECK_HIGH_CEILING);
+
+    (void)xCeilingMutexGive(&s_xHighMutex);
+    CheckPriority("give high", CHECK_TASK_PRIORITY);
+}
+
+static void CheckPrioritySet(void)
+{
+    /* Lowered while holding - the ceiling applies until the give. */
+    (void)xCeilingMutexTake(&s_xLowMutex, portMAX_DELAY);
+    vTaskPrioritySet(NULL, tskIDLE_PRIORITY);
+    CheckPriority("set below ceiling", CHECK_LOW_CEILING);
+    (void)xCeilingMutexGive(&s_xLowMutex);
+    CheckPriority("give after set below", tskIDLE_PRIORITY);
+    vTaskPrioritySet(NULL, CHECK_TASK_PRIORITY);
+
+    /* Raised above the ceiling while holding - takes effect at once. */
+    (void)xCeilingMutexTake(&s_xLowMutex, portMAX_DELAY);
+    vTaskPrioritySet(NULL, CHECK_HIGH_CEILING);
+    CheckPriority("set above ceiling", CHECK_HIGH_CEILING);
+    (void)xCeilingMutexGive(&s_xLowMutex);
+    CheckPriority("give after set above", CHECK_HIGH_CEILING);
+    vTaskPrioritySet(NULL, CHECK_TASK_PRIORITY);
+    CheckPriority("set back", CHECK_TASK_PRIORITY);
+}
+
+static void CheckPreemption(void)
+{
+    TickType_t xStart;
+    uint32_t u32Runs;
+
+    (void)xCeilingMutexTake(&s_xHighMutex, portMAX_DELAY);
+
+    /* The user task has a higher priority than this task, but not higher
+       than the ceiling, so it must not run while the mutex is held. */
+    u32Runs = s_u32UserRuns;
+    xTaskNotifyGive(s_xUserTask);
+    xStart = xTaskGetTickCount();
+    while((xTaskGetTickCount() - xStart) < CHECK_HOLD_TICKS)
+    {
+    }
+    CheckTrue("no preemption while held", s_u32UserRuns == u32Runs);
+
+    (void)xCeilingMutexGive(&s_xHighMutex);
+    CheckTrue("preempted on give", s_u32UserRuns == (u32Runs + 1));
+}
+
+static void CeilingMutexCheckTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    CheckNesting();
+    CheckPrioritySet();
+    CheckPreemption();
+
+    printf("ceiling mutex check: %u failures\n", (unsigned int)s_u32Failures);
+
+    vTaskDelete(s_xUserTask);
+    vTaskDelete(NULL);
+}
+
+void vCeilingMutexCheckStart(void)
+{
+    (void)xTaskCreate(CeilingMutexCheckTask, "CMChk", 160, NULL, CHECK_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(UserTask, "CMusr", 80, NULL, CHECK_USER_PRIORITY, &s_xUserTask);
+}
+
+#endif /* configUSE_CEILING_MUTEX_CHECK */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * @file     croutine_bench.c
+ * @version  V1.00
+ * @brief    RAM used by state machines written as co-routines and as tasks.
+ *
+ * To use it, set configUSE_CO_ROUTINES, configUSE_CO_ROUTINE_HOST and
+ * configUSE_CROUTINE_BENCH to 1 in FreeRTOSConfig.h.
+ *
+ * BENCH_MACHINES protocol state machines, each stepping every few ticks, are
+ * created first as co-routines run by the host task, and then as tasks with
+ * configMINIMAL_STACK_SIZE words of stack.  Each design runs for
+ * BENCH_RUN_TICKS ticks, and then the heap it took and the least free stack
+ * of the tasks it uses, from the high-water marks, are printed.  The
+ * co-routines must be created before the scheduler starts, so they keep
+ * running while the tasks are measured; the step counts are kept apart.  The tasks are skipped if they cannot
+ * be allocated.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "croutine.h"
+
+#if (configUSE_CO_ROUTINE_HOST == 1) && (configUSE_CROUTINE_BENCH == 1)
+
+#if (configUSE_TRACE_FACILITY != 1)
+#error croutine_bench.c reads the stack high-water marks with uxTaskGetSystemState()
+#endif
+
+#define BENCH_MACHINES          4
+#define BENCH_STEP_TICKS        5
+#define BENCH_RUN_TICKS         1000
+#define BENCH_HOST_STACK        80
+#define BENCH_MAX_TASKS         12
+#define BENCH_MACHINE_PRIORITY  1
+#define BENCH_TASK_PRIORITY     2
+
+static TaskStatus_t s_axStatus[BENCH_MAX_TASKS];
+static TaskHandle_t s_axMachineTasks[BENCH_MACHINES];
+static volatile uint32_t s_au32CoRoutineSteps[BENCH_MACHINES], s_au32TaskSteps[BENCH_MACHINES];
+static size_t s_xHostHeap, s_xCoRoutineHeap;
+
+static void MachineCoRoutine(CoRoutineHandle_t xHandle, UBaseType_t uxIndex)
+{
+    crSTART(xHandle);
+
+    for(;;)
+    {
+        s_au32CoRoutineSteps[uxIndex]++;
+        crDELAY(xHandle, BENCH_STEP_TICKS + uxIndex);
+    }
+
+    crEND();
+}
+
+static void MachineTask(void *pvParameters)
+{
+    uint32_t u32Index = (uint32_t)pvParameters;
+
+    for(;;)
+    {
+        s_au32TaskSteps[u32Index]++;
+        vTaskDelay(BENCH_STEP_TICKS + u32Index);
+    }
+}
+
+/* Least free stack, in words, of the tasks called pcName. */
+static uint32_t StackMinFree(const char *pcName)
+{
+    UBaseType_t i, uxTasks;
+    uint32_t u32MinFree = 0xFFFFFFFF;
+
+    uxTasks = uxTaskGetSystemState(s_axStatus, BENCH_MAX_TASKS, NULL);
+    for(i = 0; i < uxTasks; i++)
+    {
+        if((strcmp(s_axStatus[i].pcTaskName, pcName) == 0) && (s_axStatus[i].usStackHighWaterMark < u32MinFree))
+            u32MinFree = s_axStatus[i].usStackHighWaterMark;
+    }
+
+    return u32MinFree;
+}
+
+static uint32_t StepsTaken(volatile uint32_t *pu32Steps)
+{
+    uint32_t i, u32Steps = 0;
+
+    for(i = 0; i < BENCH_MACHINES; i++)
+    {
+        u32Steps += pu32Steps[i];
+        pu32Steps[i] = 0;
+    }
+
+    return u32Steps;
+}
+
+static void CoRoutineBenchTask(void *pvParameters)
+{
+    uint32_t i;
+    size_t xHeapBefore, xTaskHeap;
+
+    (void)pvParameters;
+
+    printf("%u state machines, task stack %u words\n", (unsigned int)BENCH_MACHINES,
+           (unsigned int)configMINIMAL_STACK_SIZE);
+
+    vTaskDelay(BENCH_RUN_TICKS);
+    printf("co-routines heap=%4u bytes (host task %u, %u per co-routine) stack min free=%3u of %u words steps=%u\n",
+           (unsigned int)(s_xHostHeap + s_xCoRoutineHeap), (unsigned int)s_xHostHeap,
+           (unsigned int)(s_xCoRoutineHeap / BENCH_MACHINES), (unsigned int)StackMinFree("CoR"),
+           (unsigned int)BENCH_HOST_STACK, (unsigned int)StepsTaken(s_au32CoRoutineSteps));
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    for(i = 0; i < BENCH_MACHINES; i++)
+    {
+        if(xTaskCreate(MachineTask, "SM", configMINIMAL_STACK_SIZE, (void *)i, BENCH_MACHINE_PRIORITY,
+                       &s_axMachineTasks[i]) != pdPASS)
+        {
+            printf("tasks skipped, out of heap\n");
+            break;
+        }
+    }
+    xTaskHeap = xHeapBefore - xPortGetFreeHeapSize();
+
+    if(i == BENCH_MACHINES)
+    {
+        vTaskDelay(BENCH_RUN_TICKS);
+        printf("tasks       heap=%4u bytes (%u per task) stack min free=%3u of %u words steps=%u\n",
+               (unsigned int)xTaskHeap, (unsigned int)(xTaskHeap / BENCH_MACHINES), (unsigned int)StackMinFree("SM"),
+               (unsigned int)configMINIMAL_STACK_SIZE, (unsigned int)StepsTaken(s_au32TaskSteps));
+    }
+
+    while(i > 0)
+        vTaskDelete(s_axMachineTasks[--i]);
+
+    vTaskDelete(NULL);
+}
+
+void vCoRoutineBenchStart(void)
+{
+    uint32_t i;
+    size_t xHeapBefore;
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    (void)xCoRoutineHostCreate(BENCH_HOST_STACK, BENCH_MACHINE_PRIORITY);
+    s_xHostHeap = xHeapBefore - xPortGetFreeHeapSize();
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    for(i = 0; i < BENCH_MACHINES; i++)
+        (void)xCoRoutineCreate(MachineCoRoutine, 0, i);
+    s_xCoRoutineHeap = xHeapBefore - xPortGetFreeHeapSize();
+
+    (void)xTaskCreate(CoRoutineBenchTask, "CRB", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_CROUTINE_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
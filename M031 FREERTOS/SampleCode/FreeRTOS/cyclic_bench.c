@@ -0,0 +1,332 @@
+/******************************************************************************
+ * @file     cyclic_bench.c
+ * @version  V1.00
+ * @brief    Release jitter of a cyclic executive against vTaskDelayUntil().
+ *
+ * To use it, set configUSE_CYCLIC_BENCH to 1 in FreeRTOSConfig.h.  TIMER3
+ * interrupts at BENCH_MINOR_HZ to dispatch the executive, and TIMER0
+ * free-runs at the HIRC frequency, which is also HCLK, to time the releases.
+ *
+ * A control job runs every BENCH_PERIOD_MS milliseconds, first released by a
+ * task slot of a cyclic executive whose major frame is that period, with a
+ * function slot half way through it, and then by a task looping on
+ * vTaskDelayUntil() at the same priority.  Background tasks below it run a
+ * comms task that wakes every few ticks to work for a while, and a load task
+ * that never blocks and spends much of its time in critical sections.  For
+ * BENCH_RUN_TICKS ticks each, the time between the starts of consecutive jobs
+ * is taken, and a histogram of how far it is from the period is printed, in
+ * microseconds.  Every BENCH_LONG_EVERY jobs, one job takes longer than the
+ * period.  The executive counts it as an overrun and skips the release it
+ * overlaps, where the vTaskDelayUntil() loop starts the following jobs late
+ * until it catches up.  The intervals after a long job are not taken.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cyclic.h"
+#include "bench_common.h"
+
+#if (configUSE_CYCLIC_BENCH == 1)
+
+#define BENCH_MINOR_HZ          1000
+#define BENCH_MAJOR_FRAME       10      /* Minor frames, the period of the control job. */
+#define BENCH_PERIOD_MS         ((BENCH_MAJOR_FRAME * 1000) / BENCH_MINOR_HZ)
+#define BENCH_RUN_TICKS         5000
+#define BENCH_JOB_US            500
+#define BENCH_LONG_JOB_US       ((BENCH_PERIOD_MS * 1000) + 2000)
+#define BENCH_LONG_EVERY        100
+#define BENCH_COMMS_TICKS       3
+#define BENCH_COMMS_US          2000
+#define BENCH_CRITICAL_US       40      /* Longest critical section of the load task. */
+#define BENCH_CYCLES_PER_US     (__HIRC / 1000000)
+#define BENCH_PERIOD_CYCLES     (BENCH_PERIOD_MS * 1000 * BENCH_CYCLES_PER_US)
+#define BENCH_LOAD_PRIORITY     1
+#define BENCH_COMMS_PRIORITY    2
+#define BENCH_CONTROL_PRIORITY  3
+#define BENCH_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+
+enum
+{
+    BENCH_JOB_SLOT_TASK,
+    BENCH_JOB_SLOT_FUNCTION,
+    BENCH_JOB_DELAY_UNTIL,
+    BENCH_JOBS
+};
+
+#define BENCH_BUCKETS           8
+
+typedef struct
+{
+    uint32_t u32Last;
+    BaseType_t xHaveLast;
+    uint32_t u32Jobs;
+    uint32_t u32Max;
+    uint32_t au32Counts[BENCH_BUCKETS];
+} Histogram_t;
+
+/* Upper bounds of the buckets in microseconds.  The last bucket holds the rest. */
+static const uint32_t s_au32BucketUs[BENCH_BUCKETS - 1] = { 1, 2, 5, 10, 20, 50, 100 };
+
+static const char * const s_apcJobNames[BENCH_JOBS] = { "slot task", "slot function", "delay until" };
+
+static void SampleInputs(void *pvParameters);
+
+static CyclicSlot_t s_axSchedule[] =
+{
+    cyclicTASK_SLOT(0, BENCH_MAJOR_FRAME / 2),
+    cyclicFUNCTION_SLOT(BENCH_MAJOR_FRAME / 2, SampleInputs, NULL)
+};
+
+static Histogram_t s_axHistograms[BENCH_JOBS];
+static volatile uint32_t s_u32LateReleases;
+static volatile uint32_t s_u32HookCalls;
+
+static void MinorFrameInit(void)
+{
+    SYS_UnlockReg();
+    CLK_EnableModuleClock(TMR3_MODULE);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC, 0);
+    SYS_LockReg();
+
+    /* The minor frame.  Above SysTick and PendSV, which the port runs at the
+       lowest priority, so the tick does not delay the dispatch. */
+    (void)TIMER_Open(TIMER3, TIMER_PERIODIC_MODE, BENCH_MINOR_HZ);
+    TIMER_ClearIntFlag(TIMER3);
+    TIMER_EnableInt(TIMER3);
+    NVIC_SetPriority(TMR3_IRQn, 1);
+    NVIC_EnableIRQ(TMR3_IRQn);
+    TIMER_Start(TIMER3);
+}
+
+void TMR3_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    TIMER_ClearIntFlag(TIMER3);
+
+    vCyclicExecutiveDispatchFromISR(&xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* Called from TMR3_IRQHandler() for each slot whose work is not complete by
+   the end of the slot. */
+void vApplicationCyclicOverrunHook(CyclicSlot_t *pxSlot)
+{
+    (void)pxSlot;
+
+    s_u32HookCalls++;
+}
+
+/* Busy for u32Us microseconds, whatever interrupts and tasks take from it. */
+static void Spin(uint32_t u32Us)
+{
+    uint32_t u32Start = BENCH_NOW();
+
+    while(BENCH_SINCE(u32Start) < (u32Us * BENCH_CYCLES_PER_US))
+    {
+    }
+}
+
+static void Record(uint32_t u32Job, uint32_t u32Now)
+{
+    Histogram_t *pxHistogram = &s_axHistograms[u32Job];
+    uint32_t u32Interval, u32Us, i;
+
+    if(pxHistogram->xHaveLast != pdFALSE)
+    {
+        u32Interval = (u32Now - pxHistogram->u32Last) & BENCH_TIMER_MASK;
+        u32Us = ((u32Interval > BENCH_PERIOD_CYCLES) ? (u32Interval - BENCH_PERIOD_CYCLES) :
+                 (BENCH_PERIOD_CYCLES - u32Interval)) / BENCH_CYCLES_PER_US;
+
+        for(i = 0; i < (BENCH_BUCKETS - 1); i++)
+        {
+            if(u32Us < s_au32BucketUs[i])
+                break;
+        }
+        pxHistogram->au32Counts[i]++;
+        pxHistogram->u32Jobs++;
+
+        if(u32Us > pxHistogram->u32Max)
+            pxHistogram->u32Max = u32Us;
+    }
+
+    pxHistogram->u32Last = u32Now;
+    pxHistogram->xHaveLast = pdTRUE;
+}
+
+/* The work of one control job. */
+static void ControlJob(uint32_t u32Job, uint32_t u32Count)
+{
+    if((u32Count % BENCH_LONG_EVERY) == (BENCH_LONG_EVERY - 1))
+    {
+        Spin(BENCH_LONG_JOB_US);
+
+        /* The next interval is not a period. */
+        s_axHistograms[u32Job].xHaveLast = pdFALSE;
+    }
+    else
+    {
+        Spin(BENCH_JOB_US);
+    }
+}
+
+static void SampleInputs(void *pvParameters)
+{
+    (void)pvParameters;
+
+    Record(BENCH_JOB_SLOT_FUNCTION, BENCH_NOW());
+}
+
+static void SlotTask(void *pvParameters)
+{
+    uint32_t u32Count = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)xCyclicExecutiveWaitForRelease(portMAX_DELAY);
+        Record(BENCH_JOB_SLOT_TASK, BENCH_NOW());
+
+        ControlJob(BENCH_JOB_SLOT_TASK, u32Count++);
+    }
+}
+
+static void DelayUntilTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    uint32_t u32Count = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(BENCH_PERIOD_MS));
+        Record(BENCH_JOB_DELAY_UNTIL, BENCH_NOW());
+
+        if(xTaskGetTickCount() != xLastWake)
+            s_u32LateReleases++;
+
+        ControlJob(BENCH_JOB_DELAY_UNTIL, u32Count++);
+    }
+}
+
+static void CommsTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_COMMS_TICKS);
+        Spin(BENCH_COMMS_US);
+    }
+}
+
+static void LoadTask(void *pvParameters)
+{
+    uint32_t u32Seed = 1;
+
+    (void)pvParameters;
+
+    /* Never blocks. */
+    for(;;)
+    {
+        u32Seed = (u32Seed * 1103515245UL) + 12345UL;
+
+        taskENTER_CRITICAL();
+        Spin((u32Seed >> 16) % BENCH_CRITICAL_US);
+        taskEXIT_CRITICAL();
+
+        Spin(BENCH_CRITICAL_US);
+    }
+}
+
+static void PrintHistogram(uint32_t u32Job)
+{
+    Histogram_t *pxHistogram = &s_axHistograms[u32Job];
+    uint32_t i;
+
+    printf("%-13s jobs=%4u max=%5u us |", s_apcJobNames[u32Job], (unsigned int)pxHistogram->u32Jobs,
+           (unsigned int)pxHistogram->u32Max);
+    for(i = 0; i < BENCH_BUCKETS; i++)
+        printf(" %4u", (unsigned int)pxHistogram->au32Counts[i]);
+    printf("\n");
+}
+
+static void BenchReset(void)
+{
+    uint32_t i, j;
+
+    for(i = 0; i < BENCH_JOBS; i++)
+    {
+        s_axHistograms[i].xHaveLast = pdFALSE;
+        s_axHistograms[i].u32Jobs = 0;
+        s_axHistograms[i].u32Max = 0;
+        for(j = 0; j < BENCH_BUCKETS; j++)
+            s_axHistograms[i].au32Counts[j] = 0;
+    }
+
+    s_u32LateReleases = 0;
+    s_u32HookCalls = 0;
+}
+
+static void CyclicBenchTask(void *pvParameters)
+{
+    TaskHandle_t xTask;
+    uint32_t i;
+
+    (void)pvParameters;
+
+    printf("period %u ms, %u ticks per run, job %u us, every %u jobs %u us\n", (unsigned int)BENCH_PERIOD_MS,
+           (unsigned int)BENCH_RUN_TICKS, (unsigned int)BENCH_JOB_US, (unsigned int)BENCH_LONG_EVERY,
+           (unsigned int)BENCH_LONG_JOB_US);
+    printf("%-13s %-22s |", "", "distance from period");
+    for(i = 0; i < (BENCH_BUCKETS - 1); i++)
+        printf(" <%3u", (unsigned int)s_au32BucketUs[i]);
+    printf(" more\n");
+
+    (void)xTaskCreate(LoadTask, "Load", 80, NULL, BENCH_LOAD_PRIORITY, NULL);
+    (void)xTaskCreate(CommsTask, "Comms", 80, NULL, BENCH_COMMS_PRIORITY, NULL);
+
+    /* The cyclic executive. */
+    BenchReset();
+    (void)xTaskCreate(SlotTask, "Slot", 80, NULL, BENCH_CONTROL_PRIORITY, &xTask);
+    s_axSchedule[0].xTask = xTask;
+    vCyclicExecutiveStart(s_axSchedule, sizeof(s_axSchedule) / sizeof(s_axSchedule[0]), BENCH_MAJOR_FRAME);
+    vTaskDelay(BENCH_RUN_TICKS);
+    vCyclicExecutiveStop();
+    vTaskDelete(xTask);
+
+    PrintHistogram(BENCH_JOB_SLOT_TASK);
+    PrintHistogram(BENCH_JOB_SLOT_FUNCTION);
+    printf("%-13s releases=%u overruns=%u skipped=%u hook=%u\n", "", (unsigned int)ulCyclicSlotGetReleases(&s_axSchedule[0]),
+           (unsigned int)ulCyclicSlotGetOverruns(&s_axSchedule[0]), (unsigned int)ulCyclicSlotGetSkipped(&s_axSchedule[0]),
+           (unsigned int)s_u32HookCalls);
+
+    /* The vTaskDelayUntil() loop. */
+    BenchReset();
+    (void)xTaskCreate(DelayUntilTask, "DlyU", 80, NULL, BENCH_CONTROL_PRIORITY, &xTask);
+    vTaskDelay(BENCH_RUN_TICKS);
+    vTaskDelete(xTask);
+
+    PrintHistogram(BENCH_JOB_DELAY_UNTIL);
+    printf("%-13s late releases=%u\n", "", (unsigned int)s_u32LateReleases);
+
+    vTaskDelete(NULL);
+}
+
+void vCyclicBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+    MinorFrameInit();
+
+    (void)xTaskCreate(CyclicBenchTask, "CyBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_CYCLIC_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * @file     edf_bench.c
+ * @version  V1.00
+ * @brief    Deadline misses of fixed priority and EDF scheduling against load.
+ *
+ * To use it, set configUSE_EDF_SCHEDULING and configUSE_EDF_BENCH to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Two periodic tasks, with periods of 10 and 14 ticks and deadlines equal to
+ * their periods, each take half the processor load.  The load is raised in
+ * steps from 70% to 95%, and at each step the tasks run for BENCH_RUN_TICKS
+ * ticks scheduled by fixed priority, the shorter period at the higher
+ * priority, and then earliest deadline first at configEDF_PRIORITY.  The jobs
+ * completed and the deadlines missed are printed for each.  Fixed priority
+ * scheduling can miss deadlines above about 83% load, and with these periods
+ * does by 90%, where EDF should not miss any until the load approaches 100%.
+ * For the EDF runs the misses counted by the kernel are printed too.
+ *
+ * The work of each job is a busy loop calibrated against the tick, so the
+ * load is approximate.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_EDF_SCHEDULING == 1) && (configUSE_EDF_BENCH == 1)
+
+#define BENCH_WORKERS           2
+#define BENCH_RUN_TICKS         1400    /* Ten hyperperiods of 140 ticks. */
+#define BENCH_CALIBRATE_TICKS   10
+#define BENCH_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+
+typedef struct
+{
+    TickType_t xPeriod;
+    UBaseType_t uxFixedPriority;
+    uint32_t u32Loops;              /* Work per job. */
+    TaskHandle_t xHandle;
+    volatile uint32_t u32Jobs;
+    volatile uint32_t u32Misses;
+} Worker_t;
+
+static Worker_t s_axWorkers[BENCH_WORKERS] =
+{
+    { 10, configMAX_PRIORITIES - 2, 0, NULL, 0, 0 },
+    { 14, configMAX_PRIORITIES - 3, 0, NULL, 0, 0 }
+};
+
+static const uint32_t s_au32LoadPercent[] = { 70, 80, 90, 95 };
+
+static volatile BaseType_t s_xUseDeadlines;
+static volatile TickType_t s_xStart;
+static uint32_t s_u32LoopsPerTick;
+
+static void Work(uint32_t u32Loops)
+{
+    volatile uint32_t i;
+
+    for(i = 0; i < u32Loops; i++)
+    {
+    }
+}
+
+/* Loops of Work() per tick, measured at the highest priority. */
+static uint32_t Calibrate(void)
+{
+    TickType_t xTick;
+    uint32_t u32Loops = 0;
+
+    /* Start on a tick boundary. */
+    xTick = xTaskGetTickCount();
+    while(xTaskGetTickCount() == xTick)
+    {
+    }
+
+    xTick = xTaskGetTickCount();
+    while((xTaskGetTickCount() - xTick) < BENCH_CALIBRATE_TICKS)
+    {
+        Work(100);
+        u32Loops += 100;
+    }
+
+    return u32Loops / BENCH_CALIBRATE_TICKS;
+}
+
+static void WorkerTask(void *pvParameters)
+{
+    Worker_t *pxWorker = (Worker_t *)pvParameters;
+    TickType_t xLastWake, xRelease;
+
+    /* Each job's deadline is its next release. */
+    if(s_xUseDeadlines != pdFALSE)
+        vTaskSetDeadline(NULL, pxWorker->xPeriod, pxWorker->xPeriod);
+
+    /* Release the first job at s_xStart. */
+    xLastWake = s_xStart - pxWorker->xPeriod;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, pxWorker->xPeriod);
+        xRelease = xLastWake;
+
+        Work(pxWorker->u32Loops);
+
+        pxWorker->u32Jobs++;
+        if((xTaskGetTickCount() - xRelease) > pxWorker->xPeriod)
+            pxWorker->u32Misses++;
+    }
+}
+
+static void BenchRun(uint32_t u32Load, BaseType_t xUseDeadlines)
+{
+    uint32_t i, u32Jobs = 0, u32Misses = 0, u32KernelMisses = 0, u32TaskMisses;
+    TickType_t xEnd;
+
+    s_xUseDeadlines = xUseDeadlines;
+    s_xStart = xTaskGetTickCount() + 2;
+
+    for(i = 0; i < BENCH_WORKERS; i++)
+    {
+        /* Half of the load each. */
+        s_axWorkers[i].u32Loops = (s_u32LoopsPerTick * s_axWorkers[i].xPeriod * u32Load) / (100 * BENCH_WORKERS);
+        s_axWorkers[i].u32Jobs = 0;
+        s_axWorkers[i].u32Misses = 0;
+        (void)xTaskCreate(WorkerTask, "EDFw", 80, &s_axWorkers[i],
+                          (xUseDeadlines != pdFALSE) ? configEDF_PRIORITY : s_axWorkers[i].uxFixedPriority,
+                          &s_axWorkers[i].xHandle);
+    }
+
+    xEnd = s_xStart;
+    vTaskDelayUntil(&xEnd, BENCH_RUN_TICKS);
+
+    for(i = 0; i < BENCH_WORKERS; i++)
+    {
+        if(xUseDeadlines != pdFALSE)
+        {
+            vTaskGetDeadlineStats(s_axWorkers[i].xHandle, NULL, &u32TaskMisses);
+            u32KernelMisses += u32TaskMisses;
+        }
+
+        vTaskDelete(s_axWorkers[i].xHandle);
+        u32Jobs += s_axWorkers[i].u32Jobs;
+        u32Misses += s_axWorkers[i].u32Misses;
+    }
+
+    if(xUseDeadlines != pdFALSE)
+        printf("load %2u%% EDF:            jobs=%4u missed=%4u (kernel %u)\n", (unsigned int)u32Load,
+               (unsigned int)u32Jobs, (unsigned int)u32Misses, (unsigned int)u32KernelMisses);
+    else
+        printf("load %2u%% fixed priority: jobs=%4u missed=%4u\n", (unsigned int)u32Load,
+               (unsigned int)u32Jobs, (unsigned int)u32Misses);
+
+    /* Let the idle task free the workers. */
+    vTaskDelay(2);
+}
+
+static void EDFBenchTask(void *pvParameters)
+{
+    uint32_t i;
+
+    (void)pvParameters;
+
+    s_u32LoopsPerTick = Calibrate();
+    printf("%u work loops per tick\n", (unsigned int)s_u32LoopsPerTick);
+
+    for(i = 0; i < sizeof(s_au32LoadPercent) / sizeof(s_au32LoadPercent[0]); i++)
+    {
+        BenchRun(s_au32LoadPercent[i], pdFALSE);
+        BenchRun(s_au32LoadPercent[i], pdTRUE);
+    }
+
+    vTaskDelete(NULL);
+}
+
+void vEDFBenchStart(void)
+{
+    (void)xTaskCreate(EDFBenchTask, "EDFBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_EDF_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * @file     event_group_bench.c
+ * @version  V1.00
+ * @brief    Cost of setting event bits against the number of waiting tasks.
+ *
+ * To use it, set configUSE_EVENT_GROUP_BENCH to 1 in FreeRTOSConfig.h.  Build
+ * it with configUSE_EVENT_GROUP_INDEX set to 0 and to 1 to compare the
+ * waiting task list with the bit index.  TIMER0 free-runs at the HIRC
+ * frequency so costs are reported in HIRC cycles.
+ *
+ * For 4, 16 and 64 waiting tasks, each task waits for one of fourteen bits
+ * and clears it on exit.  The benchmark task runs above the waiting tasks, so
+ * no context switch happens inside xEventGroupSetBits() and the time measured
+ * is the time the scheduler is suspended for.  Two figures are printed: "hit"
+ * sets a bit that unblocks the tasks waiting for it, and "miss" sets
+ * BENCH_MISS_BIT, which no task waits for and which is alone in its index
+ * bucket.  A count is skipped if the tasks cannot be allocated - each takes
+ * about 350 bytes of heap, so heap_regions.c is needed for 16 tasks and 64
+ * tasks need a part with more SRAM.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "bench_common.h"
+
+#if (configUSE_EVENT_GROUP_BENCH == 1)
+
+#define BENCH_SETS              200
+#define BENCH_WAIT_BITS         14
+#define BENCH_MISS_BIT          7       /* Bucket 7 of the default 8, which no waiting task uses. */
+#define BENCH_WAITER_STACK      64
+#define BENCH_WAITER_PRIORITY   1
+#define BENCH_TASK_PRIORITY     3
+
+static const uint32_t s_au32WaiterCounts[] = { 4, 16, 64 };
+
+static TaskHandle_t s_axWaiters[64];
+static EventGroupHandle_t s_xEventGroup;
+
+/* Bits 0 to 6 and 8 to 14, leaving BENCH_MISS_BIT out. */
+static EventBits_t WaitBit(uint32_t u32Index)
+{
+    uint32_t u32Bit = u32Index % BENCH_WAIT_BITS;
+
+    return (EventBits_t)1 << (u32Bit + (u32Bit / BENCH_MISS_BIT));
+}
+
+static void WaiterTask(void *pvParameters)
+{
+    EventBits_t uxBit = (EventBits_t)(uint32_t)pvParameters;
+
+    for(;;)
+        (void)xEventGroupWaitBits(s_xEventGroup, uxBit, pdTRUE, pdFALSE, portMAX_DELAY);
+}
+
+static void TimeSet(BenchStats_t *pxStats, EventBits_t uxBits)
+{
+    uint32_t u32Start;
+
+    u32Start = BENCH_NOW();
+    (void)xEventGroupSetBits(s_xEventGroup, uxBits);
+    BenchStatsRecord(pxStats, BENCH_SINCE(u32Start));
+}
+
+static void PrintStats(uint32_t u32Count, const char *pcName, const BenchStats_t *pxStats)
+{
+    printf("%2u waiters: ", (unsigned int)u32Count);
+    BenchStatsPrint(pcName, pxStats);
+}
+
+static void DeleteWaiters(uint32_t u32Count)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32Count; i++)
+        vTaskDelete(s_axWaiters[i]);
+
+    /* Let the idle task free them. */
+    vTaskDelay(2);
+}
+
+static void BenchRun(uint32_t u32Count)
+{
+    BenchStats_t xHit, xMiss;
+    uint32_t i;
+
+    BenchStatsReset(&xHit);
+    BenchStatsReset(&xMiss);
+
+    for(i = 0; i < u32Count; i++)
+    {
+        if(xTaskCreate(WaiterTask, "EGw", BENCH_WAITER_STACK, (void *)(uint32_t)WaitBit(i), BENCH_WAITER_PRIORITY,
+                       &s_axWaiters[i]) != pdPASS)
+        {
+            printf("%2u waiters: skipped, out of heap\n", (unsigned int)u32Count);
+            DeleteWaiters(i);
+            return;
+        }
+    }
+
+    /* Let every waiter block. */
+    vTaskDelay(2);
+
+    for(i = 0; i < BENCH_SETS; i++)
+    {
+        TimeSet(&xMiss, (EventBits_t)1 << BENCH_MISS_BIT);
+        (void)xEventGroupClearBits(s_xEventGroup, (EventBits_t)1 << BENCH_MISS_BIT);
+
+        TimeSet(&xHit, WaitBit(i));
+
+        /* Let the unblocked waiters wait again. */
+        vTaskDelay(1);
+    }
+
+    PrintStats(u32Count, "hit", &xHit);
+    PrintStats(u32Count, "miss", &xMiss);
+
+    DeleteWaiters(u32Count);
+}
+
+static void EventGroupBenchTask(void *pvParameters)
+{
+    uint32_t i;
+
+    (void)pvParameters;
+
+    printf("event group waiters: %s\n", (configUSE_EVENT_GROUP_INDEX == 1) ? "indexed" : "single list");
+
+    s_xEventGroup = xEventGroupCreate();
+    if(s_xEventGroup != NULL)
+    {
+        for(i = 0; i < sizeof(s_au32WaiterCounts) / sizeof(s_au32WaiterCounts[0]); i++)
+            BenchRun(s_au32WaiterCounts[i]);
+    }
+
+    vTaskDelete(NULL);
+}
+
+void vEventGroupBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    (void)xTaskCreate(EventGroupBenchTask, "EGBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_EVENT_GROUP_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
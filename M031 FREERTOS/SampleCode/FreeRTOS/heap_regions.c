@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file     heap_regions.c
+ * @version  V1.00
+ * @brief    Builds the heap_5 region table from the linker memory map.
+ *
+ * To use it, build heap_5.c instead of heap_2.c and set
+ * configUSE_HEAP_REGIONS to 1 in FreeRTOSConfig.h.  All SRAM left over once
+ * .data, .bss and the main stack have been placed becomes heap, so the heap
+ * grows with the part's SRAM and configTOTAL_HEAP_SIZE is not used.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+
+#if (configUSE_HEAP_REGIONS == 1)
+
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+/* End of the ZI data, which also holds the STACK area of the startup file
+   when the project uses the default memory layout. */
+extern uint8_t Image$$RW_IRAM1$$ZI$$Limit[];
+/* Only exists when a scatter file places the main stack at the top of SRAM. */
+extern uint8_t Image$$ARM_LIB_STACK$$ZI$$Base[] __attribute__((weak));
+
+#define HEAP_SRAM_START     (Image$$RW_IRAM1$$ZI$$Limit)
+#define HEAP_SRAM_END       ((Image$$ARM_LIB_STACK$$ZI$$Base != NULL) ? Image$$ARM_LIB_STACK$$ZI$$Base : \
+                             (uint8_t *)(SRAM_BASE + configHEAP_SRAM_SIZE))
+#elif defined(__GNUC__)
+/* Exported by the CMSIS gcc_arm.ld linker script. */
+extern uint8_t __HeapLimit[];
+extern uint8_t __StackLimit[];
+
+#define HEAP_SRAM_START     (__HeapLimit)
+#define HEAP_SRAM_END       (__StackLimit)
+#endif
+
+/* One SRAM region plus the terminator. */
+static HeapRegion_t s_xHeapRegions[2];
+
+/*
+ * Hands all free SRAM to heap_5.  Must be called before anything is created,
+ * as creating a task, queue, timer, etc. calls pvPortMalloc().
+ */
+void vHeapRegionsInit(void)
+{
+    s_xHeapRegions[0].pucStartAddress = HEAP_SRAM_START;
+    s_xHeapRegions[0].xSizeInBytes = (size_t)(HEAP_SRAM_END - HEAP_SRAM_START);
+
+    s_xHeapRegions[1].pucStartAddress = NULL;
+    s_xHeapRegions[1].xSizeInBytes = 0;
+
+    vPortDefineHeapRegions(s_xHeapRegions);
+}
+
+#endif /* configUSE_HEAP_REGIONS */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
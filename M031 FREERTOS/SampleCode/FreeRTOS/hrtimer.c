@@ -0,0 +1,340 @@
+/******************************************************************************
+ * @file     hrtimer.c
+ * @version  V1.00
+ * @brief    Microsecond resolution one-shot and periodic timers on TIMER1.
+ *
+ * FreeRTOS software timers have tick resolution and every start or stop is a
+ * command to the timer service task.  This service instead runs TIMER1 at
+ * 1 MHz in continuous counting mode and keeps the active timers on a list
+ * sorted by deadline.  The compare register is always programmed with the
+ * earliest deadline, so the interrupt fires when the first timer is due and
+ * starting or stopping a timer is a list update with interrupts masked.
+ *
+ * Callbacks run either directly in the TIMER1 interrupt, for the lowest
+ * jitter, or in a task of priority configHRTIMER_TASK_PRIORITY that the
+ * interrupt notifies.
+ *
+ * The 24-bit counter is extended to a 32-bit microsecond time in software.
+ * The compare is never programmed more than half a counter period ahead, so
+ * the extension sees every wrap even when no timer is active.
+ *
+ * To use it, set configUSE_HRTIMER to 1 in FreeRTOSConfig.h.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hrtimer.h"
+
+#if (configUSE_HRTIMER == 1)
+
+#define HRTIMER_FREQ_HZ         1000000UL
+#define HRTIMER_COUNTER_MASK    0xFFFFFFUL
+/* Longest the compare is programmed ahead, half the counter period. */
+#define HRTIMER_MAX_SLEEP_US    0x800000UL
+/* Deadlines closer than this are programmed this far ahead instead, so the
+   counter cannot pass the compare value before it is written.  Timers can
+   therefore expire up to this late when they are due back to back. */
+#define HRTIMER_MIN_LEAD_US     4UL
+
+#define HRTIMER_FLAG_FROM_ISR   0x01
+#define HRTIMER_FLAG_ACTIVE     0x02
+#define HRTIMER_FLAG_PENDING    0x04
+
+/* Signed difference, valid while deadlines are within 2^31 us of now. */
+#define HRTIMER_DIFF(a, b)      ((int32_t)((uint32_t)(a) - (uint32_t)(b)))
+
+static HRTimer_t *s_pxActiveList;
+static HRTimer_t *s_pxPendingHead, *s_pxPendingTail;
+static TaskHandle_t s_xHRTimerTask;
+
+/* Software extension of the 24-bit counter. */
+static uint32_t s_u32TimeHigh;
+static uint32_t s_u32LastCount;
+
+/* Must be called with interrupts masked. */
+static uint32_t HRTimerNowLocked(void)
+{
+    uint32_t u32Count = TIMER1->CNT & HRTIMER_COUNTER_MASK;
+
+    if(u32Count < s_u32LastCount)
+        s_u32TimeHigh += HRTIMER_COUNTER_MASK + 1UL;
+
+    s_u32LastCount = u32Count;
+
+    return s_u32TimeHigh | u32Count;
+}
+
+/* Must be called with interrupts masked. */
+static void HRTimerProgram(uint32_t u32Now)
+{
+    int32_t i32Delta = (int32_t)HRTIMER_MAX_SLEEP_US;
+    uint32_t u32Compare;
+
+    if(s_pxActiveList != NULL)
+    {
+        if(HRTIMER_DIFF(s_pxActiveList->u32Deadline, u32Now) < i32Delta)
+            i32Delta = HRTIMER_DIFF(s_pxActiveList->u32Deadline, u32Now);
+    }
+
+    if(i32Delta < (int32_t)HRTIMER_MIN_LEAD_US)
+        i32Delta = (int32_t)HRTIMER_MIN_LEAD_US;
+
+    /* The compare register must hold a value of at least 2. */
+    u32Compare = (u32Now + (uint32_t)i32Delta) & HRTIMER_COUNTER_MASK;
+    if(u32Compare < 2UL)
+        u32Compare = 2UL;
+
+    TIMER1->CMP = u32Compare;
+}
+
+/* Must be called with interrupts masked.  Timers with equal deadlines expire
+   in the order they were started. */
+static void HRTimerInsert(HRTimer_t *pxTimer)
+{
+    HRTimer_t **ppxLink = &s_pxActiveList;
+
+    while((*ppxLink != NULL) && (HRTIMER_DIFF((*ppxLink)->u32Deadline, pxTimer->u32Deadline) <= 0))
+        ppxLink = &((*ppxLink)->pxNext);
+
+    pxTimer->pxNext = *ppxLink;
+    *ppxLink = pxTimer;
+    pxTimer->u8Flags |= HRTIMER_FLAG_ACTIVE;
+}
+
+/* Must be called with interrupts masked. */
+static void HRTimerRemove(HRTimer_t *pxTimer)
+{
+    HRTimer_t **ppxLink;
+
+    if((pxTimer->u8Flags & HRTIMER_FLAG_ACTIVE) != 0)
+    {
+        for(ppxLink = &s_pxActiveList; *ppxLink != NULL; ppxLink = &((*ppxLink)->pxNext))
+        {
+            if(*ppxLink == pxTimer)
+            {
+                *ppxLink = pxTimer->pxNext;
+                break;
+            }
+        }
+
+        pxTimer->u8Flags &= (uint8_t)~HRTIMER_FLAG_ACTIVE;
+    }
+
+    if((pxTimer->u8Flags & HRTIMER_FLAG_PENDING) != 0)
+    {
+        HRTimer_t *pxPrevious = NULL;
+
+        for(ppxLink = &s_pxPendingHead; *ppxLink != NULL; ppxLink = &((*ppxLink)->pxNextPending))
+        {
+            if(*ppxLink == pxTimer)
+            {
+                *ppxLink = pxTimer->pxNextPending;
+                if(s_pxPendingTail == pxTimer)
+                    s_pxPendingTail = pxPrevious;
+                break;
+            }
+            pxPrevious = *ppxLink;
+        }
+
+        pxTimer->u8Flags &= (uint8_t)~HRTIMER_FLAG_PENDING;
+    }
+}
+
+void TMR1_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+    HRTimer_t *pxTimer;
+    uint32_t u32Now;
+
+    TIMER_ClearIntFlag(TIMER1);
+
+    for(;;)
+    {
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+        u32Now = HRTimerNowLocked();
+        pxTimer = s_pxActiveList;
+
+        if((pxTimer == NULL) || (HRTIMER_DIFF(pxTimer->u32Deadline, u32Now) > 0))
+        {
+            /* Nothing more is due. */
+            HRTimerProgram(u32Now);
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+            break;
+        }
+
+        s_pxActiveList = pxTimer->pxNext;
+        pxTimer->u8Flags &= (uint8_t)~HRTIMER_FLAG_ACTIVE;
+
+        if(pxTimer->u32Period != 0UL)
+        {
+            /* Reload from the deadline rather than from now so the period
+               does not drift.  Expiries that have already been missed are
+               counted and skipped. */
+            pxTimer->u32Deadline += pxTimer->u32Period;
+            while(HRTIMER_DIFF(pxTimer->u32Deadline, u32Now) <= 0)
+            {
+                pxTimer->u32Deadline += pxTimer->u32Period;
+                pxTimer->u32Overruns++;
+            }
+            HRTimerInsert(pxTimer);
+        }
+
+        if((pxTimer->u8Flags & HRTIMER_FLAG_FROM_ISR) == 0)
+        {
+            if((pxTimer->u8Flags & HRTIMER_FLAG_PENDING) == 0)
+            {
+                pxTimer->u8Flags |= HRTIMER_FLAG_PENDING;
+                pxTimer->pxNextPending = NULL;
+                if(s_pxPendingTail == NULL)
+                    s_pxPendingHead = pxTimer;
+                else
+                    s_pxPendingTail->pxNextPending = pxTimer;
+                s_pxPendingTail = pxTimer;
+            }
+            else
+            {
+                /* The task has not handled the previous expiry yet. */
+                pxTimer->u32Overruns++;
+            }
+            pxTimer = NULL;
+        }
+
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+        if(pxTimer != NULL)
+            pxTimer->pxCallback(pxTimer, pxTimer->pvContext);
+        else
+            vTaskNotifyGiveFromISR(s_xHRTimerTask, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void HRTimerTask(void *pvParameters)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    HRTimer_t *pxTimer;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for(;;)
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            pxTimer = s_pxPendingHead;
+            if(pxTimer != NULL)
+            {
+                s_pxPendingHead = pxTimer->pxNextPending;
+                if(s_pxPendingHead == NULL)
+                    s_pxPendingTail = NULL;
+                pxTimer->u8Flags &= (uint8_t)~HRTIMER_FLAG_PENDING;
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+            if(pxTimer == NULL)
+                break;
+
+            pxTimer->pxCallback(pxTimer, pxTimer->pvContext);
+        }
+    }
+}
+
+void vHRTimerInit(void)
+{
+    SYS_UnlockReg();
+    CLK_EnableModuleClock(TMR1_MODULE);
+    CLK_SetModuleClock(TMR1_MODULE, CLK_CLKSEL1_TMR1SEL_HIRC, 0);
+    SYS_LockReg();
+
+    /* Continuous counting at 1 MHz.  Writes to CMP take effect at once in
+       this mode without resetting the counter. */
+    TIMER1->CTL = TIMER_CONTINUOUS_MODE | ((__HIRC / HRTIMER_FREQ_HZ) - 1UL);
+    TIMER1->CMP = HRTIMER_MAX_SLEEP_US;
+    TIMER_ClearIntFlag(TIMER1);
+    TIMER_EnableInt(TIMER1);
+
+    /* Above SysTick and PendSV, which the port runs at the lowest priority. */
+    NVIC_SetPriority(TMR1_IRQn, 1);
+    NVIC_EnableIRQ(TMR1_IRQn);
+
+    (void)xTaskCreate(HRTimerTask, "HRT", configMINIMAL_STACK_SIZE + 40, NULL, configHRTIMER_TASK_PRIORITY, &s_xHRTimerTask);
+
+    TIMER_Start(TIMER1);
+}
+
+void vHRTimerCreate(HRTimer_t *pxTimer, HRTimerCallback_t pxCallback, void *pvContext, BaseType_t xFromISR)
+{
+    pxTimer->pxNext = NULL;
+    pxTimer->pxNextPending = NULL;
+    pxTimer->pxCallback = pxCallback;
+    pxTimer->pvContext = pvContext;
+    pxTimer->u32Deadline = 0;
+    pxTimer->u32Period = 0;
+    pxTimer->u32Overruns = 0;
+    pxTimer->u8Flags = (xFromISR != pdFALSE) ? HRTIMER_FLAG_FROM_ISR : 0;
+}
+
+/* The Cortex-M0 port's interrupt mask functions are safe to call from both
+   tasks and interrupts, so one implementation serves both. */
+void vHRTimerStart(HRTimer_t *pxTimer, uint32_t u32DelayUs, uint32_t u32PeriodUs)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t u32Now;
+
+    /* Deadlines are compared as signed differences. */
+    configASSERT(u32DelayUs < 0x80000000UL);
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        HRTimerRemove(pxTimer);
+
+        u32Now = HRTimerNowLocked();
+        pxTimer->u32Deadline = u32Now + u32DelayUs;
+        pxTimer->u32Period = u32PeriodUs;
+        HRTimerInsert(pxTimer);
+
+        /* Only a new earliest deadline needs the compare moving. */
+        if(s_pxActiveList == pxTimer)
+            HRTimerProgram(u32Now);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+void vHRTimerStop(HRTimer_t *pxTimer)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* The compare is left as it is - if it was for this timer the interrupt
+       finds nothing due and reprograms it. */
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        HRTimerRemove(pxTimer);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+uint32_t ulHRTimerNow(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t u32Now;
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        u32Now = HRTimerNowLocked();
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+    return u32Now;
+}
+
+#endif /* configUSE_HRTIMER */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
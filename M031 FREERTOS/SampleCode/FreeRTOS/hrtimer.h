@@ -0,0 +1,65 @@
+/******************************************************************************
+ * @file     hrtimer.h
+ * @version  V1.00
+ * @brief    Microsecond resolution one-shot and periodic timers on TIMER1.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __HRTIMER_H__
+#define __HRTIMER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct HRTimer;
+
+/* Called when a timer expires, either from the TIMER1 interrupt or from the
+   high resolution timer task depending on how the timer was created.
+   Interrupt callbacks may only use FromISR APIs. */
+typedef void (*HRTimerCallback_t)(struct HRTimer *pxTimer, void *pvContext);
+
+/* Timer control block.  Declared by the application and initialised with
+   vHRTimerCreate(); the members are private to hrtimer.c. */
+typedef struct HRTimer
+{
+    struct HRTimer *pxNext;         /* Next timer in deadline order. */
+    struct HRTimer *pxNextPending;  /* Next timer waiting for the timer task. */
+    HRTimerCallback_t pxCallback;
+    void *pvContext;
+    uint32_t u32Deadline;           /* Expiry time in microseconds. */
+    uint32_t u32Period;             /* Reload in microseconds, 0 for one-shot. */
+    uint32_t u32Overruns;           /* Expiries lost because the previous one was still being handled. */
+    uint8_t u8Flags;
+} HRTimer_t;
+
+/* Pass as xFromISR to run the callback from the TIMER1 interrupt. */
+#define HRTIMER_CALLBACK_FROM_ISR       1
+#define HRTIMER_CALLBACK_FROM_TASK      0
+
+/* Configure TIMER1 and create the timer task.  Call before the scheduler is
+   started. */
+void vHRTimerInit(void);
+
+void vHRTimerCreate(HRTimer_t *pxTimer, HRTimerCallback_t pxCallback, void *pvContext, BaseType_t xFromISR);
+
+/* Start, or restart, a timer to expire u32DelayUs from now and then every
+   u32PeriodUs, or only once if u32PeriodUs is 0.  Can be called from tasks,
+   interrupts and timer callbacks. */
+void vHRTimerStart(HRTimer_t *pxTimer, uint32_t u32DelayUs, uint32_t u32PeriodUs);
+
+/* Stop a timer.  A task callback that is queued but has not run yet is
+   discarded. */
+void vHRTimerStop(HRTimer_t *pxTimer);
+
+/* Microseconds since vHRTimerInit(), wrapping at 2^32. */
+uint32_t ulHRTimerNow(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HRTIMER_H__ */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
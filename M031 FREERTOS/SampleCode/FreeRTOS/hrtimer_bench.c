@@ -0,0 +1,159 @@
+/******************************************************************************
+ * @file     hrtimer_bench.c
+ * @version  V1.00
+ * @brief    Period jitter of high resolution timers against software timers.
+ *
+ * To use it, set both configUSE_HRTIMER and configUSE_HRTIMER_BENCH to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Three 1 ms periodic timers time stamp each of their callbacks with
+ * ulHRTimerNow(): a high resolution timer with an interrupt callback, one with
+ * a task callback, and a FreeRTOS software timer with a one tick period.  The
+ * deviation of every interval from 1000 us is accumulated, and once a second
+ * the minimum, maximum and mean absolute deviation of each are printed and
+ * reset.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "hrtimer.h"
+
+#if (configUSE_HRTIMER == 1) && (configUSE_HRTIMER_BENCH == 1)
+
+#define BENCH_PERIOD_US     1000UL
+
+typedef struct
+{
+    const char *pcName;
+    uint32_t u32Last;       /* Time stamp of the previous callback, 0 before the first. */
+    uint32_t u32Count;
+    int32_t i32MinDev;
+    int32_t i32MaxDev;
+    uint32_t u32SumAbsDev;
+} JitterStats_t;
+
+static JitterStats_t s_xIsrStats = { "hr isr", 0, 0, 0, 0, 0 };
+static JitterStats_t s_xTaskStats = { "hr task", 0, 0, 0, 0, 0 };
+static JitterStats_t s_xTickStats = { "tick", 0, 0, 0, 0, 0 };
+
+static HRTimer_t s_xIsrTimer, s_xTaskTimer;
+
+/* Called with the stats protected from the reporting task - from an
+   interrupt, or from a task with the scheduler suspended. */
+static void JitterRecord(JitterStats_t *pxStats, uint32_t u32Now)
+{
+    int32_t i32Dev;
+
+    if(pxStats->u32Last != 0UL)
+    {
+        i32Dev = (int32_t)(u32Now - pxStats->u32Last) - (int32_t)BENCH_PERIOD_US;
+
+        if((pxStats->u32Count == 0UL) || (i32Dev < pxStats->i32MinDev))
+            pxStats->i32MinDev = i32Dev;
+        if((pxStats->u32Count == 0UL) || (i32Dev > pxStats->i32MaxDev))
+            pxStats->i32MaxDev = i32Dev;
+
+        pxStats->u32SumAbsDev += (uint32_t)((i32Dev < 0) ? -i32Dev : i32Dev);
+        pxStats->u32Count++;
+    }
+
+    pxStats->u32Last = u32Now;
+}
+
+static void IsrTimerCallback(HRTimer_t *pxTimer, void *pvContext)
+{
+    (void)pxTimer;
+    (void)pvContext;
+
+    JitterRecord(&s_xIsrStats, ulHRTimerNow());
+}
+
+static void TaskTimerCallback(HRTimer_t *pxTimer, void *pvContext)
+{
+    uint32_t u32Now = ulHRTimerNow();
+
+    (void)pxTimer;
+    (void)pvContext;
+
+    vTaskSuspendAll();
+    JitterRecord(&s_xTaskStats, u32Now);
+    (void)xTaskResumeAll();
+}
+
+static void TickTimerCallback(TimerHandle_t xTimer)
+{
+    uint32_t u32Now = ulHRTimerNow();
+
+    (void)xTimer;
+
+    vTaskSuspendAll();
+    JitterRecord(&s_xTickStats, u32Now);
+    (void)xTaskResumeAll();
+}
+
+static void JitterTakeAndReset(JitterStats_t *pxStats, JitterStats_t *pxCopy)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* Masking interrupts also keeps the task callbacks out, as they cannot
+       be switched in. */
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    *pxCopy = *pxStats;
+    pxStats->u32Count = 0;
+    pxStats->u32SumAbsDev = 0;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+static void JitterPrint(JitterStats_t *pxStats)
+{
+    JitterStats_t xCopy;
+
+    JitterTakeAndReset(pxStats, &xCopy);
+
+    if(xCopy.u32Count != 0UL)
+    {
+        printf("%-8s n=%4u min=%+5d max=%+5d mean|dev|=%4u us\n", xCopy.pcName, (unsigned int)xCopy.u32Count,
+               (int)xCopy.i32MinDev, (int)xCopy.i32MaxDev, (unsigned int)(xCopy.u32SumAbsDev / xCopy.u32Count));
+    }
+}
+
+static void JitterReportTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+
+        JitterPrint(&s_xIsrStats);
+        JitterPrint(&s_xTaskStats);
+        JitterPrint(&s_xTickStats);
+        printf("overruns isr %u task %u\n", (unsigned int)s_xIsrTimer.u32Overruns, (unsigned int)s_xTaskTimer.u32Overruns);
+    }
+}
+
+void vHRTimerBenchStart(void)
+{
+    TimerHandle_t xTickTimer;
+
+    vHRTimerCreate(&s_xIsrTimer, IsrTimerCallback, NULL, HRTIMER_CALLBACK_FROM_ISR);
+    vHRTimerCreate(&s_xTaskTimer, TaskTimerCallback, NULL, HRTIMER_CALLBACK_FROM_TASK);
+    vHRTimerStart(&s_xIsrTimer, BENCH_PERIOD_US, BENCH_PERIOD_US);
+    vHRTimerStart(&s_xTaskTimer, BENCH_PERIOD_US, BENCH_PERIOD_US);
+
+    xTickTimer = xTimerCreate("Tick", pdMS_TO_TICKS(1), pdTRUE, NULL, TickTimerCallback);
+    if(xTickTimer != NULL)
+        (void)xTimerStart(xTickTimer, 0);
+
+    /* Lowest priority so printing does not disturb the measurement. */
+    (void)xTaskCreate(JitterReportTask, "Jit", 160, NULL, tskIDLE_PRIORITY + 1, NULL);
+}
+
+#endif /* configUSE_HRTIMER_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,303 @@
+/******************************************************************************
+ * @file     i2c_engine.c
+ * @version  V1.00
+ * @brief    Interrupt driven I2C master transactions on I2C0.
+ *
+ * The I2C_ReadMultiBytesOneReg() family of StdDriver helpers wait in
+ * I2C_WAIT_READY() for every status code, so a task reading 32 bytes from an
+ * EEPROM keeps the CPU busy for the whole transfer.  Here each transaction is
+ * an I2CTransfer_t descriptor that is queued with vI2CEngineSubmit(), and the
+ * I2C0 interrupt moves it through the same status codes the helpers handle,
+ * one per interrupt.  When the transaction ends its callback is called from
+ * the interrupt, and lI2CEngineTransfer() uses that to notify the task that
+ * queued it, so the task is blocked rather than polling while the bus is busy.
+ *
+ * The controller's time-out counter is enabled with I2C_EnableTimeout() when
+ * each transaction starts and disabled when the queue is empty, and restarts
+ * each time SI is cleared.  If a slave holds SCL low, or another master that
+ * won arbitration never releases the bus, the time-out interrupt resets the
+ * controller and fails the transaction with I2C_ENGINE_TIMEOUT, and the
+ * counter is enabled again for the next one.  After arbitration is lost the
+ * transaction is started again when the bus is free, up to
+ * I2C_ENGINE_ARB_RETRIES times.  Clocking out a slave that holds SDA low is
+ * left to the application.
+ *
+ * Starting a transaction waits for the STOP of the one before it to be sent,
+ * at most one bit time, in the interrupt if transactions are queued back to
+ * back.
+ *
+ * To use it, set configUSE_I2C_ENGINE to 1 in FreeRTOSConfig.h.  The
+ * StdDriver helpers must not be used on I2C0 while its interrupt is enabled.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "i2c_engine.h"
+
+#if (configUSE_I2C_ENGINE == 1)
+
+#if (INCLUDE_xTaskGetCurrentTaskHandle != 1)
+#error i2c_engine.c needs INCLUDE_xTaskGetCurrentTaskHandle
+#endif
+
+#if (configI2C_ENGINE_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+#error configI2C_ENGINE_NOTIFY_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+#define I2C_ENGINE_ARB_RETRIES  3
+#define I2C_ENGINE_WRITE_BIT    0x00U
+#define I2C_ENGINE_READ_BIT     0x01U
+
+/* The transaction on the bus is the head of the queue. */
+static I2CTransfer_t *s_pxHead;
+static I2CTransfer_t *s_pxTail;
+static uint32_t s_u32ArbRetries;
+
+/* Called with interrupts masked or from the I2C0 interrupt. */
+static void I2CEngineStart(void)
+{
+    s_pxHead->u32Transferred = 0;
+    s_u32ArbRetries = 0;
+
+    /* STA is ignored while the STOP of the last transaction is pending. */
+    while(I2C0->CTL0 & I2C_CTL0_STO_Msk)
+    {
+    }
+
+    /* Restart the counter from 0. */
+    I2C_DisableTimeout(I2C0);
+    I2C_EnableTimeout(I2C0, 1);
+    I2C_START(I2C0);
+}
+
+/* Called from the I2C0 interrupt.  Writes u8Ctrl, if not 0, to end the
+   transaction on the bus, then starts the next one and calls the callback. */
+static void I2CEngineFinish(int32_t i32Result, uint8_t u8Ctrl, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    I2CTransfer_t *pxTransfer = s_pxHead;
+
+    if(u8Ctrl != 0U)
+        I2C_SET_CONTROL_REG(I2C0, u8Ctrl);
+
+    s_pxHead = pxTransfer->pxNext;
+    if(s_pxHead == NULL)
+    {
+        /* The counter would otherwise expire while the bus is idle. */
+        I2C_DisableTimeout(I2C0);
+        s_pxTail = NULL;
+    }
+    else
+        I2CEngineStart();
+
+    /* Last, as the callback may queue the descriptor again. */
+    pxTransfer->i32Result = i32Result;
+    if(pxTransfer->pxCallback != NULL)
+        pxTransfer->pxCallback(pxTransfer, pxTransfer->pvContext, pxHigherPriorityTaskWoken);
+}
+
+/* Clearing I2CEN resets the controller's state machine and releases SCL and
+   SDA.  The counter stays disabled until the next transaction starts. */
+static void I2CEngineRecover(void)
+{
+    I2C_DisableTimeout(I2C0);
+    I2C_ClearTimeoutFlag(I2C0);
+
+    I2C0->CTL0 &= ~I2C_CTL0_I2CEN_Msk;
+    I2C0->CTL0 |= I2C_CTL0_I2CEN_Msk;
+}
+
+void I2C0_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    I2CTransfer_t *pxTransfer = s_pxHead;
+    uint32_t u32Read;
+
+    if(I2C0->TOCTL & I2C_TOCTL_TOIF_Msk)
+    {
+        I2CEngineRecover();
+        if(pxTransfer != NULL)
+            I2CEngineFinish(I2C_ENGINE_TIMEOUT, 0U, &xHigherPriorityTaskWoken);
+    }
+    else if(I2C_GetIntFlag(I2C0))
+    {
+        if(pxTransfer == NULL)
+        {
+            /* Not ours, such as a STOP left over after a time-out. */
+            I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
+            return;
+        }
+
+        u32Read = pxTransfer->u32Transferred - pxTransfer->u32WriteLength;
+
+        switch(I2C_GET_STATUS(I2C0))
+        {
+        case 0x08:                                           /* START */
+            if((pxTransfer->u32WriteLength != 0U) || (pxTransfer->u32ReadLength == 0U))
+                I2C_SET_DATA(I2C0, (uint8_t)((pxTransfer->u8Address << 1U) | I2C_ENGINE_WRITE_BIT));
+            else
+                I2C_SET_DATA(I2C0, (uint8_t)((pxTransfer->u8Address << 1U) | I2C_ENGINE_READ_BIT));
+            I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
+            break;
+
+        case 0x10:                                           /* Repeated START */
+            I2C_SET_DATA(I2C0, (uint8_t)((pxTransfer->u8Address << 1U) | I2C_ENGINE_READ_BIT));
+            I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
+            break;
+
+        case 0x18:                                           /* Slave Address ACK */
+        case 0x28:                                           /* Master transmit data ACK */
+            if(pxTransfer->u32Transferred < pxTransfer->u32WriteLength)
+            {
+                I2C_SET_DATA(I2C0, pxTransfer->pu8Write[pxTransfer->u32Transferred++]);
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
+            }
+            else if(pxTransfer->u32ReadLength != 0U)
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_STA_SI);     /* Send repeat START */
+            else
+                I2CEngineFinish(I2C_ENGINE_OK, I2C_CTL_STO_SI, &xHigherPriorityTaskWoken);
+            break;
+
+        case 0x20:                                           /* Slave Address NACK */
+        case 0x30:                                           /* Master transmit data NACK */
+        case 0x48:                                           /* Slave Address NACK */
+            I2CEngineFinish(I2C_ENGINE_NACK, I2C_CTL_STO_SI, &xHigherPriorityTaskWoken);
+            break;
+
+        case 0x40:                                           /* Slave Address ACK */
+            /* NACK the first byte if it is the only one. */
+            if(pxTransfer->u32ReadLength > 1U)
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI_AA);
+            else
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);
+            break;
+
+        case 0x50:                                           /* Master receive data ACK */
+            pxTransfer->pu8Read[u32Read++] = (uint8_t)I2C_GET_DATA(I2C0);
+            pxTransfer->u32Transferred++;
+
+            if(u32Read < (pxTransfer->u32ReadLength - 1U))
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI_AA);
+            else
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_SI);    /* NACK the last byte */
+            break;
+
+        case 0x58:                                           /* Master receive data NACK */
+            pxTransfer->pu8Read[u32Read] = (uint8_t)I2C_GET_DATA(I2C0);
+            pxTransfer->u32Transferred++;
+            I2CEngineFinish(I2C_ENGINE_OK, I2C_CTL_STO_SI, &xHigherPriorityTaskWoken);
+            break;
+
+        case 0x38:                                           /* Arbitration Lost */
+            if(s_u32ArbRetries < I2C_ENGINE_ARB_RETRIES)
+            {
+                /* START again once the bus is free.  The time-out counter
+                   runs while waiting, in case it never is. */
+                s_u32ArbRetries++;
+                pxTransfer->u32Transferred = 0;
+                I2C_SET_CONTROL_REG(I2C0, I2C_CTL_STA_SI);
+            }
+            else
+                I2CEngineFinish(I2C_ENGINE_ARB_LOST, I2C_CTL_SI, &xHigherPriorityTaskWoken);
+            break;
+
+        case 0x00:                                           /* Bus error */
+        default:                                             /* Unknow status */
+            I2CEngineFinish(I2C_ENGINE_BUS_ERROR, I2C_CTL_STO_SI, &xHigherPriorityTaskWoken);
+            break;
+        }
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+uint32_t ulI2CEngineInit(uint32_t u32BusHz)
+{
+    uint32_t u32ActualHz;
+
+    SYS_UnlockReg();
+    CLK_EnableModuleClock(I2C0_MODULE);
+
+    /* Set PB multi-function pins for I2C0 SDA=PB.4 and SCL=PB.5 */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB4MFP_Msk | SYS_GPB_MFPL_PB5MFP_Msk)) |
+                    (SYS_GPB_MFPL_PB4MFP_I2C0_SDA | SYS_GPB_MFPL_PB5MFP_I2C0_SCL);
+    SYS_LockReg();
+
+    u32ActualHz = I2C_Open(I2C0, u32BusHz);
+    I2C_EnableInt(I2C0);
+
+    /* Above SysTick and PendSV, which the port runs at the lowest priority. */
+    NVIC_SetPriority(I2C0_IRQn, 1);
+    NVIC_EnableIRQ(I2C0_IRQn);
+
+    return u32ActualHz;
+}
+
+/* The Cortex-M0 port's interrupt mask functions are safe to call from both
+   tasks and interrupts, so one implementation serves both. */
+void vI2CEngineSubmit(I2CTransfer_t *pxTransfer)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    pxTransfer->pxNext = NULL;
+    pxTransfer->u32Transferred = 0;
+    pxTransfer->i32Result = I2C_ENGINE_PENDING;
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if(s_pxHead == NULL)
+        {
+            s_pxHead = pxTransfer;
+            s_pxTail = pxTransfer;
+            I2CEngineStart();
+        }
+        else
+        {
+            s_pxTail->pxNext = pxTransfer;
+            s_pxTail = pxTransfer;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+static void I2CEngineNotify(I2CTransfer_t *pxTransfer, void *pvContext, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)pxTransfer;
+
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)pvContext, configI2C_ENGINE_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+}
+
+int32_t lI2CEngineTransfer(I2CTransfer_t *pxTransfer)
+{
+    pxTransfer->pxCallback = I2CEngineNotify;
+    pxTransfer->pvContext = (void *)xTaskGetCurrentTaskHandle();
+
+    vI2CEngineSubmit(pxTransfer);
+
+    /* The time-out counter ends every transaction, so none is needed here.
+       A notification left over from an earlier transaction is absorbed by
+       checking the result. */
+    while(pxTransfer->i32Result == I2C_ENGINE_PENDING)
+        (void)ulTaskNotifyTakeIndexed(configI2C_ENGINE_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+    return pxTransfer->i32Result;
+}
+
+int32_t lI2CEngineReadReg(uint8_t u8Address, uint8_t u8Register, uint8_t *pu8Data, uint32_t u32Length)
+{
+    I2CTransfer_t xTransfer;
+
+    xTransfer.u8Address = u8Address;
+    xTransfer.pu8Write = &u8Register;
+    xTransfer.u32WriteLength = 1U;
+    xTransfer.pu8Read = pu8Data;
+    xTransfer.u32ReadLength = u32Length;
+
+    return lI2CEngineTransfer(&xTransfer);
+}
+
+#endif /* configUSE_I2C_ENGINE */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * @file     i2c_engine.h
+ * @version  V1.00
+ * @brief    Interrupt driven I2C master transactions on I2C0.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __I2C_ENGINE_H__
+#define __I2C_ENGINE_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Results of a transaction, in I2CTransfer_t::i32Result. */
+#define I2C_ENGINE_OK           0
+#define I2C_ENGINE_PENDING      1       /* Queued or on the bus. */
+#define I2C_ENGINE_NACK         (-1)    /* The address or a written byte was not acknowledged. */
+#define I2C_ENGINE_ARB_LOST     (-2)    /* Another master kept winning the bus. */
+#define I2C_ENGINE_TIMEOUT      (-3)    /* The bus stalled and the controller was reset. */
+#define I2C_ENGINE_BUS_ERROR    (-4)    /* An unexpected status code. */
+
+struct I2CTransfer;
+
+/* Called from the I2C0 interrupt when a transaction ends, so it may only use
+   FromISR APIs.  Set *pxHigherPriorityTaskWoken to pdTRUE if it wakes a task
+   that should run next. */
+typedef void (*I2CCallback_t)(struct I2CTransfer *pxTransfer, void *pvContext,
+                              BaseType_t *pxHigherPriorityTaskWoken);
+
+/* One transaction: a START, the write segment if u32WriteLength is not 0,
+   then a repeated START and the read segment if u32ReadLength is not 0, and a
+   STOP.  With both lengths 0 only the address is sent, which probes for a
+   device.  Declared by the application, which fills in the first seven
+   members; the descriptor must stay valid until the callback is called.  The
+   last three members are written by i2c_engine.c. */
+typedef struct I2CTransfer
+{
+    uint8_t u8Address;              /* 7-bit slave address. */
+    const uint8_t *pu8Write;        /* Usually a register address, then any data to write. */
+    uint32_t u32WriteLength;
+    uint8_t *pu8Read;
+    uint32_t u32ReadLength;
+    I2CCallback_t pxCallback;       /* NULL if no callback is needed. */
+    void *pvContext;
+
+    struct I2CTransfer *pxNext;     /* Next transaction waiting for the bus. */
+    uint32_t u32Transferred;        /* Bytes written and read so far. */
+    volatile int32_t i32Result;
+} I2CTransfer_t;
+
+/* Configure I2C0 at u32BusHz, with its pins on PB.4 and PB.5, and enable its
+   interrupt.  Returns the actual bus clock. */
+uint32_t ulI2CEngineInit(uint32_t u32BusHz);
+
+/* Queue a transaction and return at once.  It starts when the transactions
+   queued before it end.  Can be called from tasks and interrupts. */
+void vI2CEngineSubmit(I2CTransfer_t *pxTransfer);
+
+/* Queue a transaction and block the calling task on its notification value
+   at configI2C_ENGINE_NOTIFY_INDEX until it ends, then return its result.
+   pxCallback and pvContext are overwritten.  The task must not use that
+   notification value for anything else. */
+int32_t lI2CEngineTransfer(I2CTransfer_t *pxTransfer);
+
+/* Read u32Length bytes into pu8Data starting at the one byte register
+   u8Register of the device at u8Address, blocking like lI2CEngineTransfer().
+   The equivalent of I2C_ReadMultiBytesOneReg(). */
+int32_t lI2CEngineReadReg(uint8_t u8Address, uint8_t u8Register, uint8_t *pu8Data, uint32_t u32Length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __I2C_ENGINE_H__ */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * @file     i2c_engine_bench.c
+ * @version  V1.00
+ * @brief    CPU left to other tasks by polled and interrupt driven I2C reads.
+ *
+ * To use it, set configUSE_I2C_ENGINE and configUSE_I2C_ENGINE_BENCH to 1 in
+ * FreeRTOSConfig.h.  A 24LC64 or similar EEPROM with two address bytes is
+ * expected at BENCH_EEPROM_ADDRESS on I2C0.
+ *
+ * A reader task reads BENCH_READ_BYTES bytes from the EEPROM BENCH_READS times,
+ * first with I2C_ReadMultiBytesTwoRegs() and then with lI2CEngineTransfer(),
+ * while a background task below it counts as fast as it can.  The ticks taken
+ * and the background count of each method are printed.  The polled helper
+ * keeps the CPU until the read ends, so the background task only counts
+ * between reads; with the engine it also counts while the reader is blocked.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "i2c_engine.h"
+
+#if (configUSE_I2C_ENGINE == 1) && (configUSE_I2C_ENGINE_BENCH == 1)
+
+#define BENCH_EEPROM_ADDRESS    0x50
+#define BENCH_READ_BYTES        32
+#define BENCH_READS             200
+#define BENCH_LOW_PRIORITY      1
+#define BENCH_TASK_PRIORITY     2
+
+static uint8_t s_au8Data[BENCH_READ_BYTES];
+static volatile uint32_t s_u32Background;
+
+static void BackgroundTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+        s_u32Background++;
+}
+
+static void I2CEngineBenchTask(void *pvParameters)
+{
+    I2CTransfer_t xTransfer;
+    uint8_t au8Address[2] = { 0x00, 0x00 };
+    uint32_t i, u32Count, u32Failed;
+    TickType_t xStart;
+
+    (void)pvParameters;
+
+    printf("%u reads of %u bytes from 0x%02x\n", (unsigned int)BENCH_READS, (unsigned int)BENCH_READ_BYTES,
+           (unsigned int)BENCH_EEPROM_ADDRESS);
+
+    /* Polled, with the interrupt disabled so the engine does not see it. */
+    I2C_DisableInt(I2C0);
+    u32Failed = 0;
+    u32Count = s_u32Background;
+    xStart = xTaskGetTickCount();
+    for(i = 0; i < BENCH_READS; i++)
+    {
+        if(I2C_ReadMultiBytesTwoRegs(I2C0, BENCH_EEPROM_ADDRESS, 0x0000, s_au8Data, BENCH_READ_BYTES) != BENCH_READ_BYTES)
+            u32Failed++;
+        vTaskDelay(1);
+    }
+    printf("polled: %u ticks, background %u, %u failed\n", (unsigned int)(xTaskGetTickCount() - xStart),
+           (unsigned int)(s_u32Background - u32Count), (unsigned int)u32Failed);
+    NVIC_ClearPendingIRQ(I2C0_IRQn);
+    I2C_EnableInt(I2C0);
+
+    /* The same reads as descriptors, blocking on the notification. */
+    xTransfer.u8Address = BENCH_EEPROM_ADDRESS;
+    xTransfer.pu8Write = au8Address;
+    xTransfer.u32WriteLength = sizeof(au8Address);
+    xTransfer.pu8Read = s_au8Data;
+    xTransfer.u32ReadLength = BENCH_READ_BYTES;
+
+    u32Failed = 0;
+    u32Count = s_u32Background;
+    xStart = xTaskGetTickCount();
+    for(i = 0; i < BENCH_READS; i++)
+    {
+        if(lI2CEngineTransfer(&xTransfer) != I2C_ENGINE_OK)
+            u32Failed++;
+        vTaskDelay(1);
+    }
+    printf("engine: %u ticks, background %u, %u failed, last result %d\n",
+           (unsigned int)(xTaskGetTickCount() - xStart), (unsigned int)(s_u32Background - u32Count),
+           (unsigned int)u32Failed, (int)xTransfer.i32Result);
+
+    vTaskDelete(NULL);
+}
+
+void vI2CEngineBenchStart(void)
+{
+    (void)xTaskCreate(I2CEngineBenchTask, "I2CBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(BackgroundTask, "Bkgnd", configMINIMAL_STACK_SIZE, NULL, BENCH_LOW_PRIORITY, NULL);
+}
+
+#endif /* configUSE_I2C_ENGINE_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
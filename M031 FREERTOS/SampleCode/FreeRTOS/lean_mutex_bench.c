@@ -0,0 +1,199 @@
+/******************************************************************************
+ * @file     lean_mutex_bench.c
+ * @version  V1.00
+ * @brief    Cost of lean mutexes against mutex type semaphores.
+ *
+ * To use it, include lean_mutex.c in the build and set both
+ * configUSE_LEAN_MUTEXES and configUSE_LEAN_MUTEX_BENCH to 1 in
+ * FreeRTOSConfig.h.  TIMER0 free-runs at the HIRC frequency, which is also
+ * HCLK, so costs are reported in CPU cycles.
+ *
+ * For each mutex type the benchmark first times BENCH_CALLS uncontended take
+ * and give calls, less the cost of reading the timer.  It then measures the
+ * hand over: a higher priority task blocks on the mutex while the benchmark
+ * task holds it, and the time from just before the give to the higher
+ * priority task returning from its take, including the context switch, is
+ * recorded.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "lean_mutex.h"
+#include "bench_common.h"
+
+#if (configUSE_LEAN_MUTEXES == 1) && (configUSE_LEAN_MUTEX_BENCH == 1)
+
+#define BENCH_CALLS             1000
+#define BENCH_HANDOVERS         100
+#define BENCH_TASK_PRIORITY     2
+#define BENCH_WAITER_PRIORITY   3
+
+typedef struct
+{
+    const char *pcName;
+    BaseType_t (*pxTake)(void);
+    BaseType_t (*pxGive)(void);
+} MutexOps_t;
+
+static LeanMutex_t s_xLeanMutex = leanMUTEX_INITIALISER;
+static SemaphoreHandle_t s_xQueueMutex;
+
+static const MutexOps_t *s_pxWaiterOps;
+static TaskHandle_t s_xWaiterTask, s_xBenchTask;
+static volatile uint32_t s_u32GiveStamp;
+static BenchStats_t s_xHandover;
+
+static BaseType_t LeanTake(void)
+{
+    return xLeanMutexTake(&s_xLeanMutex, portMAX_DELAY);
+}
+
+static BaseType_t LeanGive(void)
+{
+    return xLeanMutexGive(&s_xLeanMutex);
+}
+
+static BaseType_t QueueTake(void)
+{
+    return xSemaphoreTake(s_xQueueMutex, portMAX_DELAY);
+}
+
+static BaseType_t QueueGive(void)
+{
+    return xSemaphoreGive(s_xQueueMutex);
+}
+
+static const MutexOps_t s_axOps[] =
+{
+    { "lean", LeanTake, LeanGive },
+    { "queue", QueueTake, QueueGive }
+};
+
+static void StatsPrint(const char *pcMutex, const char *pcWhat, const BenchStats_t *pxStats)
+{
+    printf("%-5s ", pcMutex);
+    BenchStatsPrint(pcWhat, pxStats);
+}
+
+/* Cycles taken by reading TIMER0 twice, subtracted from the call timings. */
+static uint32_t TimerOverhead(void)
+{
+    uint32_t i, u32Start, u32Cycles, u32Min = 0xFFFFFFFF;
+
+    for(i = 0; i < 16; i++)
+    {
+        u32Start = BENCH_NOW();
+        u32Cycles = BENCH_SINCE(u32Start);
+        if(u32Cycles < u32Min)
+            u32Min = u32Cycles;
+    }
+
+    return u32Min;
+}
+
+static void BenchUncontended(const MutexOps_t *pxOps, uint32_t u32Overhead)
+{
+    BenchStats_t xTake, xGive;
+    uint32_t i, u32Start, u32Cycles;
+
+    BenchStatsReset(&xTake);
+    BenchStatsReset(&xGive);
+
+    for(i = 0; i < BENCH_CALLS; i++)
+    {
+        u32Start = BENCH_NOW();
+        (void)pxOps->pxTake();
+        u32Cycles = BENCH_SINCE(u32Start);
+        BenchStatsRecord(&xTake, u32Cycles - u32Overhead);
+
+        u32Start = BENCH_NOW();
+        (void)pxOps->pxGive();
+        u32Cycles = BENCH_SINCE(u32Start);
+        BenchStatsRecord(&xGive, u32Cycles - u32Overhead);
+    }
+
+    StatsPrint(pxOps->pcName, "take", &xTake);
+    StatsPrint(pxOps->pcName, "give", &xGive);
+}
+
+/* Blocks on the mutex the benchmark task holds each time it is notified. */
+static void WaiterTask(void *pvParameters)
+{
+    uint32_t u32Cycles;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        (void)s_pxWaiterOps->pxTake();
+        u32Cycles = BENCH_SINCE(s_u32GiveStamp);
+        BenchStatsRecord(&s_xHandover, u32Cycles);
+        (void)s_pxWaiterOps->pxGive();
+
+        xTaskNotifyGive(s_xBenchTask);
+    }
+}
+
+static void BenchHandover(const MutexOps_t *pxOps)
+{
+    uint32_t i;
+
+    s_pxWaiterOps = pxOps;
+    BenchStatsReset(&s_xHandover);
+
+    for(i = 0; i < BENCH_HANDOVERS; i++)
+    {
+        (void)pxOps->pxTake();
+
+        /* The waiter preempts this task and blocks on the mutex. */
+        xTaskNotifyGive(s_xWaiterTask);
+
+        s_u32GiveStamp = BENCH_NOW();
+        (void)pxOps->pxGive();
+
+        /* Wait for the waiter to give the mutex back. */
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    StatsPrint(pxOps->pcName, "handover", &s_xHandover);
+}
+
+static void LeanMutexBenchTask(void *pvParameters)
+{
+    uint32_t i, u32Overhead;
+
+    (void)pvParameters;
+
+    u32Overhead = TimerOverhead();
+    printf("lean mutex %u bytes, timer read %u cycles\n", (unsigned int)sizeof(LeanMutex_t), (unsigned int)u32Overhead);
+
+    for(i = 0; i < sizeof(s_axOps) / sizeof(s_axOps[0]); i++)
+    {
+        BenchUncontended(&s_axOps[i], u32Overhead);
+        BenchHandover(&s_axOps[i]);
+    }
+
+    vTaskDelete(s_xWaiterTask);
+    vTaskDelete(NULL);
+}
+
+void vLeanMutexBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    s_xQueueMutex = xSemaphoreCreateMutex();
+
+    (void)xTaskCreate(LeanMutexBenchTask, "LMBch", 160, NULL, BENCH_TASK_PRIORITY, &s_xBenchTask);
+    (void)xTaskCreate(WaiterTask, "LMw", 80, NULL, BENCH_WAITER_PRIORITY, &s_xWaiterTask);
+}
+
+#endif /* configUSE_LEAN_MUTEX_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -12,6 +12,83 @@
 #include "task.h"
 #include "timers.h"
 #include "semphr.h"
+
+#if (configUSE_HEAP_REGIONS == 1)
+extern void vHeapRegionsInit(void);
+#endif
+#if (configUSE_AO_BENCH == 1)
+extern void vAOBenchStart(void);
+#endif
+#if (configUSE_HRTIMER == 1)
+#include "hrtimer.h"
+#endif
+#if (configUSE_HRTIMER_BENCH == 1)
+extern void vHRTimerBenchStart(void);
+#endif
+#if (configUSE_TIMER_BENCH == 1)
+extern void vTimerBenchStart(void);
+#endif
+#if (configUSE_EVENT_GROUP_BENCH == 1)
+extern void vEventGroupBenchStart(void);
+#endif
+#if (configUSE_LEAN_MUTEX_BENCH == 1)
+extern void vLeanMutexBenchStart(void);
+#endif
+#if (configUSE_RWLOCK_BENCH == 1)
+extern void vRWLockBenchStart(void);
+#endif
+#if (configUSE_CEILING_MUTEX_CHECK == 1)
+extern void vCeilingMutexCheckStart(void);
+#endif
+#if (configUSE_BROADCAST_BENCH == 1)
+extern void vBroadcastBenchStart(void);
+#endif
+#if (configUSE_PRIORITY_QUEUE_BENCH == 1)
+extern void vPriorityQueueBenchStart(void);
+#endif
+#if (configUSE_EDF_BENCH == 1)
+extern void vEDFBenchStart(void);
+#endif
+#if (configUSE_BUDGET_BENCH == 1)
+extern void vBudgetBenchStart(void);
+#endif
+#if (configUSE_QUANTUM_BENCH == 1)
+extern void vQuantumBenchStart(void);
+#endif
+#if (configUSE_CYCLIC_BENCH == 1)
+extern void vCyclicBenchStart(void);
+#endif
+#if (configUSE_TASK_POOL_BENCH == 1)
+extern void vTaskPoolBenchStart(void);
+#endif
+#if (configUSE_SNAPSHOT_BENCH == 1)
+extern void vSnapshotBenchStart(void);
+#endif
+#if (configUSE_STACK_BENCH == 1)
+extern void vStackBenchStart(void);
+#endif
+#if (configUSE_OBJECT_STATS_BENCH == 1)
+extern void vObjectStatsBenchStart(void);
+#endif
+#if (configUSE_BLOCKING_BENCH == 1)
+extern void vBlockingBenchStart(void);
+#endif
+#if (configUSE_PROFILER == 1)
+#include "profiler.h"
+#endif
+#if (configUSE_PROFILER_BENCH == 1)
+extern void vProfilerBenchStart(void);
+#endif
+#if (configUSE_I2C_ENGINE == 1)
+#include "i2c_engine.h"
+#endif
+#if (configUSE_I2C_ENGINE_BENCH == 1)
+extern void vI2CEngineBenchStart(void);
+#endif
+#if (configUSE_CROUTINE_BENCH == 1)
+extern void vCoRoutineBenchStart(void);
+#endif
+
 void UART_Open(UART_T *uart, uint32_t u32baudrate);
 
 void SYS_Init(void)
@@ -85,8 +162,66 @@ int main()
 
     /* Connect UART to PC, and open a terminal tool to receive following message */
   //  printf("Hello World\n");
+#if (configUSE_HEAP_REGIONS == 1)
+    /* Must run before the first object is created. */
+    vHeapRegionsInit();
+#endif
+#if (configUSE_HRTIMER == 1)
+    vHRTimerInit();
+#endif
+#if (configUSE_PROFILER == 1)
+    (void)ulProfilerInit(configPROFILER_SAMPLE_HZ);
+#endif
+#if (configUSE_I2C_ENGINE == 1)
+    (void)ulI2CEngineInit(configI2C_ENGINE_BUS_HZ);
+#endif
+#if (configUSE_AO_BENCH == 1)
+    /* Replaces the demo tasks so the benchmark fits in the heap. */
+    vAOBenchStart();
+#elif (configUSE_HRTIMER_BENCH == 1)
+    vHRTimerBenchStart();
+#elif (configUSE_TIMER_BENCH == 1)
+    vTimerBenchStart();
+#elif (configUSE_EVENT_GROUP_BENCH == 1)
+    vEventGroupBenchStart();
+#elif (configUSE_LEAN_MUTEX_BENCH == 1)
+    vLeanMutexBenchStart();
+#elif (configUSE_RWLOCK_BENCH == 1)
+    vRWLockBenchStart();
+#elif (configUSE_CEILING_MUTEX_CHECK == 1)
+    vCeilingMutexCheckStart();
+#elif (configUSE_BROADCAST_BENCH == 1)
+    vBroadcastBenchStart();
+#elif (configUSE_PRIORITY_QUEUE_BENCH == 1)
+    vPriorityQueueBenchStart();
+#elif (configUSE_EDF_BENCH == 1)
+    vEDFBenchStart();
+#elif (configUSE_BUDGET_BENCH == 1)
+    vBudgetBenchStart();
+#elif (configUSE_QUANTUM_BENCH == 1)
+    vQuantumBenchStart();
+#elif (configUSE_CYCLIC_BENCH == 1)
+    vCyclicBenchStart();
+#elif (configUSE_TASK_POOL_BENCH == 1)
+    vTaskPoolBenchStart();
+#elif (configUSE_SNAPSHOT_BENCH == 1)
+    vSnapshotBenchStart();
+#elif (configUSE_STACK_BENCH == 1)
+    vStackBenchStart();
+#elif (configUSE_OBJECT_STATS_BENCH == 1)
+    vObjectStatsBenchStart();
+#elif (configUSE_BLOCKING_BENCH == 1)
+    vBlockingBenchStart();
+#elif (configUSE_PROFILER_BENCH == 1)
+    vProfilerBenchStart();
+#elif (configUSE_I2C_ENGINE_BENCH == 1)
+    vI2CEngineBenchStart();
+#elif (configUSE_CROUTINE_BENCH == 1)
+    vCoRoutineBenchStart();
+#else
     xTaskCreate(Task0, (const char *)"Task0", 100, NULL, 1, NULL);
     xTaskCreate(Task1, (const char *)"Task1", 100, NULL, 2, NULL);
+#endif
     vTaskStartScheduler();
     /* Got no where to go, just loop forever */
     while(1);
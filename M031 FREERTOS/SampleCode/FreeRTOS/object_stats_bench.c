@@ -0,0 +1,194 @@
+/******************************************************************************
+ * @file     object_stats_bench.c
+ * @version  V1.00
+ * @brief    Finding the IPC object tasks wait on most from the registry.
+ *
+ * To use it, set configUSE_OBJECT_STATS and configUSE_OBJECT_STATS_BENCH to 1
+ * in FreeRTOSConfig.h.
+ *
+ * A producer task sends a reading to a queue each tick, sets a bit in an event
+ * group and writes a line to a stream buffer.  A consumer task takes one
+ * reading every BENCH_CONSUME_TICKS ticks, so the queue fills and the producer
+ * waits, and reads the lines without waiting.  A low priority holder task
+ * keeps a mutex for BENCH_HOLD_TICKS ticks at a time, and an urgent task above
+ * them waits for the event bit and then for the mutex, raising the priority of
+ * the holder.  The objects are added to the registry, and every
+ * BENCH_REPORT_TICKS ticks the statistics uxQueueGetRegistryStats() returns
+ * are printed.  After BENCH_REPORTS reports the object tasks waited on longest
+ * in total is printed.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+
+#if (configUSE_OBJECT_STATS == 1) && (configUSE_OBJECT_STATS_BENCH == 1)
+
+#define BENCH_REPORT_TICKS      1000
+#define BENCH_REPORTS           5
+#define BENCH_MAX_OBJECTS       configQUEUE_REGISTRY_SIZE
+#define BENCH_QUEUE_LENGTH      4
+#define BENCH_LOG_BYTES         64
+#define BENCH_CONSUME_TICKS     3
+#define BENCH_HOLD_TICKS        5
+#define BENCH_WAIT_TICKS        20
+#define BENCH_READING_BIT       0x01
+#define BENCH_LOW_PRIORITY      1
+#define BENCH_PRODUCER_PRIORITY 2
+#define BENCH_URGENT_PRIORITY   3
+#define BENCH_TASK_PRIORITY     4
+
+static QueueHandle_t s_xReadings;
+static SemaphoreHandle_t s_xBusLock;
+static StreamBufferHandle_t s_xLog;
+static EventGroupHandle_t s_xEvents;
+static QueueRegistryStats_t s_axStats[BENCH_MAX_OBJECTS];
+
+static void ProducerTask(void *pvParameters)
+{
+    uint32_t u32Reading = 0;
+    char acLine[16];
+    int i32Length;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(1);
+
+        u32Reading++;
+        (void)xQueueSend(s_xReadings, &u32Reading, BENCH_WAIT_TICKS);
+        (void)xEventGroupSetBits(s_xEvents, BENCH_READING_BIT);
+
+        i32Length = sprintf(acLine, "r%u\n", (unsigned int)u32Reading);
+        (void)xStreamBufferSend(s_xLog, acLine, (size_t)i32Length, 0);
+    }
+}
+
+static void ConsumerTask(void *pvParameters)
+{
+    uint32_t u32Reading;
+    char acLine[16];
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_CONSUME_TICKS);
+
+        (void)xQueueReceive(s_xReadings, &u32Reading, 0);
+        (void)xStreamBufferReceive(s_xLog, acLine, sizeof(acLine), 0);
+    }
+}
+
+static void HolderTask(void *pvParameters)
+{
+    TickType_t xStart;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        if(xSemaphoreTake(s_xBusLock, portMAX_DELAY) == pdPASS)
+        {
+            /* A slow transfer on the bus. */
+            xStart = xTaskGetTickCount();
+            while((xTaskGetTickCount() - xStart) < BENCH_HOLD_TICKS)
+            {
+            }
+            (void)xSemaphoreGive(s_xBusLock);
+        }
+        vTaskDelay(BENCH_HOLD_TICKS);
+    }
+}
+
+static void UrgentTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)xEventGroupWaitBits(s_xEvents, BENCH_READING_BIT, pdTRUE, pdFALSE, BENCH_WAIT_TICKS);
+
+        if(xSemaphoreTake(s_xBusLock, BENCH_WAIT_TICKS) == pdPASS)
+            (void)xSemaphoreGive(s_xBusLock);
+
+        vTaskDelay(BENCH_HOLD_TICKS + 2);
+    }
+}
+
+static void ObjectStatsBenchTask(void *pvParameters)
+{
+    UBaseType_t uxObjects = 0, ux;
+    uint32_t i, u32Waited, u32Most = 0;
+    const char *pcMost = "none";
+    const ObjectStats_t *pxStats;
+
+    (void)pvParameters;
+
+    for(i = 0; i < BENCH_REPORTS; i++)
+    {
+        vTaskDelay(BENCH_REPORT_TICKS);
+
+        uxObjects = uxQueueGetRegistryStats(s_axStats, BENCH_MAX_OBJECTS);
+
+        printf("report %u\n", (unsigned int)i);
+        for(ux = 0; ux < uxObjects; ux++)
+        {
+            pxStats = &s_axStats[ux].xStats;
+            printf("  %-7s snd=%5u rcv=%5u fail=%u/%u fill=%u wait snd=%u/%u rcv=%u/%u\n", s_axStats[ux].pcName,
+                   (unsigned int)pxStats->ulSends, (unsigned int)pxStats->ulReceives,
+                   (unsigned int)pxStats->ulSendFailures, (unsigned int)pxStats->ulReceiveFailures,
+                   (unsigned int)pxStats->uxMaxFill, (unsigned int)pxStats->ulSendBlockedTicks,
+                   (unsigned int)pxStats->xSendBlockedMax, (unsigned int)pxStats->ulReceiveBlockedTicks,
+                   (unsigned int)pxStats->xReceiveBlockedMax);
+            if(s_axStats[ux].pvHandle == (void *)s_xBusLock)
+                printf("  %-7s held=%u/%u inheritances=%u\n", "", (unsigned int)pxStats->ulHoldTicks,
+                       (unsigned int)pxStats->xHoldMax, (unsigned int)pxStats->ulInheritances);
+        }
+    }
+
+    /* The object tasks spent the most time waiting on. */
+    for(ux = 0; ux < uxObjects; ux++)
+    {
+        u32Waited = s_axStats[ux].xStats.ulSendBlockedTicks + s_axStats[ux].xStats.ulReceiveBlockedTicks;
+        if(u32Waited > u32Most)
+        {
+            u32Most = u32Waited;
+            pcMost = s_axStats[ux].pcName;
+        }
+    }
+    printf("most waited on: %s, %u ticks\n", pcMost, (unsigned int)u32Most);
+
+    vTaskDelete(NULL);
+}
+
+void vObjectStatsBenchStart(void)
+{
+    s_xReadings = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    s_xBusLock = xSemaphoreCreateMutex();
+    s_xLog = xStreamBufferCreate(BENCH_LOG_BYTES, 1);
+    s_xEvents = xEventGroupCreate();
+
+    vQueueAddToRegistry(s_xReadings, "Reading");
+    vQueueAddToRegistry(s_xBusLock, "BusLock");
+    vStreamBufferAddToRegistry(s_xLog, "Log");
+    vEventGroupAddToRegistry(s_xEvents, "Events");
+
+    (void)xTaskCreate(ObjectStatsBenchTask, "OSBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(ProducerTask, "Prod", configMINIMAL_STACK_SIZE + 20, NULL, BENCH_PRODUCER_PRIORITY, NULL);
+    (void)xTaskCreate(ConsumerTask, "Cons", configMINIMAL_STACK_SIZE + 10, NULL, BENCH_LOW_PRIORITY, NULL);
+    (void)xTaskCreate(HolderTask, "Holder", configMINIMAL_STACK_SIZE, NULL, BENCH_LOW_PRIORITY, NULL);
+    (void)xTaskCreate(UrgentTask, "Urgent", configMINIMAL_STACK_SIZE, NULL, BENCH_URGENT_PRIORITY, NULL);
+}
+
+#endif /* configUSE_OBJECT_STATS_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * @file     priority_queue_bench.c
+ * @version  V1.00
+ * @brief    Latency of an urgent command behind bulk requests.
+ *
+ * To use it, set configUSE_PRIORITY_QUEUE_BENCH to 1 in FreeRTOSConfig.h.
+ * TIMER0 free-runs at the HIRC frequency, which is also HCLK, so times are
+ * reported in CPU cycles.
+ *
+ * A command handler task serves a queue of commands.  The benchmark task,
+ * which runs above it, queues BENCH_BULK telemetry requests, each of which
+ * takes the handler a while to serve, followed by a stop command, and the time
+ * from sending the stop command to the handler receiving it is recorded.  The
+ * commands are sent first through a queue, where the stop command waits
+ * behind the telemetry requests, and then through a priority queue with the
+ * stop command sent at the higher of two priorities.  The depth high-water
+ * mark of each priority is printed at the end.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "priority_queue.h"
+#include "bench_common.h"
+
+#if (configUSE_PRIORITY_QUEUE_BENCH == 1)
+
+#define BENCH_LENGTH            8
+#define BENCH_BULK              (BENCH_LENGTH - 1)
+#define BENCH_ROUNDS            100
+#define BENCH_WORK_LOOPS        500     /* Busy loops the handler spends on each telemetry request. */
+#define BENCH_HANDLER_PRIORITY  1
+#define BENCH_TASK_PRIORITY     2
+
+#define PRIORITY_BULK           0
+#define PRIORITY_URGENT         1
+#define BENCH_LEVELS            2
+
+enum
+{
+    CMD_TELEMETRY,
+    CMD_STOP
+};
+
+enum
+{
+    BENCH_MODE_QUEUE,
+    BENCH_MODE_PRIORITY_QUEUE
+};
+
+typedef struct
+{
+    uint8_t u8Command;
+    uint8_t u8Argument;
+    uint32_t u32Stamp;
+} Command_t;
+
+static volatile uint32_t s_u32Mode;
+static volatile uint32_t s_u32StopLatency;
+static QueueHandle_t s_xQueue;
+static PriorityQueueHandle_t s_xPriorityQueue;
+static TaskHandle_t s_xBenchTask;
+
+static void HandlerTask(void *pvParameters)
+{
+    Command_t xCommand;
+    BaseType_t xReceived;
+    volatile uint32_t i;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        /* Wait a tick at a time so a change of mode is seen. */
+        if(s_u32Mode == BENCH_MODE_QUEUE)
+            xReceived = xQueueReceive(s_xQueue, &xCommand, 1);
+        else
+            xReceived = xPriorityQueueReceive(s_xPriorityQueue, &xCommand, NULL, 1);
+
+        if(xReceived != pdPASS)
+            continue;
+
+        if(xCommand.u8Command == CMD_STOP)
+        {
+            s_u32StopLatency = BENCH_SINCE(xCommand.u32Stamp);
+            xTaskNotifyGive(s_xBenchTask);
+        }
+        else
+        {
+            for(i = 0; i < BENCH_WORK_LOOPS; i++)
+            {
+            }
+        }
+    }
+}
+
+static void Send(const Command_t *pxCommand, UBaseType_t uxPriority)
+{
+    if(s_u32Mode == BENCH_MODE_QUEUE)
+        (void)xQueueSend(s_xQueue, pxCommand, portMAX_DELAY);
+    else
+        (void)xPriorityQueueSend(s_xPriorityQueue, pxCommand, uxPriority, portMAX_DELAY);
+}
+
+static UBaseType_t MessagesWaiting(void)
+{
+    if(s_u32Mode == BENCH_MODE_QUEUE)
+        return uxQueueMessagesWaiting(s_xQueue);
+    else
+        return uxPriorityQueueMessagesWaiting(s_xPriorityQueue);
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    Command_t xCommand = { CMD_TELEMETRY, 0, 0 };
+    BenchStats_t xStop;
+    uint32_t i, j;
+
+    s_u32Mode = u32Mode;
+    BenchStatsReset(&xStop);
+
+    for(i = 0; i < BENCH_ROUNDS; i++)
+    {
+        /* The handler runs below this task, so it starts on the commands
+           once this task blocks for the stop command to be received. */
+        xCommand.u8Command = CMD_TELEMETRY;
+        for(j = 0; j < BENCH_BULK; j++)
+        {
+            xCommand.u8Argument = (uint8_t)j;
+            Send(&xCommand, PRIORITY_BULK);
+        }
+
+        xCommand.u8Command = CMD_STOP;
+        xCommand.u32Stamp = BENCH_NOW();
+        Send(&xCommand, PRIORITY_URGENT);
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        BenchStatsRecord(&xStop, s_u32StopLatency);
+
+        /* Let the handler serve the rest of the telemetry requests. */
+        while(MessagesWaiting() != 0)
+            vTaskDelay(1);
+    }
+
+    printf("%-14s ", pcName);
+    BenchStatsPrint("stop", &xStop);
+}
+
+static void PriorityQueueBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    printf("%u telemetry requests queued before each stop command\n", (unsigned int)BENCH_BULK);
+
+    BenchRun(BENCH_MODE_QUEUE, "queue");
+    BenchRun(BENCH_MODE_PRIORITY_QUEUE, "priority queue");
+
+    printf("priority queue high-water marks: bulk=%u urgent=%u\n",
+           (unsigned int)uxPriorityQueueGetHighWaterMark(s_xPriorityQueue, PRIORITY_BULK),
+           (unsigned int)uxPriorityQueueGetHighWaterMark(s_xPriorityQueue, PRIORITY_URGENT));
+
+    vTaskDelete(NULL);
+}
+
+void vPriorityQueueBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    s_xQueue = xQueueCreate(BENCH_LENGTH, sizeof(Command_t));
+    s_xPriorityQueue = xPriorityQueueCreate(BENCH_LENGTH, sizeof(Command_t), BENCH_LEVELS);
+
+    (void)xTaskCreate(PriorityQueueBenchTask, "PQBch", 160, NULL, BENCH_TASK_PRIORITY, &s_xBenchTask);
+    (void)xTaskCreate(HandlerTask, "PQh", 80, NULL, BENCH_HANDLER_PRIORITY, NULL);
+}
+
+#endif /* configUSE_PRIORITY_QUEUE_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * @file     profiler.c
+ * @version  V1.00
+ * @brief    Statistical PC sampling profiler on TIMER3.
+ *
+ * The Cortex-M0 has no cycle counter and no trace, so this profiler samples
+ * instead.  TIMER3 interrupts at a fixed rate at the highest priority, and
+ * the handler reads the PC and LR that the interrupted code stacked in its
+ * exception frame, with the running task, and counts them in a small hash
+ * table.  The PC shows where time is spent, and in a leaf function the LR
+ * shows where it was called from.  Samples that interrupt another handler are
+ * counted without a task.  Code that masks interrupts, such as kernel critical
+ * sections, is not sampled: a sample due inside it is taken where interrupts
+ * are unmasked again.
+ *
+ * vProfilerDump() prints the histogram, which profiler_report.py turns into
+ * function level hot spots using the map file of the Keil or GCC build.  The
+ * sample rate should not be a multiple of the tick rate, or samples would
+ * always fall at the same point after each tick.
+ *
+ * To use it, set configUSE_PROFILER to 1 in FreeRTOSConfig.h.  cyclic_bench.c
+ * also uses TIMER3, so the two cannot be used together.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "profiler.h"
+
+#if (configUSE_PROFILER == 1)
+
+#if (configUSE_CYCLIC_BENCH == 1)
+#error cyclic_bench.c also uses TIMER3
+#endif
+
+#if (configUSE_TRACE_FACILITY != 1) || (INCLUDE_xTaskGetCurrentTaskHandle != 1)
+#error profiler.c needs configUSE_TRACE_FACILITY and INCLUDE_xTaskGetCurrentTaskHandle
+#endif
+
+#if ((configPROFILER_BUCKETS & (configPROFILER_BUCKETS - 1)) != 0)
+#error configPROFILER_BUCKETS must be a power of two
+#endif
+
+#define PROFILER_MAX_PROBES     8       /* Buckets tried before a sample is dropped. */
+#define PROFILER_MAX_TASKS      12      /* Tasks vProfilerDump() can name. */
+/* The exception number in the stacked xPSR, not 0 if a handler was interrupted. */
+#define PROFILER_IPSR_MASK      0x3FUL
+/* Clears the Thumb bit of the LR as well as rounding down. */
+#define PROFILER_ROUND(u32Address) \
+    ((u32Address) & ~(((1UL << configPROFILER_PC_SHIFT) - 1UL) | 1UL))
+
+static ProfilerBucket_t s_axBuckets[configPROFILER_BUCKETS];
+static volatile uint32_t s_u32Samples;
+static volatile uint32_t s_u32Dropped;
+static uint32_t s_u32SampleHz;
+static TaskStatus_t s_axTasks[PROFILER_MAX_TASKS];
+
+void ProfilerSample(uint32_t *pu32Frame);
+
+/* Called by TMR3_IRQHandler() with the exception frame of the interrupted
+   code: r0-r3, r12, lr, pc and xpsr.  Nothing preempts it, so the histogram
+   is updated without masking interrupts. */
+void ProfilerSample(uint32_t *pu32Frame)
+{
+    uint32_t u32Pc, u32Lr, u32Index, u32Probe;
+    TaskHandle_t xTask;
+    ProfilerBucket_t *pxBucket;
+
+    TIMER_ClearIntFlag(TIMER3);
+
+    u32Pc = PROFILER_ROUND(pu32Frame[6]);
+    u32Lr = PROFILER_ROUND(pu32Frame[5]);
+    if((pu32Frame[7] & PROFILER_IPSR_MASK) != 0UL)
+        xTask = NULL;
+    else
+        xTask = xTaskGetCurrentTaskHandle();
+
+    u32Index = (u32Pc >> configPROFILER_PC_SHIFT) ^ (u32Lr >> 4) ^ ((uint32_t)xTask >> 3);
+    u32Index ^= u32Index >> 8;
+
+    for(u32Probe = 0; u32Probe < PROFILER_MAX_PROBES; u32Probe++)
+    {
+        pxBucket = &s_axBuckets[(u32Index + u32Probe) & (configPROFILER_BUCKETS - 1)];
+
+        if(pxBucket->u32Count == 0UL)
+        {
+            pxBucket->u32Pc = u32Pc;
+            pxBucket->u32Lr = u32Lr;
+            pxBucket->xTask = xTask;
+            pxBucket->u32Count = 1UL;
+            s_u32Samples++;
+            return;
+        }
+
+        if((pxBucket->u32Pc == u32Pc) && (pxBucket->u32Lr == u32Lr) && (pxBucket->xTask == xTask))
+        {
+            pxBucket->u32Count++;
+            s_u32Samples++;
+            return;
+        }
+    }
+
+    s_u32Dropped++;
+}
+
+/* Passes the exception frame to ProfilerSample().  Bit 2 of EXC_RETURN is set
+   if the interrupted code was using the process stack, as tasks do.
+   ProfilerSample() is branched to rather than called, so it returns from the
+   exception itself. */
+#if defined(__CC_ARM)
+__asm void TMR3_IRQHandler(void)
+{
+    extern ProfilerSample
+
+    PRESERVE8
+
+    movs r0, #4
+    mov r1, lr
+    tst r0, r1
+    beq ProfilerMainStack
+    mrs r0, psp
+    b ProfilerBranch
+ProfilerMainStack
+    mrs r0, msp
+ProfilerBranch
+    ldr r1, =ProfilerSample
+    bx r1
+    ALIGN
+}
+#else
+void TMR3_IRQHandler(void) __attribute__((naked));
+void TMR3_IRQHandler(void)
+{
+    __asm volatile
+    (
+        "   movs r0, #4                 \n"
+        "   mov r1, lr                  \n"
+        "   tst r0, r1                  \n"
+        "   beq 1f                      \n"
+        "   mrs r0, psp                 \n"
+        "   b 2f                        \n"
+        "1:                             \n"
+        "   mrs r0, msp                 \n"
+        "2:                             \n"
+        "   ldr r1, ProfilerSampleConst \n"
+        "   bx r1                       \n"
+        "   .align 2                    \n"
+        "ProfilerSampleConst: .word ProfilerSample \n"
+    );
+}
+#endif
+
+uint32_t ulProfilerInit(uint32_t u32SampleHz)
+{
+    SYS_UnlockReg();
+    CLK_EnableModuleClock(TMR3_MODULE);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC, 0);
+    SYS_LockReg();
+
+    s_u32SampleHz = TIMER_Open(TIMER3, TIMER_PERIODIC_MODE, u32SampleHz);
+    TIMER_ClearIntFlag(TIMER3);
+    TIMER_EnableInt(TIMER3);
+
+    /* The highest priority, so other interrupt handlers are sampled too. */
+    NVIC_SetPriority(TMR3_IRQn, 0);
+    NVIC_EnableIRQ(TMR3_IRQn);
+
+    return s_u32SampleHz;
+}
+
+void vProfilerStart(void)
+{
+    TIMER_Start(TIMER3);
+}
+
+void vProfilerStop(void)
+{
+    TIMER_Stop(TIMER3);
+}
+
+void vProfilerReset(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t i;
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        for(i = 0; i < configPROFILER_BUCKETS; i++)
+            s_axBuckets[i].u32Count = 0UL;
+
+        s_u32Samples = 0UL;
+        s_u32Dropped = 0UL;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+uint32_t ulProfilerGetSamples(void)
+{
+    return s_u32Samples;
+}
+
+uint32_t ulProfilerGetDropped(void)
+{
+    return s_u32Dropped;
+}
+
+void vProfilerDump(void)
+{
+    UBaseType_t uxSavedInterruptStatus, uxTasks, ux;
+    ProfilerBucket_t xBucket;
+    uint32_t i;
+
+    /* Tasks are named from those that exist now.  Returns 0 if there are more
+       than PROFILER_MAX_TASKS, in which case tasks are printed by handle, as
+       are tasks deleted since they were sampled. */
+    uxTasks = uxTaskGetSystemState(s_axTasks, PROFILER_MAX_TASKS, NULL);
+
+    printf("P hz=%u samples=%u dropped=%u shift=%u\n", (unsigned int)s_u32SampleHz, (unsigned int)s_u32Samples,
+           (unsigned int)s_u32Dropped, (unsigned int)configPROFILER_PC_SHIFT);
+
+    for(i = 0; i < configPROFILER_BUCKETS; i++)
+    {
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        xBucket = s_axBuckets[i];
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+        if(xBucket.u32Count == 0UL)
+            continue;
+
+        printf("S %08x %08x %u ", (unsigned int)xBucket.u32Pc, (unsigned int)xBucket.u32Lr,
+               (unsigned int)xBucket.u32Count);
+
+        if(xBucket.xTask == NULL)
+        {
+            printf("isr\n");
+            continue;
+        }
+
+        for(ux = 0; ux < uxTasks; ux++)
+        {
+            if(s_axTasks[ux].xHandle == xBucket.xTask)
+                break;
+        }
+
+        if(ux < uxTasks)
+            printf("%s\n", s_axTasks[ux].pcTaskName);
+        else
+            printf("task@%08x\n", (unsigned int)xBucket.xTask);
+    }
+
+    printf("E\n");
+}
+
+#endif /* configUSE_PROFILER */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * @file     profiler.h
+ * @version  V1.00
+ * @brief    Statistical PC sampling profiler on TIMER3.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* One bucket of the histogram.  Samples with the same PC, LR and task, once
+   the PC and LR are rounded down to 1 << configPROFILER_PC_SHIFT bytes, are
+   counted in the same bucket. */
+typedef struct
+{
+    uint32_t u32Pc;         /* Interrupted PC, rounded down. */
+    uint32_t u32Lr;         /* LR at the time of the interrupt, rounded down. */
+    TaskHandle_t xTask;     /* Running task, or NULL if an interrupt handler was interrupted. */
+    uint32_t u32Count;      /* Samples that fell in this bucket, 0 if the bucket is free. */
+} ProfilerBucket_t;
+
+/* Configure TIMER3 to interrupt u32SampleHz times a second.  Sampling does not
+   start until vProfilerStart() is called.  Returns the rate the timer
+   actually runs at. */
+uint32_t ulProfilerInit(uint32_t u32SampleHz);
+
+/* Start or stop taking samples.  The histogram is kept while stopped. */
+void vProfilerStart(void);
+void vProfilerStop(void);
+
+/* Empty the histogram and clear the sample counts. */
+void vProfilerReset(void);
+
+/* Samples taken so far, and samples lost because the histogram was full. */
+uint32_t ulProfilerGetSamples(void);
+uint32_t ulProfilerGetDropped(void);
+
+/* Copy the histogram, one bucket at a time, and print it with printf() in the
+   format profiler_report.py reads.  Call from a task; sampling can continue
+   while it prints. */
+void vProfilerDump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROFILER_H__ */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * @file     profiler_bench.c
+ * @version  V1.00
+ * @brief    Finding the hot spots of a few tasks with the sampling profiler.
+ *
+ * To use it, set configUSE_PROFILER and configUSE_PROFILER_BENCH to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * A CRC task checksums a buffer a bit at a time, a sort task insertion sorts a
+ * shuffled array, and two tasks pass a counter back and forth through a pair
+ * of queues, each at the same priority, so they share the CPU.  The profiler
+ * runs for BENCH_RUN_TICKS ticks and the histogram is printed.  Save the
+ * output from the "P" line to the "E" line to a file and run
+ *
+ *     python profiler_report.py <log> <map file>
+ *
+ * on the host to see the time spent in each function, by task, and where the
+ * hot functions were called from.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "profiler.h"
+
+#if (configUSE_PROFILER == 1) && (configUSE_PROFILER_BENCH == 1)
+
+#define BENCH_RUN_TICKS         3000
+#define BENCH_CRC_BYTES         64
+#define BENCH_SORT_ITEMS        48
+#define BENCH_OTHER_PRIORITY    1
+#define BENCH_TASK_PRIORITY     2
+
+static uint8_t s_au8Data[BENCH_CRC_BYTES];
+static uint16_t s_au16Items[BENCH_SORT_ITEMS];
+static QueueHandle_t s_xPing;
+static QueueHandle_t s_xPong;
+static volatile uint32_t s_u32Crc;
+static volatile uint32_t s_u32Rounds;
+
+static uint32_t Crc32(const uint8_t *pu8Data, uint32_t u32Bytes)
+{
+    uint32_t u32Crc = 0xFFFFFFFFUL, i, j;
+
+    for(i = 0; i < u32Bytes; i++)
+    {
+        u32Crc ^= pu8Data[i];
+        for(j = 0; j < 8; j++)
+            u32Crc = (u32Crc >> 1) ^ (0xEDB88320UL & (0UL - (u32Crc & 1UL)));
+    }
+
+    return ~u32Crc;
+}
+
+static void InsertionSort(uint16_t *pu16Items, uint32_t u32Count)
+{
+    uint32_t i, j;
+    uint16_t u16Item;
+
+    for(i = 1; i < u32Count; i++)
+    {
+        u16Item = pu16Items[i];
+        for(j = i; (j > 0) && (pu16Items[j - 1] > u16Item); j--)
+            pu16Items[j] = pu16Items[j - 1];
+        pu16Items[j] = u16Item;
+    }
+}
+
+static void CrcTask(void *pvParameters)
+{
+    uint32_t i;
+
+    (void)pvParameters;
+
+    for(i = 0; i < BENCH_CRC_BYTES; i++)
+        s_au8Data[i] = (uint8_t)(i * 7);
+
+    for(;;)
+        s_u32Crc = Crc32(s_au8Data, BENCH_CRC_BYTES);
+}
+
+static void SortTask(void *pvParameters)
+{
+    uint32_t i, u32Seed = 1;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        for(i = 0; i < BENCH_SORT_ITEMS; i++)
+        {
+            u32Seed = u32Seed * 1103515245UL + 12345UL;
+            s_au16Items[i] = (uint16_t)(u32Seed >> 16);
+        }
+        InsertionSort(s_au16Items, BENCH_SORT_ITEMS);
+    }
+}
+
+static void PingTask(void *pvParameters)
+{
+    uint32_t u32Value = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)xQueueSend(s_xPing, &u32Value, portMAX_DELAY);
+        (void)xQueueReceive(s_xPong, &u32Value, portMAX_DELAY);
+        s_u32Rounds++;
+    }
+}
+
+static void PongTask(void *pvParameters)
+{
+    uint32_t u32Value;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        (void)xQueueReceive(s_xPing, &u32Value, portMAX_DELAY);
+        u32Value++;
+        (void)xQueueSend(s_xPong, &u32Value, portMAX_DELAY);
+    }
+}
+
+static void ProfilerBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    vProfilerReset();
+    vProfilerStart();
+    vTaskDelay(BENCH_RUN_TICKS);
+    vProfilerStop();
+
+    printf("%u ping-pong rounds, crc %08x\n", (unsigned int)s_u32Rounds, (unsigned int)s_u32Crc);
+    vProfilerDump();
+
+    if(ulProfilerGetDropped() != 0UL)
+        printf("%u samples dropped, increase configPROFILER_BUCKETS or configPROFILER_PC_SHIFT\n",
+               (unsigned int)ulProfilerGetDropped());
+
+    vTaskDelete(NULL);
+}
+
+void vProfilerBenchStart(void)
+{
+    s_xPing = xQueueCreate(1, sizeof(uint32_t));
+    s_xPong = xQueueCreate(1, sizeof(uint32_t));
+
+    (void)xTaskCreate(ProfilerBenchTask, "PfBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(CrcTask, "Crc", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+    (void)xTaskCreate(SortTask, "Sort", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+    (void)xTaskCreate(PingTask, "Ping", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+    (void)xTaskCreate(PongTask, "Pong", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+}
+
+#endif /* configUSE_PROFILER_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
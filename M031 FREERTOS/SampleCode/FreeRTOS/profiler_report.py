@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+#
+# profiler_report.py
+#
+# Turns the histogram printed by vProfilerDump() in profiler.c into function
+# level hot spots, using the map file of the Keil (armlink) or GCC (ld) build
+# that produced it.
+#
+#     python profiler_report.py <log> <map file> [-n <lines>]
+#
+# The log is the UART output; lines other than those from "P" to "E" are
+# ignored.  Keil map files need the Image Symbol Table, which armlink writes
+# with --symbols (Options for Target, Listing, Symbols).  GCC map files list
+# static functions only when built with -ffunction-sections.
+#
+# Three tables are printed: samples by function, samples by task and function,
+# and where each of the hottest functions was called from.  The caller is the
+# function the stacked LR points into, which is the caller only while the
+# sampled function has not yet made a call of its own, so it is most reliable
+# for leaf functions.
+#
+# Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+#
+
+import argparse
+import bisect
+import re
+import sys
+from collections import defaultdict
+
+# Keil:  "    Crc32    0x00000d15   Thumb Code    60  profiler_bench.o(.text)"
+KEIL_SYMBOL = re.compile(r'^\s*(\S+)\s+0x([0-9a-fA-F]+)\s+(?:Thumb|ARM) Code\s+(\d+)\s+\S+')
+# GCC:   " .text.Crc32    0x00000d14       0x3c ./profiler_bench.o"
+# with the address on the next line if the section name is long.
+GCC_SECTION = re.compile(r'^\s*\.text\.(\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+\S+)?\s*$')
+GCC_SECTION_ADDRESS = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+\S+\s*$')
+GCC_TEXT = re.compile(r'^\s*\.text\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+\S+\s*$')
+# GCC:   "                0x00000d14                Crc32"
+GCC_SYMBOL = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_]\w*)\s*$')
+
+HEADER = re.compile(r'^P\s+hz=(\d+)\s+samples=(\d+)\s+dropped=(\d+)\s+shift=(\d+)')
+SAMPLE = re.compile(r'^S\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\d+)\s+(\S+)')
+
+
+class SymbolTable:
+    def __init__(self, symbols, sections):
+        # symbols: {address: (name, size or None)}, sections: [(start, end)]
+        self.starts = sorted(symbols)
+        self.names = [symbols[a][0] for a in self.starts]
+        self.ends = []
+        for i, start in enumerate(self.starts):
+            size = symbols[start][1]
+            if size is not None:
+                self.ends.append(start + size)
+                continue
+            # A GCC symbol runs up to the next one, within its section.
+            end = self.starts[i + 1] if i + 1 < len(self.starts) else None
+            for first, last in sections:
+                if first <= start < last:
+                    end = last if end is None else min(end, last)
+            self.ends.append(start if end is None else end)
+
+    def lookup(self, address):
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i < 0 or address >= self.ends[i]:
+            return '?%08x' % address
+        return self.names[i]
+
+
+def read_map(path):
+    symbols = {}
+    sections = []
+    keil = False
+    pending = None
+
+    with open(path, errors='replace') as f:
+        for line in f:
+            if 'Image Symbol Table' in line:
+                keil = True
+                continue
+
+            if keil:
+                m = KEIL_SYMBOL.match(line)
+                if m:
+                    # Thumb symbols have bit 0 set.
+                    address = int(m.group(2), 16) & ~1
+                    size = int(m.group(3))
+                    if size > 0:
+                        symbols[address] = (m.group(1), size)
+                continue
+
+            if pending is not None:
+                m = GCC_SECTION_ADDRESS.match(line)
+                if m and int(m.group(2), 16) > 0:
+                    symbols.setdefault(int(m.group(1), 16), (pending, int(m.group(2), 16)))
+                    sections.append((int(m.group(1), 16), int(m.group(1), 16) + int(m.group(2), 16)))
+                pending = None
+                continue
+
+            m = GCC_SECTION.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending = m.group(1)
+                elif int(m.group(3), 16) > 0:
+                    symbols.setdefault(int(m.group(2), 16), (m.group(1), int(m.group(3), 16)))
+                    sections.append((int(m.group(2), 16), int(m.group(2), 16) + int(m.group(3), 16)))
+                continue
+
+            m = GCC_TEXT.match(line)
+            if m:
+                sections.append((int(m.group(1), 16), int(m.group(1), 16) + int(m.group(2), 16)))
+                continue
+
+            m = GCC_SYMBOL.match(line)
+            if m:
+                address = int(m.group(1), 16)
+                # A symbol replaces the name of a section starting there.
+                symbols[address] = (m.group(2), None)
+
+    if not symbols:
+        sys.exit('%s: no code symbols found' % path)
+    return SymbolTable(symbols, sections)
+
+
+def read_log(path):
+    header = None
+    samples = []
+    taking = False
+
+    with open(path, errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            m = HEADER.match(line)
+            if m:
+                header = [int(g) for g in m.groups()]
+                samples = []
+                taking = True
+                continue
+            if not taking:
+                continue
+            if line == 'E':
+                taking = False
+                continue
+            m = SAMPLE.match(line)
+            if m:
+                samples.append((int(m.group(1), 16), int(m.group(2), 16), int(m.group(3)), m.group(4)))
+
+    if header is None:
+        sys.exit('%s: no profiler dump found' % path)
+    return header, samples
+
+
+def print_table(title, rows, total, lines):
+    print(title)
+    for count, label in sorted(rows, key=lambda r: -r[0])[:lines]:
+        print('  %6d %5.1f%%  %s' % (count, 100.0 * count / total, label))
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Symbolise a profiler.c histogram.')
+    parser.add_argument('log', help='UART output containing the output of vProfilerDump()')
+    parser.add_argument('map', help='Keil or GCC map file of the build that was profiled')
+    parser.add_argument('-n', '--lines', type=int, default=20, help='lines in each table')
+    args = parser.parse_args()
+
+    table = read_map(args.map)
+    (hz, taken, dropped, shift), samples = read_log(args.log)
+    total = sum(s[2] for s in samples)
+    if total == 0:
+        sys.exit('no samples')
+
+    print('%d samples at %d Hz (%.2f s), %d dropped, PC resolution %d bytes' %
+          (total, hz, float(total) / hz if hz else 0.0, dropped, 1 << shift))
+    if total != taken:
+        print('warning: the dump has %d samples, the header %d' % (total, taken))
+    print()
+
+    functions = defaultdict(int)
+    tasks = defaultdict(int)
+    callers = defaultdict(lambda: defaultdict(int))
+    for pc, lr, count, task in samples:
+        function = table.lookup(pc)
+        functions[function] += count
+        tasks[(task, function)] += count
+        callers[function][table.lookup(lr)] += count
+
+    print_table('by function:', [(c, f) for f, c in functions.items()], total, args.lines)
+    print_table('by task:', [(c, '%-10s %s' % t) for t, c in tasks.items()], total, args.lines)
+
+    print('callers of the hottest functions:')
+    for count, function in sorted(((c, f) for f, c in functions.items()), reverse=True)[:5]:
+        print('  %s (%d):' % (function, count))
+        for n, caller in sorted(((n, c) for c, n in callers[function].items()), reverse=True)[:5]:
+            print('    %6d %5.1f%%  %s' % (n, 100.0 * n / count, caller))
+
+
+if __name__ == '__main__':
+    main()
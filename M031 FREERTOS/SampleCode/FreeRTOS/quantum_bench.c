@@ -0,0 +1,138 @@
+/******************************************************************************
+ * @file     quantum_bench.c
+ * @version  V1.00
+ * @brief    Context switches between batch tasks against the time slice.
+ *
+ * To use it, set configUSE_TIME_SLICE_QUANTUM and configUSE_QUANTUM_BENCH to
+ * 1 in FreeRTOSConfig.h.
+ *
+ * BENCH_WORKERS batch tasks of equal priority compute without ever blocking,
+ * so time slicing is all that switches between them.  Their time slice
+ * quantum is set with vTaskSetTimeSliceQuantum() to each of s_auxQuanta[] in
+ * turn, and for BENCH_RUN_TICKS ticks at each the switches from one worker to
+ * another and the work loops completed are counted.  The switches are printed
+ * with the percentage they are of the switches with a quantum of 1 tick, the
+ * time slicing used without configUSE_TIME_SLICE_QUANTUM.
+ *
+ * The last run uses a quantum of BENCH_PREEMPT_QUANTUM ticks while a task of
+ * higher priority wakes every BENCH_PREEMPT_TICKS ticks, preempting the
+ * workers part way through their slices.  A preempted worker carries on with
+ * the rest of its slice, so the switches between workers stay near
+ * BENCH_RUN_TICKS / BENCH_PREEMPT_QUANTUM rather than following the number of
+ * preemptions.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_TIME_SLICE_QUANTUM == 1) && (configUSE_QUANTUM_BENCH == 1)
+
+#define BENCH_WORKERS           3
+#define BENCH_RUN_TICKS         1000
+#define BENCH_PREEMPT_QUANTUM   10
+#define BENCH_PREEMPT_TICKS     3
+#define BENCH_WORKER_PRIORITY   1
+#define BENCH_TASK_PRIORITY     2
+#define BENCH_PREEMPT_PRIORITY  3
+
+static const UBaseType_t s_auxQuanta[] = { 1, 2, 5, 10, 20 };
+
+static TaskHandle_t s_axWorkers[BENCH_WORKERS];
+static volatile uint32_t s_u32LastWorker;
+static volatile uint32_t s_u32Switches;
+static volatile uint32_t s_u32Work;
+static volatile uint32_t s_u32Preemptions;
+
+static void WorkerTask(void *pvParameters)
+{
+    uint32_t u32Worker = (uint32_t)pvParameters;
+
+    for(;;)
+    {
+        /* Another worker ran since this one last looped. */
+        if(s_u32LastWorker != u32Worker)
+        {
+            s_u32LastWorker = u32Worker;
+            s_u32Switches++;
+        }
+
+        s_u32Work++;
+    }
+}
+
+/* Wakes every BENCH_PREEMPT_TICKS ticks and blocks again at once. */
+static void PreemptTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_PREEMPT_TICKS);
+        s_u32Preemptions++;
+    }
+}
+
+static void QuantumBenchTask(void *pvParameters)
+{
+    TaskHandle_t xPreempt;
+    uint32_t i, j, u32Base = 0;
+
+    (void)pvParameters;
+
+    printf("%u batch tasks, %u ticks per quantum\n", (unsigned int)BENCH_WORKERS, (unsigned int)BENCH_RUN_TICKS);
+
+    for(i = 0; i < sizeof(s_auxQuanta) / sizeof(s_auxQuanta[0]); i++)
+    {
+        for(j = 0; j < BENCH_WORKERS; j++)
+            vTaskSetTimeSliceQuantum(s_axWorkers[j], s_auxQuanta[i]);
+
+        /* The workers only run while this task is blocked. */
+        s_u32Switches = 0;
+        s_u32Work = 0;
+        vTaskDelay(BENCH_RUN_TICKS);
+
+        if(i == 0)
+            u32Base = s_u32Switches;
+
+        printf("quantum %2u ticks: switches=%4u (%3u%%) work=%u\n", (unsigned int)s_auxQuanta[i],
+               (unsigned int)s_u32Switches, (unsigned int)((u32Base != 0) ? (s_u32Switches * 100) / u32Base : 0),
+               (unsigned int)s_u32Work);
+    }
+
+    for(j = 0; j < BENCH_WORKERS; j++)
+        vTaskSetTimeSliceQuantum(s_axWorkers[j], BENCH_PREEMPT_QUANTUM);
+
+    s_u32Switches = 0;
+    s_u32Work = 0;
+    s_u32Preemptions = 0;
+    (void)xTaskCreate(PreemptTask, "Prmpt", configMINIMAL_STACK_SIZE, NULL, BENCH_PREEMPT_PRIORITY, &xPreempt);
+    vTaskDelay(BENCH_RUN_TICKS);
+    vTaskDelete(xPreempt);
+
+    printf("quantum %2u ticks, preempted every %u: switches=%4u (about %u expected) preemptions=%u work=%u\n",
+           (unsigned int)BENCH_PREEMPT_QUANTUM, (unsigned int)BENCH_PREEMPT_TICKS, (unsigned int)s_u32Switches,
+           (unsigned int)(BENCH_RUN_TICKS / BENCH_PREEMPT_QUANTUM), (unsigned int)s_u32Preemptions,
+           (unsigned int)s_u32Work);
+
+    for(j = 0; j < BENCH_WORKERS; j++)
+        vTaskDelete(s_axWorkers[j]);
+
+    vTaskDelete(NULL);
+}
+
+void vQuantumBenchStart(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < BENCH_WORKERS; i++)
+        (void)xTaskCreate(WorkerTask, "Batch", 64, (void *)i, BENCH_WORKER_PRIORITY, &s_axWorkers[i]);
+    (void)xTaskCreate(QuantumBenchTask, "QBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_QUANTUM_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * @file     rwlock_bench.c
+ * @version  V1.00
+ * @brief    Read throughput of a readers-writer lock against a mutex.
+ *
+ * To use it, set configUSE_RWLOCK_BENCH to 1 in FreeRTOSConfig.h.  TIMER0
+ * free-runs at the HIRC frequency, which is also HCLK, so times are reported
+ * in CPU cycles.
+ *
+ * Four reader tasks of equal priority repeatedly sum a shared table, which
+ * takes long enough that time slicing often switches readers part way through
+ * a read.  A higher priority writer task updates the table every
+ * BENCH_WRITE_TICKS ticks.  The table is protected first by a mutex and then by
+ * a readers-writer lock, for BENCH_RUN_TICKS ticks each, and the number of
+ * completed reads and writes and the longest time the writer waited for the
+ * lock are printed for each.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rwlock.h"
+#include "bench_common.h"
+
+#if (configUSE_RWLOCK_BENCH == 1)
+
+#define BENCH_READERS           4
+#define BENCH_TABLE_SIZE        64
+#define BENCH_READ_PASSES       8       /* Passes over the table per read. */
+#define BENCH_WRITE_TICKS       10
+#define BENCH_RUN_TICKS         1000
+#define BENCH_READER_PRIORITY   1
+#define BENCH_WRITER_PRIORITY   2
+#define BENCH_TASK_PRIORITY     3
+
+enum
+{
+    BENCH_MODE_IDLE,
+    BENCH_MODE_MUTEX,
+    BENCH_MODE_RWLOCK
+};
+
+static volatile uint32_t s_au32Table[BENCH_TABLE_SIZE];
+static volatile uint32_t s_u32Mode = BENCH_MODE_IDLE;
+static volatile uint32_t s_au32Reads[BENCH_READERS];
+static volatile uint32_t s_u32Writes, s_u32MaxWriteWait;
+
+static SemaphoreHandle_t s_xMutex;
+static RWLockHandle_t s_xRWLock;
+
+static void ReaderTask(void *pvParameters)
+{
+    uint32_t u32Reader = (uint32_t)pvParameters;
+    uint32_t u32Mode, u32Sum, i, j;
+
+    for(;;)
+    {
+        /* Give the lock back the same way it was taken even if the mode
+           changes part way through the read. */
+        u32Mode = s_u32Mode;
+
+        if(u32Mode == BENCH_MODE_MUTEX)
+            (void)xSemaphoreTake(s_xMutex, portMAX_DELAY);
+        else if(u32Mode == BENCH_MODE_RWLOCK)
+            (void)xRWLockTakeRead(s_xRWLock, portMAX_DELAY);
+        else
+        {
+            vTaskDelay(1);
+            continue;
+        }
+
+        u32Sum = 0;
+        for(j = 0; j < BENCH_READ_PASSES; j++)
+        {
+            for(i = 0; i < BENCH_TABLE_SIZE; i++)
+                u32Sum += s_au32Table[i];
+        }
+
+        if(u32Mode == BENCH_MODE_MUTEX)
+            (void)xSemaphoreGive(s_xMutex);
+        else
+            (void)xRWLockGiveRead(s_xRWLock);
+
+        /* Every write keeps the table summing to zero. */
+        configASSERT(u32Sum == 0);
+        s_au32Reads[u32Reader]++;
+    }
+}
+
+static void WriterTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    uint32_t u32Mode, u32Start, u32Wait, i;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, BENCH_WRITE_TICKS);
+
+        u32Mode = s_u32Mode;
+        if(u32Mode == BENCH_MODE_IDLE)
+            continue;
+
+        u32Start = BENCH_NOW();
+        if(u32Mode == BENCH_MODE_MUTEX)
+            (void)xSemaphoreTake(s_xMutex, portMAX_DELAY);
+        else
+            (void)xRWLockTakeWrite(s_xRWLock, portMAX_DELAY);
+        u32Wait = BENCH_SINCE(u32Start);
+
+        /* Move a value between two entries so the sum stays zero. */
+        i = s_u32Writes % (BENCH_TABLE_SIZE - 1);
+        s_au32Table[i] += 1;
+        s_au32Table[i + 1] -= 1;
+
+        if(u32Mode == BENCH_MODE_MUTEX)
+            (void)xSemaphoreGive(s_xMutex);
+        else
+            (void)xRWLockGiveWrite(s_xRWLock);
+
+        s_u32Writes++;
+        if(u32Wait > s_u32MaxWriteWait)
+            s_u32MaxWriteWait = u32Wait;
+    }
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    uint32_t i, u32Reads = 0;
+
+    for(i = 0; i < BENCH_READERS; i++)
+        s_au32Reads[i] = 0;
+    s_u32Writes = 0;
+    s_u32MaxWriteWait = 0;
+
+    s_u32Mode = u32Mode;
+    vTaskDelay(BENCH_RUN_TICKS);
+    s_u32Mode = BENCH_MODE_IDLE;
+
+    for(i = 0; i < BENCH_READERS; i++)
+        u32Reads += s_au32Reads[i];
+
+    printf("%-6s reads=%6u writes=%4u writer wait max=%6u cycles\n", pcName, (unsigned int)u32Reads,
+           (unsigned int)s_u32Writes, (unsigned int)s_u32MaxWriteWait);
+
+    /* Let the readers and the writer finish with the lock. */
+    vTaskDelay(BENCH_WRITE_TICKS * 2);
+}
+
+static void RWLockBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        BenchRun(BENCH_MODE_MUTEX, "mutex");
+        BenchRun(BENCH_MODE_RWLOCK, "rwlock");
+    }
+}
+
+void vRWLockBenchStart(void)
+{
+    uint32_t i;
+
+    BenchTimerInit(TIMER0);
+
+    s_xMutex = xSemaphoreCreateMutex();
+    s_xRWLock = xRWLockCreate();
+
+    for(i = 0; i < BENCH_READERS; i++)
+        (void)xTaskCreate(ReaderTask, "Rd", 64, (void *)i, BENCH_READER_PRIORITY, NULL);
+    (void)xTaskCreate(WriterTask, "Wr", 64, NULL, BENCH_WRITER_PRIORITY, NULL);
+    (void)xTaskCreate(RWLockBenchTask, "RWBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+}
+
+#endif /* configUSE_RWLOCK_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * @file     snapshot_bench.c
+ * @version  V1.00
+ * @brief    A control task's wake up delay while a monitor reads the tasks.
+ *
+ * To use it, set configUSE_TASK_SNAPSHOT and configUSE_SNAPSHOT_BENCH to 1 in
+ * FreeRTOSConfig.h.  TIMER0 free-runs at the HIRC frequency, which is also
+ * HCLK, so times are reported in CPU cycles.
+ *
+ * A control task wakes every tick at the highest priority and records how
+ * much later than a tick after its previous wake up it runs.  A monitor task
+ * below it reads the state of every task each BENCH_POLL_TICKS ticks, first
+ * with uxTaskGetSystemState(), which suspends the scheduler until it has read
+ * them all, and then with eTaskSnapshotNext(), which reads one task in each
+ * short critical section and packs it into a record.  A churn task creates a
+ * short lived task every BENCH_CHURN_TICKS ticks, so some snapshots are
+ * restarted.  For BENCH_RUN_TICKS ticks each, the control task's latest wake
+ * up in cycles, the polls and, for the snapshots, the records and restarts are
+ * printed.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#if (configUSE_TASK_SNAPSHOT == 1) && (configUSE_SNAPSHOT_BENCH == 1)
+
+#define BENCH_RUN_TICKS         3000
+#define BENCH_POLL_TICKS        100
+#define BENCH_CHURN_TICKS       7
+#define BENCH_FILLERS           2
+#define BENCH_MAX_TASKS         10
+#define BENCH_CYCLES_PER_TICK   (__HIRC / configTICK_RATE_HZ)
+#define BENCH_OTHER_PRIORITY    1
+#define BENCH_TASK_PRIORITY     2
+#define BENCH_CONTROL_PRIORITY  (configMAX_PRIORITIES - 1)
+
+enum
+{
+    BENCH_MODE_SYSTEM_STATE,
+    BENCH_MODE_SNAPSHOT
+};
+
+static TaskStatus_t s_axStatus[BENCH_MAX_TASKS];
+static uint8_t s_au8Records[BENCH_MAX_TASKS * tskSNAPSHOT_RECORD_LENGTH];
+static volatile uint32_t s_u32MaxLate;
+static volatile uint32_t s_u32Wakes;
+
+static void ControlTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+    uint32_t u32Now, u32Last, u32Interval;
+
+    (void)pvParameters;
+
+    vTaskDelayUntil(&xLastWake, 1);
+    u32Last = BENCH_NOW();
+
+    for(;;)
+    {
+        vTaskDelayUntil(&xLastWake, 1);
+        u32Now = BENCH_NOW();
+        u32Interval = (u32Now - u32Last) & BENCH_TIMER_MASK;
+        u32Last = u32Now;
+
+        if((u32Interval > BENCH_CYCLES_PER_TICK) && ((u32Interval - BENCH_CYCLES_PER_TICK) > s_u32MaxLate))
+            s_u32MaxLate = u32Interval - BENCH_CYCLES_PER_TICK;
+        s_u32Wakes++;
+    }
+}
+
+static void FillerTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+        vTaskSuspend(NULL);
+}
+
+static void ShortLivedTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    vTaskDelete(NULL);
+}
+
+static void ChurnTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_CHURN_TICKS);
+        (void)xTaskCreate(ShortLivedTask, "Short", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+    }
+}
+
+/* Returns the records packed, or 0 if the snapshot had to be restarted. */
+static uint32_t SnapshotPoll(void)
+{
+    TaskSnapshot_t xSnapshot;
+    TaskStatus_t xStatus;
+    eSnapshotResult eResult;
+    uint32_t u32Records = 0;
+
+    vTaskSnapshotStart(&xSnapshot);
+
+    for(;;)
+    {
+        eResult = eTaskSnapshotNext(&xSnapshot, &xStatus, pdTRUE);
+        if(eResult != eSnapshotTask)
+            break;
+
+        if(u32Records < BENCH_MAX_TASKS)
+        {
+            (void)xTaskSnapshotEncode(&xSnapshot, &xStatus, &s_au8Records[u32Records * tskSNAPSHOT_RECORD_LENGTH]);
+            u32Records++;
+        }
+    }
+
+    return (eResult == eSnapshotComplete) ? u32Records : 0;
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    TickType_t xLastPoll = xTaskGetTickCount(), xStart = xLastPoll;
+    uint32_t u32Polls = 0, u32Records = 0, u32Restarts = 0, u32Packed;
+
+    s_u32MaxLate = 0;
+    s_u32Wakes = 0;
+
+    while((xTaskGetTickCount() - xStart) < BENCH_RUN_TICKS)
+    {
+        vTaskDelayUntil(&xLastPoll, BENCH_POLL_TICKS);
+
+        if(u32Mode == BENCH_MODE_SYSTEM_STATE)
+        {
+            (void)uxTaskGetSystemState(s_axStatus, BENCH_MAX_TASKS, NULL);
+        }
+        else
+        {
+            /* Start again until a snapshot is not disturbed. */
+            while((u32Packed = SnapshotPoll()) == 0)
+                u32Restarts++;
+            u32Records += u32Packed;
+        }
+        u32Polls++;
+    }
+
+    if(u32Mode == BENCH_MODE_SYSTEM_STATE)
+        printf("%-12s control latest=%5u cycles wakes=%u polls=%u\n", pcName, (unsigned int)s_u32MaxLate,
+               (unsigned int)s_u32Wakes, (unsigned int)u32Polls);
+    else
+        printf("%-12s control latest=%5u cycles wakes=%u polls=%u records=%u restarts=%u\n", pcName,
+               (unsigned int)s_u32MaxLate, (unsigned int)s_u32Wakes, (unsigned int)u32Polls,
+               (unsigned int)u32Records, (unsigned int)u32Restarts);
+}
+
+static void SnapshotBenchTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    printf("%u ticks per run, polled every %u ticks, %u bytes per record\n", (unsigned int)BENCH_RUN_TICKS,
+           (unsigned int)BENCH_POLL_TICKS, (unsigned int)tskSNAPSHOT_RECORD_LENGTH);
+
+    BenchRun(BENCH_MODE_SYSTEM_STATE, "system state");
+    BenchRun(BENCH_MODE_SNAPSHOT, "snapshot");
+
+    vTaskDelete(NULL);
+}
+
+void vSnapshotBenchStart(void)
+{
+    uint32_t i;
+
+    BenchTimerInit(TIMER0);
+
+    (void)xTaskCreate(SnapshotBenchTask, "SnBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(ControlTask, "Ctrl", 80, NULL, BENCH_CONTROL_PRIORITY, NULL);
+    (void)xTaskCreate(ChurnTask, "Churn", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+    for(i = 0; i < BENCH_FILLERS; i++)
+        (void)xTaskCreate(FillerTask, "Fill", configMINIMAL_STACK_SIZE, NULL, BENCH_OTHER_PRIORITY, NULL);
+}
+
+#endif /* configUSE_SNAPSHOT_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * @file     stack_bench.c
+ * @version  V1.00
+ * @brief    Stack sizes recommended from the watermarks kept by the idle task.
+ *
+ * To use it, set configUSE_STACK_WATERMARK and configUSE_STACK_BENCH to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Three tasks are created with the BENCH_GUESSED_STACK words of stack the
+ * sample tasks in main.c are given.  A printer task prints a line now and
+ * then, a filter task works on a small buffer on its stack, and a parser task
+ * recurses one level deeper each second, up to BENCH_PARSE_MAX_LEVELS, so its
+ * stack use grows until it comes within configSTACK_WATERMARK_MARGIN words of
+ * the end of its stack.  The idle task scans one stack each time it runs,
+ * and vApplicationStackMarginHook() records the tasks that come within the
+ * margin.  Every BENCH_REPORT_TICKS ticks the report of uxTaskGetStackReport()
+ * is printed, with the margin alerts, and after BENCH_REPORTS reports the
+ * words that the recommendations would reclaim.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (configUSE_STACK_WATERMARK == 1) && (configUSE_STACK_BENCH == 1)
+
+#define BENCH_GUESSED_STACK     100
+#define BENCH_REPORT_TICKS      1000
+#define BENCH_REPORTS           8
+#define BENCH_MAX_TASKS         8
+#define BENCH_MAX_ALERTS        4
+#define BENCH_PARSE_WORDS       8       /* Words of stack each level of the parser uses. */
+#define BENCH_PARSE_MAX_LEVELS  6       /* Within the margin, short of overflowing. */
+#define BENCH_FILTER_TAPS       16
+#define BENCH_OTHER_PRIORITY    1
+#define BENCH_TASK_PRIORITY     2
+
+static TaskStackReport_t s_axReport[BENCH_MAX_TASKS];
+static TaskHandle_t s_axAlerts[BENCH_MAX_ALERTS];
+static volatile uint32_t s_u32Alerts;
+static volatile uint32_t s_u32ParseLevels;
+
+/* Called from the idle task, so it must not block. */
+void vApplicationStackMarginHook(TaskHandle_t xTask, char *pcTaskName, configSTACK_DEPTH_TYPE uxFreeWords)
+{
+    (void)pcTaskName;
+    (void)uxFreeWords;
+
+    if(s_u32Alerts < BENCH_MAX_ALERTS)
+        s_axAlerts[s_u32Alerts] = xTask;
+    s_u32Alerts++;
+}
+
+static void PrinterTask(void *pvParameters)
+{
+    uint32_t u32Lines = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_REPORT_TICKS / 2);
+        printf("printer line %u\n", (unsigned int)u32Lines++);
+    }
+}
+
+static void FilterTask(void *pvParameters)
+{
+    volatile uint32_t au32Taps[BENCH_FILTER_TAPS];
+    uint32_t i, u32Sum = 0;
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(10);
+
+        for(i = 0; i < BENCH_FILTER_TAPS; i++)
+            au32Taps[i] = u32Sum + i;
+        for(i = 0; i < BENCH_FILTER_TAPS; i++)
+            u32Sum += au32Taps[i];
+    }
+}
+
+static uint32_t Parse(uint32_t u32Levels)
+{
+    volatile uint32_t au32Frame[BENCH_PARSE_WORDS];
+
+    au32Frame[0] = u32Levels;
+    if(u32Levels > 1)
+        au32Frame[1] = Parse(u32Levels - 1);
+
+    return au32Frame[0];
+}
+
+static void ParserTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelay(BENCH_REPORT_TICKS);
+
+        /* A message nested one level deeper than the last. */
+        if(s_u32ParseLevels < BENCH_PARSE_MAX_LEVELS)
+            s_u32ParseLevels++;
+        (void)Parse(s_u32ParseLevels);
+    }
+}
+
+static void StackBenchTask(void *pvParameters)
+{
+    uint32_t i, j, u32Reclaimed;
+    UBaseType_t uxTasks = 0;
+
+    (void)pvParameters;
+
+    printf("stacks of %u words, margin %u words\n", (unsigned int)BENCH_GUESSED_STACK,
+           (unsigned int)configSTACK_WATERMARK_MARGIN);
+
+    for(i = 0; i < BENCH_REPORTS; i++)
+    {
+        vTaskDelay(BENCH_REPORT_TICKS);
+
+        uxTasks = uxTaskGetStackReport(s_axReport, BENCH_MAX_TASKS);
+
+        printf("report %u, parser %u levels deep\n", (unsigned int)i, (unsigned int)s_u32ParseLevels);
+        for(j = 0; j < uxTasks; j++)
+            printf("  %-8s depth=%4u min free=%4u recommended=%4u\n", s_axReport[j].pcTaskName,
+                   (unsigned int)s_axReport[j].uxStackDepth, (unsigned int)s_axReport[j].uxMinimumEverFree,
+                   (unsigned int)s_axReport[j].uxRecommendedDepth);
+        for(j = 0; (j < s_u32Alerts) && (j < BENCH_MAX_ALERTS); j++)
+            printf("  alert: %s is within the margin\n", pcTaskGetName(s_axAlerts[j]));
+    }
+
+    /* Words freed if each task were given its recommended stack. */
+    u32Reclaimed = 0;
+    for(j = 0; j < uxTasks; j++)
+    {
+        if(s_axReport[j].uxRecommendedDepth < s_axReport[j].uxStackDepth)
+            u32Reclaimed += s_axReport[j].uxStackDepth - s_axReport[j].uxRecommendedDepth;
+    }
+    printf("recommended sizes reclaim %u words (%u bytes)\n", (unsigned int)u32Reclaimed,
+           (unsigned int)(u32Reclaimed * sizeof(StackType_t)));
+
+    vTaskDelete(NULL);
+}
+
+void vStackBenchStart(void)
+{
+    (void)xTaskCreate(StackBenchTask, "StBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(PrinterTask, "Printer", BENCH_GUESSED_STACK, NULL, BENCH_OTHER_PRIORITY, NULL);
+    (void)xTaskCreate(FilterTask, "Filter", BENCH_GUESSED_STACK, NULL, BENCH_OTHER_PRIORITY, NULL);
+    (void)xTaskCreate(ParserTask, "Parser", BENCH_GUESSED_STACK, NULL, BENCH_OTHER_PRIORITY, NULL);
+}
+
+#endif /* configUSE_STACK_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * @file     task_pool_bench.c
+ * @version  V1.00
+ * @brief    Creating and deleting connection tasks from the heap and a pool.
+ *
+ * To use it, set configUSE_TASK_POOLS and configUSE_TASK_POOL_BENCH to 1 in
+ * FreeRTOSConfig.h.  TIMER0 free-runs at the HIRC frequency, which is also
+ * HCLK, so times are reported in CPU cycles.
+ *
+ * A server task accepts BENCH_CONNECTIONS connections, creating a handler task
+ * for each.  Every other handler serves its connection and deletes itself, and
+ * the rest are closed by the server, which deletes them.  A load task that
+ * never blocks runs below them, so the idle task does not run.  The handlers
+ * are created first with xTaskCreate() and then with xTaskCreateFromPool(),
+ * from a pool of BENCH_POOL_TASKS.  The time each create and each delete by
+ * the server takes is printed, with the connections refused because a handler
+ * could not be created.  The handlers that delete themselves from the heap
+ * are not freed until the idle task runs, so the heap soon runs out, where
+ * those from the pool are back in the pool as soon as they are switched out.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#if (configUSE_TASK_POOLS == 1) && (configUSE_TASK_POOL_BENCH == 1)
+
+#define BENCH_CONNECTIONS       100
+#define BENCH_POOL_TASKS        2
+#define BENCH_HANDLER_STACK     80
+#define BENCH_HANDLER_LOOPS     200     /* Busy loops to serve each connection. */
+#define BENCH_LOAD_PRIORITY     1
+#define BENCH_HANDLER_PRIORITY  2
+#define BENCH_TASK_PRIORITY     3
+
+enum
+{
+    BENCH_MODE_HEAP,
+    BENCH_MODE_POOL
+};
+
+enum
+{
+    HANDLER_DELETES_ITSELF,
+    HANDLER_CLOSED_BY_SERVER
+};
+
+static TaskPoolHandle_t s_xPool;
+static TaskHandle_t s_xLoadTask;
+
+static void LatencyPrint(const char *pcName, const char *pcWhat, const BenchStats_t *pxLatency)
+{
+    printf("%-4s ", pcName);
+    BenchStatsPrint(pcWhat, pxLatency);
+}
+
+static void LoadTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    /* Never blocks, so the idle task only runs while this is suspended. */
+    for(;;)
+    {
+    }
+}
+
+static void HandlerTask(void *pvParameters)
+{
+    volatile uint32_t i;
+
+    for(i = 0; i < BENCH_HANDLER_LOOPS; i++)
+    {
+    }
+
+    if((uint32_t)pvParameters == HANDLER_DELETES_ITSELF)
+        vTaskDelete(NULL);
+
+    /* Wait for the server to close the connection. */
+    for(;;)
+        vTaskSuspend(NULL);
+}
+
+static void BenchRun(uint32_t u32Mode, const char *pcName)
+{
+    BenchStats_t xCreate, xDelete;
+    uint32_t i, u32Start, u32Cycles, u32Refused = 0;
+    TaskHandle_t xHandler;
+    BaseType_t xCreated;
+    size_t xHeapBefore = xPortGetFreeHeapSize();
+
+    BenchStatsReset(&xCreate);
+    BenchStatsReset(&xDelete);
+
+    for(i = 0; i < BENCH_CONNECTIONS; i++)
+    {
+        /* The handler runs below this task, so it is only created here. */
+        u32Start = BENCH_NOW();
+        if(u32Mode == BENCH_MODE_HEAP)
+            xCreated = xTaskCreate(HandlerTask, "Conn", BENCH_HANDLER_STACK, (void *)(i & 1), BENCH_HANDLER_PRIORITY, &xHandler);
+        else
+            xCreated = xTaskCreateFromPool(s_xPool, HandlerTask, "Conn", (void *)(i & 1), BENCH_HANDLER_PRIORITY, &xHandler);
+        u32Cycles = BENCH_SINCE(u32Start);
+
+        if(xCreated != pdPASS)
+        {
+            u32Refused++;
+            vTaskDelay(1);
+            continue;
+        }
+        BenchStatsRecord(&xCreate, u32Cycles);
+
+        /* Let the handler serve the connection. */
+        vTaskDelay(1);
+
+        if((i & 1) == HANDLER_CLOSED_BY_SERVER)
+        {
+            u32Start = BENCH_NOW();
+            vTaskDelete(xHandler);
+            BenchStatsRecord(&xDelete, BENCH_SINCE(u32Start));
+        }
+    }
+
+    LatencyPrint(pcName, "create", &xCreate);
+    LatencyPrint(pcName, "delete", &xDelete);
+    printf("%-4s refused=%u of %u, heap waiting for the idle task=%u bytes\n", pcName, (unsigned int)u32Refused,
+           (unsigned int)BENCH_CONNECTIONS, (unsigned int)(xHeapBefore - xPortGetFreeHeapSize()));
+
+    /* Let the idle task free the handlers that deleted themselves. */
+    vTaskSuspend(s_xLoadTask);
+    vTaskDelay(2);
+    vTaskResume(s_xLoadTask);
+}
+
+static void TaskPoolBenchTask(void *pvParameters)
+{
+    size_t xHeapBefore;
+
+    (void)pvParameters;
+
+    printf("%u connections, handler stack %u words\n", (unsigned int)BENCH_CONNECTIONS, (unsigned int)BENCH_HANDLER_STACK);
+
+    BenchRun(BENCH_MODE_HEAP, "heap");
+
+    xHeapBefore = xPortGetFreeHeapSize();
+    s_xPool = xTaskPoolCreate(BENCH_POOL_TASKS, BENCH_HANDLER_STACK);
+    if(s_xPool == NULL)
+    {
+        printf("pool skipped, out of heap\n");
+    }
+    else
+    {
+        printf("pool of %u tasks, heap=%u bytes\n", (unsigned int)BENCH_POOL_TASKS,
+               (unsigned int)(xHeapBefore - xPortGetFreeHeapSize()));
+
+        BenchRun(BENCH_MODE_POOL, "pool");
+
+        printf("pool minimum ever free=%u\n", (unsigned int)uxTaskPoolGetMinimumEverFree(s_xPool));
+    }
+
+    vTaskDelete(s_xLoadTask);
+    vTaskDelete(NULL);
+}
+
+void vTaskPoolBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    (void)xTaskCreate(TaskPoolBenchTask, "TPBch", 160, NULL, BENCH_TASK_PRIORITY, NULL);
+    (void)xTaskCreate(LoadTask, "Load", configMINIMAL_STACK_SIZE, NULL, BENCH_LOAD_PRIORITY, &s_xLoadTask);
+}
+
+#endif /* configUSE_TASK_POOL_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
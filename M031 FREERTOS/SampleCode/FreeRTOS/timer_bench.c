@@ -0,0 +1,129 @@
+/******************************************************************************
+ * @file     timer_bench.c
+ * @version  V1.00
+ * @brief    Cost of software timer commands against the number of active timers.
+ *
+ * To use it, set configUSE_TIMER_BENCH to 1 in FreeRTOSConfig.h.  Build it
+ * with each combination of configUSE_TIMER_HEAP and
+ * configUSE_TIMER_DIRECT_COMMANDS to compare the timer list implementations.
+ * TIMER0 free-runs at the HIRC frequency so costs are reported in HIRC
+ * cycles.
+ *
+ * For 10, 100 and 500 active timers the benchmark task resets randomly chosen
+ * timers and times each xTimerReset() call.  It runs below the timer service
+ * task, so a command sent through the timer queue is processed before the call
+ * returns and the figure covers the whole cost of the command.  A count is
+ * skipped if the timers cannot be allocated - each timer takes about 56 bytes
+ * of heap, so heap_regions.c is needed for 100 timers and 500 timers need a
+ * part with more SRAM - or if it exceeds configTIMER_HEAP_LENGTH.
+ *
+ * Copyright (C) 2017 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "bench_common.h"
+
+#if (configUSE_TIMER_BENCH == 1)
+
+#define BENCH_RESETS            200
+#define BENCH_MIN_PERIOD        5000    /* Long enough that no timer expires during a run. */
+#define BENCH_PERIOD_SPREAD     10000
+
+static const uint32_t s_au32TimerCounts[] = { 10, 100, 500 };
+
+static TimerHandle_t s_axTimers[500];
+static uint32_t s_u32Random = 1;
+
+static uint32_t BenchRandom(void)
+{
+    s_u32Random = s_u32Random * 1103515245UL + 12345UL;
+    return s_u32Random >> 8;
+}
+
+static void BenchTimerCallback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+}
+
+static void DeleteTimers(uint32_t u32Count)
+{
+    uint32_t i;
+
+    for(i = 0; i < u32Count; i++)
+        (void)xTimerDelete(s_axTimers[i], portMAX_DELAY);
+
+    /* Let the timer service task free them. */
+    vTaskDelay(2);
+}
+
+static void BenchRun(uint32_t u32Count)
+{
+    BenchStats_t xReset;
+    uint32_t i, u32Start;
+
+    if((configUSE_TIMER_HEAP == 1) && (u32Count > configTIMER_HEAP_LENGTH))
+    {
+        printf("%3u timers: skipped, above configTIMER_HEAP_LENGTH\n", (unsigned int)u32Count);
+        return;
+    }
+
+    for(i = 0; i < u32Count; i++)
+    {
+        s_axTimers[i] = xTimerCreate("Bch", BENCH_MIN_PERIOD + (BenchRandom() % BENCH_PERIOD_SPREAD), pdFALSE, NULL,
+                                     BenchTimerCallback);
+        if(s_axTimers[i] == NULL)
+        {
+            printf("%3u timers: skipped, out of heap\n", (unsigned int)u32Count);
+            DeleteTimers(i);
+            return;
+        }
+
+        (void)xTimerStart(s_axTimers[i], portMAX_DELAY);
+    }
+
+    BenchStatsReset(&xReset);
+    for(i = 0; i < BENCH_RESETS; i++)
+    {
+        TimerHandle_t xTimer = s_axTimers[BenchRandom() % u32Count];
+
+        u32Start = BENCH_NOW();
+        (void)xTimerReset(xTimer, portMAX_DELAY);
+        BenchStatsRecord(&xReset, BENCH_SINCE(u32Start));
+    }
+
+    printf("%3u timers: ", (unsigned int)u32Count);
+    BenchStatsPrint("reset", &xReset);
+
+    DeleteTimers(u32Count);
+}
+
+static void TimerBenchTask(void *pvParameters)
+{
+    uint32_t i;
+
+    (void)pvParameters;
+
+    printf("timer list: %s, direct commands: %s\n", (configUSE_TIMER_HEAP == 1) ? "heap" : "sorted list",
+           (configUSE_TIMER_DIRECT_COMMANDS == 1) ? "on" : "off");
+
+    for(i = 0; i < sizeof(s_au32TimerCounts) / sizeof(s_au32TimerCounts[0]); i++)
+        BenchRun(s_au32TimerCounts[i]);
+
+    vTaskDelete(NULL);
+}
+
+void vTimerBenchStart(void)
+{
+    BenchTimerInit(TIMER0);
+
+    /* Below the timer service task. */
+    (void)xTaskCreate(TimerBenchTask, "TBch", 160, NULL, configTIMER_TASK_PRIORITY - 1, NULL);
+}
+
+#endif /* configUSE_TIMER_BENCH */
+
+/*** (C) COPYRIGHT 2017 Nuvoton Technology Corp. ***/
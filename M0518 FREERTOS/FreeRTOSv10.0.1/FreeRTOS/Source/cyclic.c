@@ -0,0 +1,284 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cyclic.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to use the cyclic executive
+#endif
+
+/* The table being dispatched.  There is one executive, as there is one
+processor for it to divide between the slots. */
+typedef struct CyclicExecutiveDefinition
+{
+	CyclicSlot_t *pxSlots;		/*< The table of slots, or NULL if the executive is stopped. */
+	UBaseType_t uxSlots;
+	TickType_t xMajorFrame;		/*< Minor frames in each major frame. */
+	TickType_t xMinorFrame;		/*< The minor frame the executive is in. */
+} CyclicExecutive_t;
+
+PRIVILEGED_DATA static CyclicExecutive_t xExecutive = { NULL, 0, 0, 0 };
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if xTask is still working on the release of any of the slots
+ * in the table.  Called with interrupts masked.
+ */
+static BaseType_t prvTaskIsRunning( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void vCyclicExecutiveStart( CyclicSlot_t *pxSlots, UBaseType_t uxSlots, TickType_t xMajorFrame )
+{
+UBaseType_t ux;
+
+	configASSERT( pxSlots );
+	configASSERT( xMajorFrame > ( TickType_t ) 0 );
+
+	taskENTER_CRITICAL();
+	{
+		for( ux = ( UBaseType_t ) 0; ux < uxSlots; ux++ )
+		{
+			configASSERT( pxSlots[ ux ].xOffset < xMajorFrame );
+			configASSERT( ( pxSlots[ ux ].xLength > ( TickType_t ) 0 ) && ( pxSlots[ ux ].xLength <= xMajorFrame ) );
+			configASSERT( ( pxSlots[ ux ].xTask != NULL ) || ( pxSlots[ ux ].pxFunction != NULL ) );
+
+			pxSlots[ ux ].ulReleases = 0UL;
+			pxSlots[ ux ].ulOverruns = 0UL;
+			pxSlots[ ux ].ulSkipped = 0UL;
+			pxSlots[ ux ].xRunning = pdFALSE;
+		}
+
+		xExecutive.pxSlots = pxSlots;
+		xExecutive.uxSlots = uxSlots;
+		xExecutive.xMajorFrame = xMajorFrame;
+
+		/* The next dispatch moves into minor frame 0. */
+		xExecutive.xMinorFrame = xMajorFrame - ( TickType_t ) 1;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vCyclicExecutiveStop( void )
+{
+	taskENTER_CRITICAL();
+	{
+		xExecutive.pxSlots = NULL;
+		xExecutive.uxSlots = ( UBaseType_t ) 0;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vCyclicExecutiveDispatchFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+{
+CyclicSlot_t *pxSlots, *pxSlot;
+UBaseType_t ux, uxSlots, uxSavedInterruptStatus;
+TickType_t xMinorFrame;
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxSlots = xExecutive.pxSlots;
+		uxSlots = xExecutive.uxSlots;
+
+		if( pxSlots != NULL )
+		{
+			xExecutive.xMinorFrame++;
+			if( xExecutive.xMinorFrame >= xExecutive.xMajorFrame )
+			{
+				xExecutive.xMinorFrame = ( TickType_t ) 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xMinorFrame = xExecutive.xMinorFrame;
+
+		/* The slots that end in this minor frame are checked before any are
+		released, so a slot as long as the major frame is checked before it
+		is released again. */
+		for( ux = ( UBaseType_t ) 0; ux < uxSlots; ux++ )
+		{
+			pxSlot = &( pxSlots[ ux ] );
+
+			if( ( pxSlot->xRunning != pdFALSE ) && ( ( ( pxSlot->xOffset + pxSlot->xLength ) % xExecutive.xMajorFrame ) == xMinorFrame ) )
+			{
+				( pxSlot->ulOverruns )++;
+
+				#if( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+				{
+					extern void vApplicationCyclicOverrunHook( CyclicSlot_t *pxSlot );
+
+					vApplicationCyclicOverrunHook( pxSlot );
+				}
+				#endif
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		for( ux = ( UBaseType_t ) 0; ux < uxSlots; ux++ )
+		{
+			pxSlot = &( pxSlots[ ux ] );
+
+			if( ( pxSlot->xOffset == xMinorFrame ) && ( pxSlot->xTask != NULL ) )
+			{
+				/* A task still working on an earlier release would start this
+				one late, so it is skipped. */
+				if( prvTaskIsRunning( pxSlot->xTask ) != pdFALSE )
+				{
+					( pxSlot->ulSkipped )++;
+				}
+				else
+				{
+					( pxSlot->ulReleases )++;
+					pxSlot->xRunning = pdTRUE;
+					vTaskNotifyGiveIndexedFromISR( pxSlot->xTask, configCYCLIC_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	/* Function slots are called with interrupts unmasked.  Only this
+	interrupt changes the table, and tasks cannot run until it exits. */
+	for( ux = ( UBaseType_t ) 0; ux < uxSlots; ux++ )
+	{
+		pxSlot = &( pxSlots[ ux ] );
+
+		if( ( pxSlot->xOffset == xMinorFrame ) && ( pxSlot->xTask == NULL ) )
+		{
+			( pxSlot->ulReleases )++;
+			pxSlot->pxFunction( pxSlot->pvParameters );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCyclicExecutiveWaitForRelease( TickType_t xTicksToWait )
+{
+TaskHandle_t xTask = xTaskGetCurrentTaskHandle();
+CyclicSlot_t *pxSlot;
+UBaseType_t ux;
+BaseType_t xReturn;
+
+	/* Complete the work of the current release. */
+	taskENTER_CRITICAL();
+	{
+		for( ux = ( UBaseType_t ) 0; ux < xExecutive.uxSlots; ux++ )
+		{
+			pxSlot = &( xExecutive.pxSlots[ ux ] );
+
+			if( pxSlot->xTask == xTask )
+			{
+				pxSlot->xRunning = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( ulTaskNotifyTakeIndexed( configCYCLIC_NOTIFICATION_INDEX, pdTRUE, xTicksToWait ) != 0UL )
+	{
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xCyclicExecutiveGetMinorFrame( void )
+{
+	/* A single read of a TickType_t, as xTaskGetTickCount() assumes. */
+	return xExecutive.xMinorFrame;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTaskIsRunning( TaskHandle_t xTask )
+{
+UBaseType_t ux;
+BaseType_t xReturn = pdFALSE;
+
+	for( ux = ( UBaseType_t ) 0; ux < xExecutive.uxSlots; ux++ )
+	{
+		if( ( xExecutive.pxSlots[ ux ].xTask == xTask ) && ( xExecutive.pxSlots[ ux ].xRunning != pdFALSE ) )
+		{
+			xReturn = pdTRUE;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * A broadcast channel delivers every item published to it to every task that
+ * has subscribed, where a queue delivers each item to one receiver.  Items are
+ * held once, in a single ring buffer, and each subscriber keeps its own read
+ * position in it, so fanning a sample out to several tasks needs neither a
+ * queue per task nor a copy per task when publishing.
+ *
+ * Each subscriber chooses a policy when it subscribes:
+ *
+ * eBroadcastLossless - the subscriber receives every item in the order it was
+ * published.  The ring buffer cannot overwrite an item a lossless subscriber
+ * has not yet received, so publishing blocks, or fails, while the buffer is
+ * full for the slowest lossless subscriber.
+ *
+ * eBroadcastLatest - the subscriber receives the most recently published item
+ * and skips any it was too slow to receive.  Latest value subscribers never
+ * hold up the publisher, and count the items they skip.
+ *
+ * Each subscriber is received from by one task at a time.  Tasks block while
+ * there is nothing new for their subscriber, and any number of tasks and
+ * interrupts can publish.  Items are copied in and out with interrupts masked,
+ * so channels suit small items such as sensor samples.
+ */
+
+#ifndef BROADCAST_H
+#define BROADCAST_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include broadcast.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * broadcast.h
+ *
+ * Type by which broadcast channels are referenced.  For example, a call to
+ * xBroadcastCreate() returns a BroadcastHandle_t variable that can then be
+ * used as a parameter to other broadcast channel functions.
+ *
+ * \defgroup BroadcastHandle_t BroadcastHandle_t
+ * \ingroup BroadcastChannels
+ */
+typedef void * BroadcastHandle_t;
+
+/* The policies a subscriber can receive with. */
+typedef enum
+{
+	eBroadcastLossless = 0,		/* Receive every item, holding up the publisher if necessary. */
+	eBroadcastLatest			/* Receive the newest item, skipping any older ones not yet received. */
+} eBroadcastPolicy;
+
+/*
+ * A subscription to a broadcast channel.  Declared by the application, one per
+ * receiving task, and passed to vBroadcastSubscribe().  The members are private
+ * to broadcast.c.
+ */
+typedef struct BROADCAST_SUBSCRIBER
+{
+	struct BROADCAST_SUBSCRIBER *pxNext;	/*< The next subscriber to the same channel. */
+	void *pvChannel;						/*< The channel subscribed to, or NULL. */
+	uint32_t ulReadSequence;				/*< The sequence number of the next item to receive. */
+	uint32_t ulMissed;						/*< Items skipped by a latest value subscriber. */
+	eBroadcastPolicy ePolicy;
+} BroadcastSubscriber_t;
+
+/**
+ * broadcast.h
+ *
+<pre>
+BroadcastHandle_t xBroadcastCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+BroadcastHandle_t xBroadcastCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorageBuffer, StaticBroadcast_t *pxStaticBroadcast );
+</pre>
+ *
+ * Create a broadcast channel that holds up to uxLength items of uxItemSize
+ * bytes each, either allocating its memory from the FreeRTOS heap or using the
+ * pucStorageBuffer array, which must be at least ( uxLength * uxItemSize )
+ * bytes, and the StaticBroadcast_t variable pointed to by pxStaticBroadcast.
+ * The channel is created with no subscribers.
+ *
+ * uxLength bounds how far a lossless subscriber can fall behind the publisher.
+ * It does not depend on the number of subscribers.
+ *
+ * @return The handle of the channel, or NULL if it could not be allocated.
+ *
+ * \defgroup xBroadcastCreate xBroadcastCreate
+ * \ingroup BroadcastChannels
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	BroadcastHandle_t xBroadcastCreate( UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	BroadcastHandle_t xBroadcastCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorageBuffer, StaticBroadcast_t *pxStaticBroadcast ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * broadcast.h
+ *
+<pre>
+void vBroadcastDelete( BroadcastHandle_t xChannel );
+</pre>
+ *
+ * Delete a broadcast channel.  Every subscriber must have unsubscribed, and no
+ * task may be waiting to publish.
+ *
+ * \defgroup vBroadcastDelete vBroadcastDelete
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastDelete( BroadcastHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast.h
+ *
+<pre>
+void vBroadcastSubscribe( BroadcastHandle_t xChannel, BroadcastSubscriber_t *pxSubscriber, eBroadcastPolicy ePolicy );
+void vBroadcastUnsubscribe( BroadcastSubscriber_t *pxSubscriber );
+</pre>
+ *
+ * Subscribe to a channel, or cancel a subscription.  A new subscriber receives
+ * the items published after it subscribed.  A subscriber can only subscribe to
+ * one channel at a time, and must not be unsubscribed while a task is waiting
+ * to receive with it.  Unsubscribing a lossless subscriber releases any
+ * publisher it was holding up.
+ *
+ * \defgroup vBroadcastSubscribe vBroadcastSubscribe
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastSubscribe( BroadcastHandle_t xChannel, BroadcastSubscriber_t *pxSubscriber, eBroadcastPolicy ePolicy ) PRIVILEGED_FUNCTION;
+void vBroadcastUnsubscribe( BroadcastSubscriber_t *pxSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast.h
+ *
+<pre>
+BaseType_t xBroadcastPublish( BroadcastHandle_t xChannel, const void *pvItem, TickType_t xTicksToWait );
+</pre>
+ *
+ * Copy an item into the channel for every subscriber to receive, and unblock
+ * the tasks waiting to receive.  If a lossless subscriber has not yet received
+ * the oldest item in the buffer, the calling task blocks for up to
+ * xTicksToWait ticks for it to do so.
+ *
+ * Example use:
+<pre>
+BroadcastHandle_t xSampleChannel;
+
+void vSampleTask( void *pvParameters )
+{
+int16_t sSample;
+
+    for( ;; )
+    {
+        sSample = sReadSensor();
+        ( void ) xBroadcastPublish( xSampleChannel, &sSample, pdMS_TO_TICKS( 2 ) );
+        vTaskDelay( pdMS_TO_TICKS( 10 ) );
+    }
+}
+
+void vDisplayTask( void *pvParameters )
+{
+BroadcastSubscriber_t xSubscriber;
+int16_t sSample;
+
+    vBroadcastSubscribe( xSampleChannel, &xSubscriber, eBroadcastLatest );
+
+    for( ;; )
+    {
+        if( xBroadcastReceive( &xSubscriber, &sSample, portMAX_DELAY ) == pdPASS )
+        {
+            vShowSample( sSample );
+        }
+    }
+}
+</pre>
+ *
+ * @return pdPASS if the item was published, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xBroadcastPublish xBroadcastPublish
+ * \ingroup BroadcastChannels
+ */
+BaseType_t xBroadcastPublish( BroadcastHandle_t xChannel, const void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast.h
+ *
+<pre>
+BaseType_t xBroadcastPublishFromISR( BroadcastHandle_t xChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xBroadcastPublish() that can be called from an interrupt.  It
+ * does not block, and fails if a lossless subscriber would lose an item.
+ *
+ * xBroadcastPublishFromISR() sets *pxHigherPriorityTaskWoken to pdTRUE if
+ * publishing unblocked a task with a priority above that of the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt exits.
+ *
+ * @return pdPASS if the item was published, otherwise pdFAIL.
+ *
+ * \defgroup xBroadcastPublishFromISR xBroadcastPublishFromISR
+ * \ingroup BroadcastChannels
+ */
+BaseType_t xBroadcastPublishFromISR( BroadcastHandle_t xChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast.h
+ *
+<pre>
+BaseType_t xBroadcastReceive( BroadcastSubscriber_t *pxSubscriber, void *pvBuffer, TickType_t xTicksToWait );
+</pre>
+ *
+ * Receive the next item for a subscriber into pvBuffer, blocking for up to
+ * xTicksToWait ticks if it has received every item published so far.  A
+ * lossless subscriber receives items in the order they were published.  A
+ * latest value subscriber receives the newest item, and adds the number of
+ * older items it skipped to the count returned by ulBroadcastGetMissed().
+ *
+ * @return pdPASS if an item was received, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xBroadcastReceive xBroadcastReceive
+ * \ingroup BroadcastChannels
+ */
+BaseType_t xBroadcastReceive( BroadcastSubscriber_t *pxSubscriber, void *pvBuffer, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast.h
+ *
+<pre>
+uint32_t ulBroadcastGetMissed( BroadcastSubscriber_t *pxSubscriber );
+</pre>
+ *
+ * @return The number of items a latest value subscriber has skipped since it
+ * subscribed.  Always 0 for a lossless subscriber.
+ *
+ * \defgroup ulBroadcastGetMissed ulBroadcastGetMissed
+ * \ingroup BroadcastChannels
+ */
+#define ulBroadcastGetMissed( pxSubscriber ) ( ( pxSubscriber )->ulMissed )
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* BROADCAST_H */
+
@@ -54,6 +54,11 @@ typedef struct corCoRoutineControlBlock
 	UBaseType_t 		uxPriority;			/*< The priority of the co-routine in relation to other co-routines. */
 	UBaseType_t 		uxIndex;			/*< Used to distinguish between co-routines when multiple co-routines use the same co-routine function. */
 	uint16_t 			uxState;			/*< Used internally by the co-routine implementation. */
+	#if( configUSE_CO_ROUTINE_HOST == 1 )
+		TickType_t		xWaitStartTime;		/*< Tick count at which the current crWAIT_UNTIL() started. */
+		TickType_t		xTicksToWait;		/*< Timeout of the current crWAIT_UNTIL(). */
+		uint32_t		ulNotifiedValue;	/*< Bits set by xCoRoutineNotify() and not yet taken. */
+	#endif
 } CRCB_t; /* Co-routine control block.  Note must be identical in size down to uxPriority with TCB_t. */
 
 /**
@@ -693,6 +698,247 @@ void vCoRoutineSchedule( void );
  */
 #define crQUEUE_RECEIVE_FROM_ISR( pxQueue, pvBuffer, pxCoRoutineWoken ) xQueueCRReceiveFromISR( ( pxQueue ), ( pvBuffer ), ( pxCoRoutineWoken ) )
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+
+/**
+ * croutine. h
+ *<pre>
+ BaseType_t xCoRoutineHostCreate(
+                                     configSTACK_DEPTH_TYPE usStackDepth,
+                                     UBaseType_t uxPriority
+                                  );</pre>
+ *
+ * Create the task that hosts every co-routine in the application.
+ *
+ * Available when configUSE_CO_ROUTINE_HOST is set to 1 in FreeRTOSConfig.h.
+ * vCoRoutineSchedule() must then not be called from the idle hook.
+ *
+ * Co-routines share the stack of the host task, so a state machine written as
+ * a co-routine costs only its CRCB_t plus its static variables, where a task
+ * costs a TCB and a stack of at least configMINIMAL_STACK_SIZE words.  With the
+ * configuration used by the NuMicro samples on Cortex-M0 (five character task
+ * names, trace facility and mutexes enabled, 60 word minimum stack, heap_4)
+ * each task should take 344 bytes of heap (a 84 byte TCB and a 240 byte stack,
+ * plus block headers) and each co-routine 80 bytes (a 68 byte CRCB_t plus its
+ * block header).  Eight protocol state machines would therefore need 2752
+ * bytes as tasks, or 640 bytes as co-routines plus one host task.  These
+ * figures are worked out from sizeof( TCB_t ), sizeof( CRCB_t ) and the heap_4
+ * block header, not measured; croutine_bench.c in the M031 sample measures the
+ * heap taken and the stack high-water marks of both designs on the target.
+ *
+ * The host task sleeps until a co-routine is ready to run, the next co-routine
+ * delay expires, a co-routine is readied by an ISR, or an object that a
+ * co-routine waits on through crWAIT_UNTIL() changes state.  Co-routines should
+ * be created before the scheduler is started, or by another co-routine.
+ *
+ * @param usStackDepth The stack depth of the host task, in words.  It must
+ * hold the deepest call made by any co-routine.
+ *
+ * @param uxPriority The task priority at which co-routines execute.
+ *
+ * @return pdPASS if the host task was created, otherwise an error code
+ * defined within projdefs.h.
+ *
+ * \defgroup xCoRoutineHostCreate xCoRoutineHostCreate
+ * \ingroup Tasks
+ */
+BaseType_t xCoRoutineHostCreate( configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority );
+
+/**
+ * croutine. h
+ *<pre>
+ crWAIT_UNTIL( CoRoutineHandle_t xHandle, xCondition, TickType_t xTicksToWait, BaseType_t *pxResult );</pre>
+ *
+ * Block a co-routine until xCondition evaluates to non-zero, or until
+ * xTicksToWait ticks have passed.  Setting xTicksToWait to portMAX_DELAY waits
+ * without a timeout.
+ *
+ * The condition is evaluated once on entry, and then again each time an object
+ * that co-routines can wait on changes state: a call to xCoRoutineNotify(), a
+ * send to or receive from a stream or message buffer, or a call to
+ * xEventGroupSetBits() (including those deferred from xEventGroupSetBitsFromISR()).
+ * The condition must therefore only depend on the state of such objects, and
+ * must not block.  crNOTIFY_TAKE(), crSTREAM_BUFFER_SEND(),
+ * crSTREAM_BUFFER_RECEIVE() and crEVENT_GROUP_WAIT_BITS() are built on
+ * crWAIT_UNTIL().
+ *
+ * As with crDELAY(), crWAIT_UNTIL() can only be called from the co-routine
+ * function itself.
+ *
+ * @param xHandle The handle of the calling co-routine.
+ *
+ * @param xCondition The expression to wait for.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait.
+ *
+ * @param pxResult Set to pdPASS if the condition became true, or pdFAIL if the
+ * wait timed out.
+ *
+ * \defgroup crWAIT_UNTIL crWAIT_UNTIL
+ * \ingroup Tasks
+ */
+#define crWAIT_UNTIL( xHandle, xCondition, xTicksToWait, pxResult )						\
+{																						\
+	vCoRoutineBeginWait( ( xTicksToWait ) );											\
+	for( ;; )																			\
+	{																					\
+		if( xCondition )																\
+		{																				\
+			*( pxResult ) = pdPASS;														\
+			break;																		\
+		}																				\
+		if( xCoRoutineWaitForCondition() == pdFALSE )									\
+		{																				\
+			*( pxResult ) = pdFAIL;														\
+			break;																		\
+		}																				\
+		crSET_STATE0( ( xHandle ) );													\
+	}																					\
+	vCoRoutineEndWait();																\
+}
+
+/**
+ * croutine. h
+ *<pre>
+ BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet );
+ BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * The co-routine equivalent of xTaskNotify() with the eSetBits action.  The
+ * bits are ORed into the co-routine's notification value, where they remain
+ * until the co-routine takes them with crNOTIFY_TAKE().
+ *
+ * xCoRoutineNotify() can be called from a task or a co-routine,
+ * xCoRoutineNotifyFromISR() from an interrupt.
+ *
+ * @param xCoRoutine The handle of the co-routine to notify.
+ *
+ * @param ulBitsToSet The bits to set in the co-routine's notification value.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the host task was woken
+ * and has a priority above that of the interrupted task.
+ *
+ * @return Always pdPASS.
+ *
+ * \defgroup xCoRoutineNotify xCoRoutineNotify
+ * \ingroup Tasks
+ */
+BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet );
+BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet, BaseType_t *pxHigherPriorityTaskWoken );
+
+/**
+ * croutine. h
+ *<pre>
+ crNOTIFY_TAKE( CoRoutineHandle_t xHandle, TickType_t xTicksToWait, uint32_t *pulValue );</pre>
+ *
+ * Wait for the calling co-routine's notification value to become non-zero,
+ * then read and clear it.  *pulValue is set to the bits taken, or 0 if the
+ * wait timed out.
+ *
+ * Example usage:
+   <pre>
+ #define RX_DONE		( 1UL << 0 )
+ #define TX_DONE		( 1UL << 1 )
+
+ void vProtocolCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+ {
+ static uint32_t ulEvents;
+
+     crSTART( xHandle );
+
+     for( ;; )
+     {
+         // Wait up to 100 ticks for the UART ISR to call
+         // xCoRoutineNotifyFromISR( xProtocolCoRoutine, RX_DONE, &xWoken ).
+         crNOTIFY_TAKE( xHandle, 100, &ulEvents );
+
+         if( ( ulEvents & RX_DONE ) != 0 )
+         {
+             // Process the frame.
+         }
+         else
+         {
+             // Timed out - restart the protocol.
+         }
+     }
+
+     crEND();
+ }</pre>
+ * \defgroup crNOTIFY_TAKE crNOTIFY_TAKE
+ * \ingroup Tasks
+ */
+#define crNOTIFY_TAKE( xHandle, xTicksToWait, pulValue )								\
+{																						\
+BaseType_t xCrWaitResult;																\
+																						\
+	crWAIT_UNTIL( ( xHandle ), ( ( CRCB_t * ) ( xHandle ) )->ulNotifiedValue != 0UL, ( xTicksToWait ), &xCrWaitResult );	\
+	( void ) xCrWaitResult;																\
+	*( pulValue ) = ulCoRoutineNotifyTake( ( xHandle ) );								\
+}
+
+/**
+ * croutine. h
+ *<pre>
+ crSTREAM_BUFFER_SEND( CoRoutineHandle_t xHandle, StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait, size_t *pxBytesSent );
+ crSTREAM_BUFFER_RECEIVE( CoRoutineHandle_t xHandle, StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait, size_t *pxBytesReceived );</pre>
+ *
+ * The co-routine equivalents of xStreamBufferSend() and xStreamBufferReceive(),
+ * which also work on message buffers.  The co-routine blocks until the send
+ * or receive moves at least one byte (one message for message buffers), or
+ * until xTicksToWait ticks have passed, in which case the byte count is 0.
+ *
+ * A co-routine waiting to receive is only re-evaluated once the number of
+ * bytes in the buffer reaches the buffer's trigger level, as for a task.
+ *
+ * \defgroup crSTREAM_BUFFER_SEND crSTREAM_BUFFER_SEND
+ * \ingroup Tasks
+ */
+#define crSTREAM_BUFFER_SEND( xHandle, xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait, pxBytesSent )	\
+{																						\
+BaseType_t xCrWaitResult;																\
+																						\
+	crWAIT_UNTIL( ( xHandle ), ( *( pxBytesSent ) = xStreamBufferSend( ( xStreamBuffer ), ( pvTxData ), ( xDataLengthBytes ), 0 ) ) != ( size_t ) 0, ( xTicksToWait ), &xCrWaitResult );	\
+	( void ) xCrWaitResult;																\
+}
+
+#define crSTREAM_BUFFER_RECEIVE( xHandle, xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait, pxBytesReceived )	\
+{																						\
+BaseType_t xCrWaitResult;																\
+																						\
+	crWAIT_UNTIL( ( xHandle ), ( *( pxBytesReceived ) = xStreamBufferReceive( ( xStreamBuffer ), ( pvRxData ), ( xBufferLengthBytes ), 0 ) ) != ( size_t ) 0, ( xTicksToWait ), &xCrWaitResult );	\
+	( void ) xCrWaitResult;																\
+}
+
+/**
+ * croutine. h
+ *<pre>
+ crEVENT_GROUP_WAIT_BITS( CoRoutineHandle_t xHandle, EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor, BaseType_t xClearOnExit, BaseType_t xWaitForAllBits, TickType_t xTicksToWait, EventBits_t *puxBits );</pre>
+ *
+ * The co-routine equivalent of xEventGroupWaitBits().  *puxBits is set to the
+ * value of the event group when the wait condition was met or the wait timed
+ * out.  If xClearOnExit is pdTRUE the bits waited for are cleared after a
+ * successful wait - unlike xEventGroupWaitBits() the test and the clear are
+ * not atomic, so the event group should not also be cleared by a task that
+ * can preempt the host task.
+ *
+ * \defgroup crEVENT_GROUP_WAIT_BITS crEVENT_GROUP_WAIT_BITS
+ * \ingroup Tasks
+ */
+#define crEVENT_BITS_MATCH( uxBits, uxBitsToWaitFor, xWaitForAllBits )					\
+	( ( ( xWaitForAllBits ) != pdFALSE ) ? ( ( ( uxBits ) & ( uxBitsToWaitFor ) ) == ( uxBitsToWaitFor ) ) : ( ( ( uxBits ) & ( uxBitsToWaitFor ) ) != 0 ) )
+
+#define crEVENT_GROUP_WAIT_BITS( xHandle, xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait, puxBits )	\
+{																						\
+BaseType_t xCrWaitResult;																\
+																						\
+	crWAIT_UNTIL( ( xHandle ), crEVENT_BITS_MATCH( ( *( puxBits ) = xEventGroupGetBits( ( xEventGroup ) ) ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) ), ( xTicksToWait ), &xCrWaitResult );	\
+	if( ( xCrWaitResult == pdPASS ) && ( ( xClearOnExit ) != pdFALSE ) )				\
+	{																					\
+		( void ) xEventGroupClearBits( ( xEventGroup ), ( uxBitsToWaitFor ) );			\
+	}																					\
+}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+
 /*
  * This function is intended for internal use by the co-routine macros only.
  * The macro nature of the co-routine implementation requires that the
@@ -713,6 +959,31 @@ void vCoRoutineAddToDelayedList( TickType_t xTicksToDelay, List_t *pxEventList )
  */
 BaseType_t xCoRoutineRemoveFromEventList( const List_t *pxEventList );
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+
+	/*
+	 * These functions are intended for internal use by the co-routine macros
+	 * only.  vCoRoutineBeginWait() and vCoRoutineEndWait() bracket a
+	 * crWAIT_UNTIL().  xCoRoutineWaitForCondition() blocks the current
+	 * co-routine until the next state change or the end of its timeout, and
+	 * returns pdFALSE if the timeout has already passed.
+	 * ulCoRoutineNotifyTake() reads and clears a notification value.
+	 */
+	void vCoRoutineBeginWait( TickType_t xTicksToWait );
+	BaseType_t xCoRoutineWaitForCondition( void );
+	void vCoRoutineEndWait( void );
+	uint32_t ulCoRoutineNotifyTake( CoRoutineHandle_t xCoRoutine );
+
+	/*
+	 * These functions are intended for internal use by the stream buffer and
+	 * event group implementations only.  They wake the host task so it
+	 * re-evaluates the conditions of co-routines blocked in crWAIT_UNTIL().
+	 */
+	void vCoRoutineHostObjectChanged( void );
+	void vCoRoutineHostObjectChangedFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+
 #ifdef __cplusplus
 }
 #endif
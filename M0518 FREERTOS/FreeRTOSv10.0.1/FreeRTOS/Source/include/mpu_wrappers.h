@@ -49,10 +49,20 @@ only for ports that are using the MPU. */
 		#define xTaskCreate								MPU_xTaskCreate
 		#define xTaskCreateStatic						MPU_xTaskCreateStatic
 		#define xTaskCreateRestricted					MPU_xTaskCreateRestricted
+		#define xTaskPoolCreate							MPU_xTaskPoolCreate
+		#define xTaskCreateFromPool						MPU_xTaskCreateFromPool
+		#define uxTaskPoolGetFree						MPU_uxTaskPoolGetFree
+		#define uxTaskPoolGetMinimumEverFree			MPU_uxTaskPoolGetMinimumEverFree
 		#define vTaskAllocateMPURegions					MPU_vTaskAllocateMPURegions
 		#define vTaskDelete								MPU_vTaskDelete
 		#define vTaskDelay								MPU_vTaskDelay
 		#define vTaskDelayUntil							MPU_vTaskDelayUntil
+		#define vTaskSetDeadline						MPU_vTaskSetDeadline
+		#define vTaskGetDeadlineStats					MPU_vTaskGetDeadlineStats
+		#define vTaskSetBudget							MPU_vTaskSetBudget
+		#define vTaskGetBudgetStats						MPU_vTaskGetBudgetStats
+		#define vTaskSetTimeSliceQuantum				MPU_vTaskSetTimeSliceQuantum
+		#define uxTaskGetTimeSliceQuantum				MPU_uxTaskGetTimeSliceQuantum
 		#define xTaskAbortDelay							MPU_xTaskAbortDelay
 		#define uxTaskPriorityGet						MPU_uxTaskPriorityGet
 		#define eTaskGetState							MPU_eTaskGetState
@@ -67,6 +77,8 @@ only for ports that are using the MPU. */
 		#define pcTaskGetName							MPU_pcTaskGetName
 		#define xTaskGetHandle							MPU_xTaskGetHandle
 		#define uxTaskGetStackHighWaterMark				MPU_uxTaskGetStackHighWaterMark
+		#define uxTaskGetStackReport					MPU_uxTaskGetStackReport
+		#define vTaskGetBlockingStats					MPU_vTaskGetBlockingStats
 		#define vTaskSetApplicationTaskTag				MPU_vTaskSetApplicationTaskTag
 		#define xTaskGetApplicationTaskTag				MPU_xTaskGetApplicationTaskTag
 		#define vTaskSetThreadLocalStoragePointer		MPU_vTaskSetThreadLocalStoragePointer
@@ -75,11 +87,13 @@ only for ports that are using the MPU. */
 		#define xTaskGetIdleTaskHandle					MPU_xTaskGetIdleTaskHandle
 		#define uxTaskGetSystemState					MPU_uxTaskGetSystemState
 		#define vTaskList								MPU_vTaskList
+		#define vTaskSnapshotStart						MPU_vTaskSnapshotStart
+		#define eTaskSnapshotNext						MPU_eTaskSnapshotNext
 		#define vTaskGetRunTimeStats					MPU_vTaskGetRunTimeStats
 		#define xTaskGenericNotify						MPU_xTaskGenericNotify
-		#define xTaskNotifyWait							MPU_xTaskNotifyWait
-		#define ulTaskNotifyTake						MPU_ulTaskNotifyTake
-		#define xTaskNotifyStateClear					MPU_xTaskNotifyStateClear
+		#define xTaskGenericNotifyWait					MPU_xTaskGenericNotifyWait
+		#define ulTaskGenericNotifyTake					MPU_ulTaskGenericNotifyTake
+		#define xTaskGenericNotifyStateClear			MPU_xTaskGenericNotifyStateClear
 
 		#define xTaskGetCurrentTaskHandle				MPU_xTaskGetCurrentTaskHandle
 		#define vTaskSetTimeOutState					MPU_vTaskSetTimeOutState
@@ -108,6 +122,8 @@ only for ports that are using the MPU. */
 		#define xQueueRemoveFromSet						MPU_xQueueRemoveFromSet
 		#define xQueueSelectFromSet						MPU_xQueueSelectFromSet
 		#define xQueueGenericReset						MPU_xQueueGenericReset
+		#define vQueueGetStats							MPU_vQueueGetStats
+		#define uxQueueGetRegistryStats					MPU_uxQueueGetRegistryStats
 
 		#if( configQUEUE_REGISTRY_SIZE > 0 )
 			#define vQueueAddToRegistry						MPU_vQueueAddToRegistry
@@ -136,6 +152,8 @@ only for ports that are using the MPU. */
 		#define xEventGroupSetBits						MPU_xEventGroupSetBits
 		#define xEventGroupSync							MPU_xEventGroupSync
 		#define vEventGroupDelete						MPU_vEventGroupDelete
+		#define vEventGroupAddToRegistry				MPU_vEventGroupAddToRegistry
+		#define vEventGroupGetStats						MPU_vEventGroupGetStats
 
 		/* Map standard message/stream_buffer.h API functions to the MPU
 		equivalents. */
@@ -152,6 +170,8 @@ only for ports that are using the MPU. */
 		#define xStreamBufferSetTriggerLevel			MPU_xStreamBufferSetTriggerLevel
 		#define xStreamBufferGenericCreate				MPU_xStreamBufferGenericCreate
 		#define xStreamBufferGenericCreateStatic		MPU_xStreamBufferGenericCreateStatic
+		#define vStreamBufferAddToRegistry				MPU_vStreamBufferAddToRegistry
+		#define vStreamBufferGetStats					MPU_vStreamBufferGetStats
 
 
 		/* Remove the privileged function macro, but keep the PRIVILEGED_DATA
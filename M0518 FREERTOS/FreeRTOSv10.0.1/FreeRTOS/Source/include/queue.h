@@ -64,6 +64,21 @@ typedef void * QueueSetMemberHandle_t;
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
 #define queueOVERWRITE			( ( BaseType_t ) 2 )
 
+/* For internal use only.  The direction passed to vQueueStatsRecord(). */
+#define queueSTATS_SEND			( ( BaseType_t ) 0 )
+#define queueSTATS_RECEIVE		( ( BaseType_t ) 1 )
+
+/*
+ * The statistics of one object in the registry, as returned by
+ * uxQueueGetRegistryStats().
+ */
+typedef struct xQUEUE_REGISTRY_STATS
+{
+	const char *pcName;		/*< The name the object was added to the registry with. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	void *pvHandle;			/*< The handle of the queue, semaphore, mutex, stream buffer or event group. */
+	ObjectStats_t xStats;	/*< The statistics of the object. */
+} QueueRegistryStats_t;
+
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE				( ( uint8_t ) 0U )
 #define queueQUEUE_TYPE_SET					( ( uint8_t ) 0U )
@@ -1485,6 +1500,52 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t pxMutex ) PRIVILEGED_FUNCTION
 	const char *pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+/*
+ * configUSE_OBJECT_STATS must be set to 1 in FreeRTOSConfig.h for
+ * vQueueGetStats() to be available.
+ *
+ * Copies the statistics of a queue, semaphore or mutex - the sends (gives) and
+ * receives (takes) made, those that failed because the queue was full or empty
+ * when the block time expired, the most items the queue has held, the total
+ * and longest time tasks waited to send and to receive, and, for mutexes, the
+ * total and longest time the mutex was held and the number of times a task
+ * waiting for it raised the priority of the task holding it.  Peeks are not
+ * counted.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+#if( configUSE_OBJECT_STATS == 1 )
+	void vQueueGetStats( QueueHandle_t xQueue, ObjectStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * configUSE_OBJECT_STATS must be set to 1 and configQUEUE_REGISTRY_SIZE must
+ * be greater than 0 in FreeRTOSConfig.h for uxQueueGetRegistryStats() to be
+ * available.
+ *
+ * Copies the name, handle and statistics of each queue, semaphore, mutex,
+ * stream buffer and event group in the registry, so the objects tasks spend
+ * the most time waiting on can be found.  Queues, semaphores and mutexes are
+ * added to the registry with vQueueAddToRegistry(), stream buffers with
+ * vStreamBufferAddToRegistry() and event groups with
+ * vEventGroupAddToRegistry().  See vQueueGetStats() for the statistics kept.
+ * The scheduler is suspended while the registry is read, and interrupts are
+ * disabled while the statistics of each object are copied.
+ *
+ * @param pxStatsArray An array of QueueRegistryStats_t structures into which
+ * the statistics are copied.
+ *
+ * @param uxArraySize The number of structures in pxStatsArray.  Objects beyond
+ * this number are not copied.
+ *
+ * @return The number of structures filled.
+ */
+#if( ( configUSE_OBJECT_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t *pxStatsArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to creaet a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1643,6 +1704,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue ) PRIV
 void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	void vQueueAddObjectToRegistry( void *pvObject, const char *pcName, ObjectStats_t *pxStats ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+#if( configUSE_OBJECT_STATS == 1 )
+	void vQueueStatsRecord( ObjectStats_t * const pxStats, const BaseType_t xDirection, const BaseType_t xSucceeded, const TickType_t xTicksBlocked, const UBaseType_t uxFill ) PRIVILEGED_FUNCTION;
+#endif
 
 
 #ifdef __cplusplus
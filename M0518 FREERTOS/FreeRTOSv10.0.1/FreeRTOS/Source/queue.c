@@ -120,6 +120,10 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xStats;		/*< The statistics returned by vQueueGetStats(). */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -141,6 +145,10 @@ typedef xQUEUE Queue_t;
 	{
 		const char *pcQueueName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 		QueueHandle_t xHandle;
+
+		#if ( configUSE_OBJECT_STATS == 1 )
+			ObjectStats_t *pxStats;	/* The statistics of the queue, stream buffer or event group. */
+		#endif
 	} xQueueRegistryItem;
 
 	/* The old xQueueRegistryItem name is maintained above then typedefed to the
@@ -244,6 +252,33 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	taskEXIT_CRITICAL()
 /*-----------------------------------------------------------*/
 
+/*
+ * Macros to update the statistics of a queue when a send or receive returns.
+ * The time the calling task waited is measured from xEntryTick, the tick count
+ * saved when its timeout was first set, so it is zero if the call did not have
+ * to wait.  xTimeOut.xTimeOnEntering cannot be used as it is moved on each
+ * time xTaskCheckForTimeOut() finds the timeout has not expired.
+ */
+#if( configUSE_OBJECT_STATS == 1 )
+	#define prvRecordStats( pxQueue, xDirection, xSucceeded, xEntryTimeSet, xEntryTick )										\
+		vQueueStatsRecord( &( ( pxQueue )->xStats ), ( xDirection ), ( xSucceeded ),										\
+						   ( ( xEntryTimeSet ) != pdFALSE ) ? ( xTaskGetTickCount() - ( xEntryTick ) ) : ( TickType_t ) 0,	\
+						   ( pxQueue )->uxMessagesWaiting )
+
+	#define prvRecordStatsFromISR( pxQueue, xDirection, xSucceeded )	\
+		vQueueStatsRecord( &( ( pxQueue )->xStats ), ( xDirection ), ( xSucceeded ), ( TickType_t ) 0, ( pxQueue )->uxMessagesWaiting )
+#else
+	#define prvRecordStats( pxQueue, xDirection, xSucceeded, xEntryTimeSet, xEntryTick )
+	#define prvRecordStatsFromISR( pxQueue, xDirection, xSucceeded )
+#endif /* configUSE_OBJECT_STATS */
+
+/*
+ * The eBlockReason recorded by configUSE_BLOCKING_STATS for a task that blocks
+ * on pxQueue.
+ */
+#define prvBlockReason( pxQueue ) ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) ? eBlockMutex : ( ( ( pxQueue )->uxItemSize == ( UBaseType_t ) 0 ) ? eBlockSemaphore : eBlockQueue ) )
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue )
 {
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
@@ -443,6 +478,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		( void ) memset( ( void * ) &( pxNewQueue->xStats ), 0x00, sizeof( ObjectStats_t ) );
+	}
+	#endif /* configUSE_OBJECT_STATS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -728,6 +769,10 @@ BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xEntryTick = 0;
+#endif
+
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
@@ -837,6 +882,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				}
 				#endif /* configUSE_QUEUE_SETS */
 
+				prvRecordStats( pxQueue, queueSTATS_SEND, pdTRUE, xEntryTimeSet, xEntryTick );
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -850,6 +896,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 					/* Return to the original privilege level before exiting
 					the function. */
+					prvRecordStats( pxQueue, queueSTATS_SEND, pdFALSE, xEntryTimeSet, xEntryTick );
 					traceQUEUE_SEND_FAILED( pxQueue );
 					return errQUEUE_FULL;
 				}
@@ -859,6 +906,12 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_OBJECT_STATS == 1 )
+					{
+						xEntryTick = xTaskGetTickCount();
+					}
+					#endif
 				}
 				else
 				{
@@ -881,6 +934,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				taskSET_BLOCK_REASON( prvBlockReason( pxQueue ), pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
 				/* Unlocking the queue means queue events can effect the
@@ -913,6 +967,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
+			prvRecordStats( pxQueue, queueSTATS_SEND, pdFALSE, xEntryTimeSet, xEntryTick );
 			traceQUEUE_SEND_FAILED( pxQueue );
 			return errQUEUE_FULL;
 		}
@@ -1064,6 +1119,8 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
 			xReturn = errQUEUE_FULL;
 		}
+
+		prvRecordStatsFromISR( pxQueue, queueSTATS_SEND, xReturn );
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -1229,6 +1286,8 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
 			xReturn = errQUEUE_FULL;
 		}
+
+		prvRecordStatsFromISR( pxQueue, queueSTATS_SEND, xReturn );
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -1242,6 +1301,10 @@ BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xEntryTick = 0;
+#endif
+
 	/* Check the pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1295,6 +1358,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdTRUE, xEntryTimeSet, xEntryTick );
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -1305,6 +1369,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					/* The queue was empty and no block time is specified (or
 					the block time has expired) so leave now. */
 					taskEXIT_CRITICAL();
+					prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdFALSE, xEntryTimeSet, xEntryTick );
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
 				}
@@ -1314,6 +1379,12 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_OBJECT_STATS == 1 )
+					{
+						xEntryTick = xTaskGetTickCount();
+					}
+					#endif
 				}
 				else
 				{
@@ -1338,6 +1409,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				taskSET_BLOCK_REASON( eBlockQueue, pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1366,6 +1438,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdFALSE, xEntryTimeSet, xEntryTick );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1384,6 +1457,10 @@ BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xEntryTick = 0;
+#endif
+
 #if( configUSE_MUTEXES == 1 )
 	BaseType_t xInheritanceOccurred = pdFALSE;
 #endif
@@ -1432,6 +1509,12 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->pxMutexHolder = ( int8_t * ) pvTaskIncrementMutexHeldCount(); /*lint !e961 Cast is not redundant as TaskHandle_t is a typedef. */
+
+						#if( configUSE_OBJECT_STATS == 1 )
+						{
+							pxQueue->xStats.xHoldStart = xTaskGetTickCount();
+						}
+						#endif
 					}
 					else
 					{
@@ -1458,6 +1541,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdTRUE, xEntryTimeSet, xEntryTick );
 				taskEXIT_CRITICAL();
 				return pdPASS;
 			}
@@ -1477,6 +1561,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					/* The semaphore count was 0 and no block time is specified
 					(or the block time has expired) so exit now. */
 					taskEXIT_CRITICAL();
+					prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdFALSE, xEntryTimeSet, xEntryTick );
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
 				}
@@ -1486,6 +1571,12 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_OBJECT_STATS == 1 )
+					{
+						xEntryTick = xTaskGetTickCount();
+					}
+					#endif
 				}
 				else
 				{
@@ -1520,6 +1611,15 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 						taskENTER_CRITICAL();
 						{
 							xInheritanceOccurred = xTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+
+							#if( configUSE_OBJECT_STATS == 1 )
+							{
+								if( xInheritanceOccurred != pdFALSE )
+								{
+									( pxQueue->xStats.ulInheritances )++;
+								}
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1530,6 +1630,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				}
 				#endif
 
+				taskSET_BLOCK_REASON( prvBlockReason( pxQueue ), pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1585,6 +1686,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 				}
 				#endif /* configUSE_MUTEXES */
 
+				prvRecordStats( pxQueue, queueSTATS_RECEIVE, pdFALSE, xEntryTimeSet, xEntryTick );
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1707,6 +1809,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+				taskSET_BLOCK_REASON( eBlockQueue, pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
@@ -1831,6 +1934,8 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xReturn = pdFAIL;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
+
+		prvRecordStatsFromISR( pxQueue, queueSTATS_RECEIVE, xReturn );
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -2053,6 +2158,22 @@ UBaseType_t uxMessagesWaiting;
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
 				/* The mutex is no longer being held. */
+				#if( configUSE_OBJECT_STATS == 1 )
+				{
+					if( pxQueue->pxMutexHolder != NULL )
+					{
+					const TickType_t xHeld = xTaskGetTickCount() - pxQueue->xStats.xHoldStart;
+
+						pxQueue->xStats.ulHoldTicks += ( uint32_t ) xHeld;
+
+						if( xHeld > pxQueue->xStats.xHoldMax )
+						{
+							pxQueue->xStats.xHoldMax = xHeld;
+						}
+					}
+				}
+				#endif /* configUSE_OBJECT_STATS */
+
 				xReturn = xTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
 				pxQueue->pxMutexHolder = NULL;
 			}
@@ -2610,20 +2731,50 @@ BaseType_t xReturn;
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
 	void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			vQueueAddObjectToRegistry( xQueue, pcQueueName, &( ( ( Queue_t * ) xQueue )->xStats ) );
+		}
+		#else
+		{
+			vQueueAddObjectToRegistry( xQueue, pcQueueName, NULL );
+		}
+		#endif
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vQueueAddObjectToRegistry( void *pvObject, const char *pcQueueName, ObjectStats_t *pxStats ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	{
 	UBaseType_t ux;
 
+		/* Remove compiler warnings about unused parameters should
+		configUSE_OBJECT_STATS not be set to 1. */
+		( void ) pxStats;
+
 		/* See if there is an empty space in the registry.  A NULL name denotes
 		a free slot. */
 		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
 		{
 			if( xQueueRegistry[ ux ].pcQueueName == NULL )
 			{
-				/* Store the information on this queue. */
+				/* Store the information on this object.  The name is stored
+				last as it marks the slot as used to uxQueueGetRegistryStats(). */
+				xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) pvObject;
+
+				#if( configUSE_OBJECT_STATS == 1 )
+				{
+					xQueueRegistry[ ux ].pxStats = pxStats;
+				}
+				#endif
+
 				xQueueRegistry[ ux ].pcQueueName = pcQueueName;
-				xQueueRegistry[ ux ].xHandle = xQueue;
 
-				traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+				traceQUEUE_REGISTRY_ADD( pvObject, pcQueueName );
 				break;
 			}
 			else
@@ -2696,6 +2847,125 @@ BaseType_t xReturn;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_STATS == 1 )
+
+	void vQueueStatsRecord( ObjectStats_t * const pxStats, const BaseType_t xDirection, const BaseType_t xSucceeded, const TickType_t xTicksBlocked, const UBaseType_t uxFill )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Called from tasks, from within critical sections and from
+		interrupts, so the interrupt mask is used as it can be nested. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( xDirection == queueSTATS_SEND )
+			{
+				if( xSucceeded != pdFALSE )
+				{
+					( pxStats->ulSends )++;
+				}
+				else
+				{
+					( pxStats->ulSendFailures )++;
+				}
+
+				pxStats->ulSendBlockedTicks += ( uint32_t ) xTicksBlocked;
+
+				if( xTicksBlocked > pxStats->xSendBlockedMax )
+				{
+					pxStats->xSendBlockedMax = xTicksBlocked;
+				}
+			}
+			else
+			{
+				if( xSucceeded != pdFALSE )
+				{
+					( pxStats->ulReceives )++;
+				}
+				else
+				{
+					( pxStats->ulReceiveFailures )++;
+				}
+
+				pxStats->ulReceiveBlockedTicks += ( uint32_t ) xTicksBlocked;
+
+				if( xTicksBlocked > pxStats->xReceiveBlockedMax )
+				{
+					pxStats->xReceiveBlockedMax = xTicksBlocked;
+				}
+			}
+
+			if( uxFill > pxStats->uxMaxFill )
+			{
+				pxStats->uxMaxFill = uxFill;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configUSE_OBJECT_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_STATS == 1 )
+
+	void vQueueGetStats( QueueHandle_t xQueue, ObjectStats_t *pxStats )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxQueue->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_OBJECT_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_OBJECT_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	UBaseType_t uxQueueGetRegistryStats( QueueRegistryStats_t *pxStatsArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t ux, uxCopied = ( UBaseType_t ) 0U;
+
+		configASSERT( pxStatsArray );
+
+		/* Objects are only added to and removed from the registry by tasks, so
+		with the scheduler suspended the entries cannot change, while the
+		statistics can still be updated by interrupts. */
+		vTaskSuspendAll();
+		{
+			for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE ) && ( uxCopied < uxArraySize ); ux++ )
+			{
+				if( xQueueRegistry[ ux ].pcQueueName != NULL )
+				{
+					pxStatsArray[ uxCopied ].pcName = xQueueRegistry[ ux ].pcQueueName;
+					pxStatsArray[ uxCopied ].pvHandle = ( void * ) xQueueRegistry[ ux ].xHandle;
+
+					taskENTER_CRITICAL();
+					{
+						pxStatsArray[ uxCopied ].xStats = *( xQueueRegistry[ ux ].pxStats );
+					}
+					taskEXIT_CRITICAL();
+
+					uxCopied++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxCopied;
+	}
+
+#endif /* ( ( configUSE_OBJECT_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
 	void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely )
@@ -2720,6 +2990,7 @@ BaseType_t xReturn;
 		if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
 		{
 			/* There is nothing in the queue, block for the specified period. */
+			taskSET_BLOCK_REASON( eBlockQueue, pxQueue );
 			vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
 		}
 		else
@@ -0,0 +1,580 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#if( configUSE_MUTEXES != 1 )
+	#error configUSE_MUTEXES must be set to 1 to build rwlock.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+typedef struct RWLockDefinition
+{
+	List_t xReadersWaiting;			/*< Tasks waiting to take the lock for reading, in priority order. */
+	List_t xWritersWaiting;			/*< Tasks waiting to take the lock for writing, in priority order. */
+	TaskHandle_t xWriter;			/*< The task holding the lock for writing, or NULL. */
+	UBaseType_t uxReaders;			/*< The number of times the lock is held for reading. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a newly allocated lock in the free state.
+ */
+static void prvInitialiseRWLock( RWLock_t *pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task in pxWaitList, or report that its block time has
+ * expired.  A writer holding the lock inherits the calling task's priority
+ * while it is blocked, and drops it again if the block time expires.  Called
+ * from a critical section.  Returns pdTRUE if the task was placed in the list,
+ * in which case the caller must try again once the critical section has been
+ * exited, and pdFALSE if the block time has expired.
+ */
+static BaseType_t prvBlockOnRWLock( RWLock_t *pxRWLock, List_t *pxWaitList, TickType_t *pxTicksToWait, TimeOut_t *pxTimeOut, BaseType_t *pxEntryTimeSet, BaseType_t *pxInheritanceOccurred ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the lock has become free.  Hands it to the highest priority
+ * waiting writer if there is one, otherwise unblocks every waiting reader so
+ * they can take it.  Called from a critical section.  Returns pdTRUE if a task
+ * with a priority above that of the calling task was unblocked.
+ */
+static BaseType_t prvHandOver( RWLock_t *pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * The priority of the highest priority task waiting for the lock, or
+ * tskIDLE_PRIORITY if there is none.
+ */
+static UBaseType_t prvGetHighestWaitingPriority( const RWLock_t *pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer )
+	{
+	RWLock_t *pxRWLock;
+
+		configASSERT( pxRWLockBuffer );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticRWLock_t equals the size of the real lock
+			structure. */
+			volatile size_t xSize = sizeof( StaticRWLock_t );
+			configASSERT( xSize == sizeof( RWLock_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxRWLock = ( RWLock_t * ) pxRWLockBuffer; /*lint !e740 RWLock_t and StaticRWLock_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseRWLock( pxRWLock );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxRWLock->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreate( void )
+	{
+	RWLock_t *pxRWLock;
+
+		pxRWLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) );
+
+		if( pxRWLock != NULL )
+		{
+			prvInitialiseRWLock( pxRWLock );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxRWLock->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+
+		return ( RWLockHandle_t ) pxRWLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+
+	configASSERT( pxRWLock );
+	configASSERT( pxRWLock->xWriter == NULL );
+	configASSERT( pxRWLock->uxReaders == ( UBaseType_t ) 0U );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xReadersWaiting ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xWritersWaiting ) ) != pdFALSE );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxRWLock );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxRWLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxRWLock );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxRWLock );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* Writers are preferred, so readers wait while a writer is
+			waiting as well as while one holds the lock. */
+			if( ( pxRWLock->xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxRWLock->xWritersWaiting ) ) != pdFALSE ) )
+			{
+				( pxRWLock->uxReaders )++;
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = prvBlockOnRWLock( pxRWLock, &( pxRWLock->xReadersWaiting ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, &xInheritanceOccurred );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+
+	configASSERT( pxRWLock );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0U )
+		{
+			( pxRWLock->uxReaders )--;
+
+			if( pxRWLock->uxReaders == ( UBaseType_t ) 0U )
+			{
+				xYieldRequired = prvHandOver( pxRWLock );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeReadFromISR( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	/* See the comment in xQueueGenericSendFromISR() about interrupt priorities. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxRWLock->xWriter == NULL ) && ( listLIST_IS_EMPTY( &( pxRWLock->xWritersWaiting ) ) != pdFALSE ) )
+		{
+			( pxRWLock->uxReaders )++;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxRWLock );
+
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0U )
+		{
+			( pxRWLock->uxReaders )--;
+
+			if( ( pxRWLock->uxReaders == ( UBaseType_t ) 0U ) && ( prvHandOver( pxRWLock ) != pdFALSE ) )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+TimeOut_t xTimeOut;
+
+	configASSERT( pxRWLock );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* Writing is not recursive. */
+	configASSERT( pxRWLock->xWriter != xCurrentTask );
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxRWLock->xWriter == xCurrentTask )
+			{
+				/* The lock was handed to this task while it was blocked. */
+				( void ) pvTaskIncrementMutexHeldCount();
+				xReturn = pdPASS;
+			}
+			else if( ( pxRWLock->xWriter == NULL ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0U ) )
+			{
+				pxRWLock->xWriter = ( TaskHandle_t ) pvTaskIncrementMutexHeldCount();
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = prvBlockOnRWLock( pxRWLock, &( pxRWLock->xWritersWaiting ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, &xInheritanceOccurred );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = ( RWLock_t * ) xRWLock;
+BaseType_t xReturn = pdFAIL, xYieldRequired = pdFALSE;
+TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	configASSERT( pxRWLock );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxRWLock->xWriter == xCurrentTask )
+		{
+			/* Give up any priority inherited while holding the lock. */
+			xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
+
+			pxRWLock->xWriter = NULL;
+
+			if( prvHandOver( pxRWLock ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseRWLock( RWLock_t *pxRWLock )
+{
+	vListInitialise( &( pxRWLock->xReadersWaiting ) );
+	vListInitialise( &( pxRWLock->xWritersWaiting ) );
+	pxRWLock->xWriter = NULL;
+	pxRWLock->uxReaders = ( UBaseType_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvBlockOnRWLock( RWLock_t *pxRWLock, List_t *pxWaitList, TickType_t *pxTicksToWait, TimeOut_t *pxTimeOut, BaseType_t *pxEntryTimeSet, BaseType_t *pxInheritanceOccurred )
+{
+BaseType_t xReturn;
+
+	xReturn = xTaskBlockOnEventList( pxWaitList, pxTicksToWait, pxTimeOut, pxEntryTimeSet, eBlockMutex, pxRWLock );
+
+	if( xReturn != pdFALSE )
+	{
+		/* Interrupts are still masked, so the writer inherits the priority
+		before the calling task stops running. */
+		if( pxRWLock->xWriter != NULL )
+		{
+			if( xTaskPriorityInherit( pxRWLock->xWriter ) != pdFALSE )
+			{
+				*pxInheritanceOccurred = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		if( ( *pxInheritanceOccurred != pdFALSE ) && ( pxRWLock->xWriter != NULL ) )
+		{
+			/* The writer only drops down as far as the highest priority task
+			still waiting. */
+			vTaskPriorityDisinheritAfterTimeout( pxRWLock->xWriter, prvGetHighestWaitingPriority( pxRWLock ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( pxWaitList == &( pxRWLock->xWritersWaiting ) ) && ( pxRWLock->xWriter == NULL ) && ( listLIST_IS_EMPTY( pxWaitList ) != pdFALSE ) )
+		{
+			/* The last waiting writer gave up while readers held the lock, so
+			the readers it was holding off can now take it too. */
+			if( prvHandOver( pxRWLock ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvHandOver( RWLock_t *pxRWLock )
+{
+BaseType_t xReturn = pdFALSE;
+
+	if( listLIST_IS_EMPTY( &( pxRWLock->xWritersWaiting ) ) == pdFALSE )
+	{
+		/* The lists are in priority order, so the head is the highest priority
+		writer.  It finds it holds the lock when it runs. */
+		pxRWLock->xWriter = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxRWLock->xWritersWaiting ) );
+		xReturn = xTaskRemoveFromEventList( &( pxRWLock->xWritersWaiting ) );
+	}
+	else
+	{
+		while( listLIST_IS_EMPTY( &( pxRWLock->xReadersWaiting ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxRWLock->xReadersWaiting ) ) != pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetHighestWaitingPriority( const RWLock_t *pxRWLock )
+{
+UBaseType_t uxPriority = tskIDLE_PRIORITY, uxWriterPriority;
+
+	if( listLIST_IS_EMPTY( &( pxRWLock->xReadersWaiting ) ) == pdFALSE )
+	{
+		uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xReadersWaiting ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( listLIST_IS_EMPTY( &( pxRWLock->xWritersWaiting ) ) == pdFALSE )
+	{
+		uxWriterPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xWritersWaiting ) );
+
+		if( uxWriterPriority > uxPriority )
+		{
+			uxPriority = uxWriterPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxPriority;
+}
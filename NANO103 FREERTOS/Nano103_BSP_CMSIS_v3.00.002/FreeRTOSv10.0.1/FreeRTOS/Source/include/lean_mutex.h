@@ -0,0 +1,244 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Lean mutexes are an alternative to the mutex type semaphores of semphr.h for
+ * code that takes and gives locks often and rarely finds them held.  A lean
+ * mutex is two words, can be declared anywhere without allocation, and is
+ * taken and given with interrupts masked for a few instructions when there is
+ * no contention - the queue, its critical sections and its bookkeeping are not
+ * involved.
+ *
+ * A task that finds the mutex held blocks in one of configLEAN_MUTEX_WAIT_LISTS
+ * event lists shared by all lean mutexes, and the holder inherits its priority
+ * exactly as with a semphr.h mutex.  Giving a mutex that has waiters hands it
+ * directly to the highest priority one.
+ *
+ * Lean mutexes cannot be used from interrupts, are not recursive, and must
+ * only be given by the task that took them.  configUSE_LEAN_MUTEXES must be set
+ * to 1 for the task support they need to be built.
+ *
+ * A ceiling mutex is a lean mutex that uses the immediate priority ceiling
+ * protocol instead of priority inheritance.  Its ceiling is fixed when it is
+ * initialised, and must be at least the priority of every task that takes it.
+ * The task that takes it runs at the ceiling until it gives it, so no other
+ * task that uses the mutex can preempt the holder and blocking on it is
+ * bounded by the longest time it is held.  configUSE_CEILING_MUTEXES must be
+ * set to 1 to build them.
+ */
+
+#ifndef LEAN_MUTEX_H
+#define LEAN_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include lean_mutex.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/*
+ * A lean mutex.  Declared by the application and initialised with
+ * leanMUTEX_INITIALISER or vLeanMutexInit().  The members are private to
+ * lean_mutex.c.
+ */
+typedef struct LEAN_MUTEX
+{
+	TaskHandle_t volatile xOwner;		/*< The task holding the mutex, or NULL if it is free. */
+	volatile UBaseType_t uxWaiters;		/*< Tasks that have blocked on the mutex and not yet been given it or timed out. */
+} LeanMutex_t;
+
+#define leanMUTEX_INITIALISER { NULL, 0U }
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+void vLeanMutexInit( LeanMutex_t *pxMutex );
+</pre>
+ *
+ * Initialise a lean mutex in the free state.  Equivalent to declaring it with
+ * leanMUTEX_INITIALISER.
+ *
+ * \defgroup vLeanMutexInit vLeanMutexInit
+ * \ingroup LeanMutexes
+ */
+void vLeanMutexInit( LeanMutex_t *pxMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+BaseType_t xLeanMutexTake( LeanMutex_t *pxMutex, TickType_t xTicksToWait );
+</pre>
+ *
+ * Take a lean mutex, blocking for up to xTicksToWait ticks if another task
+ * holds it.  While the calling task is blocked the holder inherits its
+ * priority.  Must not be called from an interrupt, or by the task that already
+ * holds the mutex.
+ *
+ * Example use:
+<pre>
+static LeanMutex_t xTableMutex = leanMUTEX_INITIALISER;
+
+void vUpdateTable( uint32_t ulIndex, uint32_t ulValue )
+{
+    if( xLeanMutexTake( &xTableMutex, pdMS_TO_TICKS( 10 ) ) == pdPASS )
+    {
+        ulTable[ ulIndex ] = ulValue;
+        ( void ) xLeanMutexGive( &xTableMutex );
+    }
+}
+</pre>
+ *
+ * @return pdPASS if the mutex was taken, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xLeanMutexTake xLeanMutexTake
+ * \ingroup LeanMutexes
+ */
+BaseType_t xLeanMutexTake( LeanMutex_t *pxMutex, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+BaseType_t xLeanMutexGive( LeanMutex_t *pxMutex );
+</pre>
+ *
+ * Give a lean mutex taken by the calling task.  If tasks are waiting for it the
+ * mutex passes to the highest priority one, and any priority the calling task
+ * inherited while holding it is given up.
+ *
+ * @return pdPASS if the mutex was given, or pdFAIL if the calling task did not
+ * hold it.
+ *
+ * \defgroup xLeanMutexGive xLeanMutexGive
+ * \ingroup LeanMutexes
+ */
+BaseType_t xLeanMutexGive( LeanMutex_t *pxMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+TaskHandle_t xLeanMutexGetOwner( LeanMutex_t *pxMutex );
+</pre>
+ *
+ * @return The handle of the task holding the mutex, or NULL if it is free.
+ *
+ * \defgroup xLeanMutexGetOwner xLeanMutexGetOwner
+ * \ingroup LeanMutexes
+ */
+#define xLeanMutexGetOwner( pxMutex ) ( ( pxMutex )->xOwner )
+
+#if( configUSE_CEILING_MUTEXES == 1 )
+
+/*
+ * A priority ceiling mutex.  Declared by the application and initialised with
+ * ceilingMUTEX_INITIALISER() or vCeilingMutexInit().  The members are private
+ * to lean_mutex.c.
+ */
+typedef struct CEILING_MUTEX
+{
+	LeanMutex_t xMutex;					/*< The mutex itself. */
+	UBaseType_t uxCeiling;				/*< The priority the holder runs at. */
+	UBaseType_t uxPreviousCeiling;		/*< The ceiling of the holder before it took the mutex. */
+} CeilingMutex_t;
+
+#define ceilingMUTEX_INITIALISER( uxCeiling ) { leanMUTEX_INITIALISER, ( uxCeiling ), 0U }
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+void vCeilingMutexInit( CeilingMutex_t *pxMutex, UBaseType_t uxCeiling );
+</pre>
+ *
+ * Initialise a priority ceiling mutex in the free state.  Equivalent to
+ * declaring it with ceilingMUTEX_INITIALISER( uxCeiling ).
+ *
+ * @param uxCeiling The priority a task runs at while it holds the mutex.  Must
+ * be at least the priority of every task that takes the mutex.
+ *
+ * \defgroup vCeilingMutexInit vCeilingMutexInit
+ * \ingroup LeanMutexes
+ */
+void vCeilingMutexInit( CeilingMutex_t *pxMutex, UBaseType_t uxCeiling ) PRIVILEGED_FUNCTION;
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+BaseType_t xCeilingMutexTake( CeilingMutex_t *pxMutex, TickType_t xTicksToWait );
+</pre>
+ *
+ * Take a priority ceiling mutex, raising the priority of the calling task to
+ * the ceiling of the mutex first.  Blocking only happens if the holder itself
+ * blocked while holding the mutex.  Ceiling mutexes may be nested, but must be
+ * given in the reverse of the order in which they were taken.
+ *
+ * Changing the priority of the holder with vTaskPrioritySet() takes effect
+ * when it gives the mutex, unless the new priority is above the ceiling.
+ *
+ * @return pdPASS if the mutex was taken, or pdFAIL if xTicksToWait expired
+ * first, in which case the priority of the calling task is restored.
+ *
+ * \defgroup xCeilingMutexTake xCeilingMutexTake
+ * \ingroup LeanMutexes
+ */
+BaseType_t xCeilingMutexTake( CeilingMutex_t *pxMutex, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * lean_mutex.h
+ *
+<pre>
+BaseType_t xCeilingMutexGive( CeilingMutex_t *pxMutex );
+</pre>
+ *
+ * Give a priority ceiling mutex taken by the calling task, restoring the
+ * priority the task had before taking it.
+ *
+ * @return pdPASS if the mutex was given, or pdFAIL if the calling task did not
+ * hold it.
+ *
+ * \defgroup xCeilingMutexGive xCeilingMutexGive
+ * \ingroup LeanMutexes
+ */
+BaseType_t xCeilingMutexGive( CeilingMutex_t *pxMutex ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_CEILING_MUTEXES */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* LEAN_MUTEX_H */
+
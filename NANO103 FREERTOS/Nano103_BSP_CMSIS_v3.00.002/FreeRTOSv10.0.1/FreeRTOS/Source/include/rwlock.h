@@ -0,0 +1,207 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Readers-writer locks let any number of tasks read shared data at the same
+ * time while giving a writing task exclusive access.  They suit lookup tables,
+ * calibration data and the like that are read far more often than they are
+ * written, where a mutex would serialise the readers needlessly.
+ *
+ * Writers are preferred: once a writer is waiting, new readers wait too, so a
+ * steady stream of readers cannot hold a writer off indefinitely.  When the
+ * last reader gives the lock, or a writer gives it, the lock passes directly
+ * to the highest priority waiting writer; readers are only unblocked when no
+ * writer is waiting.
+ *
+ * A writer holding the lock inherits the priority of the highest priority task
+ * waiting for it, as the holder of a mutex does.  Readers holding the lock are
+ * not tracked individually, so they do not inherit priorities.
+ *
+ * Interrupts can attempt to take the lock for reading, and give it back, but
+ * cannot block or write.
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include rwlock.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * rwlock.h
+ *
+ * Type by which readers-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns an RWLockHandle_t variable that can then be used as
+ * a parameter to other readers-writer lock functions.
+ *
+ * \defgroup RWLockHandle_t RWLockHandle_t
+ * \ingroup RWLocks
+ */
+typedef void * RWLockHandle_t;
+
+/**
+ * rwlock.h
+ *
+<pre>
+RWLockHandle_t xRWLockCreate( void );
+RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer );
+</pre>
+ *
+ * Create a readers-writer lock, either allocating its memory from the FreeRTOS
+ * heap or in the StaticRWLock_t variable pointed to by pxRWLockBuffer.  The
+ * lock is created free.
+ *
+ * @return The handle of the lock, or NULL if it could not be allocated.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLocks
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *
+<pre>
+void vRWLockDelete( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Delete a readers-writer lock.  The lock must be free and no task may be
+ * waiting for it.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLocks
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Take the lock for reading, blocking for up to xTicksToWait ticks while a
+ * writer holds it or is waiting for it, and give it back once the shared data
+ * has been read.  Reads must not be nested: if a writer starts waiting between
+ * the two takes, the second take waits for the writer while the writer waits
+ * for the first read to be given.
+ *
+ * Example use:
+<pre>
+RWLockHandle_t xTableLock;
+
+uint32_t ulLookup( uint32_t ulIndex )
+{
+uint32_t ulValue = 0;
+
+    if( xRWLockTakeRead( xTableLock, pdMS_TO_TICKS( 5 ) ) == pdPASS )
+    {
+        ulValue = ulTable[ ulIndex ];
+        ( void ) xRWLockGiveRead( xTableLock );
+    }
+
+    return ulValue;
+}
+</pre>
+ *
+ * @return xRWLockTakeRead() returns pdPASS if the lock was taken, or pdFAIL if
+ * xTicksToWait expired first.  xRWLockGiveRead() returns pdFAIL if the lock
+ * was not held for reading.
+ *
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRWLockTakeReadFromISR( RWLockHandle_t xRWLock );
+BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Versions of xRWLockTakeRead() and xRWLockGiveRead() that can be called from
+ * an interrupt.  xRWLockTakeReadFromISR() does not block, and fails if a
+ * writer holds the lock or is waiting for it.  The interrupt must give the lock
+ * back before it returns.
+ *
+ * xRWLockGiveReadFromISR() sets *pxHigherPriorityTaskWoken to pdTRUE if giving
+ * the lock unblocked a writer with a priority above that of the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt exits.
+ *
+ * \defgroup xRWLockTakeReadFromISR xRWLockTakeReadFromISR
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeReadFromISR( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *
+<pre>
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+</pre>
+ *
+ * Take the lock for writing, blocking for up to xTicksToWait ticks until no
+ * reader or other writer holds it, and give it back once the shared data has
+ * been updated.  Writing is not recursive, and the lock must be given by the
+ * task that took it.
+ *
+ * @return xRWLockTakeWrite() returns pdPASS if the lock was taken, or pdFAIL
+ * if xTicksToWait expired first.  xRWLockGiveWrite() returns pdFAIL if the
+ * calling task did not hold the lock for writing.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* RWLOCK_H */
+
@@ -120,6 +120,9 @@ void *pvPortMalloc( size_t xWantedSize )
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 static BaseType_t xHeapHasBeenInitialised = pdFALSE;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_STATS == 1 )
+	size_t xRequestedSize = xWantedSize;
+#endif
 
 	vTaskSuspendAll();
 	{
@@ -135,6 +138,14 @@ void *pvReturn = NULL;
 		structure in addition to the requested amount of bytes. */
 		if( xWantedSize > 0 )
 		{
+			#if( configUSE_HEAP_STATS == 1 )
+			{
+				/* Make room for the tag heap_stats.c places in front of the
+				application's memory. */
+				xWantedSize += xHeapStatsTagSize;
+			}
+			#endif
+
 			xWantedSize += heapSTRUCT_SIZE;
 
 			/* Ensure that blocks are always aligned to the required number of bytes. */
@@ -168,6 +179,12 @@ void *pvReturn = NULL;
 				list of free blocks. */
 				pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+				#if( configUSE_HEAP_STATS == 1 )
+				{
+					vPortHeapStatsFreeBlockRemoved( pxBlock->xBlockSize );
+				}
+				#endif
+
 				/* If the block is larger than required it can be split into two. */
 				if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
 				{
@@ -183,9 +200,21 @@ void *pvReturn = NULL;
 
 					/* Insert the new block into the list of free blocks. */
 					prvInsertBlockIntoFreeList( ( pxNewBlockLink ) );
+
+					#if( configUSE_HEAP_STATS == 1 )
+					{
+						vPortHeapStatsFreeBlockAdded( pxNewBlockLink->xBlockSize );
+					}
+					#endif
 				}
 
 				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				#if( configUSE_HEAP_STATS == 1 )
+				{
+					pvReturn = pvPortHeapStatsBlockAllocated( pvReturn, xRequestedSize, configHEAP_STATS_GET_CALLER() );
+				}
+				#endif
 			}
 		}
 
@@ -214,6 +243,14 @@ BlockLink_t *pxLink;
 
 	if( pv != NULL )
 	{
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			/* Step back over the tag to the address the allocator handed
+			out. */
+			puc = ( uint8_t * ) pvPortHeapStatsBlockFreed( pv );
+		}
+		#endif
+
 		/* The memory being freed will have an BlockLink_t structure immediately
 		before it. */
 		puc -= heapSTRUCT_SIZE;
@@ -227,6 +264,12 @@ BlockLink_t *pxLink;
 			/* Add this block to the list of free blocks. */
 			prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 			xFreeBytesRemaining += pxLink->xBlockSize;
+
+			#if( configUSE_HEAP_STATS == 1 )
+			{
+				vPortHeapStatsFreeBlockAdded( pxLink->xBlockSize );
+			}
+			#endif
 			traceFREE( pv, pxLink->xBlockSize );
 		}
 		( void ) xTaskResumeAll();
@@ -268,5 +311,11 @@ uint8_t *pucAlignedHeap;
 	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
 	pxFirstFreeBlock->xBlockSize = configADJUSTED_HEAP_SIZE;
 	pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
+
+	#if( configUSE_HEAP_STATS == 1 )
+	{
+		vPortHeapStatsFreeBlockAdded( pxFirstFreeBlock->xBlockSize );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * @file     heap_regions.c
+ * @version  V1.00
+ * @brief    Builds the heap_5 region table from the linker memory map.
+ *
+ * To use it, build heap_5.c instead of heap_2.c and set
+ * configUSE_HEAP_REGIONS to 1 in FreeRTOSConfig.h.  External SRAM on the EBI
+ * bus is added as a second region when configHEAP_EBI_SIZE is not 0.  All
+ * SRAM left over once .data, .bss and the main stack have been placed becomes
+ * heap, so the heap grows with the part's SRAM and configTOTAL_HEAP_SIZE is
+ * not used.  heap_5 allocates first fit in address order, so internal SRAM is
+ * always used before the slower EBI region.
+ *
+ * Copyright (C) 2018 Nuvoton Technology Corp. All rights reserved.
+*****************************************************************************/
+#include "NUC126.h"
+/* Kernel includes. */
+#include "FreeRTOS.h"
+
+#if (configUSE_HEAP_REGIONS == 1)
+
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+/* End of the ZI data, which also holds the STACK area of the startup file
+   when the project uses the default memory layout. */
+extern uint8_t Image$$RW_IRAM1$$ZI$$Limit[];
+/* Only exists when a scatter file places the main stack at the top of SRAM. */
+extern uint8_t Image$$ARM_LIB_STACK$$ZI$$Base[] __attribute__((weak));
+
+#define HEAP_SRAM_START     (Image$$RW_IRAM1$$ZI$$Limit)
+#define HEAP_SRAM_END       ((Image$$ARM_LIB_STACK$$ZI$$Base != NULL) ? Image$$ARM_LIB_STACK$$ZI$$Base : \
+                             (uint8_t *)(SRAM_BASE + configHEAP_SRAM_SIZE))
+#elif defined(__GNUC__)
+/* Exported by the CMSIS gcc_arm.ld linker script. */
+extern uint8_t __HeapLimit[];
+extern uint8_t __StackLimit[];
+
+#define HEAP_SRAM_START     (__HeapLimit)
+#define HEAP_SRAM_END       (__StackLimit)
+#endif
+
+#if (configHEAP_EBI_SIZE > 0)
+/* Internal SRAM, EBI SRAM and the terminator. */
+static HeapRegion_t s_xHeapRegions[3];
+#else
+/* One SRAM region plus the terminator. */
+static HeapRegion_t s_xHeapRegions[2];
+#endif
+
+/*
+ * Hands all free SRAM to heap_5.  Must be called before anything is created,
+ * as creating a task, queue, timer, etc. calls pvPortMalloc().
+ */
+void vHeapRegionsInit(void)
+{
+    HeapRegion_t *pxRegion = s_xHeapRegions;
+
+    /* Regions must be listed in increasing address order. */
+    pxRegion->pucStartAddress = HEAP_SRAM_START;
+    pxRegion->xSizeInBytes = (size_t)(HEAP_SRAM_END - HEAP_SRAM_START);
+    pxRegion++;
+
+#if (configHEAP_EBI_SIZE > 0)
+    /* The EBI multi-function pins must already be set up by SYS_Init(). */
+    CLK_EnableModuleClock(EBI_MODULE);
+    EBI_Open(EBI_BANK0, EBI_BUSWIDTH_16BIT, EBI_TIMING_NORMAL, EBI_OPMODE_NORMAL, EBI_CS_ACTIVE_LOW);
+
+    pxRegion->pucStartAddress = (uint8_t *)EBI_BANK0_BASE_ADDR;
+    pxRegion->xSizeInBytes = configHEAP_EBI_SIZE;
+    pxRegion++;
+#endif
+
+    pxRegion->pucStartAddress = NULL;
+    pxRegion->xSizeInBytes = 0;
+
+    vPortDefineHeapRegions(s_xHeapRegions);
+}
+
+#endif /* configUSE_HEAP_REGIONS */
+
+/*** (C) COPYRIGHT 2018 Nuvoton Technology Corp. ***/
@@ -18,6 +18,10 @@
 #include "timers.h"
 #include "semphr.h"
 
+#if (configUSE_HEAP_REGIONS == 1)
+extern void vHeapRegionsInit(void);
+#endif
+
 
 /*********************************************************************
 *
@@ -115,6 +119,10 @@ int main(void)
     
     printf("FreeRTOS Demo \n");
     
+#if (configUSE_HEAP_REGIONS == 1)
+    /* Must run before the first object is created. */
+    vHeapRegionsInit();
+#endif
     xTaskCreate(Task0, (const char *)"Task0", 128, NULL, 1, NULL);
     xTaskCreate(Task1, (const char *)"Task1", 128, NULL, 2, NULL);
 
@@ -0,0 +1,421 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Active objects are event driven state machines that each own an event queue
+ * and process one event at a time to completion.  Rather than giving every
+ * state machine its own task and stack, any number of active objects are
+ * assigned to a few runner tasks - one per preemption level the application
+ * actually needs.  A runner always dispatches to the highest priority active
+ * object that has an event waiting, and never preempts a dispatch in progress,
+ * so active objects sharing a runner need no mutual exclusion between them.
+ *
+ * Events are either static (constant, or owned by a time event) or allocated
+ * from fixed block event pools.  Pool events are reference counted so a single
+ * event can be posted to, or published to, any number of active objects and is
+ * returned to its pool once the last of them has processed it.
+ *
+ * The event queues are FreeRTOS queues of event pointers, time events are
+ * FreeRTOS software timers, and runners sleep on their task notification.
+ * Runner tasks and event queues are created dynamically, so
+ * configSUPPORT_DYNAMIC_ALLOCATION must be 1.
+ */
+
+#ifndef ACTIVE_OBJECT_H
+#define ACTIVE_OBJECT_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include active_object.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+
+#if( configUSE_TIMERS == 1 )
+	#include "timers.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Identifies the type of an event.  Signals below configAO_MAX_PUB_SIGNAL can
+also be published. */
+typedef uint16_t AOSignal_t;
+
+/*
+ * The header of every event.  Events that carry parameters embed an AOEvent_t
+ * as their first member.  Static events must be initialised with
+ * aoSTATIC_EVENT(); pool events are initialised by pxAOEventNew().
+ */
+typedef struct AO_EVENT
+{
+	AOSignal_t xSignal;				/*< The event's type. */
+	uint8_t ucPoolId;				/*< 0 for static events, otherwise one more than the index of the owning pool. */
+	volatile uint8_t ucRefCount;	/*< Number of event queues the event is in, or being dispatched from. */
+} AOEvent_t;
+
+#define aoSTATIC_EVENT( xSignal ) { ( AOSignal_t ) ( xSignal ), 0U, 0U }
+
+/* Dispatch statistics kept for each active object when
+configAO_MEASURE_LATENCY is 1.  Latencies are in configAO_GET_TIMESTAMP()
+units, measured from the post to the start of the dispatch. */
+typedef struct AO_STATS
+{
+	uint32_t ulDispatchCount;		/*< Events dispatched. */
+	uint32_t ulMaxLatency;			/*< Longest post to dispatch latency. */
+	uint32_t ulTotalLatency;		/*< Sum of all latencies, to derive the mean. */
+	UBaseType_t uxMaxQueueDepth;	/*< Most events ever waiting in the queue, including the one being dispatched. */
+} AOStats_t;
+
+struct AO_ACTIVE;
+
+/* The prototype to which state machine dispatch functions must conform.  The
+event must not be used after the function returns. */
+typedef void ( *AODispatch_t )( struct AO_ACTIVE *pxAO, const AOEvent_t *pxEvent );
+
+/*
+ * A runner task.  Declared by the application (normally as a static variable)
+ * and initialised by xAORunnerCreate().
+ */
+typedef struct AO_RUNNER
+{
+	TaskHandle_t xTask;				/*< The task that dispatches to the runner's active objects. */
+	volatile uint32_t ulReadySet;	/*< Bit ( n - 1 ) is set while the active object of priority n has events waiting. */
+} AORunner_t;
+
+/*
+ * An active object.  Declared by the application, often as the first member
+ * of a structure that also holds the state machine's extended state, and
+ * initialised by xAOStart().
+ */
+typedef struct AO_ACTIVE
+{
+	AODispatch_t pxDispatch;		/*< The state machine. */
+	QueueHandle_t xQueue;			/*< Queue of pointers to posted events. */
+	AORunner_t *pxRunner;			/*< The runner the active object is assigned to. */
+	UBaseType_t uxPriority;			/*< Unique priority, 1 to configAO_MAX_ACTIVE. */
+	#if( configAO_MEASURE_LATENCY == 1 )
+		AOStats_t xStats;
+	#endif
+} AOActive_t;
+
+#if( configUSE_TIMERS == 1 )
+
+	/*
+	 * An event that is posted to an active object by a software timer.  The
+	 * event is static, so it can be posted any number of times without being
+	 * allocated.
+	 */
+	typedef struct AO_TIME_EVENT
+	{
+		AOEvent_t xEvent;			/*< The event posted on expiry - must be first. */
+		AOActive_t *pxAO;			/*< The active object the event is posted to. */
+		TimerHandle_t xTimer;		/*< The software timer that times the event. */
+	} AOTimeEvent_t;
+
+#endif /* configUSE_TIMERS */
+
+/**
+ * active_object.h
+ *
+<pre>
+BaseType_t xAOPoolInit( void *pvPoolStorage, size_t xPoolSizeBytes, size_t xEventSize );
+</pre>
+ *
+ * Add an event pool.  The storage is divided into blocks of xEventSize bytes,
+ * rounded up to portBYTE_ALIGNMENT.  Pools must be added in order of
+ * increasing event size, before any event is allocated, and
+ * pxAOEventNew() takes each event from the pool with the smallest blocks that
+ * are large enough.
+ *
+ * @return pdPASS if the pool was added, or pdFAIL if configAO_MAX_POOLS pools
+ * already exist.
+ *
+ * \defgroup xAOPoolInit xAOPoolInit
+ * \ingroup ActiveObjects
+ */
+BaseType_t xAOPoolInit( void *pvPoolStorage, size_t xPoolSizeBytes, size_t xEventSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+UBaseType_t uxAOPoolGetMinimumEverFree( UBaseType_t uxPool );
+</pre>
+ *
+ * Returns the lowest number of free blocks pool uxPool (counted from 0 in the
+ * order the pools were added) has ever had, for sizing the pools.
+ *
+ * \defgroup uxAOPoolGetMinimumEverFree uxAOPoolGetMinimumEverFree
+ * \ingroup ActiveObjects
+ */
+UBaseType_t uxAOPoolGetMinimumEverFree( UBaseType_t uxPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+AOEvent_t *pxAOEventNew( size_t xEventSize, AOSignal_t xSignal );
+AOEvent_t *pxAOEventNewFromISR( size_t xEventSize, AOSignal_t xSignal );
+</pre>
+ *
+ * Allocate an event of at least xEventSize bytes from the event pools and set
+ * its signal.  The event is returned to its pool once every active object it
+ * was posted or published to has processed it.  An event that is allocated
+ * but never posted must be released with vAOEventGarbageCollect().
+ *
+ * Example use:
+<pre>
+typedef struct
+{
+    AOEvent_t xSuper;
+    uint8_t ucByte;
+} RxEvent_t;
+
+void vUARTRxISR( uint8_t ucByte )
+{
+RxEvent_t *pxEvent;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    pxEvent = ( RxEvent_t * ) pxAOEventNewFromISR( sizeof( RxEvent_t ), RX_SIG );
+
+    if( pxEvent != NULL )
+    {
+        pxEvent->ucByte = ucByte;
+        ( void ) xAOPostFromISR( &xProtocolAO, &( pxEvent->xSuper ), &xHigherPriorityTaskWoken );
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+</pre>
+ *
+ * @return The event, or NULL if no pool with large enough blocks has a free
+ * block.
+ *
+ * \defgroup pxAOEventNew pxAOEventNew
+ * \ingroup ActiveObjects
+ */
+AOEvent_t *pxAOEventNew( size_t xEventSize, AOSignal_t xSignal ) PRIVILEGED_FUNCTION;
+AOEvent_t *pxAOEventNewFromISR( size_t xEventSize, AOSignal_t xSignal ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+void vAOEventGarbageCollect( const AOEvent_t *pxEvent );
+</pre>
+ *
+ * Release a reference to an event.  The runners call this after each
+ * dispatch, so the application only needs it for an event it allocated but
+ * decided not to post.  Static events are ignored.
+ *
+ * \defgroup vAOEventGarbageCollect vAOEventGarbageCollect
+ * \ingroup ActiveObjects
+ */
+void vAOEventGarbageCollect( const AOEvent_t *pxEvent ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+BaseType_t xAORunnerCreate( AORunner_t *pxRunner,
+                            const char * const pcName,
+                            configSTACK_DEPTH_TYPE usStackDepth,
+                            UBaseType_t uxTaskPriority );
+</pre>
+ *
+ * Create a runner task.  Its stack must hold the deepest dispatch of any
+ * active object assigned to it.
+ *
+ * @return pdPASS if the task was created, otherwise an error code defined
+ * within projdefs.h.
+ *
+ * \defgroup xAORunnerCreate xAORunnerCreate
+ * \ingroup ActiveObjects
+ */
+BaseType_t xAORunnerCreate( AORunner_t *pxRunner, const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxTaskPriority ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * active_object.h
+ *
+<pre>
+BaseType_t xAOStart( AOActive_t *pxAO,
+                     AORunner_t *pxRunner,
+                     UBaseType_t uxPriority,
+                     UBaseType_t uxQueueLength,
+                     AODispatch_t pxDispatch );
+</pre>
+ *
+ * Create the event queue of an active object and assign the active object to
+ * a runner.  uxPriority must be unique across all active objects, in the
+ * range 1 to configAO_MAX_ACTIVE, and orders both dispatching within a runner
+ * and delivery of published events.  Active objects that must preempt others
+ * are assigned to a runner with a higher task priority.
+ *
+ * Example use:
+<pre>
+static AORunner_t xFastRunner, xSlowRunner;
+static AOActive_t xProtocolAO, xDisplayAO;
+
+void vStartApplication( void )
+{
+    xAORunnerCreate( &xFastRunner, "AOf", 120, 3 );
+    xAORunnerCreate( &xSlowRunner, "AOs", 120, 1 );
+
+    xAOStart( &xProtocolAO, &xFastRunner, 2, 8, prvProtocolDispatch );
+    xAOStart( &xDisplayAO, &xSlowRunner, 1, 4, prvDisplayDispatch );
+
+    xAOSubscribe( &xDisplayAO, STATUS_SIG );
+}
+</pre>
+ *
+ * @return pdPASS if the queue was created, otherwise pdFAIL.
+ *
+ * \defgroup xAOStart xAOStart
+ * \ingroup ActiveObjects
+ */
+BaseType_t xAOStart( AOActive_t *pxAO, AORunner_t *pxRunner, UBaseType_t uxPriority, UBaseType_t uxQueueLength, AODispatch_t pxDispatch ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+BaseType_t xAOPost( AOActive_t *pxAO, const AOEvent_t *pxEvent );
+BaseType_t xAOPostFromISR( AOActive_t *pxAO, const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Post an event to the back of an active object's queue.  Posting never
+ * blocks.  If the queue is full the event is not posted, and a pool event that
+ * is not referenced anywhere else is returned to its pool.
+ *
+ * @return pdPASS if the event was posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xAOPost xAOPost
+ * \ingroup ActiveObjects
+ */
+BaseType_t xAOPost( AOActive_t *pxAO, const AOEvent_t *pxEvent ) PRIVILEGED_FUNCTION;
+BaseType_t xAOPostFromISR( AOActive_t *pxAO, const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+BaseType_t xAOSubscribe( AOActive_t *pxAO, AOSignal_t xSignal );
+BaseType_t xAOUnsubscribe( AOActive_t *pxAO, AOSignal_t xSignal );
+</pre>
+ *
+ * Add or remove an active object from the subscribers to a signal.
+ *
+ * @return pdPASS, or pdFAIL if xSignal is not below configAO_MAX_PUB_SIGNAL.
+ *
+ * \defgroup xAOSubscribe xAOSubscribe
+ * \ingroup ActiveObjects
+ */
+BaseType_t xAOSubscribe( AOActive_t *pxAO, AOSignal_t xSignal ) PRIVILEGED_FUNCTION;
+BaseType_t xAOUnsubscribe( AOActive_t *pxAO, AOSignal_t xSignal ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+<pre>
+UBaseType_t uxAOPublish( const AOEvent_t *pxEvent );
+UBaseType_t uxAOPublishFromISR( const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Post an event to every active object subscribed to its signal, highest
+ * priority first.  The scheduler is suspended while the event is multicast so
+ * no subscriber processes it before all of them have received it.  An event
+ * that nobody is subscribed to is returned to its pool.
+ *
+ * @return The number of active objects the event was posted to.  Subscribers
+ * whose queue is full are skipped.
+ *
+ * \defgroup uxAOPublish uxAOPublish
+ * \ingroup ActiveObjects
+ */
+UBaseType_t uxAOPublish( const AOEvent_t *pxEvent ) PRIVILEGED_FUNCTION;
+UBaseType_t uxAOPublishFromISR( const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMERS == 1 )
+
+	/**
+	 * active_object.h
+	 *
+	<pre>
+	BaseType_t xAOTimeEventCreate( AOTimeEvent_t *pxTimeEvent,
+	                               AOActive_t *pxAO,
+	                               AOSignal_t xSignal,
+	                               UBaseType_t uxAutoReload );
+	BaseType_t xAOTimeEventArm( AOTimeEvent_t *pxTimeEvent, TickType_t xTicks );
+	BaseType_t xAOTimeEventDisarm( AOTimeEvent_t *pxTimeEvent );
+	</pre>
+	 *
+	 * Create a time event that posts xSignal to pxAO xTicks after it is armed,
+	 * and then every xTicks if uxAutoReload is pdTRUE.  Arming an armed time
+	 * event restarts it.  A time event that expired just before it was
+	 * disarmed may still be in the active object's queue, so state machines
+	 * should ignore time events they do not expect.
+	 *
+	 * Arming and disarming send a command to the timer service task without
+	 * blocking, so can fail if the timer command queue is full.
+	 *
+	 * @return pdPASS on success, otherwise pdFAIL.
+	 *
+	 * \defgroup xAOTimeEventCreate xAOTimeEventCreate
+	 * \ingroup ActiveObjects
+	 */
+	BaseType_t xAOTimeEventCreate( AOTimeEvent_t *pxTimeEvent, AOActive_t *pxAO, AOSignal_t xSignal, UBaseType_t uxAutoReload ) PRIVILEGED_FUNCTION;
+	BaseType_t xAOTimeEventArm( AOTimeEvent_t *pxTimeEvent, TickType_t xTicks ) PRIVILEGED_FUNCTION;
+	BaseType_t xAOTimeEventDisarm( AOTimeEvent_t *pxTimeEvent ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMERS */
+
+#if( configAO_MEASURE_LATENCY == 1 )
+
+	/**
+	 * active_object.h
+	 *
+	<pre>
+	void vAOGetStats( AOActive_t *pxAO, AOStats_t *pxStats, BaseType_t xReset );
+	</pre>
+	 *
+	 * Copy the dispatch statistics of an active object, optionally resetting
+	 * them.  Only available when configAO_MEASURE_LATENCY is 1.
+	 *
+	 * \defgroup vAOGetStats vAOGetStats
+	 * \ingroup ActiveObjects
+	 */
+	void vAOGetStats( AOActive_t *pxAO, AOStats_t *pxStats, BaseType_t xReset ) PRIVILEGED_FUNCTION;
+
+#endif /* configAO_MEASURE_LATENCY */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* ACTIVE_OBJECT_H */
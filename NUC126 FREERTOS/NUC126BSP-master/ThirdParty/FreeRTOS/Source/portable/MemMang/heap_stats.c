@@ -0,0 +1,509 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Instrumentation layer shared by heap_2.c, heap_4.c and heap_5.c.  Build this
+ * file alongside one of those allocators and set configUSE_HEAP_STATS to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * The allocator reports every block that enters or leaves its free list, so a
+ * histogram of free blocks by size class is kept up to date as a side effect
+ * of normal allocation.  Querying it never walks the heap - the cost of every
+ * query is bounded by configHEAP_STATS_SIZE_CLASSES or configHEAP_STATS_MAX_TASKS,
+ * so a monitoring task can sample the heap in a production build.
+ *
+ * Each allocated block is prefixed by a small tag that records the task that
+ * owned the calling context when the block was allocated.  Bytes outstanding
+ * are accumulated per task in a table of configHEAP_STATS_MAX_TASKS entries.
+ * Entry 0 collects allocations made before the scheduler started and those
+ * made when the table is full.  When a task is deleted its entry keeps the
+ * bytes it still owns (a leak, unless another task frees them later) and is
+ * reused once they have all been freed.
+ *
+ * If configHEAP_STATS_TRACK_CALLERS is also set to 1 then the tag further
+ * records the return address of the pvPortMalloc() call and a sequence
+ * number, and the live allocations are kept on a list in allocation order.
+ * Taking a mark with ulPortHeapStatsMark() and later reading back what was
+ * allocated since the mark and is still live gives a leak snapshot that can
+ * be diffed over time.
+ */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_HEAP_STATS == 1 )
+
+/* The smallest size class covers blocks below 1 << heapstatsFIRST_CLASS_SHIFT
+bytes, which is below the minimum block size of every allocator. */
+#define heapstatsFIRST_CLASS_SHIFT	( 4 )
+
+/* The fragmentation index is expressed in parts per thousand. */
+#define heapstatsFRAGMENTATION_SCALE	( ( size_t ) 1000 )
+
+/* Index of the table entry that collects unattributed allocations. */
+#define heapstatsUNATTRIBUTED		( ( UBaseType_t ) 0 )
+
+/* The tag placed in front of every allocation handed to the application. */
+typedef struct HEAP_TAG
+{
+	#if( configHEAP_STATS_TRACK_CALLERS == 1 )
+		struct HEAP_TAG *pxPrevious;	/*<< Previous (older) live allocation. */
+		struct HEAP_TAG *pxNext;		/*<< Next (younger) live allocation. */
+		void *pvCaller;					/*<< Return address of the pvPortMalloc() call. */
+		uint32_t ulSequence;			/*<< Allocation sequence number. */
+	#endif
+	size_t xRequestedSize;				/*<< Bytes requested by the caller. */
+	UBaseType_t uxTaskEntry;			/*<< Index into xTaskEntries[]. */
+} HeapTag_t;
+
+/* Per task accounting. */
+typedef struct HEAP_TASK_ENTRY
+{
+	TaskHandle_t xTask;					/*<< Owner, or NULL if the entry is free or the owner was deleted. */
+	BaseType_t xOwnerDeleted;			/*<< pdTRUE if the owner was deleted while it still owned memory. */
+	size_t xBytesOutstanding;
+	size_t xPeakBytesOutstanding;
+	size_t xBlocksOutstanding;
+} HeapTaskEntry_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the size class a block of xBlockSize bytes belongs to.  The loop is
+ * bounded by configHEAP_STATS_SIZE_CLASSES.
+ */
+static UBaseType_t prvSizeClass( size_t xBlockSize );
+
+/*
+ * Returns the task table entry that allocations made from the calling context
+ * are attributed to, claiming a free entry if the calling task does not own
+ * one yet.  Must be called with the scheduler suspended.
+ */
+static UBaseType_t prvGetTaskEntry( void );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the tag rounded up so the application's memory stays aligned. */
+const size_t xHeapStatsTagSize = ( sizeof( HeapTag_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Free block histogram.  Class n holds blocks of at least
+( 1 << ( n + heapstatsFIRST_CLASS_SHIFT ) ) bytes and less than twice that -
+except class 0, which also holds anything smaller, and the last class, which
+holds anything larger. */
+static size_t xFreeBlocksInClass[ configHEAP_STATS_SIZE_CLASSES ];
+static size_t xFreeBytesInClass[ configHEAP_STATS_SIZE_CLASSES ];
+static size_t xNumberOfFreeBlocks = 0;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+static HeapTaskEntry_t xTaskEntries[ configHEAP_STATS_MAX_TASKS ];
+
+#if( configHEAP_STATS_TRACK_CALLERS == 1 )
+	/* Live allocations, oldest first. */
+	static HeapTag_t *pxOldestAllocation = NULL;
+	static HeapTag_t *pxYoungestAllocation = NULL;
+	static uint32_t ulNextSequence = 0UL;
+#endif
+
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvSizeClass( size_t xBlockSize )
+{
+UBaseType_t uxClass = 0;
+
+	xBlockSize >>= heapstatsFIRST_CLASS_SHIFT;
+
+	while( ( xBlockSize > ( size_t ) 1 ) && ( uxClass < ( ( UBaseType_t ) configHEAP_STATS_SIZE_CLASSES - 1U ) ) )
+	{
+		xBlockSize >>= 1;
+		uxClass++;
+	}
+
+	return uxClass;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetTaskEntry( void )
+{
+TaskHandle_t xCurrentTask;
+UBaseType_t uxEntry, uxFreeEntry = heapstatsUNATTRIBUTED;
+
+	if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+	{
+		/* There is no calling task yet. */
+		return heapstatsUNATTRIBUTED;
+	}
+
+	xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	for( uxEntry = 1; uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS; uxEntry++ )
+	{
+		if( xTaskEntries[ uxEntry ].xTask == xCurrentTask )
+		{
+			return uxEntry;
+		}
+		else if( ( uxFreeEntry == heapstatsUNATTRIBUTED ) && ( xTaskEntries[ uxEntry ].xTask == NULL ) && ( xTaskEntries[ uxEntry ].xBlocksOutstanding == ( size_t ) 0 ) )
+		{
+			/* Remember the first unused entry in case the task does not yet
+			own one. */
+			uxFreeEntry = uxEntry;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( uxFreeEntry != heapstatsUNATTRIBUTED )
+	{
+		xTaskEntries[ uxFreeEntry ].xTask = xCurrentTask;
+		xTaskEntries[ uxFreeEntry ].xOwnerDeleted = pdFALSE;
+		xTaskEntries[ uxFreeEntry ].xPeakBytesOutstanding = 0;
+	}
+	else
+	{
+		/* The table is full - increase configHEAP_STATS_MAX_TASKS. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxFreeEntry;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapStatsFreeBlockAdded( size_t xBlockSize )
+{
+UBaseType_t uxClass = prvSizeClass( xBlockSize );
+
+	( xFreeBlocksInClass[ uxClass ] )++;
+	xFreeBytesInClass[ uxClass ] += xBlockSize;
+	xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapStatsFreeBlockRemoved( size_t xBlockSize )
+{
+UBaseType_t uxClass = prvSizeClass( xBlockSize );
+
+	configASSERT( xFreeBlocksInClass[ uxClass ] > ( size_t ) 0 );
+
+	( xFreeBlocksInClass[ uxClass ] )--;
+	xFreeBytesInClass[ uxClass ] -= xBlockSize;
+	xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortHeapStatsBlockAllocated( void *pvBlock, size_t xRequestedSize, void *pvCaller )
+{
+HeapTag_t *pxTag = ( HeapTag_t * ) pvBlock;
+HeapTaskEntry_t *pxEntry;
+
+	/* Called from within the allocator, so the scheduler is already
+	suspended. */
+	pxTag->xRequestedSize = xRequestedSize;
+	pxTag->uxTaskEntry = prvGetTaskEntry();
+
+	pxEntry = &( xTaskEntries[ pxTag->uxTaskEntry ] );
+	pxEntry->xBytesOutstanding += xRequestedSize;
+	( pxEntry->xBlocksOutstanding )++;
+
+	if( pxEntry->xBytesOutstanding > pxEntry->xPeakBytesOutstanding )
+	{
+		pxEntry->xPeakBytesOutstanding = pxEntry->xBytesOutstanding;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	#if( configHEAP_STATS_TRACK_CALLERS == 1 )
+	{
+		pxTag->pvCaller = pvCaller;
+		pxTag->ulSequence = ulNextSequence;
+		ulNextSequence++;
+
+		/* Append to the live list, which is therefore in allocation order. */
+		pxTag->pxNext = NULL;
+		pxTag->pxPrevious = pxYoungestAllocation;
+
+		if( pxYoungestAllocation != NULL )
+		{
+			pxYoungestAllocation->pxNext = pxTag;
+		}
+		else
+		{
+			pxOldestAllocation = pxTag;
+		}
+
+		pxYoungestAllocation = pxTag;
+	}
+	#else
+	{
+		( void ) pvCaller;
+	}
+	#endif /* configHEAP_STATS_TRACK_CALLERS */
+
+	xNumberOfSuccessfulAllocations++;
+
+	/* The application's memory starts after the tag. */
+	return ( void * ) ( ( ( uint8_t * ) pvBlock ) + xHeapStatsTagSize );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortHeapStatsBlockFreed( void *pv )
+{
+HeapTag_t *pxTag;
+HeapTaskEntry_t *pxEntry;
+
+	pxTag = ( HeapTag_t * ) ( ( ( uint8_t * ) pv ) - xHeapStatsTagSize );
+
+	configASSERT( pxTag->uxTaskEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS );
+
+	vTaskSuspendAll();
+	{
+		pxEntry = &( xTaskEntries[ pxTag->uxTaskEntry ] );
+		configASSERT( pxEntry->xBytesOutstanding >= pxTag->xRequestedSize );
+		pxEntry->xBytesOutstanding -= pxTag->xRequestedSize;
+		( pxEntry->xBlocksOutstanding )--;
+
+		#if( configHEAP_STATS_TRACK_CALLERS == 1 )
+		{
+			if( pxTag->pxPrevious != NULL )
+			{
+				pxTag->pxPrevious->pxNext = pxTag->pxNext;
+			}
+			else
+			{
+				pxOldestAllocation = pxTag->pxNext;
+			}
+
+			if( pxTag->pxNext != NULL )
+			{
+				pxTag->pxNext->pxPrevious = pxTag->pxPrevious;
+			}
+			else
+			{
+				pxYoungestAllocation = pxTag->pxPrevious;
+			}
+		}
+		#endif /* configHEAP_STATS_TRACK_CALLERS */
+
+		xNumberOfSuccessfulFrees++;
+	}
+	( void ) xTaskResumeAll();
+
+	/* Return the address the allocator handed out. */
+	return ( void * ) pxTag;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapStatsTaskDeleted( void *pvTask )
+{
+UBaseType_t uxEntry;
+
+	vTaskSuspendAll();
+	{
+		for( uxEntry = 1; uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS; uxEntry++ )
+		{
+			if( xTaskEntries[ uxEntry ].xTask == ( TaskHandle_t ) pvTask )
+			{
+				/* The handle is about to become invalid and may be reused by
+				the next task that is created, so the entry is detached from
+				it.  Any bytes still outstanding stay visible. */
+				xTaskEntries[ uxEntry ].xTask = NULL;
+				xTaskEntries[ uxEntry ].xOwnerDeleted = ( xTaskEntries[ uxEntry ].xBlocksOutstanding != ( size_t ) 0 ) ? pdTRUE : pdFALSE;
+				break;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+UBaseType_t uxClass;
+size_t xLargestClassBytes = 0;
+
+	configASSERT( pxHeapStats );
+
+	vTaskSuspendAll();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xPortGetFreeHeapSize();
+		pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xLargestFreeBlockLowerBound = 0;
+
+		for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_STATS_SIZE_CLASSES; uxClass++ )
+		{
+			pxHeapStats->xFreeBlocksInClass[ uxClass ] = xFreeBlocksInClass[ uxClass ];
+
+			if( xFreeBlocksInClass[ uxClass ] != ( size_t ) 0 )
+			{
+				/* Class 0 also holds blocks below its nominal size. */
+				pxHeapStats->xLargestFreeBlockLowerBound = ( uxClass == 0U ) ? ( size_t ) 0 : ( ( ( size_t ) 1 ) << ( uxClass + heapstatsFIRST_CLASS_SHIFT ) );
+				xLargestClassBytes = xFreeBytesInClass[ uxClass ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* The share of the free space that is not in the largest size class -
+		0 when the free space is held in blocks of the biggest size class
+		present, approaching 1000 as it is scattered over smaller blocks. */
+		if( pxHeapStats->xAvailableHeapSpaceInBytes != ( size_t ) 0 )
+		{
+			pxHeapStats->uxFragmentationIndex = ( UBaseType_t ) ( ( ( pxHeapStats->xAvailableHeapSpaceInBytes - xLargestClassBytes ) * heapstatsFRAGMENTATION_SCALE ) / pxHeapStats->xAvailableHeapSpaceInBytes );
+		}
+		else
+		{
+			pxHeapStats->uxFragmentationIndex = 0;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapTaskStats( HeapTaskStats_t *pxTaskStatsArray, UBaseType_t uxArraySize )
+{
+UBaseType_t uxEntry, uxCount = 0;
+HeapTaskEntry_t *pxEntry;
+
+	configASSERT( pxTaskStatsArray );
+
+	vTaskSuspendAll();
+	{
+		for( uxEntry = 0; ( uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS ) && ( uxCount < uxArraySize ); uxEntry++ )
+		{
+			pxEntry = &( xTaskEntries[ uxEntry ] );
+
+			/* Only report entries that are attached to a task or still hold
+			memory. */
+			if( ( uxEntry == heapstatsUNATTRIBUTED ) || ( pxEntry->xTask != NULL ) || ( pxEntry->xBlocksOutstanding != ( size_t ) 0 ) )
+			{
+				pxTaskStatsArray[ uxCount ].pvTask = ( void * ) pxEntry->xTask;
+				pxTaskStatsArray[ uxCount ].xOwnerDeleted = pxEntry->xOwnerDeleted;
+				pxTaskStatsArray[ uxCount ].xBytesOutstanding = pxEntry->xBytesOutstanding;
+				pxTaskStatsArray[ uxCount ].xPeakBytesOutstanding = pxEntry->xPeakBytesOutstanding;
+				pxTaskStatsArray[ uxCount ].xBlocksOutstanding = pxEntry->xBlocksOutstanding;
+				uxCount++;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetHeapBytesOwnedByTask( void *pvTask )
+{
+UBaseType_t uxEntry;
+size_t xReturn = 0;
+
+	vTaskSuspendAll();
+	{
+		for( uxEntry = 1; uxEntry < ( UBaseType_t ) configHEAP_STATS_MAX_TASKS; uxEntry++ )
+		{
+			if( xTaskEntries[ uxEntry ].xTask == ( TaskHandle_t ) pvTask )
+			{
+				xReturn = xTaskEntries[ uxEntry ].xBytesOutstanding;
+				break;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_STATS_TRACK_CALLERS == 1 )
+
+	uint32_t ulPortHeapStatsMark( void )
+	{
+	uint32_t ulMark;
+
+		vTaskSuspendAll();
+		{
+			ulMark = ulNextSequence;
+		}
+		( void ) xTaskResumeAll();
+
+		return ulMark;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortHeapStatsGetAllocationsSince( uint32_t ulMark, HeapAllocationRecord_t *pxRecords, UBaseType_t uxMaxRecords )
+	{
+	HeapTag_t *pxTag;
+	UBaseType_t uxCount = 0;
+
+		configASSERT( pxRecords );
+
+		vTaskSuspendAll();
+		{
+			/* The live list is in allocation order, so everything allocated
+			since the mark is at its young end.  Walk back from there and stop
+			at the first older allocation, or when the array is full, so the
+			time spent with the scheduler suspended is bounded by
+			uxMaxRecords.  The subtraction keeps the comparison correct when
+			the sequence number wraps. */
+			for( pxTag = pxYoungestAllocation; ( pxTag != NULL ) && ( uxCount < uxMaxRecords ); pxTag = pxTag->pxPrevious )
+			{
+				if( ( int32_t ) ( pxTag->ulSequence - ulMark ) < 0 )
+				{
+					break;
+				}
+
+				pxRecords[ uxCount ].pvAddress = ( void * ) ( ( ( uint8_t * ) pxTag ) + xHeapStatsTagSize );
+				pxRecords[ uxCount ].xRequestedSize = pxTag->xRequestedSize;
+				pxRecords[ uxCount ].pvCaller = pxTag->pvCaller;
+				pxRecords[ uxCount ].pvTask = ( void * ) xTaskEntries[ pxTag->uxTaskEntry ].xTask;
+				pxRecords[ uxCount ].ulSequence = pxTag->ulSequence;
+				uxCount++;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxCount;
+	}
+
+#endif /* configHEAP_STATS_TRACK_CALLERS */
+
+#endif /* configUSE_HEAP_STATS */
+
@@ -100,12 +100,20 @@ changed then the definition of StaticTask_t must also be updated. */
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
 set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) )
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	1
 #else
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	0
 #endif
 
+/* Snapshots and the stack watermarks walk every task without suspending the
+scheduler, so need a list that references every task whatever its state. */
+#if( ( configUSE_TASK_SNAPSHOT == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) )
+	#define tskKEEP_ALL_TASKS_LIST	1
+#else
+	#define tskKEEP_ALL_TASKS_LIST	0
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -129,6 +137,41 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+/* Select the next task from a ready list that is not deadline ordered.  With
+per-task time slice quanta a task that was preempted part way through its
+slice is selected again, rather than the task after it, until its slice is
+used up. */
+#if( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configUSE_TIME_SLICE_QUANTUM == 1 ) )
+	#define taskSELECT_NEXT_ENTRY( pxList ) pxCurrentTCB = prvSelectWithinQuantum( pxList )
+#else
+	#define taskSELECT_NEXT_ENTRY( pxList ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, pxList )
+#endif
+
+/* Select the task to run from the ready list of priority uxTopPriority.
+taskSELECT_NEXT_ENTRY indexes through the list, so the tasks of the same
+priority get an equal share of the processor time.  The list of priority
+configEDF_PRIORITY is kept in deadline order when EDF scheduling is used, and
+the task at its head, the one with the earliest deadline, is always selected.
+Tasks with the same deadline take turns at the head as the tick moves the
+running task behind them. */
+#if( configUSE_EDF_SCHEDULING == 1 )
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority )													\
+	{																									\
+		if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_PRIORITY )									\
+		{																								\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );	\
+		}																								\
+		else																							\
+		{																								\
+			taskSELECT_NEXT_ENTRY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );						\
+		}																								\
+	}
+#else
+	#define taskSELECT_FROM_READY_LIST( uxTopPriority ) taskSELECT_NEXT_ENTRY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -158,9 +201,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 			--uxTopPriority;																			\
 		}																								\
 																										\
-		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
-		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );													\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -190,7 +231,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -230,12 +271,60 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if the
+ * list is that of priority configEDF_PRIORITY and EDF scheduling is used.
+ */
+#if( configUSE_EDF_SCHEDULING == 1 )
+	#define taskINSERT_INTO_READY_LIST( pxTCB )															\
+	{																									\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )								\
+		{																								\
+			prvInsertInDeadlineOrder( pxTCB );															\
+		}																								\
+		else																							\
+		{																								\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+		}																								\
+	}
+#else
+	#define taskINSERT_INTO_READY_LIST( pxTCB ) vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+#endif
+
+/*
+ * Every task leaving the Blocked state passes through prvAddTaskToReadyList(),
+ * or through vTaskSuspend(), so the time it was blocked for is recorded there.
+ * The reason it entered the Blocked state is recorded just before it is added
+ * to a delayed list.
  */
+#if( configUSE_BLOCKING_STATS == 1 )
+	#define taskRECORD_BLOCK_START( eDefaultReason ) prvRecordBlockStart( eDefaultReason )
+	#define taskRECORD_BLOCK_END( pxTCB ) prvRecordBlockEnd( pxTCB )
+	#define taskCLEAR_BLOCK_HINT() pxCurrentTCB->ucBlockHint = ( uint8_t ) eBlockNone
+
+	/* Blocking times are measured with the run time stats clock, if there is
+	one, so they can be compared with the run time of each task. */
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			#define taskBLOCK_TIME_NOW( ulNow ) portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow )
+		#else
+			#define taskBLOCK_TIME_NOW( ulNow ) ( ulNow ) = portGET_RUN_TIME_COUNTER_VALUE()
+		#endif
+		#define taskBLOCK_TIME_SINCE( ulStart, ulNow ) ( ( ulNow ) - ( ulStart ) )
+	#else
+		#define taskBLOCK_TIME_NOW( ulNow ) ( ulNow ) = ( uint32_t ) xTickCount
+		#define taskBLOCK_TIME_SINCE( ulStart, ulNow ) ( ( uint32_t ) ( ( TickType_t ) ( ( ulNow ) - ( ulStart ) ) ) )
+	#endif
+#else
+	#define taskRECORD_BLOCK_START( eDefaultReason )
+	#define taskRECORD_BLOCK_END( pxTCB )
+	#define taskCLEAR_BLOCK_HINT()
+#endif
+
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+	taskRECORD_BLOCK_END( pxTCB );																	\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -261,6 +350,54 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+/* The base priority of a task, or configBUDGET_DEMOTED_PRIORITY while it is
+demoted because its budget is used up, so a demoted task that inherits a
+priority is demoted again when it disinherits it. */
+#if( configUSE_TASK_BUDGETS == 1 )
+	#define taskBUDGET_PRIORITY( pxTCB, uxBase ) ( ( ( ( pxTCB )->ucBudgetThrottled != pdFALSE ) && ( ( pxTCB )->ucBudgetAction == ( uint8_t ) eBudgetDemote ) ) ? ( UBaseType_t ) configBUDGET_DEMOTED_PRIORITY : ( uxBase ) )
+#else
+	#define taskBUDGET_PRIORITY( pxTCB, uxBase ) ( uxBase )
+#endif
+
+/* The priority a task runs at when it has not inherited a priority from a task
+waiting for one of its mutexes - its base priority, raised to the ceiling of
+any priority ceiling mutex it holds. */
+#if( configUSE_CEILING_MUTEXES == 1 )
+	#define taskUNINHERITED_PRIORITY( pxTCB, uxBase ) ( ( taskBUDGET_PRIORITY( ( pxTCB ), ( uxBase ) ) > ( pxTCB )->uxCeilingPriority ) ? taskBUDGET_PRIORITY( ( pxTCB ), ( uxBase ) ) : ( pxTCB )->uxCeilingPriority )
+#else
+	#define taskUNINHERITED_PRIORITY( pxTCB, uxBase ) taskBUDGET_PRIORITY( ( pxTCB ), ( uxBase ) )
+#endif
+
+#if( ( configUSE_EDF_SCHEDULING == 1 ) || ( configUSE_TASK_BUDGETS == 1 ) )
+	/* Deadlines and budget replenishment times are tick counts, so are
+	compared by the sign of their difference to remain correct when the tick
+	count overflows.  xA is before xB if xA - xB is negative. */
+	#define taskTICK_IS_BEFORE( xA, xB ) ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+#endif
+
+/* Called at each tick that time slicing could switch to the next ready task of
+the running task's priority, to decide whether it should. */
+#if( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configUSE_TIME_SLICE_QUANTUM == 1 ) )
+	#define taskTIME_SLICE_EXPIRED() prvTimeSliceExpired()
+#else
+	#define taskTIME_SLICE_EXPIRED() ( pdTRUE )
+#endif
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+	/* pxA goes before pxB in the deadline ordered ready list.  A task without a
+	deadline, which can only be in that list because of the priority it was
+	created with or has inherited, goes after every task with a deadline, so
+	only runs when none of them is ready.  Tasks with equal deadlines, and
+	tasks without a deadline, stay in the order they became ready. */
+	#define taskDEADLINE_PRECEDES( pxA, pxB ) ( ( ( pxA )->xRelativeDeadline != ( TickType_t ) 0 ) && ( ( ( pxB )->xRelativeDeadline == ( TickType_t ) 0 ) || taskTICK_IS_BEFORE( ( pxA )->xAbsoluteDeadline, ( pxB )->xAbsoluteDeadline ) ) )
+
+	/* A task made ready should preempt the running task if it has a higher
+	priority, or goes before it in the deadline ordered ready list. */
+	#define taskPREEMPTS_CURRENT( pxTCB ) ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) || ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) && ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) && taskDEADLINE_PRECEDES( ( pxTCB ), pxCurrentTCB ) ) )
+#else
+	#define taskPREEMPTS_CURRENT( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -298,6 +435,63 @@ typedef struct tskTaskControlBlock
 		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if( configUSE_LEAN_MUTEXES == 1 )
+		const void		*pvEventListTag;	/*< The object waited for while the task is in an event list shared by several objects. */
+	#endif
+
+	#if( configUSE_CEILING_MUTEXES == 1 )
+		UBaseType_t		uxCeilingPriority;	/*< The highest ceiling of the priority ceiling mutexes held by the task, or tskIDLE_PRIORITY if it holds none. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xRelativeDeadline;	/*< Ticks from the release of each job to its deadline, or 0 if the task has no deadline. */
+		TickType_t		xPeriod;			/*< Ticks between releases, used by vTaskDelayUntil() when passed an increment of 0. */
+		TickType_t		xAbsoluteDeadline;	/*< The tick count by which the current job must complete. */
+		uint32_t		ulJobsCompleted;
+		uint32_t		ulDeadlinesMissed;
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+		ListItem_t		xBudgetListItem;	/*< Used to reference the task from xBudgetThrottledList while it waits for its budget to be replenished. */
+		uint32_t		ulBudget;			/*< Timer counts the task can run for each period, or 0 if it has no budget. */
+		uint32_t		ulBudgetUsed;		/*< Timer counts the task has run for in the current period. */
+		uint32_t		ulBudgetExhaustions;
+		TickType_t		xBudgetPeriod;
+		TickType_t		xBudgetReplenishTime;	/*< The tick count at which the current period ends. */
+		UBaseType_t		uxBudgetPriority;	/*< The priority to restore a demoted task to. */
+		uint8_t			ucBudgetAction;		/*< An eBudgetAction value. */
+		uint8_t			ucBudgetThrottled;	/*< Set to pdTRUE while the task is demoted or suspended by its budget. */
+	#endif
+
+	#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+		UBaseType_t		uxTimeSliceQuantum;	/*< Ticks the task runs for before time slicing switches to the next task of its priority. */
+		UBaseType_t		uxTimeSliceTicksLeft;	/*< Ticks left of the task's current time slice, or 0 once it has run for its quantum. */
+	#endif
+
+	#if( configUSE_TASK_POOLS == 1 )
+		struct TaskPoolDefinition *pxTaskPool;	/*< The pool the task was created from, or NULL if it was not created from a pool. */
+	#endif
+
+	#if( tskKEEP_ALL_TASKS_LIST == 1 )
+		ListItem_t		xAllTasksListItem;	/*< Used to reference the task from xAllTasksList. */
+	#endif
+
+	#if( configUSE_STACK_WATERMARK == 1 )
+		configSTACK_DEPTH_TYPE	uxStackDepth;		/*< The number of words the stack was created with. */
+		configSTACK_DEPTH_TYPE	uxStackMinimumFree;	/*< The least free stack space, in words, the idle task has found. */
+	#endif
+
+	#if( configUSE_BLOCKING_STATS == 1 )
+		uint32_t		ulBlockStart;		/*< When the task last entered the Blocked state, in the units of ulBlockedTime. */
+		uint32_t		ulLongestBlock;		/*< The longest the task has been blocked for at once. */
+		uint32_t		ulBlockedTime[ eBlockReasonCount ];	/*< The time the task has been blocked for each eBlockReason. */
+		const void		*pvBlockObject;		/*< The object the task is blocked on, or last blocked on, or NULL. */
+		const void		*pvLongestBlockObject;	/*< The object the task was blocked on for ulLongestBlock. */
+		uint8_t			ucBlockHint;		/*< The eBlockReason given by vTaskSetBlockReason() for the next block, or eBlockNone. */
+		uint8_t			ucBlockReason;		/*< The eBlockReason the task is blocked for, or eBlockNone. */
+		uint8_t			ucLongestBlockReason;	/*< The eBlockReason the task was blocked for ulLongestBlock. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
@@ -322,8 +516,8 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -342,6 +536,19 @@ typedef struct tskTaskControlBlock
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if( configUSE_TASK_POOLS == 1 )
+
+	/* A pool of task control blocks and stacks created by xTaskPoolCreate().
+	The TCBs not in use are held in xFreeTasks by their state list items. */
+	typedef struct TaskPoolDefinition
+	{
+		List_t xFreeTasks;
+		configSTACK_DEPTH_TYPE usStackDepth;
+		UBaseType_t uxMinimumEverFree;
+	} TaskPool_t;
+
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
@@ -397,6 +604,32 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static List_t xBudgetThrottledList;			/*< Tasks that have used up their budget, waiting for it to be replenished. */
+	PRIVILEGED_DATA static uint32_t ulBudgetChargedTime = 0UL;	/*< The value of configBUDGET_TIMER_VALUE() when the running task was last charged for its time. */
+
+#endif
+
+#if( configUSE_TASK_POOLS == 1 )
+
+	PRIVILEGED_DATA static TCB_t * volatile pxPoolTaskToReturn = NULL;	/*< A task from a pool that deleted itself, to return to its pool once it has been switched out. */
+
+#endif
+
+#if( tskKEEP_ALL_TASKS_LIST == 1 )
+
+	PRIVILEGED_DATA static List_t xAllTasksList;	/*< Every task that exists, in the order they were created, whatever their state. */
+
+#endif
+
+#if( configUSE_STACK_WATERMARK == 1 )
+
+	PRIVILEGED_DATA static const ListItem_t * pxNextStackToScan = NULL;	/*< The task the idle task scans the stack of next. */
+	PRIVILEGED_DATA static UBaseType_t uxStackScanGeneration = 0;		/*< The value of uxTaskNumber when pxNextStackToScan was set. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -414,6 +647,18 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( configUSE_STACK_MARGIN_HOOK == 1 )
+
+	extern void vApplicationStackMarginHook( TaskHandle_t xTask, char *pcTaskName, configSTACK_DEPTH_TYPE uxFreeWords );
+
+#endif
+
+#if( configUSE_BUDGET_EXHAUSTED_HOOK == 1 )
+
+	extern void vApplicationBudgetExhaustedHook( TaskHandle_t xTask );
+
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
@@ -463,6 +708,14 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
 	static void prvDeleteTCB( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
 
+	/*
+	 * Release what the port, the heap statistics and newlib hold for a deleted
+	 * task, leaving its TCB and stack in place.  Called by prvDeleteTCB(), and
+	 * for a task from a pool, whose TCB and stack go back to the pool instead
+	 * of being freed.
+	 */
+	static void prvCleanUpTCB( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
 #endif
 
 /*
@@ -507,12 +760,22 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) )
 
 	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Called by the idle task to scan the stack of the next task in xAllTasksList
+ * and update its minimum free stack space.
+ */
+#if( configUSE_STACK_WATERMARK == 1 )
+
+	static void prvScanNextStack( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state.
@@ -534,6 +797,86 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert pxTCB into the ready list of priority configEDF_PRIORITY, which is
+	 * kept in the order given by taskDEADLINE_PRECEDES().
+	 */
+	static void prvInsertInDeadlineOrder( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	/*
+	 * Add the time since the running task was last charged to the budget it
+	 * has used, first starting a new period if the last has ended.
+	 */
+	static void prvChargeBudget( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the tick.  Restores the tasks whose budget is due to be
+	 * replenished, and demotes or suspends the running task if it has used up
+	 * its budget.  Returns pdTRUE if a context switch is required.
+	 */
+	static BaseType_t prvCheckBudgets( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Replenish the budget of a task that used it up, restoring its priority or
+	 * making it ready again.  Returns pdTRUE if the task should preempt the
+	 * running task.
+	 */
+	static BaseType_t prvReplenishBudget( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Start the next budget period of pxTCB with none of its budget used.
+	 */
+	static void prvStartBudgetPeriod( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Change the priority of a task that is demoted by, or restored from, its
+	 * budget, moving it to the ready list of its new priority if it is ready.
+	 */
+	static void prvSetBudgetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configUSE_TIME_SLICE_QUANTUM == 1 ) )
+
+	/*
+	 * Count down the running task's time slice.  Returns pdTRUE once it has
+	 * run for its quantum.
+	 */
+	static BaseType_t prvTimeSliceExpired( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the task to run from pxList, a ready list of the priority being
+	 * switched to.  The task pxList is indexed at is returned again if it is
+	 * not the task being switched out and has time slice left, otherwise the
+	 * index is moved on to the next task as listGET_OWNER_OF_NEXT_ENTRY()
+	 * does.
+	 */
+	static TCB_t *prvSelectWithinQuantum( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_BLOCKING_STATS == 1 )
+
+	/*
+	 * Note that the running task is about to enter the Blocked state, and why.
+	 * eDefaultReason is used unless vTaskSetBlockReason() gave a reason.
+	 */
+	static void prvRecordBlockStart( eBlockReason eDefaultReason ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Add the time pxTCB has been blocked for to the total for the reason it
+	 * was blocked, if it was blocked.
+	 */
+	static void prvRecordBlockEnd( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -928,6 +1271,79 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if( configUSE_CEILING_MUTEXES == 1 )
+	{
+		pxNewTCB->uxCeilingPriority = tskIDLE_PRIORITY;
+	}
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xRelativeDeadline = ( TickType_t ) 0;
+		pxNewTCB->xPeriod = ( TickType_t ) 0;
+		pxNewTCB->xAbsoluteDeadline = ( TickType_t ) 0;
+		pxNewTCB->ulJobsCompleted = 0UL;
+		pxNewTCB->ulDeadlinesMissed = 0UL;
+	}
+	#endif
+
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+		pxNewTCB->ulBudget = 0UL;
+		pxNewTCB->ulBudgetUsed = 0UL;
+		pxNewTCB->ulBudgetExhaustions = 0UL;
+		pxNewTCB->xBudgetPeriod = ( TickType_t ) 0;
+		pxNewTCB->xBudgetReplenishTime = ( TickType_t ) 0;
+		pxNewTCB->uxBudgetPriority = uxPriority;
+		pxNewTCB->ucBudgetAction = ( uint8_t ) eBudgetDemote;
+		pxNewTCB->ucBudgetThrottled = pdFALSE;
+	}
+	#endif
+
+	#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+	{
+		pxNewTCB->uxTimeSliceQuantum = ( UBaseType_t ) configDEFAULT_TIME_SLICE_QUANTUM;
+		pxNewTCB->uxTimeSliceTicksLeft = ( UBaseType_t ) configDEFAULT_TIME_SLICE_QUANTUM;
+	}
+	#endif
+
+	#if( configUSE_TASK_POOLS == 1 )
+	{
+		/* Set by xTaskCreateFromPool() if the task is from a pool. */
+		pxNewTCB->pxTaskPool = NULL;
+	}
+	#endif
+
+	#if( tskKEEP_ALL_TASKS_LIST == 1 )
+	{
+		vListInitialiseItem( &( pxNewTCB->xAllTasksListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xAllTasksListItem ), pxNewTCB );
+	}
+	#endif
+
+	#if( configUSE_STACK_WATERMARK == 1 )
+	{
+		/* The whole stack is free until the idle task scans it. */
+		pxNewTCB->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+		pxNewTCB->uxStackMinimumFree = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+	}
+	#endif
+
+	#if( configUSE_BLOCKING_STATS == 1 )
+	{
+		pxNewTCB->ulBlockStart = 0UL;
+		pxNewTCB->ulLongestBlock = 0UL;
+		( void ) memset( ( void * ) pxNewTCB->ulBlockedTime, 0x00, sizeof( pxNewTCB->ulBlockedTime ) );
+		pxNewTCB->pvBlockObject = NULL;
+		pxNewTCB->pvLongestBlockObject = NULL;
+		pxNewTCB->ucBlockHint = ( uint8_t ) eBlockNone;
+		pxNewTCB->ucBlockReason = ( uint8_t ) eBlockNone;
+		pxNewTCB->ucLongestBlockReason = ( uint8_t ) eBlockNone;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -979,8 +1395,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1079,6 +1498,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			pxNewTCB->uxTCBNumber = uxTaskNumber;
 		}
 		#endif /* configUSE_TRACE_FACILITY */
+
+		#if( tskKEEP_ALL_TASKS_LIST == 1 )
+		{
+			vListInsertEnd( &xAllTasksList, &( pxNewTCB->xAllTasksListItem ) );
+		}
+		#endif /* tskKEEP_ALL_TASKS_LIST */
 		traceTASK_CREATE( pxNewTCB );
 
 		prvAddTaskToReadyList( pxNewTCB );
@@ -1139,6 +1564,28 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_TASK_BUDGETS == 1 )
+			{
+				/* Is the task waiting for its budget to be replenished? */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			#if( tskKEEP_ALL_TASKS_LIST == 1 )
+			{
+				/* Snapshots and stack scans in progress see uxTaskNumber
+				change below, so do not follow the item removed here. */
+				( void ) uxListRemove( &( pxTCB->xAllTasksListItem ) );
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1147,17 +1594,33 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			if( pxTCB == pxCurrentTCB )
 			{
-				/* A task is deleting itself.  This cannot complete within the
-				task itself, as a context switch to another task is required.
-				Place the task in the termination list.  The idle task will
-				check the termination list and free up any memory allocated by
-				the scheduler for the TCB and stack of the deleted task. */
-				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
-
-				/* Increment the ucTasksDeleted variable so the idle task knows
-				there is a task that has been deleted and that it should therefore
-				check the xTasksWaitingTermination list. */
-				++uxDeletedTasksWaitingCleanUp;
+				#if( configUSE_TASK_POOLS == 1 )
+				if( pxTCB->pxTaskPool != NULL )
+				{
+					/* A task from a pool is deleting itself.  It is still
+					running on its stack, so vTaskSwitchContext() returns it to
+					its pool once it has been switched out, without waiting for
+					the idle task.  The rest of its clean up does not touch the
+					stack, and cannot be done from vTaskSwitchContext(), so is
+					done now. */
+					prvCleanUpTCB( pxTCB );
+					pxPoolTaskToReturn = pxTCB;
+				}
+				else
+				#endif /* configUSE_TASK_POOLS */
+				{
+					/* A task is deleting itself.  This cannot complete within the
+					task itself, as a context switch to another task is required.
+					Place the task in the termination list.  The idle task will
+					check the termination list and free up any memory allocated by
+					the scheduler for the TCB and stack of the deleted task. */
+					vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+					/* Increment the ucTasksDeleted variable so the idle task knows
+					there is a task that has been deleted and that it should therefore
+					check the xTasksWaitingTermination list. */
+					++uxDeletedTasksWaitingCleanUp;
+				}
 
 				/* The pre-delete hook is primarily for the Windows simulator,
 				in which Windows specific clean up operations are performed,
@@ -1169,7 +1632,26 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			else
 			{
 				--uxCurrentNumberOfTasks;
-				prvDeleteTCB( pxTCB );
+
+				#if( configUSE_TASK_POOLS == 1 )
+				{
+					if( pxTCB->pxTaskPool != NULL )
+					{
+						/* Return the task to its pool, from which it can be
+						created again at once. */
+						prvCleanUpTCB( pxTCB );
+						vListInsertEnd( &( pxTCB->pxTaskPool->xFreeTasks ), &( pxTCB->xStateListItem ) );
+					}
+					else
+					{
+						prvDeleteTCB( pxTCB );
+					}
+				}
+				#else
+				{
+					prvDeleteTCB( pxTCB );
+				}
+				#endif /* configUSE_TASK_POOLS */
 
 				/* Reset the next expected unblock time in case it referred to
 				the task that has just been deleted. */
@@ -1203,11 +1685,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 	void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement )
 	{
-	TickType_t xTimeToWake;
+	TickType_t xTimeToWake, xIncrement = xTimeIncrement;
 	BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
+		#if( configUSE_EDF_SCHEDULING == 1 )
+		{
+			/* A task given a period by vTaskSetDeadline() can pass an increment
+			of 0 to wait for the release of its next job. */
+			if( xIncrement == ( TickType_t ) 0 )
+			{
+				xIncrement = pxCurrentTCB->xPeriod;
+			}
+		}
+		#endif /* configUSE_EDF_SCHEDULING */
+
 		configASSERT( pxPreviousWakeTime );
-		configASSERT( ( xTimeIncrement > 0U ) );
+		configASSERT( ( xIncrement > 0U ) );
 		configASSERT( uxSchedulerSuspended == 0 );
 
 		vTaskSuspendAll();
@@ -1217,7 +1710,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			const TickType_t xConstTickCount = xTickCount;
 
 			/* Generate the tick time at which the task wants to wake. */
-			xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+			xTimeToWake = *pxPreviousWakeTime + xIncrement;
 
 			if( xConstTickCount < *pxPreviousWakeTime )
 			{
@@ -1253,9 +1746,52 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
+			#if( configUSE_EDF_SCHEDULING == 1 )
+			{
+				if( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0 )
+				{
+					/* The calling task has completed a job.  Count it, and
+					whether it completed after its deadline. */
+					( pxCurrentTCB->ulJobsCompleted )++;
+
+					if( taskTICK_IS_BEFORE( pxCurrentTCB->xAbsoluteDeadline, xConstTickCount ) )
+					{
+						( pxCurrentTCB->ulDeadlinesMissed )++;
+						traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The next job is released at the wake time. */
+					pxCurrentTCB->xAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xRelativeDeadline;
+
+					/* If the release time has already passed the task stays
+					ready, and has to move to the place of its new deadline.
+					The scheduler is suspended so the ready list can be
+					accessed. */
+					if( ( xShouldDelay == pdFALSE ) && ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) )
+					{
+						( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+						prvInsertInDeadlineOrder( pxCurrentTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_EDF_SCHEDULING */
+
 			if( xShouldDelay != pdFALSE )
 			{
 				traceTASK_DELAY_UNTIL( xTimeToWake );
+				taskRECORD_BLOCK_START( eBlockDelay );
 
 				/* prvAddCurrentTaskToDelayedList() needs the block time, not
 				the time to wake, so subtract the current tick count. */
@@ -1304,6 +1840,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 				This task cannot be in an event list as it is the currently
 				executing task. */
+				taskRECORD_BLOCK_START( eBlockDelay );
 				prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
 			}
 			xAlreadyYielded = xTaskResumeAll();
@@ -1338,6 +1875,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
+		#if( configUSE_TASK_POOLS == 1 )
+		if( pxTCB == pxPoolTaskToReturn )
+		{
+			/* A task from a pool that has deleted itself, but has not yet been
+			switched out and returned to its pool. */
+			eReturn = eDeleted;
+		}
+		else
+		#endif
 		if( pxTCB == pxCurrentTCB )
 		{
 			/* The task calling this function is querying its own state. */
@@ -1385,6 +1931,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			#endif
 
+			#if ( configUSE_TASK_POOLS == 1 )
+				else if( ( pxTCB->pxTaskPool != NULL ) && ( pxStateList == &( pxTCB->pxTaskPool->xFreeTasks ) ) )
+				{
+					/* The task has been deleted and returned to its pool. */
+					eReturn = eDeleted;
+				}
+			#endif
+
 			else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
 			{
 				/* If the task is not in any other state, it must be in the
@@ -1548,10 +2102,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				#if ( configUSE_MUTEXES == 1 )
 				{
 					/* Only change the priority being used if the task is not
-					currently using an inherited priority. */
-					if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+					currently using an inherited priority.  A task holding a
+					priority ceiling mutex does not drop below the ceiling. */
+					if( taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority ) == pxTCB->uxPriority )
 					{
-						pxTCB->uxPriority = uxNewPriority;
+						pxTCB->uxPriority = taskUNINHERITED_PRIORITY( pxTCB, uxNewPriority );
 					}
 					else
 					{
@@ -1660,15 +2215,23 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			/* A blocked task stops being blocked when it is suspended. */
+			taskRECORD_BLOCK_END( pxTCB );
+
 			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -1992,6 +2555,14 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* The timer the budgets are measured with must already be
+			running. */
+			ulBudgetChargedTime = configBUDGET_TIMER_VALUE();
+		}
+		#endif
+
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
 		if( xPortStartScheduler() != pdFALSE )
@@ -2560,7 +3131,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2697,6 +3268,22 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* Restore the tasks whose budget has been replenished, and stop the
+			running task if it has used up its budget.  Budgets are enforced
+			whether or not preemption is used. */
+			if( prvCheckBudgets() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
@@ -2704,7 +3291,56 @@ BaseType_t xSwitchRequired = pdFALSE;
 		{
 			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
 			{
-				xSwitchRequired = pdTRUE;
+				#if( configUSE_EDF_SCHEDULING == 1 )
+				{
+				ListItem_t *pxNextItem;
+
+					if( pxCurrentTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY )
+					{
+						if( taskTIME_SLICE_EXPIRED() != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						/* A task in the deadline ordered list only shares the
+						processor with the tasks after it that do not go after
+						it - those with the same deadline or, like it, without
+						one.  It is moved behind them, so the next of them is
+						selected. */
+						pxNextItem = listGET_NEXT( &( pxCurrentTCB->xStateListItem ) );
+
+						if( ( pxNextItem != listGET_END_MARKER( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ) ) &&
+							( taskDEADLINE_PRECEDES( pxCurrentTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxNextItem ) ) == pdFALSE ) &&
+							( taskTIME_SLICE_EXPIRED() != pdFALSE ) )
+						{
+							( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+							prvInsertInDeadlineOrder( pxCurrentTCB );
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+				#else
+				{
+					if( taskTIME_SLICE_EXPIRED() != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
 			}
 			else
 			{
@@ -2850,6 +3486,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+	TCB_t *pxPreviousTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2888,14 +3528,74 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
+		#if( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* Charge the task being switched out for the time it has run. */
+			prvChargeBudget();
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
+		#if( configUSE_TASK_POOLS == 1 )
+		{
+			/* The context of a task from a pool that deleted itself has been
+			saved, so its stack is no longer in use. */
+			if( pxPoolTaskToReturn != NULL )
+			{
+				vListInsertEnd( &( pxPoolTaskToReturn->pxTaskPool->xFreeTasks ), &( pxPoolTaskToReturn->xStateListItem ) );
+				pxPoolTaskToReturn = NULL;
+				--uxCurrentNumberOfTasks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_POOLS */
+
+		#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+		{
+			pxPreviousTCB = pxCurrentTCB;
+		}
+		#endif
+
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
 		taskSELECT_HIGHEST_PRIORITY_TASK();
 		traceTASK_SWITCHED_IN();
 
+		#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+		{
+			/* A task that was preempted by a task of higher priority keeps
+			the rest of its time slice.  One that blocked, yielded or had its
+			priority lowered gives it up. */
+			if( ( pxCurrentTCB != pxPreviousTCB ) &&
+				( ( pxCurrentTCB->uxPriority <= pxPreviousTCB->uxPriority ) ||
+				  ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) == pdFALSE ) ) )
+			{
+				pxPreviousTCB->uxTimeSliceTicksLeft = ( UBaseType_t ) 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A task switched in after its last time slice ran out, or was
+			given up, starts a full one.  A task that was preempted part way
+			through its slice carries on with what is left of it. */
+			if( pxCurrentTCB->uxTimeSliceTicksLeft == ( UBaseType_t ) 0U )
+			{
+				pxCurrentTCB->uxTimeSliceTicksLeft = pxCurrentTCB->uxTimeSliceQuantum;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIME_SLICE_QUANTUM */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2920,10 +3620,51 @@ void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksT
 	list is locked, preventing simultaneous access from interrupts. */
 	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
+	taskRECORD_BLOCK_START( eBlockOther );
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTaskBlockOnEventList( List_t * const pxEventList, TickType_t * const pxTicksToWait, TimeOut_t * const pxTimeOut, BaseType_t * const pxEntryTimeSet, const eBlockReason eReason, const void * const pvObject )
+{
+BaseType_t xReturn;
+
+	/* Only used when configUSE_BLOCKING_STATS is 1. */
+	( void ) eReason;
+	( void ) pvObject;
+
+	if( *pxEntryTimeSet == pdFALSE )
+	{
+		/* First time round, so the block time starts now. */
+		vTaskInternalSetTimeOutState( pxTimeOut );
+		*pxEntryTimeSet = pdTRUE;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		/* xTaskCheckForTimeOut() returns pdFALSE, and updates the remaining
+		block time, if the block time has not expired. */
+		xReturn = ( xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait ) == pdFALSE ) ? pdTRUE : pdFALSE;
+	}
+
+	if( xReturn != pdFALSE )
+	{
+		/* Interrupts are masked, so neither the tick nor the FromISR
+		functions can access the list.  The yield is performed once the
+		critical section is exited. */
+		taskSET_BLOCK_REASON( eReason, pvObject );
+		vTaskPlaceOnEventList( pxEventList, *pxTicksToWait );
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait )
 {
 	configASSERT( pxEventList );
@@ -2944,6 +3685,7 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 	the task level). */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
+	taskRECORD_BLOCK_START( eBlockEventGroup );
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
 /*-----------------------------------------------------------*/
@@ -2975,6 +3717,7 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 		}
 
 		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+		taskRECORD_BLOCK_START( eBlockOther );
 		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
 	}
 
@@ -3015,7 +3758,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3072,7 +3815,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3083,6 +3826,110 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_LEAN_MUTEXES == 1 )
+
+	void vTaskPlaceOnTaggedEventList( List_t * const pxEventList, const void * const pvTag, const TickType_t xTicksToWait )
+	{
+		configASSERT( pxEventList );
+
+		/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  The event
+		list can be shared by several objects, so the task is tagged with the
+		object it is waiting for. */
+		configASSERT( uxSchedulerSuspended != 0 );
+
+		pxCurrentTCB->pvEventListTag = pvTag;
+		vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+	}
+
+#endif /* configUSE_LEAN_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_LEAN_MUTEXES == 1 )
+
+	TaskHandle_t xTaskRemoveFromTaggedEventList( const List_t * const pxEventList, const void * const pvTag, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	ListItem_t const *pxListEnd = listGET_END_MARKER( pxEventList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	ListItem_t *pxListItem;
+	TCB_t *pxUnblockedTCB = NULL;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  The event list
+		is in priority order, so the first task tagged with pvTag is the highest
+		priority task waiting for that object. */
+		for( pxListItem = listGET_HEAD_ENTRY( pxEventList ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+		{
+			if( ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) )->pvEventListTag == pvTag )
+			{
+				pxUnblockedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+				break;
+			}
+		}
+
+		if( pxUnblockedTCB != NULL )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+
+			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			{
+				( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxUnblockedTCB );
+			}
+			else
+			{
+				vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+			}
+
+			if( taskPREEMPTS_CURRENT( pxUnblockedTCB ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+				xYieldPending = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxUnblockedTCB;
+	}
+
+#endif /* configUSE_LEAN_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_LEAN_MUTEXES == 1 )
+
+	UBaseType_t uxTaskGetTaggedEventListPriority( const List_t * const pxEventList, const void * const pvTag )
+	{
+	ListItem_t const *pxListEnd = listGET_END_MARKER( pxEventList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	ListItem_t *pxListItem;
+	UBaseType_t uxPriority = tskIDLE_PRIORITY;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, OR WITH THE
+		SCHEDULER SUSPENDED. */
+		for( pxListItem = listGET_HEAD_ENTRY( pxEventList ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+		{
+			if( ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) )->pvEventListTag == pvTag )
+			{
+				uxPriority = ( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxListItem ) )->uxPriority;
+				break;
+			}
+		}
+
+		return uxPriority;
+	}
+
+#endif /* configUSE_LEAN_MUTEXES */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3272,6 +4119,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
 
+		#if( configUSE_STACK_WATERMARK == 1 )
+		{
+			/* Scan one task's stack each time round, so the idle task is not
+			kept from the hook below, or from sleeping, for long. */
+			prvScanNextStack();
+		}
+		#endif /* configUSE_STACK_WATERMARK */
+
 		#if ( configUSE_IDLE_HOOK == 1 )
 		{
 			extern void vApplicationIdleHook( void );
@@ -3458,6 +4313,18 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if( configUSE_TASK_BUDGETS == 1 )
+	{
+		vListInitialise( &xBudgetThrottledList );
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
+	#if( tskKEEP_ALL_TASKS_LIST == 1 )
+	{
+		vListInitialise( &xAllTasksList );
+	}
+	#endif /* tskKEEP_ALL_TASKS_LIST */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3529,6 +4396,12 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
+		#if( configUSE_BLOCKING_STATS == 1 )
+		{
+			vTaskGetBlockingStats( ( TaskHandle_t ) pxTCB, &( pxTaskStatus->xBlockingStats ) );
+		}
+		#endif
+
 		/* Obtaining the task state is a little fiddly, so is only done if the
 		value of eState passed into this function is eInvalid - otherwise the
 		state is just set to whatever is passed in. */
@@ -3623,7 +4496,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) )
 
 	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
 	{
@@ -3640,7 +4513,7 @@ static void prvCheckTasksWaitingTermination( void )
 		return ( uint16_t ) ulCount;
 	}
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
@@ -3673,21 +4546,35 @@ static void prvCheckTasksWaitingTermination( void )
 
 #if ( INCLUDE_vTaskDelete == 1 )
 
-	static void prvDeleteTCB( TCB_t *pxTCB )
+	static void prvCleanUpTCB( TCB_t *pxTCB )
 	{
 		/* This call is required specifically for the TriCore port.  It must be
 		above the vPortFree() calls.  The call is also used by ports/demos that
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up
-		to the task to free any memory allocated at the application level. */
+		#if ( configUSE_HEAP_STATS == 1 )
+		{
+			/* Detach the task's heap accounting before its handle can be
+			reused by a new task. */
+			vPortHeapStatsTaskDeleted( ( void * ) pxTCB );
+		}
+		#endif /* configUSE_HEAP_STATS */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDeleteTCB( TCB_t *pxTCB )
+	{
+		prvCleanUpTCB( pxTCB );
 
+		/* Free up the memory allocated by the scheduler for the task.  It is up
+		to the task to free any memory allocated at the application level. */
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
 		{
 			/* The task can only have been allocated dynamically - free both
@@ -3751,7 +4638,7 @@ TCB_t *pxTCB;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configUSE_HEAP_STATS == 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
 	{
@@ -3765,10 +4652,10 @@ TCB_t *pxTCB;
 		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configUSE_HEAP_STATS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) || ( configUSE_HEAP_STATS == 1 ) )
 
 	BaseType_t xTaskGetSchedulerState( void )
 	{
@@ -3793,7 +4680,7 @@ TCB_t *pxTCB;
 		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) || ( configUSE_HEAP_STATS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_MUTEXES == 1 )
@@ -3855,7 +4742,7 @@ TCB_t *pxTCB;
 			}
 			else
 			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				if( taskUNINHERITED_PRIORITY( pxMutexHolderTCB, pxMutexHolderTCB->uxBasePriority ) < pxCurrentTCB->uxPriority )
 				{
 					/* The base priority of the mutex holder is lower than the
 					priority of the task attempting to take the mutex, but the
@@ -3902,7 +4789,7 @@ TCB_t *pxTCB;
 
 			/* Has the holder of the mutex inherited the priority of another
 			task? */
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			if( pxTCB->uxPriority != taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority ) )
 			{
 				/* Only disinherit if no other mutexes are held. */
 				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
@@ -3924,7 +4811,7 @@ TCB_t *pxTCB;
 					/* Disinherit the priority before adding the task into the
 					new	ready list. */
 					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					pxTCB->uxPriority = pxTCB->uxBasePriority;
+					pxTCB->uxPriority = taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority );
 
 					/* Reset the event list item value.  It cannot be in use for
 					any other purpose if this task is running, and it must be
@@ -3981,13 +4868,13 @@ TCB_t *pxTCB;
 			holds the mutex should be set.  This will be the greater of the
 			holding task's base priority and the priority of the highest
 			priority task that is waiting to obtain the mutex. */
-			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+			if( taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority ) < uxHighestPriorityWaitingTask )
 			{
 				uxPriorityToUse = uxHighestPriorityWaitingTask;
 			}
 			else
 			{
-				uxPriorityToUse = pxTCB->uxBasePriority;
+				uxPriorityToUse = taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority );
 			}
 
 			/* Does the priority need to change? */
@@ -4410,30 +5297,44 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TASK_NOTIFICATIONS == 1 )
+#if( configUSE_CEILING_MUTEXES == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	UBaseType_t uxTaskRaiseCeilingPriority( UBaseType_t uxCeiling )
 	{
-	uint32_t ulReturn;
+	UBaseType_t uxPreviousCeiling;
+
+		configASSERT( uxCeiling < ( UBaseType_t ) configMAX_PRIORITIES );
 
 		taskENTER_CRITICAL();
 		{
-			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			/* The ceiling of a mutex must be at least the priority of every
+			task that takes it. */
+			configASSERT( pxCurrentTCB->uxBasePriority <= uxCeiling );
+
+			uxPreviousCeiling = pxCurrentTCB->uxCeilingPriority;
+
+			if( uxCeiling > uxPreviousCeiling )
 			{
-				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->uxCeilingPriority = uxCeiling;
 
-				if( xTicksToWait > ( TickType_t ) 0 )
+				/* The running task is in the ready list of its priority.  It
+				is already the highest priority task able to run, so moving it
+				up does not require a yield. */
+				if( pxCurrentTCB->uxPriority < uxCeiling )
 				{
-					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_TAKE_BLOCK();
+					if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 
-					/* All ports are written to allow a yield in a critical
-					section (some will yield immediately, others wait until the
-					critical section exits) - but it is not something that
-					application code should ever do. */
-					portYIELD_WITHIN_API();
+					traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeiling );
+					pxCurrentTCB->uxPriority = uxCeiling;
+					listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeiling ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					prvAddTaskToReadyList( pxCurrentTCB );
 				}
 				else
 				{
@@ -4447,60 +5348,85 @@ TickType_t uxReturn;
 		}
 		taskEXIT_CRITICAL();
 
+		return uxPreviousCeiling;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CEILING_MUTEXES == 1 )
+
+	BaseType_t xTaskRestoreCeilingPriority( UBaseType_t uxPreviousCeiling )
+	{
+	UBaseType_t uxOldPriority, uxNewPriority;
+	BaseType_t xYieldRequired = pdFALSE;
+
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			/* Ceilings are restored in the reverse of the order in which they
+			were raised. */
+			configASSERT( uxPreviousCeiling <= pxCurrentTCB->uxCeilingPriority );
 
-			if( ulReturn != 0UL )
+			uxOldPriority = taskUNINHERITED_PRIORITY( pxCurrentTCB, pxCurrentTCB->uxBasePriority );
+			pxCurrentTCB->uxCeilingPriority = uxPreviousCeiling;
+			uxNewPriority = taskUNINHERITED_PRIORITY( pxCurrentTCB, pxCurrentTCB->uxBasePriority );
+
+			/* If the task has inherited a priority above the ceiling it keeps
+			it until the mutex that caused the inheritance is given. */
+			if( ( pxCurrentTCB->uxPriority == uxOldPriority ) && ( uxNewPriority != uxOldPriority ) )
 			{
-				if( xClearCountOnExit != pdFALSE )
+				if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					mtCOVERAGE_TEST_MARKER();
 				}
+
+				traceTASK_PRIORITY_DISINHERIT( pxCurrentTCB, uxNewPriority );
+				pxCurrentTCB->uxPriority = uxNewPriority;
+				listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				prvAddTaskToReadyList( pxCurrentTCB );
+
+				/* A task that was kept out by the ceiling may now be able to
+				run. */
+				xYieldRequired = pdTRUE;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
-		return ulReturn;
+		return xYieldRequired;
 	}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_CEILING_MUTEXES */
 /*-----------------------------------------------------------*/
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
-	BaseType_t xReturn;
+	uint32_t ulReturn;
+
+		configASSERT( uxIndexToWaitOn < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		taskENTER_CRITICAL();
 		{
-			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
 			{
-				/* Clear bits in the task's notification value as bits may get
-				set	by the notifying task or interrupt.  This can be used to
-				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
-
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
+					taskRECORD_BLOCK_START( eBlockNotification );
 					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_WAIT_BLOCK();
+					traceTASK_NOTIFY_TAKE_BLOCK();
 
 					/* All ports are written to allow a yield in a critical
 					section (some will yield immediately, others wait until the
@@ -4522,33 +5448,115 @@ TickType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_WAIT();
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 
-			if( pulNotificationValue != NULL )
-			{
-				/* Output the current notification value, which may or may not
-				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
-			}
+			/* A reason given for a block that did not happen is not kept. */
+			taskCLEAR_BLOCK_HINT();
 
-			/* If ucNotifyValue is set then either the task never entered the
-			blocked state (because a notification was already pending) or the
-			task unblocked because of a notification.  Otherwise the task
-			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( ulReturn != 0UL )
 			{
-				/* A notification was not received. */
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
+				}
+				else
+				{
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn;
+
+		configASSERT( uxIndexToWaitOn < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set	by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
+
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
+
+				if( xTicksToWait > ( TickType_t ) 0 )
+				{
+					taskRECORD_BLOCK_START( eBlockNotification );
+					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+					traceTASK_NOTIFY_WAIT_BLOCK();
+
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_WAIT();
+
+			/* A reason given for a block that did not happen is not kept. */
+			taskCLEAR_BLOCK_HINT();
+
+			if( pulNotificationValue != NULL )
+			{
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
+			}
+
+			/* If ucNotifyValue is set then either the task never entered the
+			blocked state (because a notification was already pending) or the
+			task unblocked because of a notification.  Otherwise the task
+			unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+			{
+				/* A notification was not received. */
 				xReturn = pdFALSE;
 			}
 			else
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4560,44 +5568,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4640,7 +5649,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4666,7 +5675,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4674,6 +5683,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4699,30 +5709,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4758,7 +5768,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4790,13 +5800,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4820,12 +5831,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4848,7 +5859,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4879,20 +5890,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4908,6 +5921,1108 @@ TickType_t uxReturn;
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+
+		/* Deadlines are compared by the sign of their difference, so must be
+		less than half the tick range apart. */
+		configASSERT( xRelativeDeadline <= ( portMAX_DELAY >> 2 ) );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The job the task is running, or will run next, is taken to have
+			been released now. */
+			pxTCB->xRelativeDeadline = xRelativeDeadline;
+			pxTCB->xPeriod = xPeriod;
+			pxTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+			pxTCB->ulJobsCompleted = 0UL;
+			pxTCB->ulDeadlinesMissed = 0UL;
+
+			/* A ready task of priority configEDF_PRIORITY has to move to its
+			new place in the deadline ordered list, which can change the task
+			that should be running. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvInsertInDeadlineOrder( pxTCB );
+
+				if( xSchedulerRunning != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskGetDeadlineStats( TaskHandle_t xTask, uint32_t *pulJobsCompleted, uint32_t *pulDeadlinesMissed )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( pulJobsCompleted != NULL )
+			{
+				*pulJobsCompleted = pxTCB->ulJobsCompleted;
+			}
+
+			if( pulDeadlinesMissed != NULL )
+			{
+				*pulDeadlinesMissed = pxTCB->ulDeadlinesMissed;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertInDeadlineOrder( TCB_t *pxTCB )
+	{
+	List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+	ListItem_t *pxIterator;
+
+		/* Find the first task pxTCB goes before.  The list is short, as it
+		only holds the ready tasks of one priority. */
+		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			if( taskDEADLINE_PRECEDES( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxNext ) ) )
+			{
+				break;
+			}
+		}
+
+		/* Insert it after pxIterator, as vListInsert() does. */
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pvContainer = ( void * ) pxList;
+
+		( pxList->uxNumberOfItems )++;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		/* Replenishment times are compared by the sign of their difference, so
+		periods must be less than half the tick range. */
+		configASSERT( ( ulBudget == 0UL ) || ( ( xPeriod > ( TickType_t ) 0 ) && ( xPeriod <= ( portMAX_DELAY >> 2 ) ) ) );
+
+		#if( INCLUDE_vTaskSuspend != 1 )
+		{
+			configASSERT( eAction != eBudgetSuspend );
+		}
+		#endif
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Holding back the idle task would leave nothing to run. */
+			configASSERT( pxTCB != xIdleTaskHandle );
+
+			/* Charge the running task up to now, so time it ran for before
+			the call is not counted against a new budget. */
+			prvChargeBudget();
+
+			/* A task held by its old budget is released. */
+			if( pxTCB->ucBudgetThrottled != pdFALSE )
+			{
+				xYieldRequired = prvReplenishBudget( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->ulBudget = ulBudget;
+			pxTCB->ulBudgetUsed = 0UL;
+			pxTCB->ulBudgetExhaustions = 0UL;
+			pxTCB->xBudgetPeriod = xPeriod;
+			pxTCB->xBudgetReplenishTime = xTickCount + xPeriod;
+			pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+
+			if( ( xYieldRequired != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskGetBudgetStats( TaskHandle_t xTask, TaskBudgetStats_t *pxStats )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Bring the time of a task querying itself up to date. */
+			prvChargeBudget();
+
+			pxStats->ulBudget = pxTCB->ulBudget;
+			pxStats->ulUsed = pxTCB->ulBudgetUsed;
+			pxStats->ulExhaustions = pxTCB->ulBudgetExhaustions;
+			pxStats->xThrottled = ( BaseType_t ) pxTCB->ucBudgetThrottled;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvChargeBudget( void )
+	{
+	const uint32_t ulNow = configBUDGET_TIMER_VALUE();
+
+		if( pxCurrentTCB->ulBudget != 0UL )
+		{
+			/* The time since the task was last charged is charged to the
+			period it was used in.  The running task is charged at each tick,
+			after the tick count has moved on, so if its period has now ended
+			that time was used before the end, and the new period starts with
+			nothing used.  The budget of a task that is held until it is
+			replenished is replenished by the tick, so only a task running
+			normally can start a new period here. */
+			pxCurrentTCB->ulBudgetUsed += ( ulNow - ulBudgetChargedTime ) & configBUDGET_TIMER_MASK;
+
+			if( ( pxCurrentTCB->ucBudgetThrottled == pdFALSE ) && ( taskTICK_IS_BEFORE( xTickCount, pxCurrentTCB->xBudgetReplenishTime ) == pdFALSE ) )
+			{
+				prvStartBudgetPeriod( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		ulBudgetChargedTime = ulNow;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvCheckBudgets( void )
+	{
+	BaseType_t xSwitchRequired = pdFALSE;
+	BaseType_t xCanStop;
+	ListItem_t const *pxEndMarker = listGET_END_MARKER( &xBudgetThrottledList );
+	ListItem_t *pxIterator, *pxNext;
+	TCB_t *pxTCB;
+
+		/* Only tasks that have used up their budget are in the list, so it is
+		short, and is not kept in order as the times in it can overflow. */
+		for( pxIterator = listGET_HEAD_ENTRY( &xBudgetThrottledList ); pxIterator != pxEndMarker; pxIterator = pxNext )
+		{
+			pxNext = listGET_NEXT( pxIterator );
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			if( taskTICK_IS_BEFORE( xTickCount, pxTCB->xBudgetReplenishTime ) == pdFALSE )
+			{
+				if( prvReplenishBudget( pxTCB ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		prvChargeBudget();
+		pxTCB = pxCurrentTCB;
+
+		/* The running task can have left the ready list, to block or be
+		suspended, before the context switch that follows has taken place.  It
+		is not stopped then. */
+		xCanStop = listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) );
+
+		#if( configUSE_MUTEXES == 1 )
+		{
+			/* Stopping a mutex holder would hold up the tasks waiting for the
+			mutex too, so it is stopped once it has given back the last. */
+			if( pxTCB->uxMutexesHeld != ( UBaseType_t ) 0 )
+			{
+				xCanStop = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		if( ( pxTCB->ulBudget != 0UL ) && ( pxTCB->ucBudgetThrottled == pdFALSE ) && ( pxTCB->ulBudgetUsed >= pxTCB->ulBudget ) && ( xCanStop != pdFALSE ) )
+		{
+			( pxTCB->ulBudgetExhaustions )++;
+			pxTCB->ucBudgetThrottled = pdTRUE;
+			vListInsertEnd( &xBudgetThrottledList, &( pxTCB->xBudgetListItem ) );
+			traceTASK_BUDGET_EXHAUSTED( pxTCB );
+
+			#if( INCLUDE_vTaskSuspend == 1 )
+			if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetSuspend )
+			{
+				if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+			}
+			else
+			#endif /* INCLUDE_vTaskSuspend */
+			{
+				pxTCB->uxBudgetPriority = pxTCB->uxPriority;
+				prvSetBudgetPriority( pxTCB, ( UBaseType_t ) configBUDGET_DEMOTED_PRIORITY );
+			}
+
+			#if( configUSE_BUDGET_EXHAUSTED_HOOK == 1 )
+			{
+				vApplicationBudgetExhaustedHook( ( TaskHandle_t ) pxTCB );
+			}
+			#endif
+
+			xSwitchRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvReplenishBudget( TCB_t *pxTCB )
+	{
+	BaseType_t xPreempts = pdFALSE;
+
+		( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+		pxTCB->ucBudgetThrottled = pdFALSE;
+		prvStartBudgetPeriod( pxTCB );
+
+		#if( INCLUDE_vTaskSuspend == 1 )
+		if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetSuspend )
+		{
+			/* vTaskResume() might already have released it. */
+			if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+				xPreempts = taskPREEMPTS_CURRENT( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		#endif /* INCLUDE_vTaskSuspend */
+		{
+			/* A demoted task running at an inherited or ceiling priority
+			keeps it, and drops to its restored priority when it gives back
+			the mutex. */
+			if( pxTCB->uxPriority == ( UBaseType_t ) configBUDGET_DEMOTED_PRIORITY )
+			{
+				#if( configUSE_MUTEXES == 1 )
+				{
+					/* vTaskPrioritySet() only changes the base priority of a
+					demoted task. */
+					pxTCB->uxBudgetPriority = taskUNINHERITED_PRIORITY( pxTCB, pxTCB->uxBasePriority );
+				}
+				#endif
+
+				prvSetBudgetPriority( pxTCB, pxTCB->uxBudgetPriority );
+
+				if( pxTCB != pxCurrentTCB )
+				{
+					xPreempts = taskPREEMPTS_CURRENT( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xPreempts;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvStartBudgetPeriod( TCB_t *pxTCB )
+	{
+		pxTCB->ulBudgetUsed = 0UL;
+		pxTCB->xBudgetReplenishTime += pxTCB->xBudgetPeriod;
+
+		/* A task that has not run for more than a period starts its next
+		period now. */
+		if( taskTICK_IS_BEFORE( xTickCount, pxTCB->xBudgetReplenishTime ) == pdFALSE )
+		{
+			pxTCB->xBudgetReplenishTime = xTickCount + pxTCB->xBudgetPeriod;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvSetBudgetPriority( TCB_t *pxTCB, UBaseType_t uxNewPriority )
+	{
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyList( pxTCB );
+		}
+		else
+		{
+			pxTCB->uxPriority = uxNewPriority;
+		}
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+
+	void vTaskSetTimeSliceQuantum( TaskHandle_t xTask, UBaseType_t uxQuantum )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( uxQuantum > ( UBaseType_t ) 0U );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxTimeSliceQuantum = uxQuantum;
+
+			/* Shorten the slice the task is part way through. */
+			if( pxTCB->uxTimeSliceTicksLeft > uxQuantum )
+			{
+				pxTCB->uxTimeSliceTicksLeft = uxQuantum;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIME_SLICE_QUANTUM */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+
+	UBaseType_t uxTaskGetTimeSliceQuantum( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxTimeSliceQuantum;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_TIME_SLICE_QUANTUM */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configUSE_TIME_SLICE_QUANTUM == 1 ) )
+
+	static BaseType_t prvTimeSliceExpired( void )
+	{
+	BaseType_t xReturn;
+
+		/* The count is left at 0 once the slice has run out, and reloaded
+		when the task is next switched in, which is after it has been rotated
+		to the end of its ready list.  It stays at 0 while the switch is held
+		off, as it is while the ticks pended during a scheduler suspension
+		are processed. */
+		if( pxCurrentTCB->uxTimeSliceTicksLeft > ( UBaseType_t ) 1U )
+		{
+			( pxCurrentTCB->uxTimeSliceTicksLeft )--;
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			pxCurrentTCB->uxTimeSliceTicksLeft = ( UBaseType_t ) 0U;
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TCB_t *prvSelectWithinQuantum( List_t * const pxList )
+	{
+	TCB_t *pxTCB = NULL;
+
+		/* The index is left on the task that last ran from the list.  If that
+		task was preempted by a task of higher priority, which is now being
+		switched out, it carries on with the rest of its slice.  A task
+		switching itself out by yielding, or whose slice has run out or was
+		given up, is passed over. */
+		if( pxList->pxIndex != ( ListItem_t * ) &( pxList->xListEnd ) ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxList->pxIndex );
+
+			if( ( pxTCB == pxCurrentTCB ) || ( pxTCB->uxTimeSliceTicksLeft == ( UBaseType_t ) 0U ) )
+			{
+				pxTCB = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxTCB == NULL )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxList );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxTCB;
+	}
+
+#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configUSE_TIME_SLICE_QUANTUM == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+
+	TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxTasks, const configSTACK_DEPTH_TYPE usStackDepth )
+	{
+	TaskPool_t *pxPool;
+	TCB_t *pxTCB;
+	UBaseType_t ux;
+
+		configASSERT( uxTasks > ( UBaseType_t ) 0U );
+
+		/* The pool is allocated once and never freed. */
+		pxPool = ( TaskPool_t * ) pvPortMalloc( sizeof( TaskPool_t ) );
+
+		if( pxPool != NULL )
+		{
+			vListInitialise( &( pxPool->xFreeTasks ) );
+			pxPool->usStackDepth = usStackDepth;
+			pxPool->uxMinimumEverFree = uxTasks;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( ux = ( UBaseType_t ) 0U; ( ux < uxTasks ) && ( pxPool != NULL ); ux++ )
+		{
+			/* Allocate the stack and TCB in the same order as xTaskCreate(),
+			so the stack does not grow into the TCB. */
+			#if( portSTACK_GROWTH > 0 )
+			{
+				pxTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+
+				if( pxTCB != NULL )
+				{
+					pxTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+					if( pxTCB->pxStack == NULL )
+					{
+						vPortFree( pxTCB );
+						pxTCB = NULL;
+					}
+				}
+			}
+			#else /* portSTACK_GROWTH */
+			{
+			StackType_t *pxStack;
+
+				pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				if( pxStack != NULL )
+				{
+					pxTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+
+					if( pxTCB != NULL )
+					{
+						pxTCB->pxStack = pxStack;
+					}
+					else
+					{
+						vPortFree( pxStack );
+					}
+				}
+				else
+				{
+					pxTCB = NULL;
+				}
+			}
+			#endif /* portSTACK_GROWTH */
+
+			if( pxTCB != NULL )
+			{
+				vListInitialiseItem( &( pxTCB->xStateListItem ) );
+				listSET_LIST_ITEM_OWNER( &( pxTCB->xStateListItem ), pxTCB );
+				vListInsertEnd( &( pxPool->xFreeTasks ), &( pxTCB->xStateListItem ) );
+			}
+			else
+			{
+				/* Out of heap.  Free the part of the pool already allocated. */
+				while( listLIST_IS_EMPTY( &( pxPool->xFreeTasks ) ) == pdFALSE )
+				{
+					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxPool->xFreeTasks ) );
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					vPortFree( pxTCB->pxStack );
+					vPortFree( pxTCB );
+				}
+
+				vPortFree( pxPool );
+				pxPool = NULL;
+			}
+		}
+
+		return ( TaskPoolHandle_t ) pxPool;
+	}
+
+#endif /* configUSE_TASK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+
+	BaseType_t xTaskCreateFromPool(	TaskPoolHandle_t xPool,
+									TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask )
+	{
+	TaskPool_t * const pxPool = ( TaskPool_t * ) xPool;
+	TCB_t *pxNewTCB;
+	UBaseType_t uxFree;
+	BaseType_t xReturn;
+
+		configASSERT( pxPool );
+
+		taskENTER_CRITICAL();
+		{
+			if( listLIST_IS_EMPTY( &( pxPool->xFreeTasks ) ) == pdFALSE )
+			{
+				pxNewTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxPool->xFreeTasks ) );
+				uxFree = uxListRemove( &( pxNewTCB->xStateListItem ) );
+
+				if( uxFree < pxPool->uxMinimumEverFree )
+				{
+					pxPool->uxMinimumEverFree = uxFree;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxNewTCB = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxNewTCB != NULL )
+		{
+			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) pxPool->usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			pxNewTCB->pxTaskPool = pxPool;
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+
+	UBaseType_t uxTaskPoolGetFree( TaskPoolHandle_t xPool )
+	{
+	TaskPool_t * const pxPool = ( TaskPool_t * ) xPool;
+
+		configASSERT( pxPool );
+
+		return listCURRENT_LIST_LENGTH( &( pxPool->xFreeTasks ) );
+	}
+
+#endif /* configUSE_TASK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+
+	UBaseType_t uxTaskPoolGetMinimumEverFree( TaskPoolHandle_t xPool )
+	{
+	TaskPool_t * const pxPool = ( TaskPool_t * ) xPool;
+
+		configASSERT( pxPool );
+
+		return pxPool->uxMinimumEverFree;
+	}
+
+#endif /* configUSE_TASK_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_SNAPSHOT == 1 )
+
+	void vTaskSnapshotStart( TaskSnapshot_t *pxSnapshot )
+	{
+		configASSERT( pxSnapshot );
+
+		taskENTER_CRITICAL();
+		{
+			pxSnapshot->pxNextTask = listGET_HEAD_ENTRY( &xAllTasksList );
+			pxSnapshot->uxGeneration = uxTaskNumber;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_SNAPSHOT == 1 )
+
+	eSnapshotResult eTaskSnapshotNext( TaskSnapshot_t *pxSnapshot, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace )
+	{
+	TCB_t *pxTCB = NULL;
+	const uint8_t *pucStackByte = NULL;
+	eSnapshotResult eReturn;
+
+		configASSERT( pxSnapshot );
+		configASSERT( pxTaskStatus );
+
+		taskENTER_CRITICAL();
+		{
+			/* uxTaskNumber is incremented each time a task is created or
+			deleted, so if it is unchanged pxNextTask is still in the list. */
+			if( pxSnapshot->uxGeneration != uxTaskNumber )
+			{
+				eReturn = eSnapshotChanged;
+			}
+			else if( pxSnapshot->pxNextTask == listGET_END_MARKER( &xAllTasksList ) )
+			{
+				eReturn = eSnapshotComplete;
+			}
+			else
+			{
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxSnapshot->pxNextTask );
+				pxSnapshot->pxNextTask = listGET_NEXT( pxSnapshot->pxNextTask );
+
+				/* Passing eInvalid obtains the state without suspending the
+				scheduler. */
+				vTaskGetInfo( ( TaskHandle_t ) pxTCB, pxTaskStatus, pdFALSE, eInvalid );
+
+				#if ( portSTACK_GROWTH > 0 )
+				{
+					pucStackByte = ( const uint8_t * ) pxTCB->pxEndOfStack;
+				}
+				#else
+				{
+					pucStackByte = ( const uint8_t * ) pxTCB->pxStack;
+				}
+				#endif
+
+				eReturn = eSnapshotTask;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* The stack is examined with interrupts enabled, as it takes time. */
+		if( ( eReturn == eSnapshotTask ) && ( xGetFreeStackSpace != pdFALSE ) )
+		{
+			pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( pucStackByte );
+
+			/* The stack may have been freed if the task was deleted while it
+			was examined. */
+			if( pxSnapshot->uxGeneration != uxTaskNumber )
+			{
+				eReturn = eSnapshotChanged;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_SNAPSHOT == 1 )
+
+	size_t xTaskSnapshotEncode( const TaskSnapshot_t *pxSnapshot, const TaskStatus_t *pxTaskStatus, uint8_t *pucRecord )
+	{
+		configASSERT( pxSnapshot );
+		configASSERT( pxTaskStatus );
+		configASSERT( pucRecord );
+
+		pucRecord[ 0 ] = ( uint8_t ) pxTaskStatus->xTaskNumber;
+		pucRecord[ 1 ] = ( uint8_t ) ( pxTaskStatus->xTaskNumber >> 8 );
+		pucRecord[ 2 ] = ( uint8_t ) pxTaskStatus->eCurrentState;
+		pucRecord[ 3 ] = ( uint8_t ) pxTaskStatus->uxCurrentPriority;
+		pucRecord[ 4 ] = ( uint8_t ) pxTaskStatus->uxBasePriority;
+		pucRecord[ 5 ] = ( uint8_t ) pxSnapshot->uxGeneration;
+		pucRecord[ 6 ] = ( uint8_t ) pxTaskStatus->usStackHighWaterMark;
+		pucRecord[ 7 ] = ( uint8_t ) ( pxTaskStatus->usStackHighWaterMark >> 8 );
+		pucRecord[ 8 ] = ( uint8_t ) pxTaskStatus->ulRunTimeCounter;
+		pucRecord[ 9 ] = ( uint8_t ) ( pxTaskStatus->ulRunTimeCounter >> 8 );
+		pucRecord[ 10 ] = ( uint8_t ) ( pxTaskStatus->ulRunTimeCounter >> 16 );
+		pucRecord[ 11 ] = ( uint8_t ) ( pxTaskStatus->ulRunTimeCounter >> 24 );
+
+		return tskSNAPSHOT_RECORD_LENGTH;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOT */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STACK_WATERMARK == 1 )
+
+	static void prvScanNextStack( void )
+	{
+	TCB_t *pxTCB;
+	const uint8_t *pucStackByte;
+	configSTACK_DEPTH_TYPE uxFree;
+
+		taskENTER_CRITICAL();
+		{
+			/* Start again from the first task once every task has been
+			scanned, or if a task has been created or deleted since the last
+			was scanned, as pxNextStackToScan might then have been removed. */
+			if( ( pxNextStackToScan == NULL ) ||
+				( pxNextStackToScan == listGET_END_MARKER( &xAllTasksList ) ) ||
+				( uxStackScanGeneration != uxTaskNumber ) )
+			{
+				pxNextStackToScan = listGET_HEAD_ENTRY( &xAllTasksList );
+				uxStackScanGeneration = uxTaskNumber;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The idle task is in the list, so it is never empty. */
+			pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxNextStackToScan );
+			pxNextStackToScan = listGET_NEXT( pxNextStackToScan );
+
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				pucStackByte = ( const uint8_t * ) pxTCB->pxEndOfStack;
+			}
+			#else
+			{
+				pucStackByte = ( const uint8_t * ) pxTCB->pxStack;
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+
+		/* The stack is scanned with interrupts enabled, as it takes time. */
+		uxFree = ( configSTACK_DEPTH_TYPE ) prvTaskCheckFreeStackSpace( pucStackByte );
+
+		/* No other task can run, so none can delete pxTCB, while the
+		scheduler is suspended. */
+		vTaskSuspendAll();
+		{
+			/* Discard the result if the task might have been deleted while its
+			stack was scanned. */
+			if( ( uxStackScanGeneration == uxTaskNumber ) && ( uxFree < pxTCB->uxStackMinimumFree ) )
+			{
+				#if( configUSE_STACK_MARGIN_HOOK == 1 )
+				{
+					/* The free space only ever falls, so the hook is called
+					once for each task that comes within the margin. */
+					if( ( pxTCB->uxStackMinimumFree >= ( configSTACK_DEPTH_TYPE ) configSTACK_WATERMARK_MARGIN ) &&
+						( uxFree < ( configSTACK_DEPTH_TYPE ) configSTACK_WATERMARK_MARGIN ) )
+					{
+						vApplicationStackMarginHook( ( TaskHandle_t ) pxTCB, pxTCB->pcTaskName, uxFree );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_STACK_MARGIN_HOOK */
+
+				pxTCB->uxStackMinimumFree = uxFree;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_STACK_WATERMARK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STACK_WATERMARK == 1 )
+
+	UBaseType_t uxTaskGetStackReport( TaskStackReport_t * const pxReportArray, const UBaseType_t uxArraySize )
+	{
+	const ListItem_t *pxItem;
+	TCB_t *pxTCB;
+	UBaseType_t uxTask = 0;
+
+		configASSERT( pxReportArray );
+
+		/* Only the values the idle task has already found are copied, so the
+		scheduler is not suspended for long. */
+		vTaskSuspendAll();
+		{
+			for( pxItem = listGET_HEAD_ENTRY( &xAllTasksList );
+				 ( pxItem != listGET_END_MARKER( &xAllTasksList ) ) && ( uxTask < uxArraySize );
+				 pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+				pxReportArray[ uxTask ].xHandle = ( TaskHandle_t ) pxTCB;
+				pxReportArray[ uxTask ].pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+				pxReportArray[ uxTask ].uxStackDepth = pxTCB->uxStackDepth;
+				pxReportArray[ uxTask ].uxMinimumEverFree = pxTCB->uxStackMinimumFree;
+				pxReportArray[ uxTask ].uxRecommendedDepth = ( configSTACK_DEPTH_TYPE ) ( ( pxTCB->uxStackDepth - pxTCB->uxStackMinimumFree ) + configSTACK_WATERMARK_MARGIN );
+				uxTask++;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif /* configUSE_STACK_WATERMARK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_BLOCKING_STATS == 1 )
+
+	void vTaskSetBlockReason( eBlockReason eReason, const void *pvObject )
+	{
+		configASSERT( ( eReason > eBlockNone ) && ( eReason < eBlockReasonCount ) );
+
+		/* Only the running task reads its hint, when it next blocks. */
+		pxCurrentTCB->ucBlockHint = ( uint8_t ) eReason;
+		pxCurrentTCB->pvBlockObject = pvObject;
+	}
+
+#endif /* configUSE_BLOCKING_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_BLOCKING_STATS == 1 )
+
+	static void prvRecordBlockStart( eBlockReason eDefaultReason )
+	{
+		if( pxCurrentTCB->ucBlockHint != ( uint8_t ) eBlockNone )
+		{
+			/* The object the task blocks on was set with the hint. */
+			pxCurrentTCB->ucBlockReason = pxCurrentTCB->ucBlockHint;
+			pxCurrentTCB->ucBlockHint = ( uint8_t ) eBlockNone;
+		}
+		else
+		{
+			pxCurrentTCB->ucBlockReason = ( uint8_t ) eDefaultReason;
+			pxCurrentTCB->pvBlockObject = NULL;
+		}
+
+		taskBLOCK_TIME_NOW( pxCurrentTCB->ulBlockStart );
+	}
+
+#endif /* configUSE_BLOCKING_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_BLOCKING_STATS == 1 )
+
+	static void prvRecordBlockEnd( TCB_t *pxTCB )
+	{
+	uint32_t ulNow, ulBlocked;
+
+		/* Called from a critical section, with the scheduler suspended, or
+		from the tick interrupt. */
+		if( pxTCB->ucBlockReason != ( uint8_t ) eBlockNone )
+		{
+			taskBLOCK_TIME_NOW( ulNow );
+			ulBlocked = taskBLOCK_TIME_SINCE( pxTCB->ulBlockStart, ulNow );
+
+			pxTCB->ulBlockedTime[ pxTCB->ucBlockReason ] += ulBlocked;
+
+			if( ulBlocked >= pxTCB->ulLongestBlock )
+			{
+				pxTCB->ulLongestBlock = ulBlocked;
+				pxTCB->ucLongestBlockReason = pxTCB->ucBlockReason;
+				pxTCB->pvLongestBlockObject = pxTCB->pvBlockObject;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->ucBlockReason = ( uint8_t ) eBlockNone;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_BLOCKING_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_BLOCKING_STATS == 1 )
+
+	void vTaskGetBlockingStats( TaskHandle_t xTask, TaskBlockingStats_t *pxStats )
+	{
+	TCB_t *pxTCB;
+	uint32_t ulNow;
+
+		configASSERT( pxStats );
+
+		/* A task can be unblocked from an interrupt, so the statistics are
+		copied in a critical section. */
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			( void ) memcpy( ( void * ) pxStats->ulBlockedTime, ( void * ) pxTCB->ulBlockedTime, sizeof( pxStats->ulBlockedTime ) );
+			pxStats->ulLongestBlock = pxTCB->ulLongestBlock;
+			pxStats->eLongestBlockReason = ( eBlockReason ) pxTCB->ucLongestBlockReason;
+			pxStats->pvLongestBlockObject = pxTCB->pvLongestBlockObject;
+			pxStats->eCurrentReason = ( eBlockReason ) pxTCB->ucBlockReason;
+			pxStats->pvCurrentObject = pxTCB->pvBlockObject;
+
+			if( pxTCB->ucBlockReason != ( uint8_t ) eBlockNone )
+			{
+				taskBLOCK_TIME_NOW( ulNow );
+				pxStats->ulCurrentBlockTime = taskBLOCK_TIME_SINCE( pxTCB->ulBlockStart, ulNow );
+			}
+			else
+			{
+				pxStats->ulCurrentBlockTime = 0UL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_BLOCKING_STATS */
+/*-----------------------------------------------------------*/
 
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
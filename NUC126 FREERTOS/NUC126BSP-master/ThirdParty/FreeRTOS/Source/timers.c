@@ -27,6 +27,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -80,6 +81,15 @@ typedef struct tmrTimerControl
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t 			ucStaticallyAllocated; /*<< Set to pdTRUE if the timer was created statically so no attempt is made to free the memory again if the timer is later deleted. */
 	#endif
+
+	#if( configUSE_TIMER_HEAP == 1 )
+		UBaseType_t			uxHeapIndex;		/*<< Position of the timer in pxTimerHeap[] while it is active. */
+	#endif
+
+	#if( configUSE_TIMER_STATS == 1 )
+		TimerStats_t		xStats;				/*<< Callback statistics returned by vTimerGetStats(). */
+		uint32_t			ulCallbackBudget;	/*<< Callback execution time above which an overrun is recorded, or 0. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -133,12 +143,63 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
+#if( configUSE_TIMER_HEAP == 1 )
+	/* When configUSE_TIMER_HEAP is 1 the active timers are held in a binary
+	min-heap instead.  Timers in the current list sort before timers in the
+	overflow list, then by expiry time, so the head of the current list is
+	always pxTimerHeap[ 0 ].  xActiveTimerList1 and xActiveTimerList2 then only
+	count their timers, and are referenced from each timer's list item so
+	listIS_CONTAINED_WITHIN() and listLIST_IS_EMPTY() work as before. */
+	PRIVILEGED_DATA static Timer_t *pxTimerHeap[ configTIMER_HEAP_LENGTH ];
+	PRIVILEGED_DATA static UBaseType_t uxTimersInHeap = ( UBaseType_t ) 0U;
+
+	/* Timers that exist, including those not yet deleted by the timer service
+	task.  Limited to configTIMER_HEAP_LENGTH so a start command can never find
+	the heap full after the command has been accepted. */
+	PRIVILEGED_DATA static UBaseType_t uxTimersCreated = ( UBaseType_t ) 0U;
+#endif
+
+#if( configUSE_TIMER_STATS == 1 )
+	PRIVILEGED_DATA static TimerServiceStats_t xServiceStats;
+#endif
+
+/* The tick count when the timer service task last checked for an overflow. */
+PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U;
+
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
 /*lint -restore */
 
+#if( configUSE_TIMER_HEAP == 1 )
+	#define tmrINSERT_TIMER( pxList, pxTimer )	prvTimerHeapInsert( ( pxList ), ( pxTimer ) )
+	#define tmrREMOVE_TIMER( pxTimer )			prvTimerHeapRemove( pxTimer )
+	#define tmrGET_HEAD_TIMER( pxList )			( pxTimerHeap[ 0 ] ) /* Only valid for pxCurrentTimerList. */
+#else
+	#define tmrINSERT_TIMER( pxList, pxTimer )	vListInsert( ( pxList ), &( ( pxTimer )->xTimerListItem ) )
+	#define tmrREMOVE_TIMER( pxTimer )			( void ) uxListRemove( &( ( pxTimer )->xTimerListItem ) )
+	#define tmrGET_HEAD_TIMER( pxList )			( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) )
+#endif
+
+#define tmrGET_HEAD_EXPIRY( pxList )	listGET_LIST_ITEM_VALUE( &( tmrGET_HEAD_TIMER( pxList )->xTimerListItem ) )
+
+#if( configUSE_TIMER_STATS == 1 )
+	#define tmrEXECUTE_CALLBACK( pxTimer, xExpiryTime )		prvExecuteTimerCallback( ( pxTimer ), ( xExpiryTime ) )
+#else
+	#define tmrEXECUTE_CALLBACK( pxTimer, xExpiryTime )		( pxTimer )->pxCallbackFunction( ( TimerHandle_t ) ( pxTimer ) )
+#endif
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+	/* Other tasks can update the active timer lists directly, so the timer
+	service task must suspend the scheduler while it updates them too. */
+	#define tmrLOCK_LISTS()		vTaskSuspendAll()
+	#define tmrUNLOCK_LISTS()	( void ) xTaskResumeAll()
+#else
+	#define tmrLOCK_LISTS()
+	#define tmrUNLOCK_LISTS()
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -176,9 +237,17 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the active timer list a timer expiring at xNextExpiryTime belongs in,
+ * or NULL if its expiry time passed before the command was processed and the
+ * timer must be processed now.
+ */
+static List_t *prvSelectActiveList( const TickType_t xNextExpiryTime, const TickType_t xTimerPeriod, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * auto reload timer, then call its callback.  Called with the scheduler
+ * suspended, which is resumed before the callback executes.
  */
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
@@ -206,7 +275,60 @@ static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIV
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_HEAP == 1 )
+
+	/*
+	 * Add a timer to, or remove a timer from, pxTimerHeap[].  pxList is the
+	 * active timer list the timer is logically in.
+	 */
+	static void prvTimerHeapInsert( List_t * const pxList, Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+	static void prvTimerHeapRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Count a timer being created, returning pdFAIL if configTIMER_HEAP_LENGTH
+	 * timers already exist, or a timer being deleted.
+	 */
+	static BaseType_t prvReserveHeapSlot( void ) PRIVILEGED_FUNCTION;
+	static void prvReleaseHeapSlot( void ) PRIVILEGED_FUNCTION;
+
+	#define tmrRESERVE_TIMER()	prvReserveHeapSlot()
+	#define tmrRELEASE_TIMER()	prvReleaseHeapSlot()
+#else
+	#define tmrRESERVE_TIMER()	pdPASS
+	#define tmrRELEASE_TIMER()
+
+#endif /* configUSE_TIMER_HEAP */
+
+#if( configUSE_TIMER_STATS == 1 )
+
+	/*
+	 * Execute the callback of a timer that expired at xExpiryTime, recording
+	 * its lateness and execution time.
+	 */
+	static void prvExecuteTimerCallback( Timer_t * const pxTimer, const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Count a command that could not be sent to the timer service task.  Can
+	 * be called from tasks and interrupts.
+	 */
+	static void prvRecordDroppedCommand( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_STATS */
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/*
+	 * Apply a start, reset, stop or change period command from a task directly
+	 * to the active timer lists.  Returns pdFAIL if the command must instead be
+	 * sent to the timer service task, either to keep it behind commands that
+	 * are already queued or because the task has to wake earlier than it
+	 * otherwise would.
+	 */
+	static BaseType_t prvDirectCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
 
 /*
  * Called after a Timer_t structure has been allocated either statically or
@@ -283,7 +405,19 @@ BaseType_t xReturn = pdFAIL;
 	{
 	Timer_t *pxNewTimer;
 
-		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+		if( tmrRESERVE_TIMER() != pdFAIL )
+		{
+			pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+
+			if( pxNewTimer == NULL )
+			{
+				tmrRELEASE_TIMER();
+			}
+		}
+		else
+		{
+			pxNewTimer = NULL;
+		}
 
 		if( pxNewTimer != NULL )
 		{
@@ -328,7 +462,15 @@ BaseType_t xReturn = pdFAIL;
 
 		/* A pointer to a StaticTimer_t structure MUST be provided, use it. */
 		configASSERT( pxTimerBuffer );
-		pxNewTimer = ( Timer_t * ) pxTimerBuffer; /*lint !e740 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+
+		if( tmrRESERVE_TIMER() != pdFAIL )
+		{
+			pxNewTimer = ( Timer_t * ) pxTimerBuffer; /*lint !e740 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+		}
+		else
+		{
+			pxNewTimer = NULL;
+		}
 
 		if( pxNewTimer != NULL )
 		{
@@ -373,6 +515,14 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+			( void ) memset( &( pxNewTimer->xStats ), 0x00, sizeof( TimerStats_t ) );
+			pxNewTimer->ulCallbackBudget = 0U;
+		}
+		#endif /* configUSE_TIMER_STATS */
+
 		traceTIMER_CREATE( pxNewTimer );
 	}
 }
@@ -398,7 +548,20 @@ DaemonTaskMessage_t xMessage;
 		{
 			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+				{
+					xReturn = prvDirectCommand( ( Timer_t * ) xTimer, xCommandID, xOptionalValue );
+				}
+				#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+				if( xReturn == pdFAIL )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
@@ -410,6 +573,19 @@ DaemonTaskMessage_t xMessage;
 			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 		}
 
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+			if( xReturn == pdFAIL )
+			{
+				prvRecordDroppedCommand();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_STATS */
+
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
 	else
@@ -462,11 +638,11 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+Timer_t * const pxTimer = tmrGET_HEAD_TIMER( pxCurrentTimerList );
 
 	/* Remove the timer from the list of active timers.  A check has already
 	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	tmrREMOVE_TIMER( pxTimer );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -494,8 +670,10 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	( void ) xTaskResumeAll();
+
 	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	tmrEXECUTE_CALLBACK( pxTimer, xNextExpireTime );
 }
 /*-----------------------------------------------------------*/
 
@@ -535,13 +713,21 @@ BaseType_t xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
 BaseType_t xTimerListsWereSwitched;
 
 	vTaskSuspendAll();
 	{
+		#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+		{
+			/* Another task may have started or stopped a timer since the next
+			expire time was obtained. */
+			xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		}
+		#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
 		/* Obtain the time now to make an assessment as to whether the timer
 		has expired or not.  If obtaining the time causes the lists to switch
 		then don't process this timer as any timers that remained in the list
@@ -553,7 +739,8 @@ BaseType_t xTimerListsWereSwitched;
 			/* The tick count has not overflowed, has the timer expired? */
 			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
 			{
-				( void ) xTaskResumeAll();
+				/* The scheduler is resumed once the timer has been removed
+				from the list. */
 				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
 			}
 			else
@@ -609,7 +796,7 @@ TickType_t xNextExpireTime;
 	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
 	if( *pxListWasEmpty == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = tmrGET_HEAD_EXPIRY( pxCurrentTimerList );
 	}
 	else
 	{
@@ -624,7 +811,6 @@ TickType_t xNextExpireTime;
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
@@ -647,23 +833,41 @@ PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Va
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
 {
 BaseType_t xProcessTimerNow = pdFALSE;
+List_t * const pxList = prvSelectActiveList( xNextExpiryTime, pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime );
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+	if( pxList != NULL )
+	{
+		tmrINSERT_TIMER( pxList, pxTimer );
+	}
+	else
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+static List_t *prvSelectActiveList( const TickType_t xNextExpiryTime, const TickType_t xTimerPeriod, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+List_t *pxList;
+
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
 		timer was issued, and the time the command was processed? */
-		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= xTimerPeriod ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		{
 			/* The time between a command being issued and the command being
 			processed actually exceeds the timers period.  */
-			xProcessTimerNow = pdTRUE;
+			pxList = NULL;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			pxList = pxOverflowTimerList;
 		}
 	}
 	else
@@ -673,15 +877,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 			/* If, since the command was issued, the tick count has overflowed
 			but the expiry time has not, then the timer must have already passed
 			its expiry time and should be processed immediately. */
-			xProcessTimerNow = pdTRUE;
+			pxList = NULL;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			pxList = pxCurrentTimerList;
 		}
 	}
 
-	return xProcessTimerNow;
+	return pxList;
 }
 /*-----------------------------------------------------------*/
 
@@ -689,11 +893,41 @@ static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
 Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
+BaseType_t xTimerListsWereSwitched, xResult, xProcessTimerNow;
 TickType_t xTimeNow;
 
+	/* When tasks can update the lists directly, commands are received with
+	the scheduler suspended so a task cannot apply a later command between
+	this task receiving a command and applying it.  The scheduler is resumed
+	around each callback. */
+	tmrLOCK_LISTS();
+
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+		UBaseType_t uxMessagesWaiting;
+
+			/* The queue only grows until this task next receives from it, so
+			the high water mark can be sampled here, including the message
+			just received. */
+			uxMessagesWaiting = uxQueueMessagesWaiting( xTimerQueue ) + ( UBaseType_t ) 1U;
+
+			if( uxMessagesWaiting > xServiceStats.uxQueueHighWaterMark )
+			{
+				taskENTER_CRITICAL();
+				{
+					xServiceStats.uxQueueHighWaterMark = uxMessagesWaiting;
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_STATS */
+
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
 			/* Negative commands are pended function calls rather than timer
@@ -707,7 +941,9 @@ TickType_t xTimeNow;
 				configASSERT( pxCallback );
 
 				/* Call the function. */
+				tmrUNLOCK_LISTS();
 				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				tmrLOCK_LISTS();
 			}
 			else
 			{
@@ -723,11 +959,12 @@ TickType_t xTimeNow;
 			/* The messages uses the xTimerParameters member to work on a
 			software timer. */
 			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			xProcessTimerNow = pdFALSE;
 
 			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
 			{
 				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				tmrREMOVE_TIMER( pxTimer );
 			}
 			else
 			{
@@ -751,29 +988,9 @@ TickType_t xTimeNow;
 			    case tmrCOMMAND_RESET :
 			    case tmrCOMMAND_RESET_FROM_ISR :
 				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					/* Start or restart a timer.  If the timer expired before it
+					was added to the active timer list it is processed below. */
+					xProcessTimerNow = prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue );
 					break;
 
 				case tmrCOMMAND_STOP :
@@ -800,6 +1017,8 @@ TickType_t xTimeNow;
 					/* The timer has already been removed from the active list,
 					just free up the memory if the memory was dynamically
 					allocated. */
+					tmrRELEASE_TIMER();
+
 					#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 					{
 						/* The timer can only have been allocated dynamically -
@@ -827,8 +1046,35 @@ TickType_t xTimeNow;
 					/* Don't expect to get here. */
 					break;
 			}
+
+			if( xProcessTimerNow != pdFALSE )
+			{
+				/* The timer expired before it was added to the active
+				timer list.  Process it now. */
+				tmrUNLOCK_LISTS();
+				tmrEXECUTE_CALLBACK( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks );
+				traceTIMER_EXPIRED( pxTimer );
+				tmrLOCK_LISTS();
+
+				if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 	}
+
+	tmrUNLOCK_LISTS();
 }
 /*-----------------------------------------------------------*/
 
@@ -845,17 +1091,17 @@ BaseType_t xResult;
 	are switched. */
 	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = tmrGET_HEAD_EXPIRY( pxCurrentTimerList );
 
 		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		pxTimer = tmrGET_HEAD_TIMER( pxCurrentTimerList );
+		tmrREMOVE_TIMER( pxTimer );
 		traceTIMER_EXPIRED( pxTimer );
 
 		/* Execute its callback, then send a command to restart the timer if
 		it is an auto-reload timer.  It cannot be restarted here as the lists
 		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		tmrEXECUTE_CALLBACK( pxTimer, xNextExpireTime );
 
 		if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
 		{
@@ -870,7 +1116,7 @@ BaseType_t xResult;
 			{
 				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
 				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				tmrINSERT_TIMER( pxCurrentTimerList, pxTimer );
 			}
 			else
 			{
@@ -1010,6 +1256,19 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 
 		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+			if( xReturn == pdFAIL )
+			{
+				prvRecordDroppedCommand();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_STATS */
+
 		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
 		return xReturn;
@@ -1039,6 +1298,19 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 
 		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 
+		#if( configUSE_TIMER_STATS == 1 )
+		{
+			if( xReturn == pdFAIL )
+			{
+				prvRecordDroppedCommand();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_STATS */
+
 		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
 		return xReturn;
@@ -1047,6 +1319,448 @@ Timer_t * const pxTimer = ( Timer_t * ) xTimer;
 #endif /* INCLUDE_xTimerPendFunctionCall */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_HEAP == 1 )
+
+	static BaseType_t prvTimerHeapIsBefore( const Timer_t * const pxTimer1, const Timer_t * const pxTimer2 )
+	{
+	BaseType_t xReturn;
+
+		if( pxTimer1->xTimerListItem.pvContainer == pxTimer2->xTimerListItem.pvContainer )
+		{
+			/* Unlike vListInsert(), timers with equal expiry times are not
+			guaranteed to expire in the order they were started. */
+			xReturn = ( BaseType_t ) ( listGET_LIST_ITEM_VALUE( &( pxTimer1->xTimerListItem ) ) < listGET_LIST_ITEM_VALUE( &( pxTimer2->xTimerListItem ) ) );
+		}
+		else
+		{
+			/* Timers in the current list expire before timers in the overflow
+			list whatever their expiry times. */
+			xReturn = ( BaseType_t ) ( pxTimer1->xTimerListItem.pvContainer == ( void * ) pxCurrentTimerList );
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerHeapMoveUp( Timer_t * const pxTimer, UBaseType_t uxIndex )
+	{
+	UBaseType_t uxParent;
+
+		while( uxIndex > ( UBaseType_t ) 0U )
+		{
+			uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1U;
+
+			if( prvTimerHeapIsBefore( pxTimer, pxTimerHeap[ uxParent ] ) == pdFALSE )
+			{
+				break;
+			}
+
+			pxTimerHeap[ uxIndex ] = pxTimerHeap[ uxParent ];
+			pxTimerHeap[ uxIndex ]->uxHeapIndex = uxIndex;
+			uxIndex = uxParent;
+		}
+
+		pxTimerHeap[ uxIndex ] = pxTimer;
+		pxTimer->uxHeapIndex = uxIndex;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerHeapMoveDown( Timer_t * const pxTimer, UBaseType_t uxIndex )
+	{
+	UBaseType_t uxChild;
+
+		for( ;; )
+		{
+			uxChild = ( uxIndex << 1U ) + ( UBaseType_t ) 1U;
+
+			if( uxChild >= uxTimersInHeap )
+			{
+				break;
+			}
+
+			/* Follow the child that expires first. */
+			if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxTimersInHeap ) && ( prvTimerHeapIsBefore( pxTimerHeap[ uxChild + ( UBaseType_t ) 1U ], pxTimerHeap[ uxChild ] ) != pdFALSE ) )
+			{
+				uxChild++;
+			}
+
+			if( prvTimerHeapIsBefore( pxTimerHeap[ uxChild ], pxTimer ) == pdFALSE )
+			{
+				break;
+			}
+
+			pxTimerHeap[ uxIndex ] = pxTimerHeap[ uxChild ];
+			pxTimerHeap[ uxIndex ]->uxHeapIndex = uxIndex;
+			uxIndex = uxChild;
+		}
+
+		pxTimerHeap[ uxIndex ] = pxTimer;
+		pxTimer->uxHeapIndex = uxIndex;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerHeapInsert( List_t * const pxList, Timer_t * const pxTimer )
+	{
+		/* Cannot fail, as no more than configTIMER_HEAP_LENGTH timers can be
+		created. */
+		configASSERT( uxTimersInHeap < ( UBaseType_t ) configTIMER_HEAP_LENGTH );
+
+		if( uxTimersInHeap < ( UBaseType_t ) configTIMER_HEAP_LENGTH )
+		{
+			/* The list item records which list the timer is logically in, and
+			the list counts the timers it contains. */
+			pxTimer->xTimerListItem.pvContainer = ( void * ) pxList;
+			( pxList->uxNumberOfItems )++;
+
+			uxTimersInHeap++;
+			prvTimerHeapMoveUp( pxTimer, uxTimersInHeap - ( UBaseType_t ) 1U );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimerHeapRemove( Timer_t * const pxTimer )
+	{
+	List_t * const pxList = ( List_t * ) pxTimer->xTimerListItem.pvContainer;
+	const UBaseType_t uxIndex = pxTimer->uxHeapIndex;
+	Timer_t *pxLastTimer;
+
+		( pxList->uxNumberOfItems )--;
+		pxTimer->xTimerListItem.pvContainer = NULL;
+		uxTimersInHeap--;
+
+		if( uxIndex < uxTimersInHeap )
+		{
+			/* Fill the gap with the last timer in the heap, then move that
+			timer up or down to restore the heap order. */
+			pxLastTimer = pxTimerHeap[ uxTimersInHeap ];
+
+			if( ( uxIndex > ( UBaseType_t ) 0U ) && ( prvTimerHeapIsBefore( pxLastTimer, pxTimerHeap[ ( uxIndex - ( UBaseType_t ) 1U ) >> 1U ] ) != pdFALSE ) )
+			{
+				prvTimerHeapMoveUp( pxLastTimer, uxIndex );
+			}
+			else
+			{
+				prvTimerHeapMoveDown( pxLastTimer, uxIndex );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvReserveHeapSlot( void )
+	{
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( uxTimersCreated < ( UBaseType_t ) configTIMER_HEAP_LENGTH )
+			{
+				uxTimersCreated++;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseHeapSlot( void )
+	{
+		taskENTER_CRITICAL();
+		{
+			configASSERT( uxTimersCreated > ( UBaseType_t ) 0U );
+			uxTimersCreated--;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_HEAP */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	static BaseType_t prvDirectCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue )
+	{
+	BaseType_t xReturn = pdFAIL;
+	TickType_t xTimeNow, xNextExpiryTime, xCommandTime = ( TickType_t ) 0U, xPeriod = ( TickType_t ) 0U;
+	List_t *pxList = NULL;
+
+		vTaskSuspendAll();
+		{
+			xTimeNow = xTaskGetTickCount();
+
+			/* Commands that are already queued must be applied first.  If the
+			tick count has overflowed since the timer service task last sampled
+			it then the lists are about to be switched, so leave that to the
+			task too. */
+			if( ( uxQueueMessagesWaiting( xTimerQueue ) == ( UBaseType_t ) 0U ) && ( xTimeNow >= xLastTime ) )
+			{
+				switch( xCommandID )
+				{
+					case tmrCOMMAND_START :
+					case tmrCOMMAND_RESET :
+						xPeriod = pxTimer->xTimerPeriodInTicks;
+						xCommandTime = xOptionalValue;
+						xReturn = pdPASS;
+						break;
+
+					case tmrCOMMAND_CHANGE_PERIOD :
+						configASSERT( ( xOptionalValue > 0 ) );
+						xPeriod = xOptionalValue;
+						xCommandTime = xTimeNow;
+						xReturn = pdPASS;
+						break;
+
+					case tmrCOMMAND_STOP :
+						xReturn = pdPASS;
+						break;
+
+					default :
+						/* Timers are only deleted by the timer service task as
+						commands it has yet to process may reference them. */
+						break;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xReturn != pdFAIL ) && ( xCommandID != tmrCOMMAND_STOP ) )
+			{
+				xNextExpiryTime = xCommandTime + xPeriod;
+				pxList = prvSelectActiveList( xNextExpiryTime, xPeriod, xTimeNow, xCommandTime );
+
+				/* The timer service task is blocked until the head of the
+				current list expires, or until the tick count overflows if the
+				current list is empty, or indefinitely if both lists are empty.
+				A timer that must be processed before then has to be sent as a
+				command so the task is woken.  Stopping a timer never needs the
+				task to wake earlier. */
+				if( pxList == NULL )
+				{
+					/* Already expired - the callback must run in the task. */
+					xReturn = pdFAIL;
+				}
+				else if( listLIST_IS_EMPTY( pxCurrentTimerList ) != pdFALSE )
+				{
+					if( ( pxList == pxCurrentTimerList ) || ( listLIST_IS_EMPTY( pxOverflowTimerList ) != pdFALSE ) )
+					{
+						xReturn = pdFAIL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( pxList == pxCurrentTimerList ) && ( xNextExpiryTime < tmrGET_HEAD_EXPIRY( pxCurrentTimerList ) ) )
+				{
+					xReturn = pdFAIL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xReturn != pdFAIL )
+			{
+				if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+				{
+					tmrREMOVE_TIMER( pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+				if( pxList != NULL )
+				{
+					pxTimer->xTimerPeriodInTicks = xPeriod;
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xCommandTime + xPeriod );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					tmrINSERT_TIMER( pxList, pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_STATS == 1 )
+
+	static void prvExecuteTimerCallback( Timer_t * const pxTimer, const TickType_t xExpiryTime )
+	{
+	TimerStats_t * const pxStats = &( pxTimer->xStats );
+	uint32_t ulLateness, ulStartTime, ulExecutionTime;
+	BaseType_t xOverrun;
+
+		ulLateness = ( uint32_t ) ( ( TickType_t ) ( xTaskGetTickCount() - xExpiryTime ) );
+
+		ulStartTime = configTIMER_STATS_GET_TIME();
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		ulExecutionTime = configTIMER_STATS_GET_TIME() - ulStartTime;
+
+		xOverrun = ( BaseType_t ) ( ( pxTimer->ulCallbackBudget != 0U ) && ( ulExecutionTime > pxTimer->ulCallbackBudget ) );
+
+		/* Other tasks can read and clear the statistics. */
+		taskENTER_CRITICAL();
+		{
+			if( ( pxStats->ulCallbackCount == 0U ) || ( ulExecutionTime < pxStats->ulMinExecutionTime ) )
+			{
+				pxStats->ulMinExecutionTime = ulExecutionTime;
+			}
+
+			if( ulExecutionTime > pxStats->ulMaxExecutionTime )
+			{
+				pxStats->ulMaxExecutionTime = ulExecutionTime;
+			}
+
+			if( ulLateness > pxStats->ulMaxLateness )
+			{
+				pxStats->ulMaxLateness = ulLateness;
+			}
+
+			if( ulLateness > xServiceStats.ulMaxLateness )
+			{
+				xServiceStats.ulMaxLateness = ulLateness;
+			}
+
+			pxStats->ulTotalExecutionTime += ulExecutionTime;
+			pxStats->ulTotalLateness += ulLateness;
+			( pxStats->ulCallbackCount )++;
+			( xServiceStats.ulCallbackCount )++;
+
+			if( xOverrun != pdFALSE )
+			{
+				( pxStats->ulOverrunCount )++;
+				( xServiceStats.ulOverrunCount )++;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		#if( configUSE_TIMER_OVERRUN_HOOK == 1 )
+		{
+			if( xOverrun != pdFALSE )
+			{
+				extern void vApplicationTimerOverrunHook( TimerHandle_t xTimer, uint32_t ulExecutionTime );
+
+				vApplicationTimerOverrunHook( ( TimerHandle_t ) pxTimer, ulExecutionTime );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMER_OVERRUN_HOOK */
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordDroppedCommand( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			( xServiceStats.ulDroppedCommands )++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTimerGetStats( TimerHandle_t xTimer, TimerStats_t *pxStats, BaseType_t xReset )
+	{
+	Timer_t * const pxTimer = ( Timer_t * ) xTimer;
+
+		configASSERT( xTimer );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxTimer->xStats;
+
+			if( xReset != pdFALSE )
+			{
+				( void ) memset( &( pxTimer->xStats ), 0x00, sizeof( TimerStats_t ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTimerGetServiceStats( TimerServiceStats_t *pxStats, BaseType_t xReset )
+	{
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = xServiceStats;
+
+			if( xReset != pdFALSE )
+			{
+				( void ) memset( &xServiceStats, 0x00, sizeof( TimerServiceStats_t ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		pxStats->uxQueueLength = ( UBaseType_t ) configTIMER_QUEUE_LENGTH;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTimerSetCallbackBudget( TimerHandle_t xTimer, uint32_t ulBudget )
+	{
+	Timer_t * const pxTimer = ( Timer_t * ) xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			pxTimer->ulCallbackBudget = ulBudget;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer )
@@ -0,0 +1,797 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "active_object.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build active_object.c
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to build active_object.c
+#endif
+
+#if( configAO_MAX_ACTIVE > 32 )
+	#error configAO_MAX_ACTIVE must be 32 or less as the ready sets are 32 bit
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The bit that represents an active object in ready and subscriber sets. */
+#define aoPRIORITY_BIT( uxPriority )	( ( uint32_t ) 1UL << ( ( uxPriority ) - ( UBaseType_t ) 1U ) )
+
+/* What is held in an active object's queue. */
+typedef struct AO_QUEUE_ITEM
+{
+	const AOEvent_t *pxEvent;
+	#if( configAO_MEASURE_LATENCY == 1 )
+		uint32_t ulPostTime;		/*< configAO_GET_TIMESTAMP() when the event was posted. */
+	#endif
+} AOQueueItem_t;
+
+/* A fixed block event pool.  Free blocks are linked through their first
+word. */
+typedef struct AO_POOL
+{
+	void *pvFreeList;
+	size_t xBlockSize;
+	UBaseType_t uxFreeBlocks;
+	UBaseType_t uxMinimumEverFreeBlocks;
+} AOPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The runner task.  Sleeps on its task notification, then dispatches events
+ * to the highest priority ready active object until none of its active objects
+ * have events waiting.
+ */
+static portTASK_FUNCTION_PROTO( prvRunnerTask, pvParameters );
+
+/*
+ * Remove a free block from the first pool with blocks of at least xEventSize
+ * bytes.  Must be called from a critical section.
+ */
+static AOEvent_t *prvAllocateEvent( size_t xEventSize, AOSignal_t xSignal );
+
+/*
+ * Drop one reference to a pool event, returning it to its pool if that was
+ * the last.  Must be called from a critical section.
+ */
+static void prvReleaseEvent( AOEvent_t *pxEvent );
+
+#if( configUSE_TIMERS == 1 )
+
+	/*
+	 * Timer callback shared by all time events.
+	 */
+	static void prvTimeEventCallback( TimerHandle_t xTimer );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Active objects indexed by priority.  Entry 0 is unused. */
+static AOActive_t *pxActiveObjects[ configAO_MAX_ACTIVE + 1 ];
+
+/* The active objects subscribed to each signal, one bit per priority. */
+static uint32_t ulSubscriberSets[ configAO_MAX_PUB_SIGNAL ];
+
+static AOPool_t xPools[ configAO_MAX_POOLS ];
+static UBaseType_t uxNumberOfPools = 0;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOPoolInit( void *pvPoolStorage, size_t xPoolSizeBytes, size_t xEventSize )
+{
+AOPool_t *pxPool;
+uint8_t *pucBlock;
+size_t xBlockSize;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pvPoolStorage );
+	configASSERT( xEventSize >= sizeof( AOEvent_t ) );
+	configASSERT( ( ( ( size_t ) pvPoolStorage ) & portBYTE_ALIGNMENT_MASK ) == 0U );
+
+	/* Each free block holds the link to the next, and must keep the next
+	block aligned. */
+	xBlockSize = xEventSize;
+	if( xBlockSize < sizeof( void * ) )
+	{
+		xBlockSize = sizeof( void * );
+	}
+	xBlockSize = ( xBlockSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	if( uxNumberOfPools < ( UBaseType_t ) configAO_MAX_POOLS )
+	{
+		/* Pools must be added smallest first so allocation can take the first
+		pool that fits. */
+		configASSERT( ( uxNumberOfPools == 0U ) || ( xPools[ uxNumberOfPools - 1U ].xBlockSize < xBlockSize ) );
+
+		pxPool = &( xPools[ uxNumberOfPools ] );
+		pxPool->pvFreeList = NULL;
+		pxPool->xBlockSize = xBlockSize;
+		pxPool->uxFreeBlocks = 0;
+
+		/* Link the blocks so the lowest address is allocated first. */
+		pucBlock = ( uint8_t * ) pvPoolStorage + ( ( xPoolSizeBytes / xBlockSize ) * xBlockSize );
+		while( pucBlock > ( uint8_t * ) pvPoolStorage )
+		{
+			pucBlock -= xBlockSize;
+			*( ( void ** ) pucBlock ) = pxPool->pvFreeList; /*lint !e9087 !e826 Free blocks hold a link. */
+			pxPool->pvFreeList = ( void * ) pucBlock;
+			( pxPool->uxFreeBlocks )++;
+		}
+
+		pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+		uxNumberOfPools++;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxAOPoolGetMinimumEverFree( UBaseType_t uxPool )
+{
+UBaseType_t uxReturn = 0;
+
+	if( uxPool < uxNumberOfPools )
+	{
+		uxReturn = xPools[ uxPool ].uxMinimumEverFreeBlocks;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static AOEvent_t *prvAllocateEvent( size_t xEventSize, AOSignal_t xSignal )
+{
+AOPool_t *pxPool;
+AOEvent_t *pxEvent = NULL;
+UBaseType_t uxPool;
+
+	for( uxPool = 0; uxPool < uxNumberOfPools; uxPool++ )
+	{
+		pxPool = &( xPools[ uxPool ] );
+
+		if( pxPool->xBlockSize >= xEventSize )
+		{
+			/* Events are not taken from a pool of larger blocks when the best
+			fitting pool is empty, so small events cannot starve large ones. */
+			if( pxPool->pvFreeList != NULL )
+			{
+				pxEvent = ( AOEvent_t * ) pxPool->pvFreeList;
+				pxPool->pvFreeList = *( ( void ** ) pxPool->pvFreeList );
+				( pxPool->uxFreeBlocks )--;
+
+				if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+				{
+					pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+				}
+
+				pxEvent->xSignal = xSignal;
+				pxEvent->ucPoolId = ( uint8_t ) ( uxPool + 1U );
+				pxEvent->ucRefCount = 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxEvent;
+}
+/*-----------------------------------------------------------*/
+
+AOEvent_t *pxAOEventNew( size_t xEventSize, AOSignal_t xSignal )
+{
+AOEvent_t *pxEvent;
+
+	taskENTER_CRITICAL();
+	{
+		pxEvent = prvAllocateEvent( xEventSize, xSignal );
+	}
+	taskEXIT_CRITICAL();
+
+	return pxEvent;
+}
+/*-----------------------------------------------------------*/
+
+AOEvent_t *pxAOEventNewFromISR( size_t xEventSize, AOSignal_t xSignal )
+{
+AOEvent_t *pxEvent;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxEvent = prvAllocateEvent( xEventSize, xSignal );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pxEvent;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseEvent( AOEvent_t *pxEvent )
+{
+AOPool_t *pxPool;
+
+	if( pxEvent->ucRefCount > 1U )
+	{
+		( pxEvent->ucRefCount )--;
+	}
+	else
+	{
+		/* Last reference, or an event that was allocated and never posted. */
+		pxPool = &( xPools[ pxEvent->ucPoolId - 1U ] );
+		*( ( void ** ) pxEvent ) = pxPool->pvFreeList; /*lint !e9087 !e826 Free blocks hold a link. */
+		pxPool->pvFreeList = ( void * ) pxEvent;
+		( pxPool->uxFreeBlocks )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAOEventGarbageCollect( const AOEvent_t *pxEvent )
+{
+	/* Static events are never recycled. */
+	if( pxEvent->ucPoolId != 0U )
+	{
+		taskENTER_CRITICAL();
+		{
+			prvReleaseEvent( ( AOEvent_t * ) pxEvent ); /*lint !e9005 The event is only writable by the framework. */
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAORunnerCreate( AORunner_t *pxRunner, const char * const pcName, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxTaskPriority ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+	configASSERT( pxRunner );
+
+	pxRunner->ulReadySet = 0UL;
+
+	return xTaskCreate( prvRunnerTask, pcName, usStackDepth, ( void * ) pxRunner, uxTaskPriority, &( pxRunner->xTask ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOStart( AOActive_t *pxAO, AORunner_t *pxRunner, UBaseType_t uxPriority, UBaseType_t uxQueueLength, AODispatch_t pxDispatch )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxAO );
+	configASSERT( pxRunner );
+	configASSERT( pxDispatch );
+	configASSERT( ( uxPriority > 0U ) && ( uxPriority <= ( UBaseType_t ) configAO_MAX_ACTIVE ) );
+	configASSERT( pxActiveObjects[ uxPriority ] == NULL );
+
+	pxAO->pxDispatch = pxDispatch;
+	pxAO->pxRunner = pxRunner;
+	pxAO->uxPriority = uxPriority;
+
+	#if( configAO_MEASURE_LATENCY == 1 )
+	{
+		memset( ( void * ) &( pxAO->xStats ), 0x00, sizeof( pxAO->xStats ) );
+	}
+	#endif
+
+	pxAO->xQueue = xQueueCreate( uxQueueLength, sizeof( AOQueueItem_t ) );
+
+	if( pxAO->xQueue != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxActiveObjects[ uxPriority ] = pxAO;
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOPost( AOActive_t *pxAO, const AOEvent_t *pxEvent )
+{
+AOQueueItem_t xItem;
+AOEvent_t * const pxMutableEvent = ( AOEvent_t * ) pxEvent; /*lint !e9005 The event is only writable by the framework. */
+BaseType_t xReturn;
+
+	configASSERT( pxAO );
+	configASSERT( pxEvent );
+
+	xItem.pxEvent = pxEvent;
+
+	#if( configAO_MEASURE_LATENCY == 1 )
+	{
+		xItem.ulPostTime = configAO_GET_TIMESTAMP();
+	}
+	#endif
+
+	taskENTER_CRITICAL();
+	{
+		/* Take the reference before the event is visible to the runner.  The
+		queue is not full-checked first as a failed send is rare. */
+		if( pxMutableEvent->ucPoolId != 0U )
+		{
+			( pxMutableEvent->ucRefCount )++;
+		}
+
+		xReturn = xQueueSendToBack( pxAO->xQueue, &xItem, 0 );
+
+		if( xReturn == pdPASS )
+		{
+			pxAO->pxRunner->ulReadySet |= aoPRIORITY_BIT( pxAO->uxPriority );
+		}
+		else if( pxMutableEvent->ucPoolId != 0U )
+		{
+			prvReleaseEvent( pxMutableEvent );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xReturn == pdPASS )
+	{
+		/* Yields if the runner has a higher priority than the calling task. */
+		( void ) xTaskNotifyGive( pxAO->pxRunner->xTask );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOPostFromISR( AOActive_t *pxAO, const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken )
+{
+AOQueueItem_t xItem;
+AOEvent_t * const pxMutableEvent = ( AOEvent_t * ) pxEvent; /*lint !e9005 The event is only writable by the framework. */
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxAO );
+	configASSERT( pxEvent );
+
+	xItem.pxEvent = pxEvent;
+
+	#if( configAO_MEASURE_LATENCY == 1 )
+	{
+		xItem.ulPostTime = configAO_GET_TIMESTAMP();
+	}
+	#endif
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxMutableEvent->ucPoolId != 0U )
+		{
+			( pxMutableEvent->ucRefCount )++;
+		}
+
+		/* The runner only ever receives without blocking, so no task can be
+		unblocked by the send and NULL is passed for the woken flag. */
+		xReturn = xQueueSendToBackFromISR( pxAO->xQueue, &xItem, NULL );
+
+		if( xReturn == pdPASS )
+		{
+			pxAO->pxRunner->ulReadySet |= aoPRIORITY_BIT( pxAO->uxPriority );
+		}
+		else if( pxMutableEvent->ucPoolId != 0U )
+		{
+			prvReleaseEvent( pxMutableEvent );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		vTaskNotifyGiveFromISR( pxAO->pxRunner->xTask, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOSubscribe( AOActive_t *pxAO, AOSignal_t xSignal )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxAO );
+
+	if( xSignal < ( AOSignal_t ) configAO_MAX_PUB_SIGNAL )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulSubscriberSets[ xSignal ] |= aoPRIORITY_BIT( pxAO->uxPriority );
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAOUnsubscribe( AOActive_t *pxAO, AOSignal_t xSignal )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxAO );
+
+	if( xSignal < ( AOSignal_t ) configAO_MAX_PUB_SIGNAL )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulSubscriberSets[ xSignal ] &= ~aoPRIORITY_BIT( pxAO->uxPriority );
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxAOPublish( const AOEvent_t *pxEvent )
+{
+UBaseType_t uxPriority, uxPosted = 0;
+uint32_t ulSubscribers;
+AOEvent_t * const pxMutableEvent = ( AOEvent_t * ) pxEvent; /*lint !e9005 The event is only writable by the framework. */
+
+	configASSERT( pxEvent );
+	configASSERT( pxEvent->xSignal < ( AOSignal_t ) configAO_MAX_PUB_SIGNAL );
+
+	/* Hold an extra reference while multicasting so the event cannot be
+	recycled part way through by a subscriber that processes it first. */
+	if( pxMutableEvent->ucPoolId != 0U )
+	{
+		taskENTER_CRITICAL();
+		{
+			( pxMutableEvent->ucRefCount )++;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	ulSubscribers = ulSubscriberSets[ pxEvent->xSignal ];
+
+	/* With the scheduler suspended the runners woken by the posts do not run
+	until every subscriber has the event, so the higher priority active
+	objects, which are posted to first, still process it first. */
+	vTaskSuspendAll();
+	{
+		for( uxPriority = ( UBaseType_t ) configAO_MAX_ACTIVE; uxPriority > 0U; uxPriority-- )
+		{
+			if( ( ulSubscribers & aoPRIORITY_BIT( uxPriority ) ) != 0UL )
+			{
+				if( xAOPost( pxActiveObjects[ uxPriority ], pxEvent ) == pdPASS )
+				{
+					uxPosted++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	/* Drop the multicast reference, which recycles the event if nobody
+	received it. */
+	vAOEventGarbageCollect( pxEvent );
+
+	return uxPosted;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxAOPublishFromISR( const AOEvent_t *pxEvent, BaseType_t *pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxPriority, uxPosted = 0;
+uint32_t ulSubscribers;
+UBaseType_t uxSavedInterruptStatus;
+AOEvent_t * const pxMutableEvent = ( AOEvent_t * ) pxEvent; /*lint !e9005 The event is only writable by the framework. */
+
+	configASSERT( pxEvent );
+	configASSERT( pxEvent->xSignal < ( AOSignal_t ) configAO_MAX_PUB_SIGNAL );
+
+	/* Tasks cannot run before the ISR completes, so the multicast reference
+	only guards against the event being recycled by a nested interrupt. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxMutableEvent->ucPoolId != 0U )
+		{
+			( pxMutableEvent->ucRefCount )++;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	ulSubscribers = ulSubscriberSets[ pxEvent->xSignal ];
+
+	for( uxPriority = ( UBaseType_t ) configAO_MAX_ACTIVE; uxPriority > 0U; uxPriority-- )
+	{
+		if( ( ulSubscribers & aoPRIORITY_BIT( uxPriority ) ) != 0UL )
+		{
+			if( xAOPostFromISR( pxActiveObjects[ uxPriority ], pxEvent, pxHigherPriorityTaskWoken ) == pdPASS )
+			{
+				uxPosted++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	if( pxMutableEvent->ucPoolId != 0U )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvReleaseEvent( pxMutableEvent );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+	return uxPosted;
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvRunnerTask, pvParameters )
+{
+AORunner_t * const pxRunner = ( AORunner_t * ) pvParameters;
+AOActive_t *pxAO;
+AOQueueItem_t xItem;
+UBaseType_t uxPriority;
+uint32_t ulReadySet;
+
+	for( ;; )
+	{
+		/* Every post gives the notification, so one is always pending while
+		any of the runner's active objects has an event waiting. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		for( ;; )
+		{
+			ulReadySet = pxRunner->ulReadySet;
+
+			if( ulReadySet == 0UL )
+			{
+				break;
+			}
+
+			/* Find the highest priority ready active object.  The loop is
+			bounded by configAO_MAX_ACTIVE. */
+			uxPriority = ( UBaseType_t ) configAO_MAX_ACTIVE;
+			while( ( ulReadySet & aoPRIORITY_BIT( uxPriority ) ) == 0UL )
+			{
+				uxPriority--;
+			}
+
+			pxAO = pxActiveObjects[ uxPriority ];
+
+			if( xQueueReceive( pxAO->xQueue, &xItem, 0 ) == pdPASS )
+			{
+				#if( configAO_MEASURE_LATENCY == 1 )
+				{
+				uint32_t ulLatency;
+				UBaseType_t uxDepth;
+
+					ulLatency = configAO_GET_TIMESTAMP() - xItem.ulPostTime;
+					uxDepth = uxQueueMessagesWaiting( pxAO->xQueue ) + 1U;
+
+					( pxAO->xStats.ulDispatchCount )++;
+					pxAO->xStats.ulTotalLatency += ulLatency;
+
+					if( ulLatency > pxAO->xStats.ulMaxLatency )
+					{
+						pxAO->xStats.ulMaxLatency = ulLatency;
+					}
+
+					if( uxDepth > pxAO->xStats.uxMaxQueueDepth )
+					{
+						pxAO->xStats.uxMaxQueueDepth = uxDepth;
+					}
+				}
+				#endif /* configAO_MEASURE_LATENCY */
+
+				/* Run to completion.  Active objects on higher priority runners
+				may preempt this, but none on this runner can. */
+				pxAO->pxDispatch( pxAO, xItem.pxEvent );
+
+				vAOEventGarbageCollect( xItem.pxEvent );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Posts set the ready bit in the same critical section as the
+			send, so the bit cannot be cleared here while an event is
+			waiting. */
+			taskENTER_CRITICAL();
+			{
+				if( uxQueueMessagesWaiting( pxAO->xQueue ) == ( UBaseType_t ) 0 )
+				{
+					pxRunner->ulReadySet &= ~aoPRIORITY_BIT( uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMERS == 1 )
+
+	BaseType_t xAOTimeEventCreate( AOTimeEvent_t *pxTimeEvent, AOActive_t *pxAO, AOSignal_t xSignal, UBaseType_t uxAutoReload )
+	{
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxTimeEvent );
+		configASSERT( pxAO );
+
+		pxTimeEvent->xEvent.xSignal = xSignal;
+		pxTimeEvent->xEvent.ucPoolId = 0U;
+		pxTimeEvent->xEvent.ucRefCount = 0U;
+		pxTimeEvent->pxAO = pxAO;
+
+		/* The period is set each time the time event is armed. */
+		pxTimeEvent->xTimer = xTimerCreate( "AOTE", ( TickType_t ) 1, uxAutoReload, ( void * ) pxTimeEvent, prvTimeEventCallback );
+
+		if( pxTimeEvent->xTimer != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xAOTimeEventArm( AOTimeEvent_t *pxTimeEvent, TickType_t xTicks )
+	{
+		configASSERT( pxTimeEvent );
+		configASSERT( xTicks > ( TickType_t ) 0 );
+
+		/* Changing the period also (re)starts the timer. */
+		return xTimerChangePeriod( pxTimeEvent->xTimer, xTicks, 0 );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xAOTimeEventDisarm( AOTimeEvent_t *pxTimeEvent )
+	{
+		configASSERT( pxTimeEvent );
+
+		return xTimerStop( pxTimeEvent->xTimer, 0 );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimeEventCallback( TimerHandle_t xTimer )
+	{
+	AOTimeEvent_t * const pxTimeEvent = ( AOTimeEvent_t * ) pvTimerGetTimerID( xTimer );
+
+		/* Runs in the timer service task.  If the active object's queue is
+		full the expiry is lost, as it would be for a task that missed a
+		notification. */
+		( void ) xAOPost( pxTimeEvent->pxAO, &( pxTimeEvent->xEvent ) );
+	}
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if( configAO_MEASURE_LATENCY == 1 )
+
+	void vAOGetStats( AOActive_t *pxAO, AOStats_t *pxStats, BaseType_t xReset )
+	{
+		configASSERT( pxAO );
+		configASSERT( pxStats );
+
+		/* The statistics are written by the runner task, so take a consistent
+		copy with the scheduler suspended. */
+		vTaskSuspendAll();
+		{
+			*pxStats = pxAO->xStats;
+
+			if( xReset != pdFALSE )
+			{
+				memset( ( void * ) &( pxAO->xStats ), 0x00, sizeof( pxAO->xStats ) );
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configAO_MEASURE_LATENCY */
@@ -0,0 +1,528 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "broadcast.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* Items are numbered in the order they are published.  Item n is held in slot
+( n % uxLength ) of the ring buffer, and the unsigned difference between two
+sequence numbers is correct across wrap round. */
+typedef struct BroadcastDefinition
+{
+	uint8_t *pucStorage;					/*< The ring buffer, uxLength items of uxItemSize bytes. */
+	UBaseType_t uxLength;
+	UBaseType_t uxItemSize;
+	uint32_t ulWriteSequence;				/*< The sequence number the next item published will have. */
+	BroadcastSubscriber_t *pxSubscribers;	/*< The subscribers, linked through their pxNext members. */
+	List_t xTasksWaitingToReceive;			/*< Tasks with nothing new to receive, in priority order. */
+	List_t xTasksWaitingToPublish;			/*< Tasks held up by a lossless subscriber, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the channel is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} Broadcast_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise a newly allocated channel with no subscribers.
+ */
+static void prvInitialiseBroadcast( Broadcast_t *pxChannel, UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if publishing another item would overwrite one that a
+ * lossless subscriber has not yet received.  Called with interrupts masked.
+ */
+static BaseType_t prvIsFull( const Broadcast_t *pxChannel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy an item into the ring buffer and unblock every task waiting to
+ * receive, as each now has an item.  Called with interrupts masked.  Returns
+ * pdTRUE if a task with a priority above that of the calling task was
+ * unblocked.
+ */
+static BaseType_t prvPublish( Broadcast_t *pxChannel, const void *pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the highest priority task waiting to publish, if there is one.
+ * Called from a critical section.  Returns pdTRUE if that task has a priority
+ * above that of the calling task.
+ */
+static BaseType_t prvReleasePublisher( Broadcast_t *pxChannel ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	BroadcastHandle_t xBroadcastCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorageBuffer, StaticBroadcast_t *pxStaticBroadcast )
+	{
+	Broadcast_t *pxChannel;
+
+		configASSERT( uxLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( pucStorageBuffer );
+		configASSERT( pxStaticBroadcast );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticBroadcast_t equals the size of the real
+			channel structure. */
+			volatile size_t xSize = sizeof( StaticBroadcast_t );
+			configASSERT( xSize == sizeof( Broadcast_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxChannel = ( Broadcast_t * ) pxStaticBroadcast; /*lint !e740 Broadcast_t and StaticBroadcast_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxChannel != NULL )
+		{
+			prvInitialiseBroadcast( pxChannel, uxLength, uxItemSize, pucStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxChannel->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return ( BroadcastHandle_t ) pxChannel;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	BroadcastHandle_t xBroadcastCreate( UBaseType_t uxLength, UBaseType_t uxItemSize )
+	{
+	Broadcast_t *pxChannel;
+
+		configASSERT( uxLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+		/* The channel and its ring buffer are allocated together, the buffer
+		following the structure, as queue.c does. */
+		pxChannel = ( Broadcast_t * ) pvPortMalloc( sizeof( Broadcast_t ) + ( ( size_t ) uxLength * ( size_t ) uxItemSize ) );
+
+		if( pxChannel != NULL )
+		{
+			prvInitialiseBroadcast( pxChannel, uxLength, uxItemSize, ( ( uint8_t * ) pxChannel ) + sizeof( Broadcast_t ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxChannel->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+
+		return ( BroadcastHandle_t ) pxChannel;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vBroadcastDelete( BroadcastHandle_t xChannel )
+{
+Broadcast_t *pxChannel = ( Broadcast_t * ) xChannel;
+
+	configASSERT( pxChannel );
+	configASSERT( pxChannel->pxSubscribers == NULL );
+	configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToPublish ) ) != pdFALSE );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxChannel );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxChannel->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxChannel );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+void vBroadcastSubscribe( BroadcastHandle_t xChannel, BroadcastSubscriber_t *pxSubscriber, eBroadcastPolicy ePolicy )
+{
+Broadcast_t *pxChannel = ( Broadcast_t * ) xChannel;
+
+	configASSERT( pxChannel );
+	configASSERT( pxSubscriber );
+
+	pxSubscriber->ulMissed = 0UL;
+	pxSubscriber->ePolicy = ePolicy;
+
+	taskENTER_CRITICAL();
+	{
+		pxSubscriber->pvChannel = pxChannel;
+		pxSubscriber->ulReadSequence = pxChannel->ulWriteSequence;
+		pxSubscriber->pxNext = pxChannel->pxSubscribers;
+		pxChannel->pxSubscribers = pxSubscriber;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vBroadcastUnsubscribe( BroadcastSubscriber_t *pxSubscriber )
+{
+Broadcast_t *pxChannel;
+BroadcastSubscriber_t **ppxLink;
+BaseType_t xYieldRequired = pdFALSE;
+
+	configASSERT( pxSubscriber );
+
+	taskENTER_CRITICAL();
+	{
+		pxChannel = ( Broadcast_t * ) pxSubscriber->pvChannel;
+
+		if( pxChannel != NULL )
+		{
+			for( ppxLink = &( pxChannel->pxSubscribers ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+			{
+				if( *ppxLink == pxSubscriber )
+				{
+					*ppxLink = pxSubscriber->pxNext;
+					break;
+				}
+			}
+
+			pxSubscriber->pvChannel = NULL;
+
+			/* A lossless subscriber may have been holding up the publishers.
+			Let them all check again. */
+			if( pxSubscriber->ePolicy == eBroadcastLossless )
+			{
+				while( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToPublish ) ) == pdFALSE )
+				{
+					if( prvReleasePublisher( pxChannel ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBroadcastPublish( BroadcastHandle_t xChannel, const void *pvItem, TickType_t xTicksToWait )
+{
+Broadcast_t *pxChannel = ( Broadcast_t * ) xChannel;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( prvIsFull( pxChannel ) == pdFALSE )
+			{
+				xYieldRequired = prvPublish( pxChannel, pvItem );
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = xTaskBlockOnEventList( &( pxChannel->xTasksWaitingToPublish ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, eBlockQueue, pxChannel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBroadcastPublishFromISR( BroadcastHandle_t xChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+Broadcast_t *pxChannel = ( Broadcast_t * ) xChannel;
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	/* See the comment in xQueueGenericSendFromISR() about interrupt priorities. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( prvIsFull( pxChannel ) == pdFALSE )
+		{
+			if( prvPublish( pxChannel, pvItem ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBroadcastReceive( BroadcastSubscriber_t *pxSubscriber, void *pvBuffer, TickType_t xTicksToWait )
+{
+Broadcast_t *pxChannel;
+BaseType_t xReturn = pdFAIL, xBlocked, xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+uint32_t ulAvailable;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxSubscriber );
+	configASSERT( pvBuffer );
+	configASSERT( pxSubscriber->pvChannel );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	pxChannel = ( Broadcast_t * ) pxSubscriber->pvChannel;
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			ulAvailable = pxChannel->ulWriteSequence - pxSubscriber->ulReadSequence;
+
+			if( ulAvailable != 0UL )
+			{
+				if( pxSubscriber->ePolicy == eBroadcastLatest )
+				{
+					/* Skip to the newest item.  Older items may already have
+					been overwritten. */
+					pxSubscriber->ulMissed += ulAvailable - 1UL;
+					pxSubscriber->ulReadSequence = pxChannel->ulWriteSequence - 1UL;
+				}
+				else
+				{
+					/* The publisher never overwrites an item a lossless
+					subscriber has not received. */
+					configASSERT( ulAvailable <= ( uint32_t ) pxChannel->uxLength );
+				}
+
+				( void ) memcpy( pvBuffer, ( void * ) &( pxChannel->pucStorage[ ( pxSubscriber->ulReadSequence % ( uint32_t ) pxChannel->uxLength ) * ( uint32_t ) pxChannel->uxItemSize ] ), ( size_t ) pxChannel->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+				( pxSubscriber->ulReadSequence )++;
+
+				/* Receiving the oldest item may have made room for a waiting
+				publisher. */
+				if( ( pxSubscriber->ePolicy == eBroadcastLossless ) && ( ulAvailable == ( uint32_t ) pxChannel->uxLength ) )
+				{
+					xYieldRequired = prvReleasePublisher( pxChannel );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = xTaskBlockOnEventList( &( pxChannel->xTasksWaitingToReceive ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, eBlockQueue, pxChannel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseBroadcast( Broadcast_t *pxChannel, UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorage )
+{
+	pxChannel->pucStorage = pucStorage;
+	pxChannel->uxLength = uxLength;
+	pxChannel->uxItemSize = uxItemSize;
+	pxChannel->ulWriteSequence = 0UL;
+	pxChannel->pxSubscribers = NULL;
+	vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+	vListInitialise( &( pxChannel->xTasksWaitingToPublish ) );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsFull( const Broadcast_t *pxChannel )
+{
+const BroadcastSubscriber_t *pxSubscriber;
+BaseType_t xReturn = pdFALSE;
+
+	for( pxSubscriber = pxChannel->pxSubscribers; pxSubscriber != NULL; pxSubscriber = pxSubscriber->pxNext )
+	{
+		if( ( pxSubscriber->ePolicy == eBroadcastLossless ) && ( ( pxChannel->ulWriteSequence - pxSubscriber->ulReadSequence ) >= ( uint32_t ) pxChannel->uxLength ) )
+		{
+			xReturn = pdTRUE;
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublish( Broadcast_t *pxChannel, const void *pvItem )
+{
+BaseType_t xReturn = pdFALSE;
+
+	( void ) memcpy( ( void * ) &( pxChannel->pucStorage[ ( pxChannel->ulWriteSequence % ( uint32_t ) pxChannel->uxLength ) * ( uint32_t ) pxChannel->uxItemSize ] ), pvItem, ( size_t ) pxChannel->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+	( pxChannel->ulWriteSequence )++;
+
+	/* Every waiting task now has an item to receive.  If the scheduler is
+	suspended xTaskRemoveFromEventList() holds them in the pending ready
+	list. */
+	while( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReleasePublisher( Broadcast_t *pxChannel )
+{
+BaseType_t xReturn = pdFALSE;
+
+	if( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToPublish ) ) == pdFALSE )
+	{
+		xReturn = xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToPublish ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
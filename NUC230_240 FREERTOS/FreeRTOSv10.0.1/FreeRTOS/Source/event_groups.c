@@ -27,6 +27,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -36,9 +37,14 @@ task.h is included from an application file. */
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 #include "timers.h"
 #include "event_groups.h"
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+	#include "croutine.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -60,6 +66,20 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* xEventGroupSetBits() gathers the buckets to examine in a mask with one bit
+per bucket, and a bucket beyond the last event bit would never be used. */
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#if( ( configEVENT_GROUP_INDEX_BUCKETS < 1 ) || ( configEVENT_GROUP_INDEX_BUCKETS > 8 ) )
+			#error configEVENT_GROUP_INDEX_BUCKETS must be between 1 and the 8 event bits available when configUSE_16_BIT_TICKS is 1
+		#endif
+	#else
+		#if( ( configEVENT_GROUP_INDEX_BUCKETS < 1 ) || ( configEVENT_GROUP_INDEX_BUCKETS > 24 ) )
+			#error configEVENT_GROUP_INDEX_BUCKETS must be between 1 and the 24 event bits available when configUSE_16_BIT_TICKS is 0
+		#endif
+	#endif
+#endif
+
 typedef struct xEventGroupDefinition
 {
 	EventBits_t uxEventBits;
@@ -72,8 +92,23 @@ typedef struct xEventGroupDefinition
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
+
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		List_t xTasksWaitingForIndexedBits[ configEVENT_GROUP_INDEX_BUCKETS ];	/*< Tasks waiting for a single bit, or for all of several bits, indexed by the bucket of a bit that is not yet set. */
+		EventBits_t uxAnyBitsWaitedFor;		/*< Union of the bits waited for by tasks in xTasksWaitingForBits, which then only holds tasks waiting for any one of several bits. */
+	#endif
+
+	#if( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xStats;				/*< The statistics returned by vEventGroupGetStats(). */
+	#endif
 } EventGroup_t;
 
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	#define eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )	prvGetWaitList( ( pxEventBits ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) )
+#else
+	#define eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )	( &( ( pxEventBits )->xTasksWaitingForBits ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -86,6 +121,33 @@ typedef struct xEventGroupDefinition
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the lists in which tasks wait for bits to be set, and the
+ * statistics of the event group.
+ */
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the current
+ * event bits, adding the bits they clear on exit to *puxBitsToClear.  Returns
+ * the union of the bits waited for by the tasks left in the list.  Called with
+ * the scheduler suspended.
+ */
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t *puxBitsToClear ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	/*
+	 * Return the list a task waiting for uxBitsToWaitFor is placed in.  A task
+	 * waiting for all of its bits is indexed under the lowest bit that is not
+	 * yet set, as the wait condition cannot be met until that bit is set.  A
+	 * task waiting for a single bit is indexed under that bit.  Only tasks
+	 * waiting for any one of several bits go in xTasksWaitingForBits.
+	 */
+	static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +175,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -149,7 +211,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -180,6 +242,10 @@ EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
 BaseType_t xAlreadyYielded;
 BaseType_t xTimeoutOccurred = pdFALSE;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xTicksBlocked = 0;
+#endif
+
 	configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 	configASSERT( uxBitsToWaitFor != 0 );
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -211,10 +277,17 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			{
 				traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor );
 
+				#if( configUSE_OBJECT_STATS == 1 )
+				{
+					xTicksBlocked = xTaskGetTickCount();
+				}
+				#endif
+
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				taskSET_BLOCK_REASON( eBlockEventGroup, pxEventBits );
+				vTaskPlaceOnUnorderedEventList( eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +317,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			xTicksBlocked = xTaskGetTickCount() - xTicksBlocked;
+		}
+		#endif
+
 		/* The task blocked to wait for its required bits to be set - at this
 		point either the required bits were set or the block time expired.  If
 		the required bits were set they will have been stored in the task's
@@ -284,6 +363,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 		uxReturn &= ~eventEVENT_BITS_CONTROL_BYTES;
 	}
 
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxEventBits->xStats ), queueSTATS_RECEIVE, ( xTimeoutOccurred == pdFALSE ) ? pdTRUE : pdFALSE, xTicksBlocked, ( UBaseType_t ) 0 );
+	}
+	#endif
+
 	traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred );
 
 	/* Prevent compiler warnings when trace macros are not used. */
@@ -300,6 +385,10 @@ EventBits_t uxReturn, uxControlBits = 0;
 BaseType_t xWaitConditionMet, xAlreadyYielded;
 BaseType_t xTimeoutOccurred = pdFALSE;
 
+#if( configUSE_OBJECT_STATS == 1 )
+	TickType_t xTicksBlocked = 0;
+#endif
+
 	/* Check the user is not attempting to wait on the bits used by the kernel
 	itself, and that at least one bit is being requested. */
 	configASSERT( xEventGroup );
@@ -369,7 +458,14 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			taskSET_BLOCK_REASON( eBlockEventGroup, pxEventBits );
+			vTaskPlaceOnUnorderedEventList( eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+
+			#if( configUSE_OBJECT_STATS == 1 )
+			{
+				xTicksBlocked = xTaskGetTickCount();
+			}
+			#endif
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -392,6 +488,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			xTicksBlocked = xTaskGetTickCount() - xTicksBlocked;
+		}
+		#endif
+
 		/* The task blocked to wait for its required bits to be set - at this
 		point either the required bits were set or the block time expired.  If
 		the required bits were set they will have been stored in the task's
@@ -434,6 +536,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 		/* The task blocked so control bits may have been set. */
 		uxReturn &= ~eventEVENT_BITS_CONTROL_BYTES;
 	}
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		vQueueStatsRecord( &( pxEventBits->xStats ), queueSTATS_RECEIVE, ( xTimeoutOccurred == pdFALSE ) ? pdTRUE : pdFALSE, xTicksBlocked, ( UBaseType_t ) 0 );
+	}
+	#endif
+
 	traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred );
 
 	/* Prevent compiler warnings when trace macros are not used. */
@@ -503,94 +611,82 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t *pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+EventBits_t uxBitsToClear = 0;
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
 		/* Set the bits. */
 		pxEventBits->uxEventBits |= uxBitsToSet;
 
 		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
+		#if( configUSE_EVENT_GROUP_INDEX == 1 )
 		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
-
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		UBaseType_t uxBit, uxBuckets = 0;
+
+			/* Only tasks waiting for any one of several bits that include a
+			bit being set, and tasks indexed in the buckets of the bits being
+			set, can have had their wait condition met.  The time the scheduler
+			is suspended for is therefore proportional to the number of those
+			tasks rather than to the number of tasks waiting on the group. */
+			if( ( pxEventBits->uxAnyBitsWaitedFor & uxBitsToSet ) != ( EventBits_t ) 0 )
 			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
+				pxEventBits->uxAnyBitsWaitedFor = prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear );
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
+				mtCOVERAGE_TEST_MARKER();
 			}
 
-			if( xMatchFound != pdFALSE )
+			for( uxBit = ( UBaseType_t ) 0U; ( uxBitsToSet >> uxBit ) != ( EventBits_t ) 0; uxBit++ )
 			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+				if( ( ( uxBitsToSet >> uxBit ) & ( EventBits_t ) 1U ) != ( EventBits_t ) 0 )
 				{
-					uxBitsToClear |= uxBitsWaitedFor;
+					uxBuckets |= ( UBaseType_t ) 1U << ( uxBit % ( UBaseType_t ) configEVENT_GROUP_INDEX_BUCKETS );
 				}
-				else
+			}
+
+			for( uxBit = ( UBaseType_t ) 0U; uxBit < ( UBaseType_t ) configEVENT_GROUP_INDEX_BUCKETS; uxBit++ )
+			{
+				if( ( uxBuckets & ( ( UBaseType_t ) 1U << uxBit ) ) != ( UBaseType_t ) 0 )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					( void ) prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForIndexedBits[ uxBit ] ), &uxBitsToClear );
 				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
 			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
 		}
+		#else
+		{
+			( void ) prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear );
+		}
+		#endif /* configUSE_EVENT_GROUP_INDEX */
 
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			vQueueStatsRecord( &( pxEventBits->xStats ), queueSTATS_SEND, pdTRUE, ( TickType_t ) 0, ( UBaseType_t ) 0 );
+		}
+		#endif
 	}
 	( void ) xTaskResumeAll();
 
+	#if( configUSE_CO_ROUTINE_HOST == 1 )
+	{
+		/* Co-routines cannot be placed in xTasksWaitingForBits, so let any
+		that are waiting re-evaluate the bits. */
+		vCoRoutineHostObjectChanged();
+	}
+	#endif
+
 	return pxEventBits->uxEventBits;
 }
 /*-----------------------------------------------------------*/
@@ -600,6 +696,12 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
 const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 
+	#if( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( xEventGroup );
+	}
+	#endif
+
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
@@ -612,6 +714,23 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
 		}
 
+		#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		{
+		UBaseType_t uxBucket;
+		const List_t *pxIndexedList;
+
+			for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configEVENT_GROUP_INDEX_BUCKETS; uxBucket++ )
+			{
+				pxIndexedList = &( pxEventBits->xTasksWaitingForIndexedBits[ uxBucket ] );
+
+				while( listCURRENT_LIST_LENGTH( pxIndexedList ) > ( UBaseType_t ) 0 )
+				{
+					vTaskRemoveFromUnorderedEventList( pxIndexedList->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_INDEX */
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -653,6 +772,185 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t *puxBitsToClear )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+EventBits_t uxBitsWaitedFor, uxControlBits, uxBitsRemaining = 0;
+BaseType_t xMatchFound;
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	List_t *pxWaitList;
+#endif
+
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	while( pxListItem != pxListEnd )
+	{
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			{
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set. */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+			{
+				*puxBitsToClear |= uxBitsWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+		}
+		else
+		{
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+				{
+					/* The bit the task was indexed under may now be set, in
+					which case index it under a bit that is still clear. */
+					pxWaitList = prvGetWaitList( pxEventBits, uxBitsWaitedFor, pdTRUE );
+
+					if( pxWaitList != pxList )
+					{
+						( void ) uxListRemove( pxListItem );
+						vListInsertEnd( pxWaitList, pxListItem );
+					}
+					else
+					{
+						uxBitsRemaining |= uxBitsWaitedFor;
+					}
+				}
+				else
+				{
+					uxBitsRemaining |= uxBitsWaitedFor;
+				}
+			}
+			#else
+			{
+				uxBitsRemaining |= uxBitsWaitedFor;
+			}
+			#endif /* configUSE_EVENT_GROUP_INDEX */
+		}
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list. */
+		pxListItem = pxNext;
+	}
+
+	return uxBitsRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits )
+{
+	vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	{
+	UBaseType_t uxBucket;
+
+		for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configEVENT_GROUP_INDEX_BUCKETS; uxBucket++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForIndexedBits[ uxBucket ] ) );
+		}
+
+		pxEventBits->uxAnyBitsWaitedFor = 0;
+	}
+	#endif /* configUSE_EVENT_GROUP_INDEX */
+
+	#if( configUSE_OBJECT_STATS == 1 )
+	{
+		( void ) memset( ( void * ) &( pxEventBits->xStats ), 0x00, sizeof( ObjectStats_t ) );
+	}
+	#endif /* configUSE_OBJECT_STATS */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
+	{
+	EventBits_t uxIndexBits;
+	UBaseType_t uxBit;
+	List_t *pxList;
+
+		if( xWaitForAllBits != pdFALSE )
+		{
+			uxIndexBits = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+
+			if( uxIndexBits == ( EventBits_t ) 0 )
+			{
+				/* Not expected as the condition would already be met. */
+				uxIndexBits = uxBitsToWaitFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			uxIndexBits = uxBitsToWaitFor;
+		}
+
+		if( ( xWaitForAllBits == pdFALSE ) && ( ( uxIndexBits & ( uxIndexBits - ( EventBits_t ) 1 ) ) != ( EventBits_t ) 0 ) )
+		{
+			/* Waiting for any one of several bits. */
+			pxEventBits->uxAnyBitsWaitedFor |= uxBitsToWaitFor;
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+		}
+		else
+		{
+			for( uxBit = ( UBaseType_t ) 0U; ( uxIndexBits & ( ( EventBits_t ) 1U << uxBit ) ) == ( EventBits_t ) 0; uxBit++ )
+			{
+				/* Find the lowest bit. */
+			}
+
+			pxList = &( pxEventBits->xTasksWaitingForIndexedBits[ uxBit % ( UBaseType_t ) configEVENT_GROUP_INDEX_BUCKETS ] );
+		}
+
+		return pxList;
+	}
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -703,6 +1001,45 @@ BaseType_t xWaitConditionMet = pdFALSE;
 #endif
 /*-----------------------------------------------------------*/
 
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+
+	void vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	{
+		configASSERT( xEventGroup );
+
+		#if( configUSE_OBJECT_STATS == 1 )
+		{
+			vQueueAddObjectToRegistry( xEventGroup, pcName, &( ( ( EventGroup_t * ) xEventGroup )->xStats ) );
+		}
+		#else
+		{
+			vQueueAddObjectToRegistry( xEventGroup, pcName, NULL );
+		}
+		#endif
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_OBJECT_STATS == 1 )
+
+	void vEventGroupGetStats( EventGroupHandle_t xEventGroup, ObjectStats_t *pxStats )
+	{
+	const EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+
+		configASSERT( xEventGroup );
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxEventBits->xStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_OBJECT_STATS */
+/*-----------------------------------------------------------*/
+
 #if (configUSE_TRACE_FACILITY == 1)
 
 	UBaseType_t uxEventGroupGetNumber( void* xEventGroup )
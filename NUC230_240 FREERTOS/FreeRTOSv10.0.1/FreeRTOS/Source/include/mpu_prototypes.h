@@ -42,10 +42,20 @@ BaseType_t MPU_xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName
 TaskHandle_t MPU_xTaskCreateStatic( TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer );
 BaseType_t MPU_xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask );
 BaseType_t MPU_xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask );
+TaskPoolHandle_t MPU_xTaskPoolCreate( UBaseType_t uxTasks, const configSTACK_DEPTH_TYPE usStackDepth );
+BaseType_t MPU_xTaskCreateFromPool( TaskPoolHandle_t xPool, TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask );
+UBaseType_t MPU_uxTaskPoolGetFree( TaskPoolHandle_t xPool );
+UBaseType_t MPU_uxTaskPoolGetMinimumEverFree( TaskPoolHandle_t xPool );
 void MPU_vTaskAllocateMPURegions( TaskHandle_t xTask, const MemoryRegion_t * const pxRegions );
 void MPU_vTaskDelete( TaskHandle_t xTaskToDelete );
 void MPU_vTaskDelay( const TickType_t xTicksToDelay );
 void MPU_vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement );
+void MPU_vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod );
+void MPU_vTaskGetDeadlineStats( TaskHandle_t xTask, uint32_t *pulJobsCompleted, uint32_t *pulDeadlinesMissed );
+void MPU_vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction );
+void MPU_vTaskGetBudgetStats( TaskHandle_t xTask, TaskBudgetStats_t *pxStats );
+void MPU_vTaskSetTimeSliceQuantum( TaskHandle_t xTask, UBaseType_t uxQuantum );
+UBaseType_t MPU_uxTaskGetTimeSliceQuantum( TaskHandle_t xTask );
 BaseType_t MPU_xTaskAbortDelay( TaskHandle_t xTask );
 UBaseType_t MPU_uxTaskPriorityGet( TaskHandle_t xTask );
 eTaskState MPU_eTaskGetState( TaskHandle_t xTask );
@@ -61,6 +71,8 @@ UBaseType_t MPU_uxTaskGetNumberOfTasks( void );
 char * MPU_pcTaskGetName( TaskHandle_t xTaskToQuery );
 TaskHandle_t MPU_xTaskGetHandle( const char *pcNameToQuery );
 UBaseType_t MPU_uxTaskGetStackHighWaterMark( TaskHandle_t xTask );
+UBaseType_t MPU_uxTaskGetStackReport( TaskStackReport_t * const pxReportArray, const UBaseType_t uxArraySize );
+void MPU_vTaskGetBlockingStats( TaskHandle_t xTask, TaskBlockingStats_t *pxStats );
 void MPU_vTaskSetApplicationTaskTag( TaskHandle_t xTask, TaskHookFunction_t pxHookFunction );
 TaskHookFunction_t MPU_xTaskGetApplicationTaskTag( TaskHandle_t xTask );
 void MPU_vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue );
@@ -69,11 +81,13 @@ BaseType_t MPU_xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParamet
 TaskHandle_t MPU_xTaskGetIdleTaskHandle( void );
 UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime );
 void MPU_vTaskList( char * pcWriteBuffer );
+void MPU_vTaskSnapshotStart( TaskSnapshot_t *pxSnapshot );
+eSnapshotResult MPU_eTaskSnapshotNext( TaskSnapshot_t *pxSnapshot, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace );
 void MPU_vTaskGetRunTimeStats( char *pcWriteBuffer );
-BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue );
-BaseType_t MPU_xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
-uint32_t MPU_ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
-BaseType_t MPU_xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue );
+BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
+uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
+BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear );
 BaseType_t MPU_xTaskIncrementTick( void );
 TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void );
 void MPU_vTaskSetTimeOutState( TimeOut_t * const pxTimeOut );
@@ -106,6 +120,8 @@ BaseType_t MPU_xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore, QueueSe
 BaseType_t MPU_xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet );
 QueueSetMemberHandle_t MPU_xQueueSelectFromSet( QueueSetHandle_t xQueueSet, const TickType_t xTicksToWait );
 BaseType_t MPU_xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue );
+void MPU_vQueueGetStats( QueueHandle_t xQueue, ObjectStats_t *pxStats );
+UBaseType_t MPU_uxQueueGetRegistryStats( QueueRegistryStats_t *pxStatsArray, const UBaseType_t uxArraySize );
 void MPU_vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber );
 UBaseType_t MPU_uxQueueGetQueueNumber( QueueHandle_t xQueue );
 uint8_t MPU_ucQueueGetQueueType( QueueHandle_t xQueue );
@@ -132,6 +148,8 @@ EventBits_t MPU_xEventGroupClearBits( EventGroupHandle_t xEventGroup, const Even
 EventBits_t MPU_xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet );
 EventBits_t MPU_xEventGroupSync( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, const EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait );
 void MPU_vEventGroupDelete( EventGroupHandle_t xEventGroup );
+void MPU_vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName );
+void MPU_vEventGroupGetStats( EventGroupHandle_t xEventGroup, ObjectStats_t *pxStats );
 UBaseType_t MPU_uxEventGroupGetNumber( void* xEventGroup );
 
 /* MPU versions of message/stream_buffer.h API functions. */
@@ -148,6 +166,8 @@ size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
 BaseType_t MPU_xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel );
 StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer );
 StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer );
+void MPU_vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName );
+void MPU_vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, ObjectStats_t *pxStats );
 
 
 
@@ -122,6 +122,89 @@ typedef struct HeapRegion
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Used by heap_5.c when configUSE_HEAP_REGION_STATS is set to 1. */
+typedef struct HeapRegionStats
+{
+	uint8_t *pucStartAddress;				/* Aligned start address of the region. */
+	size_t xRegionSizeInBytes;				/* Bytes available for allocation once alignment and the end marker are accounted for. */
+	size_t xFreeBytesRemaining;				/* Bytes currently free within the region. */
+	size_t xMinimumEverFreeBytesRemaining;	/* Low water mark of xFreeBytesRemaining. */
+	size_t xNumberOfSuccessfulAllocations;	/* Blocks handed out from the region. */
+	size_t xNumberOfSuccessfulFrees;		/* Blocks returned to the region. */
+} HeapRegionStats_t;
+
+/*
+ * Obtain the statistics for a single heap region defined by a call to
+ * vPortDefineHeapRegions().  Regions are indexed from 0 in the order they
+ * appeared in the array passed to vPortDefineHeapRegions().  Returns pdFAIL if
+ * uxRegion does not reference a defined region.
+ */
+UBaseType_t uxPortGetHeapRegionCount( void ) PRIVILEGED_FUNCTION;
+BaseType_t xPortGetHeapRegionStats( UBaseType_t uxRegion, HeapRegionStats_t *pxRegionStats ) PRIVILEGED_FUNCTION;
+
+
+/* Used by heap_stats.c when configUSE_HEAP_STATS is set to 1. */
+typedef struct HeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;		/* Total free bytes, as returned by xPortGetFreeHeapSize(). */
+	size_t xNumberOfFreeBlocks;				/* Number of blocks on the allocator's free list. */
+	size_t xLargestFreeBlockLowerBound;		/* The largest free block is at least this big, and less than twice this big. */
+	UBaseType_t uxFragmentationIndex;		/* Parts per thousand of the free space held outside the largest size class present. */
+	size_t xNumberOfSuccessfulAllocations;
+	size_t xNumberOfSuccessfulFrees;
+	size_t xFreeBlocksInClass[ configHEAP_STATS_SIZE_CLASSES ];	/* Free blocks of ( 16 << n ) to ( 32 << n ) - 1 bytes. */
+} HeapStats_t;
+
+typedef struct HeapTaskStats
+{
+	void *pvTask;							/* Handle of the owning task.  NULL for allocations made before the scheduler started, by tasks since deleted, or that did not fit in the table. */
+	BaseType_t xOwnerDeleted;				/* pdTRUE if the owner was deleted while still owning memory. */
+	size_t xBytesOutstanding;				/* Bytes allocated and not yet freed. */
+	size_t xPeakBytesOutstanding;			/* High water mark of xBytesOutstanding. */
+	size_t xBlocksOutstanding;				/* Blocks allocated and not yet freed. */
+} HeapTaskStats_t;
+
+typedef struct HeapAllocationRecord
+{
+	void *pvAddress;						/* Address returned by pvPortMalloc(). */
+	size_t xRequestedSize;					/* Size passed to pvPortMalloc(). */
+	void *pvCaller;							/* Return address of the pvPortMalloc() call. */
+	void *pvTask;							/* Handle of the owning task, as per HeapTaskStats_t. */
+	uint32_t ulSequence;					/* Allocation sequence number. */
+} HeapAllocationRecord_t;
+
+/*
+ * Heap instrumentation.  Every function executes in a time bounded by
+ * configHEAP_STATS_SIZE_CLASSES, configHEAP_STATS_MAX_TASKS or its uxArraySize
+ * or uxMaxRecords parameter, regardless of the state of the heap.
+ *
+ * vPortGetHeapStats() fills in the free block histogram, fragmentation index
+ * and allocation counters.
+ *
+ * uxPortGetHeapTaskStats() writes one entry per task that owns heap memory and
+ * returns the number of entries written.
+ *
+ * ulPortHeapStatsMark() and uxPortHeapStatsGetAllocationsSince() are only
+ * available when configHEAP_STATS_TRACK_CALLERS is 1.  The second writes, most
+ * recent first, the allocations made since the mark was taken that have not
+ * been freed - a leak snapshot.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+UBaseType_t uxPortGetHeapTaskStats( HeapTaskStats_t *pxTaskStatsArray, UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+size_t xPortGetHeapBytesOwnedByTask( void *pvTask ) PRIVILEGED_FUNCTION;
+uint32_t ulPortHeapStatsMark( void ) PRIVILEGED_FUNCTION;
+UBaseType_t uxPortHeapStatsGetAllocationsSince( uint32_t ulMark, HeapAllocationRecord_t *pxRecords, UBaseType_t uxMaxRecords ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the allocators and the kernel to keep the heap statistics up to
+ * date - not for use by the application.
+ */
+extern const size_t xHeapStatsTagSize;
+void vPortHeapStatsFreeBlockAdded( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+void vPortHeapStatsFreeBlockRemoved( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+void *pvPortHeapStatsBlockAllocated( void *pvBlock, size_t xRequestedSize, void *pvCaller ) PRIVILEGED_FUNCTION;
+void *pvPortHeapStatsBlockFreed( void *pv ) PRIVILEGED_FUNCTION;
+void vPortHeapStatsTaskDeleted( void *pvTask ) PRIVILEGED_FUNCTION;
 
 /*
  * Map to the memory management routines required for the port.
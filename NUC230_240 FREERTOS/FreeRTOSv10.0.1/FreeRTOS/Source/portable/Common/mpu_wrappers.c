@@ -107,6 +107,58 @@ extern BaseType_t xPortRaisePrivilege( void );
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_POOLS == 1 )
+	TaskPoolHandle_t MPU_xTaskPoolCreate( UBaseType_t uxTasks, const configSTACK_DEPTH_TYPE usStackDepth )
+	{
+	TaskPoolHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xTaskPoolCreate( uxTasks, usStackDepth );
+		vPortResetPrivilege( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+	BaseType_t MPU_xTaskCreateFromPool( TaskPoolHandle_t xPool, TaskFunction_t pxTaskCode, const char * const pcName, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask )
+	{
+	BaseType_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xTaskCreateFromPool( xPool, pxTaskCode, pcName, pvParameters, uxPriority, pxCreatedTask );
+		vPortResetPrivilege( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+	UBaseType_t MPU_uxTaskPoolGetFree( TaskPoolHandle_t xPool )
+	{
+	UBaseType_t uxReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		uxReturn = uxTaskPoolGetFree( xPool );
+		vPortResetPrivilege( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_POOLS == 1 )
+	UBaseType_t MPU_uxTaskPoolGetMinimumEverFree( TaskPoolHandle_t xPool )
+	{
+	UBaseType_t uxReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		uxReturn = uxTaskPoolGetMinimumEverFree( xPool );
+		vPortResetPrivilege( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 void MPU_vTaskAllocateMPURegions( TaskHandle_t xTask, const MemoryRegion_t * const xRegions )
 {
 BaseType_t xRunningPrivileged = xPortRaisePrivilege();
@@ -138,6 +190,74 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	void MPU_vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskSetDeadline( xTask, xRelativeDeadline, xPeriod );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	void MPU_vTaskGetDeadlineStats( TaskHandle_t xTask, uint32_t *pulJobsCompleted, uint32_t *pulDeadlinesMissed )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskGetDeadlineStats( xTask, pulJobsCompleted, pulDeadlinesMissed );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+	void MPU_vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskSetBudget( xTask, ulBudget, xPeriod, eAction );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+	void MPU_vTaskGetBudgetStats( TaskHandle_t xTask, TaskBudgetStats_t *pxStats )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskGetBudgetStats( xTask, pxStats );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+	void MPU_vTaskSetTimeSliceQuantum( TaskHandle_t xTask, UBaseType_t uxQuantum )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskSetTimeSliceQuantum( xTask, uxQuantum );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+	UBaseType_t MPU_uxTaskGetTimeSliceQuantum( TaskHandle_t xTask )
+	{
+	UBaseType_t uxReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		uxReturn = uxTaskGetTimeSliceQuantum( xTask );
+		vPortResetPrivilege( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskAbortDelay == 1 )
 	BaseType_t MPU_xTaskAbortDelay( TaskHandle_t xTask )
 	{
@@ -322,6 +442,30 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+	void MPU_vTaskSnapshotStart( TaskSnapshot_t *pxSnapshot )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskSnapshotStart( pxSnapshot );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOT == 1 )
+	eSnapshotResult MPU_eTaskSnapshotNext( TaskSnapshot_t *pxSnapshot, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace )
+	{
+	eSnapshotResult eReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		eReturn = eTaskSnapshotNext( pxSnapshot, pxTaskStatus, xGetFreeStackSpace );
+		vPortResetPrivilege( xRunningPrivileged );
+		return eReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 	void MPU_vTaskGetRunTimeStats( char *pcWriteBuffer )
 	{
@@ -420,6 +564,30 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STACK_WATERMARK == 1 )
+	UBaseType_t MPU_uxTaskGetStackReport( TaskStackReport_t * const pxReportArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		uxReturn = uxTaskGetStackReport( pxReportArray, uxArraySize );
+		vPortResetPrivilege( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BLOCKING_STATS == 1 )
+	void MPU_vTaskGetBlockingStats( TaskHandle_t xTask, TaskBlockingStats_t *pxStats )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vTaskGetBlockingStats( xTask, pxStats );
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetCurrentTaskHandle == 1 )
 	TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void )
 	{
@@ -467,12 +635,12 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 /*-----------------------------------------------------------*/
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
-	BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	BaseType_t xReturn;
 	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 
-		xReturn = xTaskGenericNotify( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue );
+		xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
 		vPortResetPrivilege( xRunningPrivileged );
 		return xReturn;
 	}
@@ -480,12 +648,12 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 /*-----------------------------------------------------------*/
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
-	BaseType_t MPU_xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 
-		xReturn = xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
+		xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
 		vPortResetPrivilege( xRunningPrivileged );
 		return xReturn;
 	}
@@ -493,12 +661,12 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 /*-----------------------------------------------------------*/
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
-	uint32_t MPU_ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 
-		ulReturn = ulTaskNotifyTake( xClearCountOnExit, xTicksToWait );
+		ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait );
 		vPortResetPrivilege( xRunningPrivileged );
 		return ulReturn;
 	}
@@ -506,12 +674,12 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 /*-----------------------------------------------------------*/
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
-	BaseType_t MPU_xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	BaseType_t xReturn;
 	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 
-		xReturn = xTaskNotifyStateClear( xTask );
+		xReturn = xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
 		vPortResetPrivilege( xRunningPrivileged );
 		return xReturn;
 	}
@@ -812,6 +980,32 @@ void * xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_STATS == 1 )
+	void MPU_vQueueGetStats( QueueHandle_t xQueue, ObjectStats_t *pxStats )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vQueueGetStats( xQueue, pxStats );
+
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_OBJECT_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	UBaseType_t MPU_uxQueueGetRegistryStats( QueueRegistryStats_t *pxStatsArray, const UBaseType_t uxArraySize )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+	UBaseType_t uxReturn;
+
+		uxReturn = uxQueueGetRegistryStats( pxStatsArray, uxArraySize );
+
+		vPortResetPrivilege( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 void MPU_vQueueDelete( QueueHandle_t xQueue )
 {
 BaseType_t xRunningPrivileged = xPortRaisePrivilege();
@@ -1112,6 +1306,30 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 }
 /*-----------------------------------------------------------*/
 
+#if configQUEUE_REGISTRY_SIZE > 0
+	void MPU_vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vEventGroupAddToRegistry( xEventGroup, pcName );
+
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_STATS == 1 )
+	void MPU_vEventGroupGetStats( EventGroupHandle_t xEventGroup, ObjectStats_t *pxStats )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vEventGroupGetStats( xEventGroup, pxStats );
+
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait )
 {
 size_t xReturn;
@@ -1269,6 +1487,30 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if configQUEUE_REGISTRY_SIZE > 0
+	void MPU_vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vStreamBufferAddToRegistry( xStreamBuffer, pcName );
+
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_STATS == 1 )
+	void MPU_vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, ObjectStats_t *pxStats )
+	{
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		vStreamBufferGetStats( xStreamBuffer, pxStats );
+
+		vPortResetPrivilege( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
 can be defined in application_defined_privileged_functions.h.  The functions
@@ -69,6 +69,19 @@
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
 
+/* heap_5 definitions.  The Keil project holds heap_5.c, left out of the
+build, and heap_regions.c.  Set configUSE_HEAP_REGIONS to 1 and build heap_5.c
+instead of heap_2.c to make the heap of all SRAM the linker leaves unused;
+configTOTAL_HEAP_SIZE is then ignored.
+configHEAP_SRAM_SIZE must match the IRAM1 size of the Keil target. */
+#define configUSE_HEAP_REGIONS			0
+#define configUSE_HEAP_REGION_STATS		1
+#define configHEAP_SRAM_SIZE			( 0x4000 )
+
+/* Bytes of external SRAM on the EBI bus to add as a second heap region, or 0
+to leave the EBI unused. */
+#define configHEAP_EBI_SIZE				( 0 )
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 			0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
@@ -13,6 +13,10 @@
 #include "timers.h"
 #include "semphr.h"
 
+#if (configUSE_HEAP_REGIONS == 1)
+extern void vHeapRegionsInit(void);
+#endif
+
 
 void Task0(void *pvParameters)
 {
@@ -40,6 +44,10 @@ void Task1(void *pvParameters)
 
 int main()
 {
+#if (configUSE_HEAP_REGIONS == 1)
+    /* Must run before the first object is created. */
+    vHeapRegionsInit();
+#endif
     xTaskCreate(Task0, (const char *)"Task0", 100, NULL, 1, NULL);
     xTaskCreate(Task1, (const char *)"Task1", 100, NULL, 2, NULL);
     vTaskStartScheduler();
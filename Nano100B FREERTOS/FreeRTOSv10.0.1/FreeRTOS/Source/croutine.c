@@ -32,6 +32,10 @@
 /* Remove the whole file is co-routines are not being used. */
 #if( configUSE_CO_ROUTINES != 0 )
 
+#if( ( configUSE_CO_ROUTINE_HOST == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to use the co-routine host task.
+#endif
+
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
  * than file scope.
@@ -54,6 +58,13 @@ CRCB_t * pxCurrentCoRoutine = NULL;
 static UBaseType_t uxTopCoRoutineReadyPriority = 0;
 static TickType_t xCoRoutineTickCount = 0, xLastTickCount = 0, xPassedTicks = 0;
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+	static List_t xConditionWaitingCoRoutineList;				/*< Co-routines blocked in crWAIT_UNTIL().  Only accessed by the host task. */
+	static TaskHandle_t xCoRoutineHostTask = NULL;				/*< The task that runs the co-routines. */
+	static volatile UBaseType_t uxCoRoutinesInWait = 0;		/*< Number of co-routines between vCoRoutineBeginWait() and vCoRoutineEndWait(). */
+	static volatile BaseType_t xConditionEventPending = pdFALSE;	/*< Set when the co-routines in xConditionWaitingCoRoutineList must re-evaluate their conditions. */
+#endif
+
 /* The initial state of the co-routine when it is created. */
 #define corINITIAL_STATE	( 0 )
 
@@ -97,6 +108,35 @@ static void prvCheckPendingReadyList( void );
  */
 static void prvCheckDelayedList( void );
 
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+
+	/*
+	 * The host task.  Runs co-routines until none are ready, then blocks on its
+	 * task notification until the next co-routine delay expires or the host is
+	 * woken by an event.
+	 */
+	static portTASK_FUNCTION_PROTO( prvCoRoutineHostTask, pvParameters );
+
+	/*
+	 * Move every co-routine blocked in crWAIT_UNTIL() to its ready list so
+	 * the condition it is waiting for is evaluated again.
+	 */
+	static void prvReleaseConditionWaiters( void );
+
+	/*
+	 * Returns pdTRUE if a co-routine is ready to run or has been readied by an
+	 * interrupt, otherwise pdFALSE.
+	 */
+	static BaseType_t prvCoRoutineReady( void );
+
+	/*
+	 * Returns the number of ticks the host task can block before the delay of
+	 * a co-routine expires.
+	 */
+	static TickType_t prvGetHostBlockTime( void );
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+
 /*-----------------------------------------------------------*/
 
 BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex )
@@ -128,6 +168,14 @@ CRCB_t *pxCoRoutine;
 		pxCoRoutine->uxIndex = uxIndex;
 		pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
 
+		#if( configUSE_CO_ROUTINE_HOST == 1 )
+		{
+			pxCoRoutine->xWaitStartTime = 0;
+			pxCoRoutine->xTicksToWait = 0;
+			pxCoRoutine->ulNotifiedValue = 0UL;
+		}
+		#endif
+
 		/* Initialise all the other co-routine control block parameters. */
 		vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
 		vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
@@ -318,6 +366,12 @@ UBaseType_t uxPriority;
 	vListInitialise( ( List_t * ) &xDelayedCoRoutineList2 );
 	vListInitialise( ( List_t * ) &xPendingReadyCoRoutineList );
 
+	#if( configUSE_CO_ROUTINE_HOST == 1 )
+	{
+		vListInitialise( &xConditionWaitingCoRoutineList );
+	}
+	#endif
+
 	/* Start with pxDelayedCoRoutineList using list1 and the
 	pxOverflowDelayedCoRoutineList using list2. */
 	pxDelayedCoRoutineList = &xDelayedCoRoutineList1;
@@ -346,8 +400,307 @@ BaseType_t xReturn;
 		xReturn = pdFALSE;
 	}
 
+	#if( configUSE_CO_ROUTINE_HOST == 1 )
+	{
+		/* The pending ready list is only checked when the host task runs.
+		This is called with interrupts masked, either from an ISR or from a
+		co-routine, so the interrupt safe API is used.  No yield is requested
+		directly as the queue co-routine API does not provide a way to pass
+		one back to the ISR - xYieldPending is set instead. */
+		if( xCoRoutineHostTask != NULL )
+		{
+			vTaskNotifyGiveFromISR( xCoRoutineHostTask, NULL );
+		}
+	}
+	#endif
+
 	return xReturn;
 }
 
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CO_ROUTINE_HOST == 1 )
+
+	BaseType_t xCoRoutineHostCreate( configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority )
+	{
+	BaseType_t xReturn;
+
+		/* Only one host task can exist. */
+		configASSERT( xCoRoutineHostTask == NULL );
+
+		xReturn = xTaskCreate( prvCoRoutineHostTask, "CoR", usStackDepth, NULL, uxPriority, &xCoRoutineHostTask );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static portTASK_FUNCTION( prvCoRoutineHostTask, pvParameters )
+	{
+		/* Just to avoid compiler warnings. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			if( xConditionEventPending != pdFALSE )
+			{
+				/* Clear the flag before releasing the waiters so an event that
+				occurs while they are being released is not lost. */
+				xConditionEventPending = pdFALSE;
+				prvReleaseConditionWaiters();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			vCoRoutineSchedule();
+
+			if( prvCoRoutineReady() == pdFALSE )
+			{
+				/* Nothing to run.  Anything that readies a co-routine after this
+				point also notifies this task, so the notification is not
+				missed even though it may arrive before the task blocks. */
+				( void ) ulTaskNotifyTake( pdTRUE, prvGetHostBlockTime() );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseConditionWaiters( void )
+	{
+	CRCB_t *pxCRCB;
+
+		/* The condition waiting list is only accessed by the host task, so no
+		critical section is needed. */
+		while( listLIST_IS_EMPTY( &xConditionWaitingCoRoutineList ) == pdFALSE )
+		{
+			pxCRCB = ( CRCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xConditionWaitingCoRoutineList );
+			( void ) uxListRemove( &( pxCRCB->xEventListItem ) );
+
+			/* Co-routines waiting without a timeout are not in a delayed
+			list. */
+			if( listLIST_ITEM_CONTAINER( &( pxCRCB->xGenericListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxCRCB->xGenericListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddCoRoutineToReadyQueue( pxCRCB );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCoRoutineReady( void )
+	{
+	UBaseType_t uxPriority;
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( listLIST_IS_EMPTY( &xPendingReadyCoRoutineList ) == pdFALSE ) || ( xConditionEventPending != pdFALSE ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			for( uxPriority = 0; uxPriority < configMAX_CO_ROUTINE_PRIORITIES; uxPriority++ )
+			{
+				if( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxPriority ] ) ) == pdFALSE )
+				{
+					xReturn = pdTRUE;
+					break;
+				}
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvGetHostBlockTime( void )
+	{
+	TickType_t xTicksToNextWake, xTicksSinceCheck;
+
+		/* xCoRoutineTickCount was brought up to date by the last call to
+		vCoRoutineSchedule(), but the co-routine that ran since then may have
+		taken some time, which is accounted for below. */
+		if( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+		{
+			xTicksToNextWake = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedCoRoutineList ) - xCoRoutineTickCount;
+		}
+		else if( listLIST_IS_EMPTY( pxOverflowDelayedCoRoutineList ) == pdFALSE )
+		{
+			/* The lists are swapped when the tick count overflows, so wake
+			then to look again. */
+			xTicksToNextWake = ( TickType_t ) 0 - xCoRoutineTickCount;
+		}
+		else
+		{
+			return portMAX_DELAY;
+		}
+
+		xTicksSinceCheck = xTaskGetTickCount() - xCoRoutineTickCount;
+
+		if( xTicksSinceCheck >= xTicksToNextWake )
+		{
+			xTicksToNextWake = 0;
+		}
+		else
+		{
+			xTicksToNextWake -= xTicksSinceCheck;
+		}
+
+		return xTicksToNextWake;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vCoRoutineBeginWait( TickType_t xTicksToWait )
+	{
+		pxCurrentCoRoutine->xWaitStartTime = xCoRoutineTickCount;
+		pxCurrentCoRoutine->xTicksToWait = xTicksToWait;
+
+		/* Counted before the condition is first evaluated so a state change
+		that occurs between the evaluation and the co-routine blocking is not
+		missed. */
+		uxCoRoutinesInWait++;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xCoRoutineWaitForCondition( void )
+	{
+	TickType_t xTicksPassed;
+	BaseType_t xReturn = pdTRUE;
+
+		if( pxCurrentCoRoutine->xTicksToWait == portMAX_DELAY )
+		{
+			/* Wait without a timeout, so remove the co-routine from its ready
+			list without placing it in a delayed list. */
+			( void ) uxListRemove( &( pxCurrentCoRoutine->xGenericListItem ) );
+		}
+		else
+		{
+			xTicksPassed = xCoRoutineTickCount - pxCurrentCoRoutine->xWaitStartTime;
+
+			if( xTicksPassed >= pxCurrentCoRoutine->xTicksToWait )
+			{
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				vCoRoutineAddToDelayedList( pxCurrentCoRoutine->xTicksToWait - xTicksPassed, NULL );
+			}
+		}
+
+		if( xReturn != pdFALSE )
+		{
+			/* The event list item is otherwise unused while the co-routine is
+			not blocked on a queue. */
+			vListInsertEnd( &xConditionWaitingCoRoutineList, &( pxCurrentCoRoutine->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vCoRoutineEndWait( void )
+	{
+		configASSERT( uxCoRoutinesInWait > ( UBaseType_t ) 0 );
+		uxCoRoutinesInWait--;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet )
+	{
+	CRCB_t *pxCRCB = ( CRCB_t * ) xCoRoutine;
+
+		configASSERT( pxCRCB );
+
+		taskENTER_CRITICAL();
+		{
+			pxCRCB->ulNotifiedValue |= ulBitsToSet;
+		}
+		taskEXIT_CRITICAL();
+
+		vCoRoutineHostObjectChanged();
+
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	CRCB_t *pxCRCB = ( CRCB_t * ) xCoRoutine;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( pxCRCB );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxCRCB->ulNotifiedValue |= ulBitsToSet;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		vCoRoutineHostObjectChangedFromISR( pxHigherPriorityTaskWoken );
+
+		return pdPASS;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulCoRoutineNotifyTake( CoRoutineHandle_t xCoRoutine )
+	{
+	CRCB_t *pxCRCB = ( CRCB_t * ) xCoRoutine;
+	uint32_t ulReturn;
+
+		taskENTER_CRITICAL();
+		{
+			ulReturn = pxCRCB->ulNotifiedValue;
+			pxCRCB->ulNotifiedValue = 0UL;
+		}
+		taskEXIT_CRITICAL();
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vCoRoutineHostObjectChanged( void )
+	{
+		/* Kept cheap for the common case of no co-routine waiting, as this is
+		called on every stream buffer transfer and event group update. */
+		if( ( uxCoRoutinesInWait != ( UBaseType_t ) 0 ) && ( xCoRoutineHostTask != NULL ) )
+		{
+			xConditionEventPending = pdTRUE;
+			( void ) xTaskNotifyGive( xCoRoutineHostTask );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vCoRoutineHostObjectChangedFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+	{
+		if( ( uxCoRoutinesInWait != ( UBaseType_t ) 0 ) && ( xCoRoutineHostTask != NULL ) )
+		{
+			xConditionEventPending = pdTRUE;
+			vTaskNotifyGiveFromISR( xCoRoutineHostTask, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+
 #endif /* configUSE_CO_ROUTINES == 0 */
 
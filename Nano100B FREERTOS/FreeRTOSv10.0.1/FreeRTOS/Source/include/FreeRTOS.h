@@ -58,6 +58,14 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before portable.h is included as it sizes HeapStats_t. */
+#ifndef configHEAP_STATS_SIZE_CLASSES
+	/* Number of power of two size classes in the free block histogram.  The
+	first class holds blocks below 32 bytes, the last every block of
+	( 16 << ( configHEAP_STATS_SIZE_CLASSES - 1 ) ) bytes or more. */
+	#define configHEAP_STATS_SIZE_CLASSES 12
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -182,6 +190,14 @@ extern "C" {
 	#endif
 #endif
 
+#ifndef configUSE_CO_ROUTINE_HOST
+	#define configUSE_CO_ROUTINE_HOST 0
+#endif
+
+#if( ( configUSE_CO_ROUTINE_HOST == 1 ) && ( configUSE_CO_ROUTINES == 0 ) )
+	#error configUSE_CO_ROUTINES must be set to 1 to use the co-routine host task.
+#endif
+
 #ifndef configUSE_DAEMON_TASK_STARTUP_HOOK
 	#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 #endif
@@ -500,6 +516,14 @@ extern "C" {
 	#define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	#define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+	#define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
@@ -806,6 +830,12 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	/* Number of notification values each task has.  The API functions without
+	an index use index 0. */
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -826,6 +856,242 @@ extern "C" {
 	#define configSTACK_DEPTH_TYPE uint16_t
 #endif
 
+#ifndef configUSE_HEAP_REGION_STATS
+	/* Set to 1 to have heap_5.c keep free space statistics for each of the
+	regions passed to vPortDefineHeapRegions(). */
+	#define configUSE_HEAP_REGION_STATS 0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+	/* The maximum number of regions heap_5.c can keep statistics for.  Only
+	used when configUSE_HEAP_REGION_STATS is 1. */
+	#define configHEAP_MAX_REGIONS 4
+#endif
+
+#ifndef configUSE_HEAP_STATS
+	/* Set to 1 to build heap_stats.c into heap_2.c, heap_4.c or heap_5.c. */
+	#define configUSE_HEAP_STATS 0
+#endif
+
+#ifndef configHEAP_STATS_MAX_TASKS
+	/* Number of tasks heap usage can be attributed to, plus one. */
+	#define configHEAP_STATS_MAX_TASKS 8
+#endif
+
+#ifndef configHEAP_STATS_TRACK_CALLERS
+	/* Set to 1 to tag each allocation with the caller's return address so leak
+	snapshots can be taken. */
+	#define configHEAP_STATS_TRACK_CALLERS 0
+#endif
+
+#ifndef configHEAP_STATS_GET_CALLER
+	/* Return address of the pvPortMalloc() call, recorded when
+	configHEAP_STATS_TRACK_CALLERS is 1. */
+	#if defined( __CC_ARM )
+		#define configHEAP_STATS_GET_CALLER() ( ( void * ) __return_address() )
+	#elif defined( __GNUC__ )
+		#define configHEAP_STATS_GET_CALLER() __builtin_return_address( 0 )
+	#else
+		#define configHEAP_STATS_GET_CALLER() NULL
+	#endif
+#endif
+
+#ifndef configAO_MAX_ACTIVE
+	/* Number of active objects, and so of active object priorities, that
+	active_object.c can manage.  Must be 32 or less. */
+	#define configAO_MAX_ACTIVE 8
+#endif
+
+#ifndef configAO_MAX_POOLS
+	/* Number of event pools that can be passed to xAOPoolInit(). */
+	#define configAO_MAX_POOLS 3
+#endif
+
+#ifndef configAO_MAX_PUB_SIGNAL
+	/* Signals below this value can be published with vAOPublish(). */
+	#define configAO_MAX_PUB_SIGNAL 16
+#endif
+
+#ifndef configAO_MEASURE_LATENCY
+	/* Set to 1 to time stamp every posted event and record the post to
+	dispatch latency of each active object. */
+	#define configAO_MEASURE_LATENCY 0
+#endif
+
+#ifndef configAO_GET_TIMESTAMP
+	/* Time base used when configAO_MEASURE_LATENCY is 1.  Map this onto a free
+	running hardware timer for sub-tick resolution. */
+	#define configAO_GET_TIMESTAMP() ( ( uint32_t ) xTaskGetTickCountFromISR() )
+#endif
+
+#ifndef configUSE_TIMER_HEAP
+	/* Set to 1 to keep active software timers in a binary heap, making timer
+	commands O(log n) instead of O(n) in the number of active timers. */
+	#define configUSE_TIMER_HEAP 0
+#endif
+
+#ifndef configTIMER_HEAP_LENGTH
+	/* Maximum number of software timers that can exist at once when
+	configUSE_TIMER_HEAP is 1, so that every timer always fits in the heap.
+	xTimerCreate() and xTimerCreateStatic() return NULL once this many timers
+	exist. */
+	#define configTIMER_HEAP_LENGTH 16
+#endif
+
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	/* Set to 1 to let tasks update the active timer lists directly, with the
+	scheduler suspended, rather than always sending commands to the timer
+	service task. */
+	#define configUSE_TIMER_DIRECT_COMMANDS 0
+#endif
+
+#ifndef configUSE_TIMER_STATS
+	/* Set to 1 to record callback execution time and lateness for each
+	software timer, and command queue usage for the timer service task. */
+	#define configUSE_TIMER_STATS 0
+#endif
+
+#ifndef configUSE_TIMER_OVERRUN_HOOK
+	#define configUSE_TIMER_OVERRUN_HOOK 0
+#endif
+
+#ifndef configTIMER_STATS_GET_TIME
+	/* Time base for timer callback execution times.  Map this onto a free
+	running hardware timer for sub-tick resolution. */
+	#define configTIMER_STATS_GET_TIME() ( ( uint32_t ) xTaskGetTickCount() )
+#endif
+
+#ifndef configUSE_EVENT_GROUP_INDEX
+	/* Set to 1 to index tasks blocked on an event group by the bits they wait
+	for, so setting bits only examines the tasks that can be unblocked by them
+	rather than every task waiting on the group. */
+	#define configUSE_EVENT_GROUP_INDEX 0
+#endif
+
+#ifndef configEVENT_GROUP_INDEX_BUCKETS
+	/* Number of index lists per event group when configUSE_EVENT_GROUP_INDEX
+	is 1.  Event bit n is indexed in list ( n % configEVENT_GROUP_INDEX_BUCKETS ),
+	so there can be no more lists than event bits: 8 when configUSE_16_BIT_TICKS
+	is 1, otherwise 24. */
+	#define configEVENT_GROUP_INDEX_BUCKETS 8
+#endif
+
+#ifndef configUSE_LEAN_MUTEXES
+	/* Set to 1 to build the task support needed by lean_mutex.c. */
+	#define configUSE_LEAN_MUTEXES 0
+#endif
+
+#ifndef configLEAN_MUTEX_WAIT_LISTS
+	/* Number of event lists shared by all lean mutexes.  A blocked task waits
+	in the list selected by the address of its mutex. */
+	#define configLEAN_MUTEX_WAIT_LISTS 4
+#endif
+
+#ifndef configUSE_CEILING_MUTEXES
+	/* Set to 1 to build the priority ceiling mutexes of lean_mutex.c, and the
+	task support they need. */
+	#define configUSE_CEILING_MUTEXES 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to order the ready tasks of priority configEDF_PRIORITY by
+	absolute deadline instead of sharing the processor between them. */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configEDF_PRIORITY
+	/* The priority at which tasks given a deadline with vTaskSetDeadline() are
+	scheduled earliest deadline first.  Tasks above it preempt them and tasks
+	below it run in the time they leave. */
+	#define configEDF_PRIORITY 1
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+	/* Set to 1 to let tasks be given an execution budget that is replenished
+	each period, and enforced when it is used up.  configBUDGET_TIMER_VALUE()
+	must then be defined to read the free running hardware timer the budgets
+	are measured with. */
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+#ifndef configBUDGET_TIMER_MASK
+	/* The bits counted by the timer read by configBUDGET_TIMER_VALUE(), for
+	timers narrower than 32 bits. */
+	#define configBUDGET_TIMER_MASK 0xFFFFFFFFUL
+#endif
+
+#ifndef configBUDGET_DEMOTED_PRIORITY
+	/* The priority a task given the eBudgetDemote action runs at once its
+	budget is used up, until the budget is replenished. */
+	#define configBUDGET_DEMOTED_PRIORITY 0
+#endif
+
+#ifndef configUSE_BUDGET_EXHAUSTED_HOOK
+	#define configUSE_BUDGET_EXHAUSTED_HOOK 0
+#endif
+
+#ifndef configUSE_TIME_SLICE_QUANTUM
+	/* Set to 1 to let each task run for its own number of ticks before time
+	slicing switches to the next ready task of the same priority, instead of
+	switching every tick. */
+	#define configUSE_TIME_SLICE_QUANTUM 0
+#endif
+
+#ifndef configDEFAULT_TIME_SLICE_QUANTUM
+	/* The time slice, in ticks, tasks are created with when
+	configUSE_TIME_SLICE_QUANTUM is 1. */
+	#define configDEFAULT_TIME_SLICE_QUANTUM 1
+#endif
+
+#ifndef configCYCLIC_NOTIFICATION_INDEX
+	/* The index of the task notification the cyclic executive of cyclic.c
+	releases slot tasks with. */
+	#define configCYCLIC_NOTIFICATION_INDEX 0
+#endif
+
+#ifndef configUSE_CYCLIC_OVERRUN_HOOK
+	#define configUSE_CYCLIC_OVERRUN_HOOK 0
+#endif
+
+#ifndef configUSE_TASK_POOLS
+	/* Set to 1 to include xTaskPoolCreate() and xTaskCreateFromPool(). */
+	#define configUSE_TASK_POOLS 0
+#endif
+
+#ifndef configUSE_TASK_SNAPSHOT
+	/* Set to 1 to include vTaskSnapshotStart() and eTaskSnapshotNext(). */
+	#define configUSE_TASK_SNAPSHOT 0
+#endif
+
+#ifndef configUSE_STACK_WATERMARK
+	/* Set to 1 to have the idle task keep the least free stack space of every
+	task, and to include uxTaskGetStackReport(). */
+	#define configUSE_STACK_WATERMARK 0
+#endif
+
+#ifndef configSTACK_WATERMARK_MARGIN
+	/* The free stack space, in words, below which vApplicationStackMarginHook()
+	is called, and which uxTaskGetStackReport() adds to the stack a task has
+	used to recommend its stack depth. */
+	#define configSTACK_WATERMARK_MARGIN 16
+#endif
+
+#ifndef configUSE_STACK_MARGIN_HOOK
+	#define configUSE_STACK_MARGIN_HOOK 0
+#endif
+
+#ifndef configUSE_OBJECT_STATS
+	/* Set to 1 to count the sends, receives, failures and blocking time of
+	every queue, semaphore, mutex, stream buffer and event group. */
+	#define configUSE_OBJECT_STATS 0
+#endif
+
+#ifndef configUSE_BLOCKING_STATS
+	/* Set to 1 to keep, for every task, the time it has spent blocked for each
+	eBlockReason and the object it blocked on longest. */
+	#define configUSE_BLOCKING_STATS 0
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -837,6 +1103,50 @@ extern "C" {
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( ( configUSE_LEAN_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use lean mutexes
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#if( ( configUSE_CEILING_MUTEXES == 1 ) && ( configUSE_LEAN_MUTEXES != 1 ) )
+	#error configUSE_LEAN_MUTEXES must be set to 1 to use ceiling mutexes
+#endif
+
+#if( ( configUSE_EDF_SCHEDULING == 1 ) && ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) ) )
+	#error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+#endif
+
+#if( ( configUSE_TASK_BUDGETS == 1 ) && !defined( configBUDGET_TIMER_VALUE ) )
+	#error configBUDGET_TIMER_VALUE() must be defined to use task budgets
+#endif
+
+#if( ( configUSE_TASK_BUDGETS == 1 ) && ( configBUDGET_DEMOTED_PRIORITY >= configMAX_PRIORITIES ) )
+	#error configBUDGET_DEMOTED_PRIORITY must be below configMAX_PRIORITIES
+#endif
+
+#if( ( configUSE_TIME_SLICE_QUANTUM == 1 ) && ( configDEFAULT_TIME_SLICE_QUANTUM < 1 ) )
+	#error configDEFAULT_TIME_SLICE_QUANTUM must be at least 1
+#endif
+
+#if( configCYCLIC_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+	#error configCYCLIC_NOTIFICATION_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+#if( ( configUSE_TASK_POOLS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use task pools
+#endif
+
+#if( ( configUSE_TASK_SNAPSHOT == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+	#error configUSE_TRACE_FACILITY must be set to 1 to use task snapshots
+#endif
+
+#if( ( configUSE_STACK_MARGIN_HOOK == 1 ) && ( configUSE_STACK_WATERMARK != 1 ) )
+	#error configUSE_STACK_WATERMARK must be set to 1 to use the stack margin hook
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -968,6 +1278,25 @@ typedef struct xSTATIC_LIST
 	StaticMiniListItem_t xDummy3;
 } StaticList_t;
 
+/*
+ * Why a task is in the Blocked state, as recorded when configUSE_BLOCKING_STATS
+ * is set to 1.  Defined here rather than in task.h because StaticTask_t needs
+ * the number of reasons.
+ */
+typedef enum
+{
+	eBlockNone = 0,		/* The task is not blocked. */
+	eBlockDelay,		/* vTaskDelay() or vTaskDelayUntil(). */
+	eBlockQueue,		/* Sending to or receiving from a queue, a priority queue or a broadcast channel. */
+	eBlockSemaphore,	/* Taking or giving a binary or counting semaphore. */
+	eBlockMutex,		/* Taking a mutex, a lean mutex or a reader/writer lock. */
+	eBlockEventGroup,	/* Waiting for event group bits. */
+	eBlockStreamBuffer,	/* Sending to or receiving from a stream or message buffer. */
+	eBlockNotification,	/* Waiting for a direct to task notification. */
+	eBlockOther,		/* Waiting on an event list no reason was given for. */
+	eBlockReasonCount
+} eBlockReason;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1003,6 +1332,40 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_MUTEXES == 1 )
 		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if( configUSE_LEAN_MUTEXES == 1 )
+		void			*pvDummy13;
+	#endif
+	#if( configUSE_CEILING_MUTEXES == 1 )
+		UBaseType_t		uxDummy13;
+	#endif
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy22[ 3 ];
+		uint32_t		ulDummy23[ 2 ];
+	#endif
+	#if( configUSE_TASK_BUDGETS == 1 )
+		StaticListItem_t	xDummy24;
+		uint32_t		ulDummy25[ 3 ];
+		TickType_t		xDummy26[ 2 ];
+		UBaseType_t		uxDummy27;
+		uint8_t			ucDummy28[ 2 ];
+	#endif
+	#if( configUSE_TIME_SLICE_QUANTUM == 1 )
+		UBaseType_t		uxDummy29[ 2 ];
+	#endif
+	#if( configUSE_TASK_POOLS == 1 )
+		void			*pvDummy30;
+	#endif
+	#if( ( configUSE_TASK_SNAPSHOT == 1 ) || ( configUSE_STACK_WATERMARK == 1 ) )
+		StaticListItem_t	xDummy31;
+	#endif
+	#if( configUSE_STACK_WATERMARK == 1 )
+		configSTACK_DEPTH_TYPE	uxDummy32[ 2 ];
+	#endif
+	#if( configUSE_BLOCKING_STATS == 1 )
+		uint32_t		ulDummy33[ eBlockReasonCount + 2 ];
+		void			*pvDummy34[ 2 ];
+		uint8_t			ucDummy35[ 3 ];
+	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
@@ -1016,8 +1379,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) || ( portUSING_MPU_WRAPPERS == 1 ) )
 		uint8_t			uxDummy20;
@@ -1029,6 +1392,30 @@ typedef struct xSTATIC_TCB
 
 } StaticTask_t;
 
+/*
+ * The statistics kept for each queue, semaphore, mutex, stream buffer and
+ * event group when configUSE_OBJECT_STATS is set to 1.  A send is a queue
+ * send, a semaphore or mutex give, a stream buffer send or an event group set,
+ * and a receive is a queue receive, a semaphore or mutex take, a stream buffer
+ * receive or an event group wait or sync.  Times are in ticks.
+ */
+typedef struct xOBJECT_STATS
+{
+	uint32_t ulSends;				/*< Successful sends. */
+	uint32_t ulReceives;			/*< Successful receives. */
+	uint32_t ulSendFailures;		/*< Sends that found the object full and timed out, or did not wait. */
+	uint32_t ulReceiveFailures;		/*< Receives that found the object empty and timed out, or did not wait. */
+	UBaseType_t uxMaxFill;			/*< The most items a queue or semaphore, or bytes a stream buffer, has held.  Not used by event groups. */
+	uint32_t ulSendBlockedTicks;	/*< The total time senders waited. */
+	TickType_t xSendBlockedMax;		/*< The longest time a sender waited. */
+	uint32_t ulReceiveBlockedTicks;	/*< The total time receivers waited. */
+	TickType_t xReceiveBlockedMax;	/*< The longest time a receiver waited. */
+	uint32_t ulHoldTicks;			/*< Mutexes only - the total time the mutex has been held. */
+	TickType_t xHoldMax;			/*< Mutexes only - the longest time the mutex has been held. */
+	uint32_t ulInheritances;		/*< Mutexes only - the times a task waiting for the mutex raised the priority of its holder. */
+	TickType_t xHoldStart;			/*< Mutexes only - the time the mutex was last taken. */
+} ObjectStats_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1070,6 +1457,10 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xDummy10;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1100,8 +1491,79 @@ typedef struct xSTATIC_EVENT_GROUP
 			uint8_t ucDummy4;
 	#endif
 
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		StaticList_t xDummy5[ configEVENT_GROUP_INDEX_BUCKETS ];
+		TickType_t xDummy6;
+	#endif
+
+	#if( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xDummy7;
+	#endif
+
 } StaticEventGroup_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the readers-writer lock structure used internally by
+ * rwlock.c is not accessible to application code.  The StaticRWLock_t structure
+ * below has the same size and alignment requirements as the genuine structure,
+ * and is provided for applications that create readers-writer locks with
+ * xRWLockCreateStatic().
+ */
+typedef struct xSTATIC_RWLOCK
+{
+	StaticList_t xDummy1[ 2 ];
+	void *pvDummy2;
+	UBaseType_t uxDummy3;
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy4;
+	#endif
+
+} StaticRWLock_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the broadcast channel structure used internally by
+ * broadcast.c is not accessible to application code.  The StaticBroadcast_t
+ * structure below has the same size and alignment requirements as the genuine
+ * structure, and is provided for applications that create broadcast channels
+ * with xBroadcastCreateStatic().
+ */
+typedef struct xSTATIC_BROADCAST
+{
+	void *pvDummy1;
+	UBaseType_t uxDummy2[ 2 ];
+	uint32_t ulDummy3;
+	void *pvDummy4;
+	StaticList_t xDummy5[ 2 ];
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy6;
+	#endif
+
+} StaticBroadcast_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the priority queue structure used internally by
+ * priority_queue.c is not accessible to application code.  The
+ * StaticPriorityQueue_t structure below has the same size and alignment
+ * requirements as the genuine structure, and is provided for applications that
+ * create priority queues with xPriorityQueueCreateStatic().
+ */
+typedef struct xSTATIC_PRIORITY_QUEUE
+{
+	void *pvDummy1[ 3 ];
+	UBaseType_t uxDummy2[ 5 ];
+	StaticList_t xDummy3[ 2 ];
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy4;
+	#endif
+
+} StaticPriorityQueue_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1131,6 +1593,14 @@ typedef struct xSTATIC_TIMER
 		uint8_t 		ucDummy7;
 	#endif
 
+	#if( configUSE_TIMER_HEAP == 1 )
+		UBaseType_t		uxDummy8;
+	#endif
+
+	#if( configUSE_TIMER_STATS == 1 )
+		uint32_t		ulDummy9[ 8 ];
+	#endif
+
 } StaticTimer_t;
 
 /*
@@ -1155,6 +1625,9 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_OBJECT_STATS == 1 )
+		ObjectStats_t xDummy5;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
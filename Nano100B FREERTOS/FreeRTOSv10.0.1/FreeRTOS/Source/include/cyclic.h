@@ -0,0 +1,261 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A cyclic executive runs work at fixed offsets within a repeating major
+ * frame, as set out in a static table of slots, rather than when tasks next
+ * get round to it.  The major frame is divided into minor frames, and is
+ * advanced one minor frame at a time by calling
+ * vCyclicExecutiveDispatchFromISR() from a periodic interrupt - the tick hook
+ * for a minor frame of one tick, or a hardware timer interrupt for any other.
+ *
+ * Each slot either calls a function from the dispatching interrupt, or
+ * releases a task, which wakes from xCyclicExecutiveWaitForRelease().  A slot
+ * task is given the number of minor frames it has to complete its work in,
+ * and completes it by calling xCyclicExecutiveWaitForRelease() again.  The
+ * executive counts a slot's releases, its overruns - releases whose work was
+ * not complete by the end of the slot - and the releases it skipped because
+ * the task was still working on an earlier one.
+ *
+ * The slots release their tasks at the same point in every major frame
+ * however long the work of the previous release took, so releases do not
+ * drift as loops timed with vTaskDelayUntil() can when they are late.  Slot
+ * tasks should have priorities above the tasks that run in the background,
+ * which are scheduled as usual in the time the slots leave.
+ *
+ * Releases are sent with the direct to task notification at index
+ * configCYCLIC_NOTIFICATION_INDEX, which slot tasks must not use for anything
+ * else.
+ */
+
+#ifndef CYCLIC_H
+#define CYCLIC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include cyclic.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/*
+ * The prototype of the functions called by function slots, from the
+ * interrupt that calls vCyclicExecutiveDispatchFromISR().  They can only use
+ * API functions whose names end in FromISR.
+ */
+typedef void (*CyclicSlotFunction_t)( void *pvParameters );
+
+/*
+ * One slot of a cyclic schedule.  The application declares the table of slots
+ * and sets the first five members of each before passing the table to
+ * vCyclicExecutiveStart().  The remaining members are private to cyclic.c.
+ */
+typedef struct CYCLIC_SLOT
+{
+	TickType_t xOffset;					/*< Minor frames from the start of the major frame to the release. */
+	TickType_t xLength;					/*< Minor frames a slot task has to complete its work in. */
+	TaskHandle_t xTask;					/*< The task the slot releases, or NULL to call pxFunction. */
+	CyclicSlotFunction_t pxFunction;	/*< Called at the release if xTask is NULL. */
+	void *pvParameters;					/*< Passed to pxFunction. */
+
+	uint32_t ulReleases;
+	uint32_t ulOverruns;
+	uint32_t ulSkipped;
+	BaseType_t xRunning;				/*< pdTRUE from a task slot's release until its task completes the work. */
+} CyclicSlot_t;
+
+/*
+ * Initialisers for the members of a slot set by the application, to be used
+ * in the declaration of a table of slots.  The task of a task slot is set
+ * once it has been created.
+ */
+#define cyclicTASK_SLOT( xOffset, xLength ) { ( xOffset ), ( xLength ), NULL, NULL, NULL, 0UL, 0UL, 0UL, pdFALSE }
+#define cyclicFUNCTION_SLOT( xOffset, pxFunction, pvParameters ) { ( xOffset ), 1, NULL, ( pxFunction ), ( pvParameters ), 0UL, 0UL, 0UL, pdFALSE }
+
+/**
+ * cyclic.h
+ *
+<pre>
+void vCyclicExecutiveStart( CyclicSlot_t *pxSlots, UBaseType_t uxSlots, TickType_t xMajorFrame );
+</pre>
+ *
+ * Start dispatching the table of uxSlots slots pointed to by pxSlots, in a
+ * major frame of xMajorFrame minor frames.  Each slot's offset must be less
+ * than xMajorFrame, and its length between 1 and xMajorFrame.  Slots can
+ * share an offset, and are then released in table order.  The counts of
+ * every slot are reset, and the first minor frame starts at the next call to
+ * vCyclicExecutiveDispatchFromISR().  Starting a new table replaces the one
+ * being dispatched.
+ *
+ * The table is used in place, so must remain in existence until
+ * vCyclicExecutiveStop() is called.
+ *
+ * Example use:
+<pre>
+static CyclicSlot_t xSchedule[] =
+{
+    cyclicTASK_SLOT( 0, 2 ),                        // Control loop, minor frames 0 and 1.
+    cyclicFUNCTION_SLOT( 2, vSampleInputs, NULL ),  // From the interrupt at minor frame 2.
+    cyclicTASK_SLOT( 5, 2 )                         // Control loop again, minor frames 5 and 6.
+};
+
+void vStartSchedule( void )
+{
+    xTaskCreate( vControlTask, "Ctrl", 128, NULL, configMAX_PRIORITIES - 1, &( xSchedule[ 0 ].xTask ) );
+    xSchedule[ 2 ].xTask = xSchedule[ 0 ].xTask;
+
+    // A major frame of 10 ticks, dispatched from vApplicationTickHook().
+    vCyclicExecutiveStart( xSchedule, 3, 10 );
+}
+
+void vApplicationTickHook( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vCyclicExecutiveDispatchFromISR( &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+void vControlTask( void *pvParameters )
+{
+    for( ;; )
+    {
+        xCyclicExecutiveWaitForRelease( portMAX_DELAY );
+        vRunControlLoop();
+    }
+}
+</pre>
+ *
+ * \defgroup vCyclicExecutiveStart vCyclicExecutiveStart
+ * \ingroup CyclicExecutive
+ */
+void vCyclicExecutiveStart( CyclicSlot_t *pxSlots, UBaseType_t uxSlots, TickType_t xMajorFrame ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic.h
+ *
+<pre>
+void vCyclicExecutiveStop( void );
+</pre>
+ *
+ * Stop dispatching.  Tasks waiting for a release stay blocked until their
+ * block time expires, or a table that releases them is started.
+ *
+ * \defgroup vCyclicExecutiveStop vCyclicExecutiveStop
+ * \ingroup CyclicExecutive
+ */
+void vCyclicExecutiveStop( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic.h
+ *
+<pre>
+void vCyclicExecutiveDispatchFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Advance the executive by one minor frame, counting the overruns of the slots
+ * that end, and releasing the slots that start.  Call from one periodic
+ * interrupt, the period of which is the minor frame.  Does nothing if no
+ * table is being dispatched.
+ *
+ * If configUSE_CYCLIC_OVERRUN_HOOK is 1 the application must provide
+ * void vApplicationCyclicOverrunHook( CyclicSlot_t *pxSlot ), which is called
+ * from the interrupt for each overrun.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a released task has a
+ * priority above that of the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * \defgroup vCyclicExecutiveDispatchFromISR vCyclicExecutiveDispatchFromISR
+ * \ingroup CyclicExecutive
+ */
+void vCyclicExecutiveDispatchFromISR( BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic.h
+ *
+<pre>
+BaseType_t xCyclicExecutiveWaitForRelease( TickType_t xTicksToWait );
+</pre>
+ *
+ * Called by a slot task to complete the work of its current release, if it
+ * has one, and wait for its next release.  A task can be the task of several
+ * slots, and is then released by each in turn.
+ *
+ * @return pdPASS if the task was released, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xCyclicExecutiveWaitForRelease xCyclicExecutiveWaitForRelease
+ * \ingroup CyclicExecutive
+ */
+BaseType_t xCyclicExecutiveWaitForRelease( TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic.h
+ *
+<pre>
+TickType_t xCyclicExecutiveGetMinorFrame( void );
+</pre>
+ *
+ * @return The minor frame of the major frame the executive is in, from 0 to
+ * one less than the major frame length.
+ *
+ * \defgroup xCyclicExecutiveGetMinorFrame xCyclicExecutiveGetMinorFrame
+ * \ingroup CyclicExecutive
+ */
+TickType_t xCyclicExecutiveGetMinorFrame( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic.h
+ *
+<pre>
+uint32_t ulCyclicSlotGetReleases( CyclicSlot_t *pxSlot );
+uint32_t ulCyclicSlotGetOverruns( CyclicSlot_t *pxSlot );
+uint32_t ulCyclicSlotGetSkipped( CyclicSlot_t *pxSlot );
+</pre>
+ *
+ * @return The number of times a slot has been released, the number of those
+ * releases whose work was not complete by the end of the slot, and the number
+ * of releases skipped because the slot's task was still working on an earlier
+ * release, since the table was started.
+ *
+ * \defgroup ulCyclicSlotGetReleases ulCyclicSlotGetReleases
+ * \ingroup CyclicExecutive
+ */
+#define ulCyclicSlotGetReleases( pxSlot ) ( ( pxSlot )->ulReleases )
+#define ulCyclicSlotGetOverruns( pxSlot ) ( ( pxSlot )->ulOverruns )
+#define ulCyclicSlotGetSkipped( pxSlot ) ( ( pxSlot )->ulSkipped )
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* CYCLIC_H */
+
@@ -737,6 +737,50 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup ) PRIVILEG
  */
 void vEventGroupDelete( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
 
+/**
+ * event_groups.h
+ *<pre>
+	void vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName );
+ </pre>
+ *
+ * Adds an event group to the queue registry, so it is available to a kernel
+ * aware debugger and, when configUSE_OBJECT_STATS is set to 1, its statistics
+ * are returned by uxQueueGetRegistryStats().  The event group is removed from
+ * the registry when it is deleted.  configQUEUE_REGISTRY_SIZE must be greater
+ * than 0 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xEventGroup The event group being added to the registry.
+ *
+ * @param pcName The name to be associated with the handle.  Only a pointer to
+ * the string is stored, so the string must be persistent.
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	void vEventGroupAddToRegistry( EventGroupHandle_t xEventGroup, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+/**
+ * event_groups.h
+ *<pre>
+	void vEventGroupGetStats( EventGroupHandle_t xEventGroup, ObjectStats_t *pxStats );
+ </pre>
+ *
+ * Copies the statistics of an event group.  Each call to xEventGroupSetBits(),
+ * including those made by xEventGroupSync() and on behalf of
+ * xEventGroupSetBitsFromISR(), counts as a send.  Each call to
+ * xEventGroupWaitBits() or xEventGroupSync() counts as a receive if its wait
+ * condition was met, or as a receive failure if it timed out, and the time it
+ * waited is added to the receive blocking time.  uxMaxFill is not used.
+ * configUSE_OBJECT_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * @param xEventGroup The event group being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+#if( configUSE_OBJECT_STATS == 1 )
+	void vEventGroupGetStats( EventGroupHandle_t xEventGroup, ObjectStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /* For internal use only. */
 void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
 void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
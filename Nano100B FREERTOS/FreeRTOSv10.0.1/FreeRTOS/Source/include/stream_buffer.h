@@ -828,6 +828,58 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName );
+</pre>
+ *
+ * Adds a stream buffer or message buffer to the queue registry, so it is
+ * available to a kernel aware debugger and, when configUSE_OBJECT_STATS is set
+ * to 1, its statistics are returned by uxQueueGetRegistryStats().  The stream
+ * buffer is removed from the registry when it is deleted.
+ * configQUEUE_REGISTRY_SIZE must be greater than 0 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being added to the
+ * registry.
+ *
+ * @param pcName The name to be associated with the handle.  Only a pointer to
+ * the string is stored, so the string must be persistent.
+ *
+ * \defgroup vStreamBufferAddToRegistry vStreamBufferAddToRegistry
+ * \ingroup StreamBufferManagement
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	void vStreamBufferAddToRegistry( StreamBufferHandle_t xStreamBuffer, const char *pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, ObjectStats_t *pxStats );
+</pre>
+ *
+ * Copies the statistics of a stream buffer or message buffer - the sends and
+ * receives that returned data, those that returned 0 because the buffer was
+ * full or empty, the most bytes the buffer has held, and the total and longest
+ * time the sending and the receiving task waited.  The statistics are kept
+ * when the buffer is reset.  configUSE_OBJECT_STATS must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * \defgroup vStreamBufferGetStats vStreamBufferGetStats
+ * \ingroup StreamBufferManagement
+ */
+#if( configUSE_OBJECT_STATS == 1 )
+	void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, ObjectStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
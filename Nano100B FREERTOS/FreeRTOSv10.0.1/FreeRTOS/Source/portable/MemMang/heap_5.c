@@ -66,6 +66,12 @@
  *
  * Note 0x80000000 is the lower address so appears in the array first.
  *
+ * If configUSE_HEAP_REGION_STATS is set to 1 in FreeRTOSConfig.h then the free
+ * space, low water mark and allocation counts are also tracked separately for
+ * each region, and can be queried using xPortGetHeapRegionStats().  Up to
+ * configHEAP_MAX_REGIONS regions can be tracked; regions after those are
+ * still used for allocations but are not tracked.
+ *
  */
 #include <stdlib.h>
 
@@ -127,12 +133,35 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_REGION_STATS == 1 )
+
+	/* Statistics for each region passed to vPortDefineHeapRegions().  A block
+	never spans two regions as each region is terminated by its own end marker,
+	so a block belongs to the region whose address range contains it. */
+	static HeapRegionStats_t xRegionStats[ configHEAP_MAX_REGIONS ];
+	static UBaseType_t uxNumberOfRegions = 0U;
+
+	/*
+	 * Returns the statistics of the region that contains pxBlock, or NULL if
+	 * the block is in a region that is not tracked.  The search is bounded by
+	 * configHEAP_MAX_REGIONS.
+	 */
+	static HeapRegionStats_t *prvGetRegionStats( const BlockLink_t *pxBlock );
+
+#endif /* configUSE_HEAP_REGION_STATS */
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_STATS == 1 )
+	size_t xRequestedSize = xWantedSize;
+#endif
+#if( configUSE_HEAP_REGION_STATS == 1 )
+	HeapRegionStats_t *pxRegionStats;
+#endif
 
 	/* The heap must be initialised before the first call to
 	prvPortMalloc(). */
@@ -150,6 +179,14 @@ void *pvReturn = NULL;
 			structure in addition to the requested amount of bytes. */
 			if( xWantedSize > 0 )
 			{
+				#if( configUSE_HEAP_STATS == 1 )
+				{
+					/* Make room for the tag heap_stats.c places in front of
+					the application's memory. */
+					xWantedSize += xHeapStatsTagSize;
+				}
+				#endif
+
 				xWantedSize += xHeapStructSize;
 
 				/* Ensure that blocks are always aligned to the required number
@@ -193,6 +230,12 @@ void *pvReturn = NULL;
 					of the list of free blocks. */
 					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+					#if( configUSE_HEAP_STATS == 1 )
+					{
+						vPortHeapStatsFreeBlockRemoved( pxBlock->xBlockSize );
+					}
+					#endif
+
 					/* If the block is larger than required it can be split into
 					two. */
 					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
@@ -227,10 +270,41 @@ void *pvReturn = NULL;
 						mtCOVERAGE_TEST_MARKER();
 					}
 
+					#if( configUSE_HEAP_REGION_STATS == 1 )
+					{
+						pxRegionStats = prvGetRegionStats( pxBlock );
+
+						if( pxRegionStats != NULL )
+						{
+							pxRegionStats->xFreeBytesRemaining -= pxBlock->xBlockSize;
+							( pxRegionStats->xNumberOfSuccessfulAllocations )++;
+
+							if( pxRegionStats->xFreeBytesRemaining < pxRegionStats->xMinimumEverFreeBytesRemaining )
+							{
+								pxRegionStats->xMinimumEverFreeBytesRemaining = pxRegionStats->xFreeBytesRemaining;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_HEAP_REGION_STATS */
+
 					/* The block is being returned - it is allocated and owned
 					by the application and has no "next" block. */
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
 					pxBlock->pxNextFreeBlock = NULL;
+
+					#if( configUSE_HEAP_STATS == 1 )
+					{
+						pvReturn = pvPortHeapStatsBlockAllocated( pvReturn, xRequestedSize, configHEAP_STATS_GET_CALLER() );
+					}
+					#endif
 				}
 				else
 				{
@@ -273,9 +347,20 @@ void vPortFree( void *pv )
 {
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
+#if( configUSE_HEAP_REGION_STATS == 1 )
+	HeapRegionStats_t *pxRegionStats;
+#endif
 
 	if( pv != NULL )
 	{
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			/* Step back over the tag to the address the allocator handed
+			out. */
+			puc = ( uint8_t * ) pvPortHeapStatsBlockFreed( pv );
+		}
+		#endif
+
 		/* The memory being freed will have an BlockLink_t structure immediately
 		before it. */
 		puc -= xHeapStructSize;
@@ -300,6 +385,25 @@ BlockLink_t *pxLink;
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
+
+					#if( configUSE_HEAP_REGION_STATS == 1 )
+					{
+						/* Must be looked up before the block is merged with
+						its neighbours. */
+						pxRegionStats = prvGetRegionStats( pxLink );
+
+						if( pxRegionStats != NULL )
+						{
+							pxRegionStats->xFreeBytesRemaining += pxLink->xBlockSize;
+							( pxRegionStats->xNumberOfSuccessfulFrees )++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_HEAP_REGION_STATS */
+
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 				}
 				( void ) xTaskResumeAll();
@@ -346,6 +450,13 @@ uint8_t *puc;
 	puc = ( uint8_t * ) pxIterator;
 	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
 	{
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			/* The block in front is absorbed into the one being inserted. */
+			vPortHeapStatsFreeBlockRemoved( pxIterator->xBlockSize );
+		}
+		#endif
+
 		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
 		pxBlockToInsert = pxIterator;
 	}
@@ -361,6 +472,12 @@ uint8_t *puc;
 	{
 		if( pxIterator->pxNextFreeBlock != pxEnd )
 		{
+			#if( configUSE_HEAP_STATS == 1 )
+			{
+				vPortHeapStatsFreeBlockRemoved( pxIterator->pxNextFreeBlock->xBlockSize );
+			}
+			#endif
+
 			/* Form one big block from the two blocks. */
 			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
 			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
@@ -387,6 +504,12 @@ uint8_t *puc;
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
+
+	#if( configUSE_HEAP_STATS == 1 )
+	{
+		vPortHeapStatsFreeBlockAdded( pxBlockToInsert->xBlockSize );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -468,6 +591,35 @@ const HeapRegion_t *pxHeapRegion;
 
 		xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
 
+		#if( configUSE_HEAP_STATS == 1 )
+		{
+			vPortHeapStatsFreeBlockAdded( pxFirstFreeBlockInRegion->xBlockSize );
+		}
+		#endif
+
+		#if( configUSE_HEAP_REGION_STATS == 1 )
+		{
+			/* Increase configHEAP_MAX_REGIONS if this assert is hit.  Without
+			asserts the regions that do not fit are left untracked. */
+			configASSERT( uxNumberOfRegions < ( UBaseType_t ) configHEAP_MAX_REGIONS );
+
+			if( uxNumberOfRegions < ( UBaseType_t ) configHEAP_MAX_REGIONS )
+			{
+				xRegionStats[ uxNumberOfRegions ].pucStartAddress = ( uint8_t * ) pxFirstFreeBlockInRegion;
+				xRegionStats[ uxNumberOfRegions ].xRegionSizeInBytes = pxFirstFreeBlockInRegion->xBlockSize;
+				xRegionStats[ uxNumberOfRegions ].xFreeBytesRemaining = pxFirstFreeBlockInRegion->xBlockSize;
+				xRegionStats[ uxNumberOfRegions ].xMinimumEverFreeBytesRemaining = pxFirstFreeBlockInRegion->xBlockSize;
+				xRegionStats[ uxNumberOfRegions ].xNumberOfSuccessfulAllocations = 0;
+				xRegionStats[ uxNumberOfRegions ].xNumberOfSuccessfulFrees = 0;
+				uxNumberOfRegions++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_HEAP_REGION_STATS */
+
 		/* Move onto the next HeapRegion_t structure. */
 		xDefinedRegions++;
 		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
@@ -482,4 +634,73 @@ const HeapRegion_t *pxHeapRegion;
 	/* Work out the position of the top bit in a size_t variable. */
 	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
 }
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_REGION_STATS == 1 )
+
+	static HeapRegionStats_t *prvGetRegionStats( const BlockLink_t *pxBlock )
+	{
+	UBaseType_t uxRegion;
+	HeapRegionStats_t *pxReturn = NULL;
+
+		/* Regions are defined in increasing address order, so the block
+		belongs to the last region that starts at or below its address. */
+		configASSERT( uxNumberOfRegions > 0U );
+
+		for( uxRegion = uxNumberOfRegions - 1U; uxRegion > 0U; uxRegion-- )
+		{
+			if( xRegionStats[ uxRegion ].pucStartAddress <= ( const uint8_t * ) pxBlock )
+			{
+				break;
+			}
+		}
+
+		/* A block past the end of the last tracked region is in a region that
+		did not fit in xRegionStats[]. */
+		if( ( const uint8_t * ) pxBlock < ( xRegionStats[ uxRegion ].pucStartAddress + xRegionStats[ uxRegion ].xRegionSizeInBytes ) )
+		{
+			pxReturn = &( xRegionStats[ uxRegion ] );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetHeapRegionCount( void )
+	{
+		return uxNumberOfRegions;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortGetHeapRegionStats( UBaseType_t uxRegion, HeapRegionStats_t *pxRegionStats )
+	{
+	BaseType_t xReturn;
+
+		configASSERT( pxRegionStats );
+
+		if( uxRegion < uxNumberOfRegions )
+		{
+			/* Take a consistent copy - the counters are only updated with the
+			scheduler suspended. */
+			vTaskSuspendAll();
+			{
+				*pxRegionStats = xRegionStats[ uxRegion ];
+			}
+			( void ) xTaskResumeAll();
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_HEAP_REGION_STATS */
 
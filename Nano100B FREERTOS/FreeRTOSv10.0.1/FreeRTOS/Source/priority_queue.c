@@ -0,0 +1,559 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "priority_queue.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The slot index used to mark the end of a list of slots. */
+#define priorityqueueNO_SLOT( pxQueue )		( ( pxQueue )->uxLength )
+
+/* The items of one priority, held as a FIFO list of slots linked through the
+puxNextSlot array.  Four UBaseType_t values, as priorityqueueSTORAGE_SIZE()
+assumes. */
+typedef struct PriorityQueueLevel
+{
+	UBaseType_t uxHead;			/*< The slot holding the oldest item, or priorityqueueNO_SLOT(). */
+	UBaseType_t uxTail;			/*< The slot holding the newest item. */
+	UBaseType_t uxCount;
+	UBaseType_t uxHighWaterMark;
+} PriorityQueueLevel_t;
+
+typedef struct PriorityQueueDefinition
+{
+	PriorityQueueLevel_t *pxLevels;		/*< One entry per priority. */
+	UBaseType_t *puxNextSlot;			/*< The slot after each slot in its level's list, or in the free list. */
+	uint8_t *pucItems;					/*< uxLength items of uxItemSize bytes. */
+	UBaseType_t uxLength;
+	UBaseType_t uxItemSize;
+	UBaseType_t uxLevels;
+	UBaseType_t uxFreeSlot;				/*< The first unused slot, or priorityqueueNO_SLOT() if the queue is full. */
+	UBaseType_t uxMessagesWaiting;		/*< The number of items held, of all priorities. */
+	List_t xTasksWaitingToSend;			/*< Tasks blocked waiting for a free slot, in priority order. */
+	List_t xTasksWaitingToReceive;		/*< Tasks blocked waiting for an item, in priority order. */
+
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the queue is statically allocated to ensure no attempt is made to free the memory. */
+	#endif
+} PriorityQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Lay the levels, the slot links and the items out in pucStorage, and link
+ * every slot into the free list.
+ */
+static void prvInitialisePriorityQueue( PriorityQueue_t *pxQueue, UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels, uint8_t *pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy an item into a free slot at the tail of its level, and unblock the
+ * highest priority task waiting to receive.  Called with interrupts masked and
+ * the queue not full.  Returns pdTRUE if the unblocked task has a priority
+ * above that of the calling task.
+ */
+static BaseType_t prvCopyItemIn( PriorityQueue_t *pxQueue, const void *pvItem, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the oldest item of the highest priority level in use out of the queue,
+ * free its slot, and unblock the highest priority task waiting to send.
+ * Called with interrupts masked and the queue not empty.  Returns pdTRUE if
+ * the unblocked task has a priority above that of the calling task.
+ */
+static BaseType_t prvCopyItemOut( PriorityQueue_t *pxQueue, void *pvBuffer, UBaseType_t *puxPriority ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	PriorityQueueHandle_t xPriorityQueueCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels, uint8_t *pucStorageBuffer, StaticPriorityQueue_t *pxStaticPriorityQueue )
+	{
+	PriorityQueue_t *pxQueue;
+
+		configASSERT( uxLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( uxLevels > ( UBaseType_t ) 0 );
+		configASSERT( pucStorageBuffer );
+		configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucStorageBuffer ) & ( ( portPOINTER_SIZE_TYPE ) sizeof( UBaseType_t ) - 1 ) ) == 0 );
+		configASSERT( pxStaticPriorityQueue );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticPriorityQueue_t equals the size of the real
+			queue structure. */
+			volatile size_t xSize = sizeof( StaticPriorityQueue_t );
+			configASSERT( xSize == sizeof( PriorityQueue_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxQueue = ( PriorityQueue_t * ) pxStaticPriorityQueue; /*lint !e740 PriorityQueue_t and StaticPriorityQueue_t are guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+		if( pxQueue != NULL )
+		{
+			prvInitialisePriorityQueue( pxQueue, uxLength, uxItemSize, uxLevels, pucStorageBuffer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return ( PriorityQueueHandle_t ) pxQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels )
+	{
+	PriorityQueue_t *pxQueue;
+
+		configASSERT( uxLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+		configASSERT( uxLevels > ( UBaseType_t ) 0 );
+
+		/* The queue and its storage are allocated together, the storage
+		following the structure, as queue.c does. */
+		pxQueue = ( PriorityQueue_t * ) pvPortMalloc( sizeof( PriorityQueue_t ) + priorityqueueSTORAGE_SIZE( uxLength, uxItemSize, uxLevels ) );
+
+		if( pxQueue != NULL )
+		{
+			prvInitialisePriorityQueue( pxQueue, uxLength, uxItemSize, uxLevels, ( ( uint8_t * ) pxQueue ) + sizeof( PriorityQueue_t ) );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+
+		return ( PriorityQueueHandle_t ) pxQueue;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, TickType_t xTicksToWait )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+BaseType_t xReturn = errQUEUE_FULL, xBlocked, xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+	configASSERT( uxPriority < pxQueue->uxLevels );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			{
+				xYieldRequired = prvCopyItemIn( pxQueue, pvItem, uxPriority );
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = xTaskBlockOnEventList( &( pxQueue->xTasksWaitingToSend ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, eBlockQueue, pxQueue );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxPriority, BaseType_t *pxHigherPriorityTaskWoken )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+BaseType_t xReturn = errQUEUE_FULL;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+	configASSERT( uxPriority < pxQueue->uxLevels );
+
+	/* See the comment in xQueueGenericSendFromISR() about interrupt priorities. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+		{
+			if( ( prvCopyItemIn( pxQueue, pvItem, uxPriority ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, TickType_t xTicksToWait )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+BaseType_t xReturn = errQUEUE_EMPTY, xBlocked, xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	do
+	{
+		xBlocked = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				xYieldRequired = prvCopyItemOut( pxQueue, pvBuffer, puxPriority );
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait != ( TickType_t ) 0 )
+			{
+				xBlocked = xTaskBlockOnEventList( &( pxQueue->xTasksWaitingToReceive ), &xTicksToWait, &xTimeOut, &xEntryTimeSet, eBlockQueue, pxQueue );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+	} while( xBlocked != pdFALSE );
+
+	if( xYieldRequired != pdFALSE )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue, void *pvBuffer, UBaseType_t *puxPriority, BaseType_t *pxHigherPriorityTaskWoken )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+BaseType_t xReturn = errQUEUE_EMPTY;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* See the comment in xQueueGenericSendFromISR() about interrupt priorities. */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+		{
+			if( ( prvCopyItemOut( pxQueue, pvBuffer, puxPriority ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	/* A single read of a base type, so no critical section is needed. */
+	return pxQueue->uxMessagesWaiting;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPriorityQueueGetHighWaterMark( PriorityQueueHandle_t xQueue, UBaseType_t uxPriority )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( uxPriority < pxQueue->uxLevels );
+
+	return pxQueue->pxLevels[ uxPriority ].uxHighWaterMark;
+}
+/*-----------------------------------------------------------*/
+
+void vPriorityQueueResetHighWaterMarks( PriorityQueueHandle_t xQueue )
+{
+PriorityQueue_t *pxQueue = ( PriorityQueue_t * ) xQueue;
+UBaseType_t uxLevel;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxLevel = 0; uxLevel < pxQueue->uxLevels; uxLevel++ )
+		{
+			pxQueue->pxLevels[ uxLevel ].uxHighWaterMark = pxQueue->pxLevels[ uxLevel ].uxCount;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialisePriorityQueue( PriorityQueue_t *pxQueue, UBaseType_t uxLength, UBaseType_t uxItemSize, UBaseType_t uxLevels, uint8_t *pucStorage )
+{
+UBaseType_t ux;
+
+	/* priorityqueueSTORAGE_SIZE() counts four UBaseType_t values per level. */
+	configASSERT( sizeof( PriorityQueueLevel_t ) == ( 4 * sizeof( UBaseType_t ) ) );
+
+	pxQueue->pxLevels = ( PriorityQueueLevel_t * ) pucStorage; /*lint !e826 !e740 The storage is aligned to a UBaseType_t. */
+	pxQueue->puxNextSlot = ( UBaseType_t * ) &( pxQueue->pxLevels[ uxLevels ] );
+	pxQueue->pucItems = ( uint8_t * ) &( pxQueue->puxNextSlot[ uxLength ] );
+	pxQueue->uxLength = uxLength;
+	pxQueue->uxItemSize = uxItemSize;
+	pxQueue->uxLevels = uxLevels;
+	pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+
+	for( ux = 0; ux < uxLevels; ux++ )
+	{
+		pxQueue->pxLevels[ ux ].uxHead = priorityqueueNO_SLOT( pxQueue );
+		pxQueue->pxLevels[ ux ].uxTail = priorityqueueNO_SLOT( pxQueue );
+		pxQueue->pxLevels[ ux ].uxCount = ( UBaseType_t ) 0;
+		pxQueue->pxLevels[ ux ].uxHighWaterMark = ( UBaseType_t ) 0;
+	}
+
+	/* Every slot starts on the free list, the last linking to
+	priorityqueueNO_SLOT(). */
+	for( ux = 0; ux < uxLength; ux++ )
+	{
+		pxQueue->puxNextSlot[ ux ] = ux + ( UBaseType_t ) 1;
+	}
+	pxQueue->uxFreeSlot = ( UBaseType_t ) 0;
+
+	vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+	vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyItemIn( PriorityQueue_t *pxQueue, const void *pvItem, UBaseType_t uxPriority )
+{
+PriorityQueueLevel_t * const pxLevel = &( pxQueue->pxLevels[ uxPriority ] );
+UBaseType_t uxSlot;
+BaseType_t xReturn = pdFALSE;
+
+	/* Take the first free slot. */
+	uxSlot = pxQueue->uxFreeSlot;
+	configASSERT( uxSlot != priorityqueueNO_SLOT( pxQueue ) );
+	pxQueue->uxFreeSlot = pxQueue->puxNextSlot[ uxSlot ];
+
+	( void ) memcpy( ( void * ) &( pxQueue->pucItems[ uxSlot * pxQueue->uxItemSize ] ), pvItem, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+
+	/* Append it to the level's list. */
+	pxQueue->puxNextSlot[ uxSlot ] = priorityqueueNO_SLOT( pxQueue );
+	if( pxLevel->uxHead == priorityqueueNO_SLOT( pxQueue ) )
+	{
+		pxLevel->uxHead = uxSlot;
+	}
+	else
+	{
+		pxQueue->puxNextSlot[ pxLevel->uxTail ] = uxSlot;
+	}
+	pxLevel->uxTail = uxSlot;
+
+	( pxLevel->uxCount )++;
+	if( pxLevel->uxCount > pxLevel->uxHighWaterMark )
+	{
+		pxLevel->uxHighWaterMark = pxLevel->uxCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( pxQueue->uxMessagesWaiting )++;
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+	{
+		xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyItemOut( PriorityQueue_t *pxQueue, void *pvBuffer, UBaseType_t *puxPriority )
+{
+PriorityQueueLevel_t *pxLevel;
+UBaseType_t uxPriority, uxSlot;
+BaseType_t xReturn = pdFALSE;
+
+	/* Find the highest level in use.  The queue is not empty, so there is
+	one. */
+	uxPriority = pxQueue->uxLevels - ( UBaseType_t ) 1;
+	while( pxQueue->pxLevels[ uxPriority ].uxCount == ( UBaseType_t ) 0 )
+	{
+		configASSERT( uxPriority );
+		--uxPriority;
+	}
+	pxLevel = &( pxQueue->pxLevels[ uxPriority ] );
+
+	/* Unlink its oldest item. */
+	uxSlot = pxLevel->uxHead;
+	pxLevel->uxHead = pxQueue->puxNextSlot[ uxSlot ];
+	( pxLevel->uxCount )--;
+	( pxQueue->uxMessagesWaiting )--;
+
+	( void ) memcpy( pvBuffer, ( void * ) &( pxQueue->pucItems[ uxSlot * pxQueue->uxItemSize ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+
+	if( puxPriority != NULL )
+	{
+		*puxPriority = uxPriority;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Return the slot to the free list. */
+	pxQueue->puxNextSlot[ uxSlot ] = pxQueue->uxFreeSlot;
+	pxQueue->uxFreeSlot = uxSlot;
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+	{
+		xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}